@@ -0,0 +1,276 @@
+// Include{s}
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace DirectX;
+
+#pragma region CameraPath
+bool CameraPath::LoadFromJSON(const nlohmann::json& keyframes)
+{
+	m_keyframes.clear();
+
+	if (!keyframes.is_array() || keyframes.empty())
+	{
+		return false;
+	}
+
+	for (const auto& keyframe : keyframes)
+	{
+		nlohmann::json position = keyframe.value("position", nlohmann::json::object());
+		nlohmann::json rotation = keyframe.value("rotation", nlohmann::json::object());
+
+		BenchmarkKeyframe pathKeyframe = {};
+		pathKeyframe.Time = keyframe.value("time", 0.0f);
+		pathKeyframe.Position = XMFLOAT3(position.value("x", 0.0f), position.value("y", 0.0f),
+			position.value("z", 0.0f));
+		pathKeyframe.Rotation = XMFLOAT3(rotation.value("x", 0.0f), rotation.value("y", 0.0f),
+			rotation.value("z", 0.0f));
+
+		// The segment search relies on the times going up
+		if (!m_keyframes.empty() && pathKeyframe.Time <= m_keyframes.back().Time)
+		{
+			m_keyframes.clear();
+			return false;
+		}
+
+		m_keyframes.push_back(pathKeyframe);
+	}
+
+	return true;
+}
+
+void CameraPath::Evaluate(float time, XMFLOAT3& position, XMFLOAT3& rotation) const
+{
+	if (m_keyframes.empty())
+	{
+		position = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		rotation = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		return;
+	}
+
+	// Hold the end points outside the path
+	if (time <= m_keyframes.front().Time || m_keyframes.size() == 1)
+	{
+		position = m_keyframes.front().Position;
+		rotation = m_keyframes.front().Rotation;
+		return;
+	}
+	if (time >= m_keyframes.back().Time)
+	{
+		position = m_keyframes.back().Position;
+		rotation = m_keyframes.back().Rotation;
+		return;
+	}
+
+	// Find the segment the time falls in, the first keyframe after it ends the segment
+	auto next = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), time,
+		[](float value, const BenchmarkKeyframe& keyframe) { return value < keyframe.Time; });
+
+	size_t end = static_cast<size_t>(next - m_keyframes.begin());
+	size_t start = end - 1;
+
+	// The neighbours shape the curve, the end keyframes stand in for the missing ones
+	const BenchmarkKeyframe& before = m_keyframes[start > 0 ? start - 1 : start];
+	const BenchmarkKeyframe& from = m_keyframes[start];
+	const BenchmarkKeyframe& to = m_keyframes[end];
+	const BenchmarkKeyframe& after = m_keyframes[end + 1 < m_keyframes.size() ? end + 1 : end];
+
+	float segmentTime = (time - from.Time) / (to.Time - from.Time);
+
+	XMStoreFloat3(&position, XMVectorCatmullRom(XMLoadFloat3(&before.Position), XMLoadFloat3(&from.Position),
+		XMLoadFloat3(&to.Position), XMLoadFloat3(&after.Position), segmentTime));
+	XMStoreFloat3(&rotation, XMVectorCatmullRom(XMLoadFloat3(&before.Rotation), XMLoadFloat3(&from.Rotation),
+		XMLoadFloat3(&to.Rotation), XMLoadFloat3(&after.Rotation), segmentTime));
+}
+#pragma endregion
+
+#pragma region Script Loading
+bool LoadBenchmarkScript(const std::string& path, BenchmarkScript& script)
+{
+	std::ifstream file(path);
+
+	if (!file.is_open())
+	{
+		std::cerr << "Failed to open the benchmark script " << path << std::endl;
+		return false;
+	}
+
+	nlohmann::json scriptData = nlohmann::json::parse(file, nullptr, false);
+
+	if (scriptData.is_discarded())
+	{
+		std::cerr << "Failed to parse the benchmark script " << path << std::endl;
+		return false;
+	}
+
+	script.Name = scriptData.value("name", path);
+	script.Frames = scriptData.value("frames", static_cast<size_t>(1000));
+	script.Timestep = scriptData.value("timestep", 1.0f / 60.0f);
+	script.Views = scriptData.value("views", uint32_t(1));
+
+	if (script.Frames == 0 || script.Timestep <= 0.0f ||
+		!script.Path.LoadFromJSON(scriptData.value("keyframes", nlohmann::json::array())))
+	{
+		std::cerr << "The benchmark script " << path << " needs frames, a timestep and increasing keyframe times"
+			<< std::endl;
+		return false;
+	}
+
+	return true;
+}
+#pragma endregion
+
+#pragma region BenchmarkRecorder
+void BenchmarkRecorder::BeginFrame()
+{
+	m_frameStart = Clock::now();
+	m_updateEnd = m_frameStart;
+}
+
+void BenchmarkRecorder::EndUpdate()
+{
+	m_updateEnd = Clock::now();
+}
+
+void BenchmarkRecorder::EndFrame()
+{
+	Clock::time_point frameEnd = Clock::now();
+
+	typedef std::chrono::duration<double, std::milli> Milliseconds;
+	AddFrame(Milliseconds(m_updateEnd - m_frameStart).count(), Milliseconds(frameEnd - m_updateEnd).count());
+}
+
+void BenchmarkRecorder::AddFrame(double updateMs, double drawMs)
+{
+	m_frames.push_back({ m_frames.size(), updateMs, drawMs, updateMs + drawMs });
+}
+
+BenchmarkSummary BenchmarkRecorder::Summarise(std::vector<double> timings)
+{
+	BenchmarkSummary summary = {};
+
+	if (timings.empty())
+	{
+		return summary;
+	}
+
+	std::sort(timings.begin(), timings.end());
+
+	// Nearest rank, the smallest timing with at least percentile% of the frames at or below it
+	auto percentile = [&timings](double percent)
+	{
+		size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * timings.size()));
+		return timings[rank > 0 ? rank - 1 : 0];
+	};
+
+	double total = 0.0;
+	for (double timing : timings)
+	{
+		total += timing;
+	}
+
+	summary.Min = timings.front();
+	summary.Average = total / timings.size();
+	summary.P50 = percentile(50.0);
+	summary.P95 = percentile(95.0);
+	summary.P99 = percentile(99.0);
+	summary.Max = timings.back();
+
+	return summary;
+}
+
+BenchmarkSummary BenchmarkRecorder::GetUpdateSummary() const
+{
+	std::vector<double> timings;
+	timings.reserve(m_frames.size());
+
+	for (const BenchmarkFrame& frame : m_frames)
+	{
+		timings.push_back(frame.UpdateMs);
+	}
+
+	return Summarise(timings);
+}
+
+BenchmarkSummary BenchmarkRecorder::GetDrawSummary() const
+{
+	std::vector<double> timings;
+	timings.reserve(m_frames.size());
+
+	for (const BenchmarkFrame& frame : m_frames)
+	{
+		timings.push_back(frame.DrawMs);
+	}
+
+	return Summarise(timings);
+}
+
+BenchmarkSummary BenchmarkRecorder::GetFrameSummary() const
+{
+	std::vector<double> timings;
+	timings.reserve(m_frames.size());
+
+	for (const BenchmarkFrame& frame : m_frames)
+	{
+		timings.push_back(frame.FrameMs);
+	}
+
+	return Summarise(timings);
+}
+
+bool BenchmarkRecorder::WriteCSV(const std::string& path) const
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+	{
+		std::cerr << "Failed to open " << path << " for the benchmark timings." << std::endl;
+		return false;
+	}
+
+	file << "frame,update_ms,draw_ms,frame_ms\n" << std::fixed << std::setprecision(4);
+
+	for (const BenchmarkFrame& frame : m_frames)
+	{
+		file << frame.Frame << ',' << frame.UpdateMs << ',' << frame.DrawMs << ',' << frame.FrameMs << '\n';
+	}
+
+	return true;
+}
+
+bool BenchmarkRecorder::WriteJSON(const std::string& path, const BenchmarkScript& script) const
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+	{
+		std::cerr << "Failed to open " << path << " for the benchmark summary." << std::endl;
+		return false;
+	}
+
+	auto summaryToJSON = [](const BenchmarkSummary& summary)
+	{
+		return nlohmann::json{
+			{ "min", summary.Min }, { "average", summary.Average }, { "p50", summary.P50 }, { "p95", summary.P95 },
+			{ "p99", summary.P99 }, { "max", summary.Max }
+		};
+	};
+
+	nlohmann::json report;
+	report["name"] = script.Name;
+	report["frames"] = m_frames.size();
+	report["timestep"] = script.Timestep;
+	report["views"] = script.Views;
+	report["updateMs"] = summaryToJSON(GetUpdateSummary());
+	report["drawMs"] = summaryToJSON(GetDrawSummary());
+	report["frameMs"] = summaryToJSON(GetFrameSummary());
+
+	file << report.dump(4) << std::endl;
+
+	return true;
+}
+#pragma endregion
\ No newline at end of file
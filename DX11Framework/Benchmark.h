@@ -0,0 +1,143 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, DirectXMath and nlohmann.json, so the path and timing code builds without D3D or Windows
+#include <DirectXMath.h>
+#include <nlohmann/json.hpp> // Using nlohmann.json Library (Not Mine!)
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Struct to hold one point of a camera path, the rotation is in radians like the camera's
+struct BenchmarkKeyframe
+{
+	float Time;
+	DirectX::XMFLOAT3 Position;
+	DirectX::XMFLOAT3 Rotation;
+};
+
+// Struct to hold the timings of one benchmark frame in milliseconds
+struct BenchmarkFrame
+{
+	size_t Frame;
+	double UpdateMs;
+	double DrawMs;
+	double FrameMs;
+};
+
+// Struct to hold the summary of one timing column in milliseconds
+struct BenchmarkSummary
+{
+	double Min;
+	double Average;
+	double P50;
+	double P95;
+	double P99;
+	double Max;
+};
+
+// Camera path through keyframes, a Catmull-Rom spline through the positions and rotations
+class CameraPath
+{
+public:
+#pragma region Loading Methods
+	// Loads the keyframes from a JSON array of { "time", "position": {x, y, z}, "rotation": {x, y, z} }
+	// Returns bool - False if there are no keyframes or the times do not increase
+	bool LoadFromJSON(const nlohmann::json& keyframes);
+#pragma endregion
+
+#pragma region Evaluation Methods
+	// Gets the camera position and rotation at a time, held at the first and last keyframes outside the path
+	void Evaluate(float time, DirectX::XMFLOAT3& position, DirectX::XMFLOAT3& rotation) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the time of the last keyframe
+	// Returns float - The path length in seconds
+	float GetDuration() const { return m_keyframes.empty() ? 0.0f : m_keyframes.back().Time; }
+
+	// Gets the keyframes
+	// Returns std::vector<BenchmarkKeyframe> - The keyframes, ordered by time
+	const std::vector<BenchmarkKeyframe>& GetKeyframes() const { return m_keyframes; }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	std::vector<BenchmarkKeyframe> m_keyframes;
+#pragma endregion
+};
+
+// Struct to hold a benchmark script
+struct BenchmarkScript
+{
+	std::string Name;
+	size_t Frames;
+	float Timestep;
+	uint32_t Views;
+	CameraPath Path;
+};
+
+// Loads a benchmark script: { "name", "frames", "timestep", "views", "keyframes": [...] }
+// Returns bool - False if the file could not be read or is missing the keyframes
+bool LoadBenchmarkScript(const std::string& path, BenchmarkScript& script);
+
+// Records the CPU time of every benchmark frame and writes them out with their percentiles
+class BenchmarkRecorder
+{
+public:
+#pragma region Recording Methods
+	// Starts timing a frame
+	void BeginFrame();
+
+	// Marks the end of the update, the rest of the frame counts as draw
+	void EndUpdate();
+
+	// Stops timing the frame and stores it
+	void EndFrame();
+
+	// Stores a frame timed somewhere else
+	void AddFrame(double updateMs, double drawMs);
+#pragma endregion
+
+#pragma region Report Methods
+	// Works out the summary of a set of timings, percentiles use the nearest rank
+	// Returns BenchmarkSummary - The summary, all zero if there are no timings
+	static BenchmarkSummary Summarise(std::vector<double> timings);
+
+	// Gets the summary of the update timings
+	// Returns BenchmarkSummary - The update summary
+	BenchmarkSummary GetUpdateSummary() const;
+
+	// Gets the summary of the draw timings
+	// Returns BenchmarkSummary - The draw summary
+	BenchmarkSummary GetDrawSummary() const;
+
+	// Gets the summary of the whole frame timings
+	// Returns BenchmarkSummary - The frame summary
+	BenchmarkSummary GetFrameSummary() const;
+
+	// Writes one row per frame
+	// Returns bool - False if the file could not be opened
+	bool WriteCSV(const std::string& path) const;
+
+	// Writes the summaries, with the script name, frame count and timestep
+	// Returns bool - False if the file could not be opened
+	bool WriteJSON(const std::string& path, const BenchmarkScript& script) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the recorded frames
+	// Returns std::vector<BenchmarkFrame> - The frames in the order they ran
+	const std::vector<BenchmarkFrame>& GetFrames() const { return m_frames; }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	typedef std::chrono::steady_clock Clock;
+
+	std::vector<BenchmarkFrame> m_frames;
+	Clock::time_point m_frameStart;
+	Clock::time_point m_updateEnd;
+#pragma endregion
+};
@@ -1,11 +1,17 @@
 // Include{s}
 #include "Camera.h"
+#include "FrustumCuller.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+
+using namespace DirectX;
 
 #pragma region Constructor
 Camera::Camera()
 {
-	// Multithreading this function is just too cool not to do.
-	std::thread loadStartingVectorsThread(&Camera::LoadStartingVectors, this);
+	// The file is only parsed once, so there is nothing left worth a thread
+	LoadStartingVectors();
 
 	// Set the base camera position and rotation
 	m_position = XMFLOAT3(0.0f, 0.0f, 0.0f);
@@ -14,11 +20,8 @@ Camera::Camera()
 	m_PositionVector = XMLoadFloat3(&m_position);
 	m_RotationVector = XMLoadFloat3(&m_rotation);
 
-	// Wait for the thread to finish
-	loadStartingVectorsThread.join();
-
-	// Apply the starting vectors to the camera
-	UpdateViewMatrix();
+	// Nothing has been projected yet
+	m_projectionMatrix = XMMatrixIdentity();
 }
 
 void Camera::SetProjectionValues(float fov, float aspectRatio, float nearZ, float farZ)
@@ -28,12 +31,37 @@ void Camera::SetProjectionValues(float fov, float aspectRatio, float nearZ, floa
 
 	// Set the projection matrix
 	m_projectionMatrix = XMMatrixPerspectiveFovLH(fovRadians, aspectRatio, nearZ, farZ);
+	m_derivedDirty = true;
 }
 #pragma endregion
 
 #pragma region Private Methods
-void Camera::UpdateViewMatrix()
+void Camera::UpdateDirections() const
 {
+	if (!m_directionsDirty)
+	{
+		return;
+	}
+
+	// Movement stays level, so only the yaw turns the vectors
+	XMMATRIX vecRotationMatrix = XMMatrixRotationRollPitchYaw(0.0f, m_rotation.y, 0.0f);
+
+	// Transform the vectors with the rotation matrix
+	m_forwardVector = XMVector3TransformCoord(m_startforwardVector, vecRotationMatrix);
+	m_backVector = XMVector3TransformCoord(m_startbackVector, vecRotationMatrix);
+	m_leftVector = XMVector3TransformCoord(m_startleftVector, vecRotationMatrix);
+	m_rightVector = XMVector3TransformCoord(m_startrightVector, vecRotationMatrix);
+
+	m_directionsDirty = false;
+}
+
+void Camera::UpdateViewMatrix() const
+{
+	if (!m_viewDirty)
+	{
+		return;
+	}
+
 	// Calculate the rotation matrix
 	XMMATRIX camRotationMatrix = XMMatrixRotationRollPitchYaw(m_rotation.x, m_rotation.y,
 		m_rotation.z);
@@ -49,66 +77,86 @@ void Camera::UpdateViewMatrix()
 
 	// Create the view matrix
 	m_viewMatrix = XMMatrixLookAtLH(m_PositionVector, camTarget, upDirection);
-	XMMATRIX vecRotationMatrix = XMMatrixRotationRollPitchYaw(0.0f, m_rotation.y, 0.0f);
 
-	// Transform the vectors with the rotation matrix
-	m_forwardVector = XMVector3TransformCoord(m_startforwardVector, vecRotationMatrix);
-	m_backVector = XMVector3TransformCoord(m_startbackVector, vecRotationMatrix);
-	m_leftVector = XMVector3TransformCoord(m_startleftVector, vecRotationMatrix);
-	m_rightVector = XMVector3TransformCoord(m_startrightVector, vecRotationMatrix);
+	m_viewDirty = false;
+	m_derivedDirty = true;
 }
 
-void Camera::LoadStartingVectors()
+void Camera::UpdateDerivedMatrices() const
 {
-	// Load the starting camera vectors from a JSON file
-	std::ifstream file("JSON Files\\Starting Camera Vectors.json");
+	UpdateViewMatrix();
 
-	// Check if the file is open
-	if (!file.is_open())
+	if (!m_derivedDirty)
 	{
-		std::cerr << "Failed to open JSON file." << std::endl;
+		return;
 	}
 
-	file >> m_cameraStartingVectors;
-
-	// Set the starting vectors using the JSON file values
-	m_startforwardVector = XMVectorSet(
-		m_cameraStartingVectors["StartingCameraVectors"]["ForwardVector"]["x"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["ForwardVector"]["y"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["ForwardVector"]["z"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["ForwardVector"]["w"].get<float>()
-	);
-
-	m_startupVector = XMVectorSet(
-		m_cameraStartingVectors["StartingCameraVectors"]["UpVector"]["x"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["UpVector"]["y"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["UpVector"]["z"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["UpVector"]["w"].get<float>()
-	);
-
-	m_startrightVector = XMVectorSet(
-		m_cameraStartingVectors["StartingCameraVectors"]["RightVector"]["x"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["RightVector"]["y"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["RightVector"]["z"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["RightVector"]["w"].get<float>()
-	);
-
-	m_startleftVector = XMVectorSet(
-		m_cameraStartingVectors["StartingCameraVectors"]["LeftVector"]["x"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["LeftVector"]["y"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["LeftVector"]["z"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["LeftVector"]["w"].get<float>()
-	);
-
-	m_startbackVector = XMVectorSet(
-		m_cameraStartingVectors["StartingCameraVectors"]["BackVector"]["x"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["BackVector"]["y"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["BackVector"]["z"].get<float>(),
-		m_cameraStartingVectors["StartingCameraVectors"]["BackVector"]["w"].get<float>()
-	);
-
-	// Close the file
-	file.close();
+	m_viewProjectionMatrix = XMMatrixMultiply(m_viewMatrix, m_projectionMatrix);
+	m_inverseViewProjectionMatrix = XMMatrixInverse(nullptr, m_viewProjectionMatrix);
+
+	// The shaders read the constant buffer column-major, so transpose once here rather than per draw
+	m_shaderMatrices.View = XMMatrixTranspose(m_viewMatrix);
+	m_shaderMatrices.Projection = XMMatrixTranspose(m_projectionMatrix);
+	m_shaderMatrices.ViewProjection = XMMatrixTranspose(m_viewProjectionMatrix);
+
+	FrustumCuller::ComputePlanes(m_viewProjectionMatrix, m_frustumPlanes);
+
+	m_derivedDirty = false;
+}
+
+void Camera::LoadStartingVectors()
+{
+	const CameraStartingVectors& startingVectors = GetStartingVectors();
+
+	// Set the starting vectors using the shared values
+	m_startforwardVector = XMLoadFloat4(&startingVectors.Forward);
+	m_startupVector = XMLoadFloat4(&startingVectors.Up);
+	m_startrightVector = XMLoadFloat4(&startingVectors.Right);
+	m_startleftVector = XMLoadFloat4(&startingVectors.Left);
+	m_startbackVector = XMLoadFloat4(&startingVectors.Back);
+}
+
+const CameraStartingVectors& Camera::GetStartingVectors()
+{
+	// Initialised once, the first time any camera is made, and safe if cameras are made on several threads
+	static const CameraStartingVectors startingVectors = []
+	{
+		// Left handed defaults in case the file is missing
+		CameraStartingVectors vectors = {
+			XMFLOAT4(0.0f, 0.0f, 1.0f, 0.0f), XMFLOAT4(0.0f, 1.0f, 0.0f, 0.0f), XMFLOAT4(1.0f, 0.0f, 0.0f, 0.0f),
+			XMFLOAT4(-1.0f, 0.0f, 0.0f, 0.0f), XMFLOAT4(0.0f, 0.0f, -1.0f, 0.0f)
+		};
+
+		// Load the starting camera vectors from a JSON file
+		std::ifstream file("JSON Files\\Starting Camera Vectors.json");
+
+		// Check if the file is open
+		if (!file.is_open())
+		{
+			std::cerr << "Failed to open JSON file." << std::endl;
+			return vectors;
+		}
+
+		nlohmann::json cameraStartingVectors;
+		file >> cameraStartingVectors;
+
+		const nlohmann::json& json = cameraStartingVectors["StartingCameraVectors"];
+		auto readVector = [&json](const char* name, XMFLOAT4& vector)
+		{
+			vector = XMFLOAT4(json[name]["x"].get<float>(), json[name]["y"].get<float>(),
+				json[name]["z"].get<float>(), json[name]["w"].get<float>());
+		};
+
+		readVector("ForwardVector", vectors.Forward);
+		readVector("UpVector", vectors.Up);
+		readVector("RightVector", vectors.Right);
+		readVector("LeftVector", vectors.Left);
+		readVector("BackVector", vectors.Back);
+
+		return vectors;
+	}();
+
+	return startingVectors;
 }
 #pragma endregion
 
@@ -119,8 +167,8 @@ void Camera::SetPosition(float x, float y, float z)
 	m_position = XMFLOAT3(x, y, z);
 	m_PositionVector = XMLoadFloat3(&m_position);
 
-	// Update the view matrix
-	UpdateViewMatrix();
+	// The view matrix is rebuilt when next asked for
+	m_viewDirty = true;
 }
 
 void Camera::AddToPosition(XMVECTOR position)
@@ -129,8 +177,8 @@ void Camera::AddToPosition(XMVECTOR position)
 	m_PositionVector += position;
 	XMStoreFloat3(&m_position, m_PositionVector);
 
-	// Update the view matrix
-	UpdateViewMatrix();
+	// The view matrix is rebuilt when next asked for
+	m_viewDirty = true;
 }
 
 void Camera::AddToPosition(float x, float y, float z)
@@ -143,8 +191,8 @@ void Camera::AddToPosition(float x, float y, float z)
 	// Update the position vector
 	m_PositionVector = XMLoadFloat3(&m_position);
 
-	// Update the view matrix
-	UpdateViewMatrix();
+	// The view matrix is rebuilt when next asked for
+	m_viewDirty = true;
 }
 
 void Camera::SetRotation(float x, float y, float z)
@@ -155,8 +203,9 @@ void Camera::SetRotation(float x, float y, float z)
 	// Update the rotation vector
 	m_RotationVector = XMLoadFloat3(&m_rotation);
 
-	// Update the view matrix
-	UpdateViewMatrix();
+	// The view matrix is rebuilt when next asked for
+	m_viewDirty = true;
+	m_directionsDirty = true;
 }
 
 void Camera::AddToRotation(float x, float y, float z)
@@ -169,8 +218,9 @@ void Camera::AddToRotation(float x, float y, float z)
 	// Update the rotation vector
 	m_RotationVector = XMLoadFloat3(&m_rotation);
 
-	// Update the view matrix
-	UpdateViewMatrix();
+	// The view matrix is rebuilt when next asked for
+	m_viewDirty = true;
+	m_directionsDirty = true;
 }
 #pragma endregion
 
@@ -179,6 +229,7 @@ void Camera::AddToRotation(float x, float y, float z)
 
 XMMATRIX Camera::GetViewMatrix() const
 {
+	UpdateViewMatrix();
 	return m_viewMatrix;
 }
 
@@ -187,6 +238,30 @@ XMMATRIX Camera::GetProjectionMatrix() const
 	return m_projectionMatrix;
 }
 
+XMMATRIX Camera::GetViewProjectionMatrix() const
+{
+	UpdateDerivedMatrices();
+	return m_viewProjectionMatrix;
+}
+
+XMMATRIX Camera::GetInverseViewProjectionMatrix() const
+{
+	UpdateDerivedMatrices();
+	return m_inverseViewProjectionMatrix;
+}
+
+const CameraShaderMatrices& Camera::GetShaderMatrices() const
+{
+	UpdateDerivedMatrices();
+	return m_shaderMatrices;
+}
+
+const XMFLOAT4* Camera::GetFrustumPlanes() const
+{
+	UpdateDerivedMatrices();
+	return m_frustumPlanes;
+}
+
 XMFLOAT3 Camera::GetPosition() const
 {
 	return m_position;
@@ -199,21 +274,25 @@ XMFLOAT3 Camera::GetRotation() const
 
 XMVECTOR Camera::GetForwardVector() const
 {
+	UpdateDirections();
 	return m_forwardVector;
 }
 
 XMVECTOR Camera::GetLeftVector() const
 {
+	UpdateDirections();
 	return m_leftVector;
 }
 
 XMVECTOR Camera::GetRightVector() const
 {
+	UpdateDirections();
 	return m_rightVector;
 }
 
 XMVECTOR Camera::GetBackVector() const
 {
+	UpdateDirections();
 	return m_backVector;
 }
 #pragma endregion
\ No newline at end of file
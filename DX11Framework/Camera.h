@@ -1,7 +1,26 @@
 #pragma once
 
 // Include{s}
-#include "Structures.h"
+// Only the standard library and DirectXMath, so cameras build and are tested without D3D or Windows
+#include <DirectXMath.h>
+
+// Struct to hold the camera axes before any rotation, read from Starting Camera Vectors.json
+struct CameraStartingVectors
+{
+	DirectX::XMFLOAT4 Forward;
+	DirectX::XMFLOAT4 Up;
+	DirectX::XMFLOAT4 Right;
+	DirectX::XMFLOAT4 Left;
+	DirectX::XMFLOAT4 Back;
+};
+
+// Struct to hold the camera matrices already transposed for the shaders' column-major constant buffers
+struct CameraShaderMatrices
+{
+	DirectX::XMMATRIX View;
+	DirectX::XMMATRIX Projection;
+	DirectX::XMMATRIX ViewProjection;
+};
 
 class Camera
 {
@@ -16,35 +35,51 @@ public:
 #pragma region Getters
 	// Get the view matrix
 	// Returns XMMATRIX - The camera view matrix
-	XMMATRIX GetViewMatrix() const;
+	DirectX::XMMATRIX GetViewMatrix() const;
 
 	// Get the projection matrix
 	// Returns XMMATRIX - The camera projection matrix
-	XMMATRIX GetProjectionMatrix() const;
+	DirectX::XMMATRIX GetProjectionMatrix() const;
+
+	// Get the view matrix multiplied by the projection matrix
+	// Returns XMMATRIX - The camera view-projection matrix
+	DirectX::XMMATRIX GetViewProjectionMatrix() const;
+
+	// Get the inverse of the view-projection matrix, takes clip space back to world space
+	// Returns XMMATRIX - The camera inverse view-projection matrix
+	DirectX::XMMATRIX GetInverseViewProjectionMatrix() const;
+
+	// Get the view, projection and view-projection matrices transposed for the shaders
+	// Returns CameraShaderMatrices - The transposed matrices
+	const CameraShaderMatrices& GetShaderMatrices() const;
+
+	// Get the frustum planes, in left, right, bottom, top, near, far order
+	// Returns XMFLOAT4* - The six planes as (normal, distance)
+	const DirectX::XMFLOAT4* GetFrustumPlanes() const;
 
 	// Get the position
 	// Returns XMFLOAT3 - The camera position as a float3
-	XMFLOAT3 GetPosition() const;
+	DirectX::XMFLOAT3 GetPosition() const;
 
 	// Get the rotation
 	// Returns XMFLOAT3 - The camera rotation as a float3
-	XMFLOAT3 GetRotation() const;
+	DirectX::XMFLOAT3 GetRotation() const;
 
 	// Get the forward vector
 	// Returns XMVECTOR - The forward camera vector
-	XMVECTOR GetForwardVector() const;
+	DirectX::XMVECTOR GetForwardVector() const;
 
 	// Get the left vector
 	// Returns XMVECTOR - The left camera vector
-	XMVECTOR GetLeftVector() const;
+	DirectX::XMVECTOR GetLeftVector() const;
 
 	// Get the right vector
 	// Returns XMVECTOR - The right camera vector
-	XMVECTOR GetRightVector() const;
+	DirectX::XMVECTOR GetRightVector() const;
 
 	// Get the back vector
 	// Returns XMVECTOR - The back camera vector
-	XMVECTOR GetBackVector() const;
+	DirectX::XMVECTOR GetBackVector() const;
 #pragma endregion
 
 #pragma region Setters
@@ -55,7 +90,7 @@ public:
 	void SetRotation(float x, float y, float z);
 
 	// Add to the camera position using an XMVECTOR
-	void AddToPosition(XMVECTOR position);
+	void AddToPosition(DirectX::XMVECTOR position);
 
 	// Add to the camera position using x, y, z values
 	void AddToPosition(float x, float y, float z);
@@ -66,34 +101,52 @@ public:
 
 private:
 #pragma region Private Methods
-	// Update the view camera matrix
-	void UpdateViewMatrix();
+	// Rebuilds the movement vectors if the rotation has changed since they were last asked for
+	void UpdateDirections() const;
 
-	// Load the starting camera vectors from a JSON file
-	void LoadStartingVectors();
-#pragma endregion
-
-#pragma region Member Variables
-	XMVECTOR m_PositionVector;
-	XMVECTOR m_RotationVector;
+	// Rebuilds the view camera matrix if the position or rotation has changed since it was last asked for
+	void UpdateViewMatrix() const;
 
-	XMFLOAT3 m_position;
-	XMFLOAT3 m_rotation;
+	// Rebuilds everything made from the view and projection matrices if either has changed
+	void UpdateDerivedMatrices() const;
 
-	XMMATRIX m_viewMatrix;
-	XMMATRIX m_projectionMatrix;
-
-	nlohmann::json m_cameraStartingVectors;
+	// Applies the shared starting camera vectors to this camera
+	void LoadStartingVectors();
 
-	XMVECTOR m_startforwardVector;
-	XMVECTOR m_startupVector;
-	XMVECTOR m_startrightVector;
-	XMVECTOR m_startleftVector;
-	XMVECTOR m_startbackVector;
+	// Gets the starting camera vectors, the file is parsed by the first camera to ask and shared by every other
+	// Returns CameraStartingVectors - The starting vectors
+	static const CameraStartingVectors& GetStartingVectors();
+#pragma endregion
 
-	XMVECTOR m_forwardVector;
-	XMVECTOR m_leftVector;
-	XMVECTOR m_rightVector;
-	XMVECTOR m_backVector;
+#pragma region Member Variables
+	DirectX::XMVECTOR m_PositionVector;
+	DirectX::XMVECTOR m_RotationVector;
+
+	DirectX::XMFLOAT3 m_position;
+	DirectX::XMFLOAT3 m_rotation;
+
+	// Setters only mark what they invalidate, the matrices are rebuilt on the next get, so a frame of
+	// movement costs one rebuild however many setters it called
+	mutable bool m_directionsDirty = true;
+	mutable bool m_viewDirty = true;
+	mutable bool m_derivedDirty = true;
+
+	mutable DirectX::XMMATRIX m_viewMatrix;
+	DirectX::XMMATRIX m_projectionMatrix;
+	mutable DirectX::XMMATRIX m_viewProjectionMatrix;
+	mutable DirectX::XMMATRIX m_inverseViewProjectionMatrix;
+	mutable CameraShaderMatrices m_shaderMatrices;
+	mutable DirectX::XMFLOAT4 m_frustumPlanes[6];
+
+	DirectX::XMVECTOR m_startforwardVector;
+	DirectX::XMVECTOR m_startupVector;
+	DirectX::XMVECTOR m_startrightVector;
+	DirectX::XMVECTOR m_startleftVector;
+	DirectX::XMVECTOR m_startbackVector;
+
+	mutable DirectX::XMVECTOR m_forwardVector;
+	mutable DirectX::XMVECTOR m_leftVector;
+	mutable DirectX::XMVECTOR m_rightVector;
+	mutable DirectX::XMVECTOR m_backVector;
 #pragma endregion
 };
@@ -0,0 +1,162 @@
+// Include{s}
+#include "CameraSystem.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+using namespace DirectX;
+
+#pragma region Constructor
+CameraSystem::CameraSystem()
+{
+	m_cameras.resize(1);
+	m_labels.push_back("Debug Camera");
+	m_hotkeys.push_back(0);
+}
+#pragma endregion
+
+#pragma region Loading Methods
+bool CameraSystem::LoadFromJSON(const std::string& path, float aspectRatio)
+{
+	std::ifstream file(path);
+
+	// Check if the file is open
+	if (!file.is_open())
+	{
+		std::cerr << "Failed to open JSON file." << std::endl;
+		return false;
+	}
+
+	nlohmann::json sceneCameraVariables;
+	file >> sceneCameraVariables;
+
+	// Struct to hold a camera entry while the entries are put in order
+	struct CameraEntry
+	{
+		const nlohmann::json* Json;
+		std::string Label;
+		int Hotkey;
+	};
+
+	std::vector<CameraEntry> entries;
+	const nlohmann::json* debugCamera = nullptr;
+
+	for (auto& camera : sceneCameraVariables["SceneCameraVariables"].items())
+	{
+		if (camera.key() == "DebugCamera")
+		{
+			debugCamera = &camera.value();
+			continue;
+		}
+
+		entries.push_back({ &camera.value(), camera.value().value("Label", camera.key()),
+			camera.value().value("Hotkey", -1) });
+	}
+
+	// The objects come back sorted by name, so order the cameras by their hotkeys, cameras without one go last
+	std::stable_sort(entries.begin(), entries.end(), [](const CameraEntry& a, const CameraEntry& b)
+	{
+		uint32_t aOrder = static_cast<uint32_t>(a.Hotkey);
+		uint32_t bOrder = static_cast<uint32_t>(b.Hotkey);
+		return aOrder < bOrder;
+	});
+
+	m_cameras.clear();
+	m_labels.clear();
+	m_hotkeys.clear();
+	m_cameras.reserve(entries.size() + 1);
+
+	auto addCamera = [&](const nlohmann::json* json, const std::string& label, int hotkey)
+	{
+		m_cameras.emplace_back();
+		m_labels.push_back(label);
+		m_hotkeys.push_back(hotkey);
+
+		if (!json)
+		{
+			return;
+		}
+
+		Camera& camera = m_cameras.back();
+		const nlohmann::json& position = (*json)["Position"];
+		const nlohmann::json& rotation = (*json)["Rotation"];
+		const nlohmann::json& projection = (*json)["ProjectionValues"];
+
+		camera.SetPosition(position["x"].get<float>(), position["y"].get<float>(), position["z"].get<float>());
+		camera.SetRotation(rotation["x"].get<float>(), rotation["y"].get<float>(), rotation["z"].get<float>());
+		camera.SetProjectionValues(projection["fov"].get<float>(), aspectRatio, projection["near"].get<float>(),
+			projection["far"].get<float>());
+	};
+
+	addCamera(debugCamera, debugCamera ? debugCamera->value("Label", "Debug Camera") : "Debug Camera", 0);
+
+	for (const CameraEntry& entry : entries)
+	{
+		addCamera(entry.Json, entry.Label, entry.Hotkey);
+	}
+
+	m_activeIndex = 0;
+
+	return true;
+}
+#pragma endregion
+
+#pragma region Camera Methods
+void CameraSystem::SetActive(uint32_t index)
+{
+	if (index >= m_cameras.size() || index == m_activeIndex)
+	{
+		return;
+	}
+
+	m_activeIndex = index;
+
+	if (index == 0)
+	{
+		return;
+	}
+
+	// Fixed cameras never move, so one copy keeps the debug camera on them for as long as they stay active
+	XMFLOAT3 position = m_cameras[index].GetPosition();
+	XMFLOAT3 rotation = m_cameras[index].GetRotation();
+
+	m_cameras[0].SetPosition(position.x, position.y, position.z);
+	m_cameras[0].SetRotation(rotation.x, rotation.y, rotation.z);
+}
+
+void CameraSystem::CycleActive(int step)
+{
+	int count = static_cast<int>(m_cameras.size());
+	int index = (static_cast<int>(m_activeIndex) + step % count + count) % count;
+
+	SetActive(static_cast<uint32_t>(index));
+}
+
+bool CameraSystem::ActivateHotkey(int hotkey)
+{
+	int index = FindByHotkey(hotkey);
+
+	if (index < 0)
+	{
+		return false;
+	}
+
+	SetActive(static_cast<uint32_t>(index));
+
+	return true;
+}
+
+int CameraSystem::FindByHotkey(int hotkey) const
+{
+	for (size_t i = 0; i < m_hotkeys.size(); i++)
+	{
+		if (m_hotkeys[i] == hotkey)
+		{
+			return static_cast<int>(i);
+		}
+	}
+
+	return -1;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+// Include{s}
+#include "Camera.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Every camera in the scene in one contiguous array, read from Scene Camera Variables.json. Slot 0 is always the
+// debug camera, the one the user flies, and the rest follow in hotkey order. Switching only changes an index
+class CameraSystem
+{
+public:
+#pragma region Constructor
+	// Constructor, starts with just the debug camera so there is always something to render from
+	CameraSystem();
+#pragma endregion
+
+#pragma region Loading Methods
+	// Replaces every camera with those in the JSON file, the debug camera is the entry named DebugCamera
+	// Returns bool - True if the file was opened and read
+	bool LoadFromJSON(const std::string& path, float aspectRatio);
+#pragma endregion
+
+#pragma region Camera Methods
+	// Makes a camera the one rendered from. A fixed camera also moves the debug camera onto it, once, so flying off
+	// again starts from where the view was
+	void SetActive(uint32_t index);
+
+	// Steps the active camera forwards or backwards through every camera, wrapping at either end
+	void CycleActive(int step);
+
+	// Makes the camera bound to a number key the active one
+	// Returns bool - True if a camera uses the hotkey
+	bool ActivateHotkey(int hotkey);
+
+	// Finds the camera bound to a number key
+	// Returns int - The camera index, -1 if no camera uses the hotkey
+	int FindByHotkey(int hotkey) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the number of cameras, including the debug camera
+	// Returns uint32_t - The camera count
+	uint32_t GetCameraCount() const { return static_cast<uint32_t>(m_cameras.size()); }
+
+	// Gets a camera
+	// Returns Camera - The camera at the index
+	Camera& GetCamera(uint32_t index) { return m_cameras[index]; }
+	const Camera& GetCamera(uint32_t index) const { return m_cameras[index]; }
+
+	// Gets the debug camera
+	// Returns Camera - The camera in slot 0
+	Camera& GetDebugCamera() { return m_cameras[0]; }
+	const Camera& GetDebugCamera() const { return m_cameras[0]; }
+
+	// Gets the index of the camera being rendered from
+	// Returns uint32_t - The active index, 0 for the debug camera
+	uint32_t GetActiveIndex() const { return m_activeIndex; }
+
+	// Gets the camera being rendered from
+	// Returns Camera - The active camera
+	const Camera& GetActiveCamera() const { return m_cameras[m_activeIndex]; }
+
+	// Checks the debug camera is being rendered from
+	// Returns bool - True if the debug camera is active
+	bool IsDebugCameraActive() const { return m_activeIndex == 0; }
+
+	// Gets the name shown for a camera in the UI
+	// Returns const char* - The camera label
+	const char* GetLabel(uint32_t index) const { return m_labels[index].c_str(); }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	std::vector<Camera> m_cameras;
+	std::vector<std::string> m_labels;
+	std::vector<int> m_hotkeys;
+
+	uint32_t m_activeIndex = 0;
+#pragma endregion
+};
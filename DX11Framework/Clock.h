@@ -0,0 +1,40 @@
+#pragma once
+
+// Include{s}
+// Nothing from Windows, so code written against a Clock builds and is tested anywhere. The real clock is in
+// HighResolutionClock.h
+
+// Monotonic time source. Everything that reads the time takes one of these, so a FakeClock can drive it by hand
+class Clock
+{
+public:
+	// Virtual destructor
+	virtual ~Clock() = default;
+
+	// Gets the time since an arbitrary fixed point, never goes backwards
+	// Returns double - The time in seconds
+	virtual double GetSeconds() const = 0;
+
+	// Blocks the calling thread for at least the given time
+	virtual void SleepFor(double seconds) = 0;
+};
+
+// Clock that only moves when told to, sleeping moves it forward instantly
+class FakeClock : public Clock
+{
+public:
+	// Constructor, starts at the given time
+	explicit FakeClock(double seconds = 0.0) : m_seconds(seconds) {}
+
+	double GetSeconds() const override { return m_seconds; }
+	void SleepFor(double seconds) override { m_seconds += seconds > 0.0 ? seconds : 0.0; }
+
+	// Moves the clock forward
+	void Advance(double seconds) { m_seconds += seconds; }
+
+	// Moves the clock to a reading, replaying a recorded run sets the same readings it took
+	void SetSeconds(double seconds) { m_seconds = seconds; }
+
+private:
+	double m_seconds = 0.0;
+};
\ No newline at end of file
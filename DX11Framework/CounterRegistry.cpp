@@ -0,0 +1,194 @@
+// Include{s}
+#include "CounterRegistry.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <chrono>
+#endif
+
+#pragma region RollingStats
+RollingStats::RollingStats(uint32_t windowSize)
+{
+	m_windowSize = windowSize > 0 ? windowSize : 1;
+	m_samples.resize(m_windowSize, 0.0f);
+	m_sorted.reserve(m_windowSize);
+}
+
+void RollingStats::Add(float value)
+{
+	m_samples[m_written % m_windowSize] = value;
+	m_written++;
+	m_sortedValid = false;
+}
+
+void RollingStats::Clear()
+{
+	m_written = 0;
+	m_sortedValid = false;
+}
+
+float RollingStats::GetSample(uint32_t age) const
+{
+	if (age >= GetCount())
+	{
+		return 0.0f;
+	}
+
+	return m_samples[(m_written - 1 - age) % m_windowSize];
+}
+
+float RollingStats::GetMin() const
+{
+	uint32_t count = GetCount();
+	if (count == 0)
+	{
+		return 0.0f;
+	}
+
+	return *std::min_element(m_samples.begin(), m_samples.begin() + count);
+}
+
+float RollingStats::GetMax() const
+{
+	uint32_t count = GetCount();
+	if (count == 0)
+	{
+		return 0.0f;
+	}
+
+	return *std::max_element(m_samples.begin(), m_samples.begin() + count);
+}
+
+float RollingStats::GetAverage() const
+{
+	uint32_t count = GetCount();
+	if (count == 0)
+	{
+		return 0.0f;
+	}
+
+	double total = 0.0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		total += m_samples[i];
+	}
+
+	return static_cast<float>(total / count);
+}
+
+float RollingStats::GetPercentile(float percentile) const
+{
+	uint32_t count = GetCount();
+	if (count == 0)
+	{
+		return 0.0f;
+	}
+
+	// The HUD asks for several percentiles a frame, so the window is only sorted once per sample
+	if (!m_sortedValid)
+	{
+		m_sorted.assign(m_samples.begin(), m_samples.begin() + count);
+		std::sort(m_sorted.begin(), m_sorted.end());
+		m_sortedValid = true;
+	}
+
+	// Nearest rank, the smallest sample with at least percentile% of the window at or below it
+	percentile = (std::max)(0.0f, (std::min)(100.0f, percentile));
+	uint32_t rank = static_cast<uint32_t>(std::ceil(percentile / 100.0f * count));
+
+	return m_sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void RollingStats::GetHistogram(float minValue, float maxValue, uint32_t* bins, uint32_t binCount) const
+{
+	if (binCount == 0)
+	{
+		return;
+	}
+
+	std::fill(bins, bins + binCount, 0u);
+
+	float binWidth = (maxValue - minValue) / binCount;
+	uint32_t count = GetCount();
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		float bin = binWidth > 0.0f ? (m_samples[i] - minValue) / binWidth : 0.0f;
+		bin = (std::max)(0.0f, (std::min)(static_cast<float>(binCount - 1), bin));
+
+		bins[static_cast<uint32_t>(bin)]++;
+	}
+}
+#pragma endregion
+
+#pragma region Constructor
+// Constructor
+CounterRegistry::CounterRegistry()
+{
+	// Registered in the same order as the BuiltInCounter enum
+	Register("Draw Calls");
+	Register("State Changes Filtered");
+	Register("Constant Buffer Bytes");
+	Register("Triangles Submitted");
+	Register("Memory In Use", CounterKind_Gauge);
+
+#if defined(_WIN32)
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_ticksPerMillisecond = frequency.QuadPart / 1000.0;
+#else
+	m_ticksPerMillisecond = 1000000.0;
+#endif
+}
+#pragma endregion
+
+#pragma region Publishing Methods
+CounterID CounterRegistry::Register(const std::string& name, CounterKind kind)
+{
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_counters.size()); i++)
+	{
+		if (m_counters[i].Name == name)
+		{
+			return i;
+		}
+	}
+
+	Counter counter = { name, kind, 0.0, 0.0, RollingStats() };
+	m_counters.push_back(counter);
+
+	return static_cast<CounterID>(m_counters.size() - 1);
+}
+
+void CounterRegistry::BeginFrame()
+{
+#if defined(_WIN32)
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	int64_t now = counter.QuadPart;
+#else
+	int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+
+	// The first call only starts the clock
+	if (m_frameStart != 0)
+	{
+		m_frameTimes.Add(static_cast<float>((now - m_frameStart) / m_ticksPerMillisecond));
+	}
+	m_frameStart = now;
+
+	for (Counter& counter : m_counters)
+	{
+		counter.LastFrame = counter.Current;
+		counter.History.Add(static_cast<float>(counter.Current));
+
+		if (counter.Kind == CounterKind_PerFrame)
+		{
+			counter.Current = 0.0;
+		}
+	}
+}
+#pragma endregion
\ No newline at end of file
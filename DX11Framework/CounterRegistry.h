@@ -0,0 +1,169 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, so the counters and their statistics build and are tested without D3D or Windows
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Handle of a counter in the CounterRegistry
+typedef uint32_t CounterID;
+
+// Counters every build publishes, anything else can be added at runtime with CounterRegistry::Register
+enum BuiltInCounter : CounterID
+{
+	Counter_DrawCalls,
+	Counter_StateChangesFiltered,
+	Counter_ConstantBufferBytes,
+	Counter_TrianglesSubmitted,
+	Counter_MemoryInUse,
+	Counter_BuiltInCount
+};
+
+// How a counter's value is carried from one frame to the next
+enum CounterKind
+{
+	// Added to during the frame and reset to zero when the frame closes
+	CounterKind_PerFrame,
+
+	// Holds the last value set until it is set again
+	CounterKind_Gauge
+};
+
+// Fixed window of the most recent samples, with the statistics worked out over the whole window. Needs nothing from
+// the renderer, so it can be driven with made up samples
+class RollingStats
+{
+public:
+#pragma region Constructor
+	// Constructor reserves the window
+	explicit RollingStats(uint32_t windowSize = 240);
+#pragma endregion
+
+#pragma region Sample Methods
+	// Adds a sample, replacing the oldest one once the window is full
+	void Add(float value);
+
+	// Removes every sample
+	void Clear();
+#pragma endregion
+
+#pragma region Statistics Methods
+	// Gets a sample by age
+	// Returns float - The sample, 0 is the newest, zero if there are not that many samples
+	float GetSample(uint32_t age) const;
+
+	// Gets the smallest sample in the window
+	// Returns float - The minimum, zero if empty
+	float GetMin() const;
+
+	// Gets the largest sample in the window
+	// Returns float - The maximum, zero if empty
+	float GetMax() const;
+
+	// Gets the mean of the window
+	// Returns float - The average, zero if empty
+	float GetAverage() const;
+
+	// Gets the nearest-rank percentile of the window, the sorted copy is kept until the next sample arrives
+	// Returns float - The sample at the percentile (0 - 100), zero if empty
+	float GetPercentile(float percentile) const;
+
+	// Counts the samples into evenly sized bins between minValue and maxValue, samples outside go in the end bins
+	void GetHistogram(float minValue, float maxValue, uint32_t* bins, uint32_t binCount) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the number of samples in the window
+	// Returns uint32_t - The sample count
+	uint32_t GetCount() const { return m_written < m_windowSize ? m_written : m_windowSize; }
+
+	// Gets the size of the window
+	// Returns uint32_t - The most samples that are kept
+	uint32_t GetWindowSize() const { return m_windowSize; }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	uint32_t m_windowSize = 0;
+	uint32_t m_written = 0;
+	std::vector<float> m_samples;
+
+	// Sorted copy for the percentiles, rebuilt on the first query after a new sample
+	mutable std::vector<float> m_sorted;
+	mutable bool m_sortedValid = false;
+#pragma endregion
+};
+
+// Struct to hold one published counter
+struct Counter
+{
+	std::string Name;
+	CounterKind Kind;
+	double Current;
+	double LastFrame;
+	RollingStats History;
+};
+
+// Named counters any subsystem can publish to, closed once a frame into a rolling history. Main thread only.
+class CounterRegistry
+{
+public:
+#pragma region Singleton
+	// Only allow one instance of the CounterRegistry
+	// Singleton Pattern
+	CounterRegistry(const CounterRegistry&) = delete;
+	CounterRegistry& operator=(const CounterRegistry&) = delete;
+
+	// Get the instance of the CounterRegistry
+	// Returns CounterRegistry* - The instance of the CounterRegistry
+	static CounterRegistry* GetInstance()
+	{
+		static CounterRegistry instance;
+		return &instance;
+	}
+#pragma endregion
+
+#pragma region Publishing Methods
+	// Registers a counter, registering a name twice hands back the first counter
+	// Returns CounterID - The handle to publish to
+	CounterID Register(const std::string& name, CounterKind kind = CounterKind_PerFrame);
+
+	// Adds to a counter's value for this frame
+	void Add(CounterID counter, double value) { m_counters[counter].Current += value; }
+
+	// Overwrites a counter's value for this frame
+	void Set(CounterID counter, double value) { m_counters[counter].Current = value; }
+
+	// Closes the frame, pushing every counter and the frame time into their histories
+	void BeginFrame();
+#pragma endregion
+
+#pragma region Getters
+	// Gets a counter
+	// Returns Counter - The counter, LastFrame holds the value of the last closed frame
+	const Counter& GetCounter(CounterID counter) const { return m_counters[counter]; }
+
+	// Gets the number of registered counters
+	// Returns uint32_t - The counter count
+	uint32_t GetCounterCount() const { return static_cast<uint32_t>(m_counters.size()); }
+
+	// Gets the time between the last BeginFrame calls
+	// Returns RollingStats - The frame times in milliseconds
+	const RollingStats& GetFrameTimes() const { return m_frameTimes; }
+#pragma endregion
+
+private:
+#pragma region Constructor
+	// Constructor registers the built in counters
+	CounterRegistry();
+#pragma endregion
+
+#pragma region Member Variables
+	std::vector<Counter> m_counters;
+
+	RollingStats m_frameTimes;
+	int64_t m_frameStart = 0;
+	double m_ticksPerMillisecond = 1.0;
+#pragma endregion
+};
@@ -0,0 +1,169 @@
+// Include{s}
+#include "D3D11RenderContext.h"
+
+#pragma region D3D11RenderDevice
+HRESULT D3D11RenderDevice::CreateBuffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+	ID3D11Buffer** buffer)
+{
+	return m_device->CreateBuffer(desc, initialData, buffer);
+}
+
+HRESULT D3D11RenderDevice::CreateTexture(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+	ID3D11ShaderResourceView** texture)
+{
+	ID3D11Texture2D* texture2D = nullptr;
+
+	HRESULT hr = m_device->CreateTexture2D(desc, initialData, &texture2D);
+	if (FAILED(hr)) return hr;
+
+	// The view keeps the texture alive
+	hr = m_device->CreateShaderResourceView(texture2D, nullptr, texture);
+	texture2D->Release();
+
+	return hr;
+}
+
+HRESULT D3D11RenderDevice::CreateTextureFromFile(const wchar_t* path, ID3D11ShaderResourceView** texture)
+{
+	return CreateDDSTextureFromFile(m_device, path, nullptr, texture);
+}
+#pragma endregion
+
+#pragma region Input Assembler
+void D3D11RenderContext::IASetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	m_immediateContext->IASetInputLayout(inputLayout);
+}
+
+void D3D11RenderContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	m_immediateContext->IASetPrimitiveTopology(topology);
+}
+
+void D3D11RenderContext::IASetVertexBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* vertexBuffers,
+	const UINT* strides, const UINT* offsets)
+{
+	m_immediateContext->IASetVertexBuffers(startSlot, bufferCount, vertexBuffers, strides, offsets);
+}
+
+void D3D11RenderContext::IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset)
+{
+	m_immediateContext->IASetIndexBuffer(indexBuffer, format, offset);
+}
+#pragma endregion
+
+#pragma region Shader Stages
+void D3D11RenderContext::VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances,
+	UINT classInstanceCount)
+{
+	m_immediateContext->VSSetShader(vertexShader, classInstances, classInstanceCount);
+}
+
+void D3D11RenderContext::PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances,
+	UINT classInstanceCount)
+{
+	m_immediateContext->PSSetShader(pixelShader, classInstances, classInstanceCount);
+}
+
+void D3D11RenderContext::VSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers)
+{
+	m_immediateContext->VSSetConstantBuffers(startSlot, bufferCount, constantBuffers);
+}
+
+void D3D11RenderContext::PSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers)
+{
+	m_immediateContext->PSSetConstantBuffers(startSlot, bufferCount, constantBuffers);
+}
+
+void D3D11RenderContext::VSSetShaderResources(UINT startSlot, UINT viewCount,
+	ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	m_immediateContext->VSSetShaderResources(startSlot, viewCount, shaderResourceViews);
+}
+
+void D3D11RenderContext::PSSetShaderResources(UINT startSlot, UINT viewCount,
+	ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	m_immediateContext->PSSetShaderResources(startSlot, viewCount, shaderResourceViews);
+}
+
+void D3D11RenderContext::VSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers)
+{
+	m_immediateContext->VSSetSamplers(startSlot, samplerCount, samplers);
+}
+
+void D3D11RenderContext::PSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers)
+{
+	m_immediateContext->PSSetSamplers(startSlot, samplerCount, samplers);
+}
+#pragma endregion
+
+#pragma region Rasterizer & Output Merger
+void D3D11RenderContext::RSSetState(ID3D11RasterizerState* rasterizerState)
+{
+	m_immediateContext->RSSetState(rasterizerState);
+}
+
+void D3D11RenderContext::RSSetViewports(UINT viewportCount, const D3D11_VIEWPORT* viewports)
+{
+	m_immediateContext->RSSetViewports(viewportCount, viewports);
+}
+
+void D3D11RenderContext::OMSetRenderTargets(UINT viewCount, ID3D11RenderTargetView* const* renderTargetViews,
+	ID3D11DepthStencilView* depthStencilView)
+{
+	m_immediateContext->OMSetRenderTargets(viewCount, renderTargetViews, depthStencilView);
+}
+
+void D3D11RenderContext::OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	m_immediateContext->OMSetBlendState(blendState, blendFactor, sampleMask);
+}
+
+void D3D11RenderContext::OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef)
+{
+	m_immediateContext->OMSetDepthStencilState(depthStencilState, stencilRef);
+}
+
+void D3D11RenderContext::ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colour[4])
+{
+	m_immediateContext->ClearRenderTargetView(renderTargetView, colour);
+}
+
+void D3D11RenderContext::ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags,
+	FLOAT depth, UINT8 stencil)
+{
+	m_immediateContext->ClearDepthStencilView(depthStencilView, clearFlags, depth, stencil);
+}
+#pragma endregion
+
+#pragma region Resources & Draws
+HRESULT D3D11RenderContext::Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags,
+	D3D11_MAPPED_SUBRESOURCE* mappedResource)
+{
+	return m_immediateContext->Map(resource, subresource, mapType, mapFlags, mappedResource);
+}
+
+void D3D11RenderContext::Unmap(ID3D11Resource* resource, UINT subresource)
+{
+	m_immediateContext->Unmap(resource, subresource);
+}
+
+void D3D11RenderContext::UpdateSubresource(ID3D11Resource* dstResource, UINT dstSubresource, const D3D11_BOX* dstBox,
+	const void* srcData, UINT srcRowPitch, UINT srcDepthPitch)
+{
+	m_immediateContext->UpdateSubresource(dstResource, dstSubresource, dstBox, srcData, srcRowPitch, srcDepthPitch);
+}
+
+void D3D11RenderContext::DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation)
+{
+	m_immediateContext->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+}
+
+void D3D11RenderContext::DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount,
+	UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation)
+{
+	m_immediateContext->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation,
+		baseVertexLocation, startInstanceLocation);
+}
+#pragma endregion
\ No newline at end of file
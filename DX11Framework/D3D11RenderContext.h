@@ -0,0 +1,78 @@
+#pragma once
+
+// Include{s}
+#include "RenderContext.h"
+
+// Creates resources on the D3D11 device
+class D3D11RenderDevice : public RenderDevice
+{
+public:
+	// Constructor, the device is borrowed and not released
+	explicit D3D11RenderDevice(ID3D11Device* device) : m_device(device) {}
+
+	HRESULT CreateBuffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+		ID3D11Buffer** buffer) override;
+	HRESULT CreateTexture(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+		ID3D11ShaderResourceView** texture) override;
+	HRESULT CreateTextureFromFile(const wchar_t* path, ID3D11ShaderResourceView** texture) override;
+
+private:
+	ID3D11Device* m_device = nullptr;
+};
+
+// Forwards every call to the D3D11 immediate context
+class D3D11RenderContext : public RenderContext
+{
+public:
+	// Constructor, the context is borrowed and not released
+	explicit D3D11RenderContext(ID3D11DeviceContext* immediateContext) : m_immediateContext(immediateContext) {}
+
+#pragma region Input Assembler
+	void IASetInputLayout(ID3D11InputLayout* inputLayout) override;
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+	void IASetVertexBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* vertexBuffers, const UINT* strides,
+		const UINT* offsets) override;
+	void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) override;
+#pragma endregion
+
+#pragma region Shader Stages
+	void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances,
+		UINT classInstanceCount) override;
+	void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances,
+		UINT classInstanceCount) override;
+	void VSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers) override;
+	void PSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers) override;
+	void VSSetShaderResources(UINT startSlot, UINT viewCount,
+		ID3D11ShaderResourceView* const* shaderResourceViews) override;
+	void PSSetShaderResources(UINT startSlot, UINT viewCount,
+		ID3D11ShaderResourceView* const* shaderResourceViews) override;
+	void VSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers) override;
+	void PSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers) override;
+#pragma endregion
+
+#pragma region Rasterizer & Output Merger
+	void RSSetState(ID3D11RasterizerState* rasterizerState) override;
+	void RSSetViewports(UINT viewportCount, const D3D11_VIEWPORT* viewports) override;
+	void OMSetRenderTargets(UINT viewCount, ID3D11RenderTargetView* const* renderTargetViews,
+		ID3D11DepthStencilView* depthStencilView) override;
+	void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) override;
+	void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) override;
+	void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colour[4]) override;
+	void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth,
+		UINT8 stencil) override;
+#pragma endregion
+
+#pragma region Resources & Draws
+	HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags,
+		D3D11_MAPPED_SUBRESOURCE* mappedResource) override;
+	void Unmap(ID3D11Resource* resource, UINT subresource) override;
+	void UpdateSubresource(ID3D11Resource* dstResource, UINT dstSubresource, const D3D11_BOX* dstBox,
+		const void* srcData, UINT srcRowPitch, UINT srcDepthPitch) override;
+	void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) override;
+	void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation,
+		INT baseVertexLocation, UINT startInstanceLocation) override;
+#pragma endregion
+
+private:
+	ID3D11DeviceContext* m_immediateContext = nullptr;
+};
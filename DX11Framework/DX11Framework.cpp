@@ -1,15 +1,47 @@
 // Include{s}
 #include "DX11Framework.h"
+#include <algorithm>
+#include <windowsx.h>
 #define RETURNFAIL(x) if(FAILED(x)) return x;
 
 #pragma region Globals
 // Some global variables to share between the framework and the window loop
-int g_mouseX;
-int g_mouseY;
-int g_lastMouseX = 0;
-int g_lastMouseY = 0;
-bool g_mouseWheelUP = false;
-bool g_mouseWheelDOWN = false;
+bool g_windowMinimized = false;
+bool g_windowFocused = true;
+
+// Input events are stamped on the same clock the update reads, so the wait before each is handled can be measured
+const Clock* g_inputClock = nullptr;
+#pragma endregion
+
+#pragma region Input Events
+// Gets when the message being handled was posted, moved onto the input clock. Messages carry a GetTickCount time,
+// so the age is only as fine as the tick, but it counts the time spent waiting in the queue
+// Returns double - The post time in input clock seconds
+static double GetMessageSeconds()
+{
+	if (!g_inputClock)
+	{
+		return 0.0;
+	}
+
+	// Unsigned, so the difference is still right when the tick count wraps
+	DWORD age = GetTickCount() - static_cast<DWORD>(GetMessageTime());
+
+	// Messages sent rather than posted report the last posted message's time, which can be long gone
+	if (age > 1000)
+	{
+		age = 0;
+	}
+
+	return g_inputClock->GetSeconds() - age / 1000.0;
+}
+
+// Stamps an event with the time its message was posted and queues it for the next update
+static void PushInputEvent(InputEventType type, WPARAM key, int x = 0, int y = 0)
+{
+	InputEvent event = { type, static_cast<uint16_t>(key), x, y, GetMessageSeconds() };
+	InputSystem::GetInstance()->PushEvent(event);
+}
 #pragma endregion
 
 #pragma region Window Loop
@@ -30,36 +62,73 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 		break;
 
 	case WM_MOUSEMOVE:
-		// Get mouse position
-		POINT pt;
-		GetCursorPos(&pt);
-		ScreenToClient(hWnd, &pt);
+		// The cursor position, already in client coordinates
+		PushInputEvent(InputEvent_MouseMove, 0, GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam));
+		break;
 
-		// Update mouse position
-		g_mouseX = pt.x;
-		g_mouseY = pt.y;
+	case WM_INPUT:
+	{
+		// Raw mouse motion, straight from the device without pointer acceleration or the cursor hitting the edge
+		RAWINPUT rawInput;
+		UINT size = sizeof(rawInput);
+		if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &rawInput, &size,
+			sizeof(RAWINPUTHEADER)) != static_cast<UINT>(-1) && rawInput.header.dwType == RIM_TYPEMOUSE &&
+			!(rawInput.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE))
+		{
+			PushInputEvent(InputEvent_MouseDelta, 0, rawInput.data.mouse.lLastX, rawInput.data.mouse.lLastY);
+		}
 
-		break;
+		// Raw input still has to go through the default handler so the system can clean up after it
+		return DefWindowProc(hWnd, message, wParam, lParam);
+	}
 
 	case WM_MOUSEWHEEL:
-	{
-		int scrollDirection = GET_WHEEL_DELTA_WPARAM(wParam);
+		PushInputEvent(InputEvent_MouseWheel, 0, GET_WHEEL_DELTA_WPARAM(wParam));
+		break;
 
-		if (scrollDirection > 0)
+	case WM_KEYDOWN:
+		// Bit 30 is set on auto-repeat, the key was already down
+		if (!(lParam & (1 << 30)))
 		{
-			// Handle scroll up
-			g_mouseWheelUP = true;
-			g_mouseWheelDOWN = false;
+			PushInputEvent(InputEvent_KeyDown, wParam);
 		}
-		else
+		return DefWindowProc(hWnd, message, wParam, lParam);
+
+	case WM_KEYUP:
+		PushInputEvent(InputEvent_KeyUp, wParam);
+		return DefWindowProc(hWnd, message, wParam, lParam);
+
+	case WM_SIZE:
+		// Minimized windows stop drawing, the message still goes on so the window is not maximized straight back
+		g_windowMinimized = wParam == SIZE_MINIMIZED;
+		return DefWindowProc(hWnd, message, wParam, lParam);
+
+	case WM_ACTIVATEAPP:
+		// Background windows are paced down to leave the CPU to whatever has focus
+		g_windowFocused = wParam != FALSE;
+
+		// Keys let go in another window never send their key up here
+		if (!g_windowFocused)
 		{
-			// Handle scroll down
-			g_mouseWheelDOWN = true;
-			g_mouseWheelUP = false;
+			PushInputEvent(InputEvent_FocusLost, 0);
+		}
+		return DefWindowProc(hWnd, message, wParam, lParam);
+
+	case WM_SYSKEYDOWN:
+	case WM_SYSKEYUP:
+		// F10 and Alt only arrive as system keys
+		if (!(message == WM_SYSKEYDOWN && (lParam & (1 << 30))))
+		{
+			PushInputEvent(message == WM_SYSKEYDOWN ? InputEvent_KeyDown : InputEvent_KeyUp, wParam);
+		}
+
+		// F10 toggles the performance HUD, keep Windows from also opening the window menu with it
+		if (wParam != VK_F10)
+		{
+			return DefWindowProc(hWnd, message, wParam, lParam);
 		}
 
 		break;
-	}
 
 	default:
 		return DefWindowProc(hWnd, message, wParam, lParam);
@@ -76,6 +145,8 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 #pragma region Initialization Methods
 HRESULT DX11Framework::Initialise(HINSTANCE hInstance, int nCmdShow)
 {
+	PROFILE_FUNCTION();
+
 	HRESULT hr = S_OK;
 
 	// Initialize application using class methods
@@ -104,6 +175,33 @@ HRESULT DX11Framework::Initialise(HINSTANCE hInstance, int nCmdShow)
 	return hr;
 }
 
+HRESULT DX11Framework::InitialiseHeadless()
+{
+	PROFILE_FUNCTION();
+
+	HRESULT hr = S_OK;
+
+	// No window, swap chain, shaders or UI, every resource and call goes to the null backend
+	m_headless = true;
+	m_renderDevice = new NullRenderDevice();
+	m_renderContext = new NullRenderContext();
+
+	hr = InitVertexIndexBuffers();
+	if (FAILED(hr)) return E_FAIL;
+
+	m_renderContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	hr = InitConstantBuffer();
+	if (FAILED(hr)) return E_FAIL;
+
+	m_cbData.LightON = 1;
+
+	hr = InitRunTimeData();
+	if (FAILED(hr)) return E_FAIL;
+
+	return hr;
+}
+
 HRESULT DX11Framework::CreateWindowHandle(HINSTANCE hInstance, int nCmdShow)
 {
 	// Set the window name
@@ -128,11 +226,23 @@ HRESULT DX11Framework::CreateWindowHandle(HINSTANCE hInstance, int nCmdShow)
 		CW_USEDEFAULT,
 		m_windowWidth, m_windowHeight, nullptr, nullptr, hInstance, nullptr);
 
+	// Ask for raw mouse motion, the mouse look reads it instead of the cursor position
+	RAWINPUTDEVICE mouseDevice = {};
+	mouseDevice.usUsagePage = 0x01; // Generic desktop controls
+	mouseDevice.usUsage = 0x02; // Mouse
+	mouseDevice.hwndTarget = m_windowHandle;
+	RegisterRawInputDevices(&mouseDevice, 1, sizeof(mouseDevice));
+
+	// Stamp input on the clock the update reads
+	g_inputClock = &m_clock;
+
 	return S_OK;
 }
 
 HRESULT DX11Framework::CreateD3DDevice()
 {
+	PROFILE_FUNCTION();
+
 	HRESULT hr = S_OK;
 
 	D3D_FEATURE_LEVEL featureLevels[] = {
@@ -159,6 +269,10 @@ HRESULT DX11Framework::CreateD3DDevice()
 	baseDevice->Release();
 	baseDeviceContext->Release();
 
+	// Everything past device creation goes through the backend interfaces
+	m_renderDevice = new D3D11RenderDevice(m_device);
+	m_renderContext = new D3D11RenderContext(m_immediateContext);
+
 	hr = m_device->QueryInterface(__uuidof(IDXGIDevice), reinterpret_cast<void**>(&m_dxgiDevice));
 	if (FAILED(hr)) return hr;
 
@@ -239,6 +353,9 @@ HRESULT DX11Framework::InitInputLayout()
 
 HRESULT DX11Framework::InitSimpleShaders()
 {
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Startup");
+
 	HRESULT hr = S_OK;
 
 	DWORD dwShaderFlags = D3DCOMPILE_ENABLE_STRICTNESS;
@@ -277,11 +394,52 @@ HRESULT DX11Framework::InitSimpleShaders()
 	hr = m_device->CreatePixelShader(psBlob->GetBufferPointer(), psBlob->GetBufferSize(), nullptr, &m_pixelShader);
 	if (FAILED(hr)) return hr;
 
+	// Compile the instanced vertex shader (kept in its own blob, the input layout below needs its signature)
+	ID3DBlob* instancedBlob = nullptr;
+	hr = D3DCompileFromFile(L"SimpleShaders.hlsl", nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "VS_Instanced", "vs_5_0",
+		dwShaderFlags, 0, &instancedBlob, &errorBlob);
+	if (FAILED(hr))
+	{
+		if (errorBlob) MessageBoxA(m_windowHandle, static_cast<char*>(errorBlob->GetBufferPointer()), nullptr, ERROR);
+		if (errorBlob) errorBlob->Release();
+		return hr;
+	}
+
+	// Create the instanced vertex shader
+	hr = m_device->CreateVertexShader(instancedBlob->GetBufferPointer(), instancedBlob->GetBufferSize(), nullptr,
+		&m_vertexShaderInstanced);
+	if (FAILED(hr))
+	{
+		instancedBlob->Release();
+		return hr;
+	}
+
+	// Slot 0 is the regular mesh data, slot 1 steps once per instance with the world matrix rows
+	D3D11_INPUT_ELEMENT_DESC instancedInputElementDesc[] =
+	{
+		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"INSTANCEWORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+		{"INSTANCEWORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+		{"INSTANCEWORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+		{"INSTANCEWORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+	};
+
+	// Create the instanced input layout
+	hr = m_device->CreateInputLayout(instancedInputElementDesc, ARRAYSIZE(instancedInputElementDesc),
+		instancedBlob->GetBufferPointer(), instancedBlob->GetBufferSize(), &m_instancedInputLayout);
+	instancedBlob->Release();
+	if (FAILED(hr)) return hr;
+
 	return hr;
 }
 
 HRESULT DX11Framework::InitSkyBoxShaders()
 {
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Startup");
+
 	HRESULT hr = S_OK;
 
 	DWORD dwShaderFlags = D3DCOMPILE_ENABLE_STRICTNESS;
@@ -324,6 +482,9 @@ HRESULT DX11Framework::InitSkyBoxShaders()
 
 HRESULT DX11Framework::InitHeightMapShader()
 {
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Startup");
+
 	HRESULT hr = S_OK;
 
 	DWORD dwShaderFlags = D3DCOMPILE_ENABLE_STRICTNESS;
@@ -346,11 +507,10 @@ HRESULT DX11Framework::InitHeightMapShader()
 		&m_vertexShaderHeightmap);
 	if (FAILED(hr)) return hr;
 
-	// Reset the input layout for the terrain
+	// Reset the input layout for the terrain, only the nodes in slot 1 as the patch grid comes from the vertex ids
 	D3D11_INPUT_ELEMENT_DESC terrainInputElementDesc[] =
 	{
-		{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+		{"NODE", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1},
 	};
 
 	// Create the input layout
@@ -379,6 +539,8 @@ HRESULT DX11Framework::InitHeightMapShader()
 
 HRESULT DX11Framework::InitShaders()
 {
+	PROFILE_FUNCTION();
+
 	HRESULT hr = S_OK;
 
 	// Create the shaders on separate threads
@@ -396,6 +558,9 @@ HRESULT DX11Framework::InitShaders()
 
 HRESULT DX11Framework::InitHardCodedObjects()
 {
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Startup");
+
 	HRESULT hr = S_OK;
 
 	// Set the vertex buffer for the cube
@@ -433,7 +598,7 @@ HRESULT DX11Framework::InitHardCodedObjects()
 	D3D11_SUBRESOURCE_DATA pyramidVertexData = { PyramidVertexData };
 
 	// Create the vertex buffer for the pyramid
-	hr = m_device->CreateBuffer(&pyramidVertexBufferDesc, &pyramidVertexData, &m_pyramidVertexBuffer);
+	hr = m_renderDevice->CreateBuffer(&pyramidVertexBufferDesc, &pyramidVertexData, &m_pyramidVertexBuffer);
 	if (FAILED(hr)) return hr;
 
 	D3D11_BUFFER_DESC vertexBufferDesc1 = {};
@@ -444,7 +609,7 @@ HRESULT DX11Framework::InitHardCodedObjects()
 	D3D11_SUBRESOURCE_DATA vertexData1 = { CubeVertexData };
 
 	// Create the vertex buffer for the cube
-	hr = m_device->CreateBuffer(&vertexBufferDesc1, &vertexData1, &m_vertexBuffer);
+	hr = m_renderDevice->CreateBuffer(&vertexBufferDesc1, &vertexData1, &m_vertexBuffer);
 	if (FAILED(hr)) return hr;
 
 	// Set the index buffer for the cube
@@ -478,7 +643,7 @@ HRESULT DX11Framework::InitHardCodedObjects()
 	D3D11_SUBRESOURCE_DATA indexData = { IndexData };
 
 	// Create the index buffer for the cube
-	hr = m_device->CreateBuffer(&indexBufferDesc, &indexData, &m_indexBuffer);
+	hr = m_renderDevice->CreateBuffer(&indexBufferDesc, &indexData, &m_indexBuffer);
 	if (FAILED(hr)) return hr;
 
 	WORD PyramidIndexData[] =
@@ -500,35 +665,53 @@ HRESULT DX11Framework::InitHardCodedObjects()
 	D3D11_SUBRESOURCE_DATA pyramidindexData = { PyramidIndexData };
 
 	// Create the index buffer for the pyramid
-	hr = m_device->CreateBuffer(&PyramidindexBufferDesc, &pyramidindexData, &m_pyramidIndexBuffer);
+	hr = m_renderDevice->CreateBuffer(&PyramidindexBufferDesc, &pyramidindexData, &m_pyramidIndexBuffer);
 	if (FAILED(hr)) return hr;
 
+	// Describe the hard coded meshes the same way as the loaded ones, so they can be batched together
+	// Both shapes fit inside the unit cube
+	m_cubeMeshData = {
+		m_vertexBuffer, m_indexBuffer, sizeof(SimpleVertex), 0, ARRAYSIZE(IndexData), XMFLOAT3(0, 0, 0),
+		XMFLOAT3(1, 1, 1)
+	};
+	m_pyramidMeshData = {
+		m_pyramidVertexBuffer, m_pyramidIndexBuffer, sizeof(SimpleVertex), 0, ARRAYSIZE(PyramidIndexData),
+		XMFLOAT3(0, 0, 0), XMFLOAT3(1, 1, 1)
+	};
+
 	return hr;
 }
 
 HRESULT DX11Framework::InitVertexIndexBuffers()
 {
+	PROFILE_FUNCTION();
+
 	HRESULT hr = S_OK;
 
 	// Start the thread to create the hard coded objects
 	std::thread hardCodedObjectsThread(&DX11Framework::InitHardCodedObjects, this);
 
 	// Create the terrain object
-	m_terrain = new Terrain(m_device);
+	m_terrain = new Terrain(m_renderDevice);
 
 	// Wait for the thread to finish
 	hardCodedObjectsThread.join();
 
+	// Create the instance renderer that batches repeated meshes
+	m_instanceRenderer = new InstanceRenderer(m_renderDevice);
+
 	return hr;
 }
 
 HRESULT DX11Framework::InitPipelineVariables()
 {
+	PROFILE_FUNCTION();
+
 	HRESULT hr = S_OK;
 
 	//Input Assembler
-	m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	m_immediateContext->IASetInputLayout(m_inputLayout);
+	m_renderContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	m_renderContext->IASetInputLayout(m_inputLayout);
 
 	////////////////////////Rasterizer//////////////////////////
 
@@ -561,23 +744,8 @@ HRESULT DX11Framework::InitPipelineVariables()
 
 	////////////////////////Rasterizer//////////////////////////
 
-	//Viewport Values
-	m_viewport = { 0.0f, 0.0f, static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight), 0.0f, 1.0f };
-	m_immediateContext->RSSetViewports(1, &m_viewport);
-
-	//Constant Buffer
-	D3D11_BUFFER_DESC constantBufferDesc = {};
-	constantBufferDesc.ByteWidth = sizeof(ConstantBuffer);
-	constantBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-	constantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-	constantBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-
-	//
-	hr = m_device->CreateBuffer(&constantBufferDesc, nullptr, &m_constantBuffer);
-	if (FAILED(hr)) { return hr; }
-
-	m_immediateContext->VSSetConstantBuffers(0, 1, &m_constantBuffer);
-	m_immediateContext->PSSetConstantBuffers(0, 1, &m_constantBuffer);
+	hr = InitConstantBuffer();
+	if (FAILED(hr)) return hr;
 
 	///////////////////////////////////////////////////////////
 
@@ -630,6 +798,9 @@ HRESULT DX11Framework::InitPipelineVariables()
 
 void DX11Framework::LoadLightVariables()
 {
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Startup");
+
 	// Using nlohmann.json Library (Not Mine!)
 	// Using a JSON file to store the light variables
 	std::ifstream file("JSON Files\\Light Variables.json");
@@ -640,8 +811,11 @@ void DX11Framework::LoadLightVariables()
 		std::cerr << "Failed to open JSON file." << std::endl;
 	}
 
-	// Load the JSON file
-	file >> m_lightVariables;
+	// Load the JSON file, the DOM stays alive so it is charged to the JSON tag
+	{
+		MemoryTagScope jsonTag(MemoryTag_JSON);
+		file >> m_lightVariables;
+	}
 
 	m_lightDir = XMFLOAT3(
 		m_lightVariables["lightDirection"]["x"].get<float>(),
@@ -703,188 +877,30 @@ void DX11Framework::LoadLightVariables()
 
 void DX11Framework::LoadSceneCameraVariables()
 {
-	std::ifstream file("JSON Files\\Scene Camera Variables.json");
-
-	// Check if the file is open
-	if (!file.is_open())
-	{
-		std::cerr << "Failed to open JSON file." << std::endl;
-	}
-
-	// Load the JSON file
-	file >> m_sceneCameraVariables;
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Startup");
 
 	//Camera
 	float aspect = m_viewport.Width / m_viewport.Height;
 
-	//////////////////////////////////////
-
-	m_debugCamera.SetPosition(
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["Position"]["z"].get<
-		float>());
-
-	m_debugCamera.SetRotation(
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["Rotation"]["z"].get<
-		float>());
-
-	m_debugCamera.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["DebugCamera"]["ProjectionValues"]["far"].get<float>());
-	m_startingCameraPosition = XMFLOAT3(m_debugCamera.GetPosition());
-
-	//////////////////////////////////////
-
-	m_camera1.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["Position"]["z"].get<float>());
-
-	m_camera1.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["Rotation"]["z"].get<float>());
-
-	m_camera1.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraOne"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
-
-	m_camera2.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["Position"]["z"].get<float>());
-
-	m_camera2.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["Rotation"]["z"].get<float>());
-
-	m_camera2.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraTwo"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
-
-	m_camera3.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["Position"]["z"].get<float>());
-
-	m_camera3.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["Rotation"]["z"].get<float>());
-
-	m_camera3.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraThree"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
-
-	m_camera4.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["Position"]["z"].get<float>());
-
-	m_camera4.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["Rotation"]["z"].get<float>());
-
-	m_camera4.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFour"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
-
-	m_camera5.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["Position"]["z"].get<float>());
-
-	m_camera5.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["Rotation"]["z"].get<float>());
-
-	m_camera5.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraFive"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
-
-	m_camera6.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["Position"]["z"].get<float>());
-
-	m_camera6.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["Rotation"]["z"].get<float>());
-
-	m_camera6.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSix"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
-
-	m_camera7.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["Position"]["z"].get<float>());
-
-	m_camera7.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["Rotation"]["z"].get<float>());
-
-	m_camera7.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraSeven"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
-
-	m_camera8.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["Position"]["z"].get<float>());
-
-	m_camera8.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["Rotation"]["z"].get<float>());
-
-	m_camera8.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraEight"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
-
-	m_camera9.SetPosition(m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["Position"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["Position"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["Position"]["z"].get<float>());
-
-	m_camera9.SetRotation(m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["Rotation"]["x"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["Rotation"]["y"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["Rotation"]["z"].get<float>());
-
-	m_camera9.SetProjectionValues(
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["ProjectionValues"]["fov"].get<float>(), aspect,
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["ProjectionValues"]["near"].get<float>(),
-		m_sceneCameraVariables["SceneCameraVariables"]["CameraNine"]["ProjectionValues"]["far"].get<float>());
-
-	//////////////////////////////////////
+	// Load the JSON file
+	{
+		MemoryTagScope jsonTag(MemoryTag_JSON);
+		m_cameraSystem.LoadFromJSON("JSON Files\\Scene Camera Variables.json", aspect);
+	}
 
-	// Close the file
-	file.close();
+	m_startingCameraPosition = XMFLOAT3(m_cameraSystem.GetDebugCamera().GetPosition());
 
-	// Set the View Matrix
-	XMStoreFloat4x4(&m_View, m_debugCamera.GetViewMatrix());
-	// Set the Projection Matrix
-	XMStoreFloat4x4(&m_Projection, m_debugCamera.GetProjectionMatrix());
+	// One culling count per camera, however many the file has
+	m_frustumCulledCount.assign(m_cameraSystem.GetCameraCount(), 0);
+	m_occlusionCulledCount.assign(m_cameraSystem.GetCameraCount(), 0);
 }
 
 HRESULT DX11Framework::LoadUI(HRESULT hr)
 {
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Startup");
+
 	// Load the UI Textures
 	hr = CreateDDSTextureFromFile(m_device, L"Textures\\Crate_COLOR.dds", nullptr, &m_crateTexture);
 	hr = CreateDDSTextureFromFile(m_device, L"Textures\\RyanLabs.dds", nullptr, &m_ryanlabsTexture);
@@ -900,6 +916,9 @@ HRESULT DX11Framework::LoadUI(HRESULT hr)
 	hr = CreateDDSTextureFromFile(m_device, L"Textures\\DownKey.dds", nullptr, &m_downTexture);
 	hr = CreateDDSTextureFromFile(m_device, L"Textures\\Skybox.dds", nullptr, &m_skyboxTexture);
 
+	// Create the performance HUD graph texture
+	hr = m_performanceHUD.Initialise(m_device);
+
 	if (FAILED(hr))
 	{
 		return hr;
@@ -908,16 +927,57 @@ HRESULT DX11Framework::LoadUI(HRESULT hr)
 	return hr;
 }
 
+HRESULT DX11Framework::InitConstantBuffer()
+{
+	HRESULT hr = S_OK;
+
+	//Viewport Values
+	m_viewport = { 0.0f, 0.0f, static_cast<float>(m_windowWidth), static_cast<float>(m_windowHeight), 0.0f, 1.0f };
+	m_renderContext->RSSetViewports(1, &m_viewport);
+
+	//Constant Buffer
+	D3D11_BUFFER_DESC constantBufferDesc = {};
+	constantBufferDesc.ByteWidth = sizeof(ConstantBuffer);
+	constantBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	constantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	constantBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	//
+	hr = m_renderDevice->CreateBuffer(&constantBufferDesc, nullptr, &m_constantBuffer);
+	if (FAILED(hr)) { return hr; }
+
+	m_renderContext->VSSetConstantBuffers(0, 1, &m_constantBuffer);
+	m_renderContext->PSSetConstantBuffers(0, 1, &m_constantBuffer);
+
+	return S_OK;
+}
+
 HRESULT DX11Framework::InitRunTimeData()
 {
+	PROFILE_FUNCTION();
+
 	HRESULT hr = S_OK;
 
 	// Start the runtime data threads
 	std::thread loadlightThread(&DX11Framework::LoadLightVariables, this);
 	std::thread loadcamerasThread(&DX11Framework::LoadSceneCameraVariables, this);
-	std::thread loadUIThread(&DX11Framework::LoadUI, this, hr);
+	std::thread loadUIThread;
 	std::thread loadobjectsThread(&DX11Framework::LoadGameObjectDataFromSceneJSON, this);
 
+	// Headless runs have no sprite batch to draw the UI with
+	if (!m_headless)
+	{
+		loadUIThread = std::thread(&DX11Framework::LoadUI, this, hr);
+	}
+
+	// Bind the keys to the actions the update responds to
+	{
+		MemoryTagScope jsonTag(MemoryTag_JSON);
+		InputSystem::GetInstance()->LoadActionMap("JSON Files\\Input Actions.json");
+	}
+	m_inputLatencyCounter = CounterRegistry::GetInstance()->Register("Input Latency (ms)", CounterKind_Gauge);
+	m_terrainVisibleCounter = CounterRegistry::GetInstance()->Register("Terrain Chunks Visible (%)", CounterKind_Gauge);
+
 	// Set some default values for the constant buffer
 	m_cbData.hasTexture = 1;
 	m_cbData.pixelationAmount = 20.0f;
@@ -925,7 +985,7 @@ HRESULT DX11Framework::InitRunTimeData()
 	// Wait for the threads to finish
 	loadcamerasThread.join();
 	loadlightThread.join();
-	loadUIThread.join();
+	if (loadUIThread.joinable()) loadUIThread.join();
 	loadobjectsThread.join();
 
 	return S_OK;
@@ -933,11 +993,17 @@ HRESULT DX11Framework::InitRunTimeData()
 
 void DX11Framework::LoadGameObjectDataFromSceneJSON()
 {
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Startup");
+
+	// Game objects, entities and transforms, the mesh and texture loads charge themselves to their own tags
+	MemoryTagScope sceneTag(MemoryTag_Scene);
+
 	// Load some non-scene graph objects (Skybox, Main Menu Object)
-	m_mainMenuObject = new GameObject(m_device, "Test models\\Made In Blender\\donut.obj", L"NULL", XMFLOAT3(0, 1, -11),
-		XMFLOAT3(0, 0, 0), XMFLOAT3(1.45f, 1.45f, 1.45f), 0, "mainmenuobject");
+	m_mainMenuObject = new GameObject(m_renderDevice, "Test models\\Made In Blender\\donut.obj", L"NULL",
+		XMFLOAT3(0, 1, -11), XMFLOAT3(0, 0, 0), XMFLOAT3(1.45f, 1.45f, 1.45f), 0, "mainmenuobject");
 
-	m_skybox = new GameObject(m_device, "OBJ's\\InvertedCube.obj", L"Textures\\skybox.dds",
+	m_skybox = new GameObject(m_renderDevice, "OBJ's\\InvertedCube.obj", L"Textures\\skybox.dds",
 		XMFLOAT3(0, 0, 0), XMFLOAT3(0, 0, 0), XMFLOAT3(1000, 1000, 1000), 0, "skybox");
 
 	std::ifstream file("JSON Files\\Scene Graph.json");
@@ -950,7 +1016,10 @@ void DX11Framework::LoadGameObjectDataFromSceneJSON()
 	}
 
 	// Load the JSON file
-	file >> m_sceneData;
+	{
+		MemoryTagScope jsonTag(MemoryTag_JSON);
+		file >> m_sceneData;
+	}
 
 	for (int i = 0; i < m_sceneData["GameObjects"].size(); i++)
 	{
@@ -958,6 +1027,30 @@ void DX11Framework::LoadGameObjectDataFromSceneJSON()
 		LoadGameObject(i);
 	}
 
+	// Parents are linked once everything is loaded, so an object can name a parent that comes after it in the file
+	for (int i = 0; i < m_sceneData["GameObjects"].size(); i++)
+	{
+		if (!m_sceneData["GameObjects"][i].contains("parent"))
+		{
+			continue;
+		}
+
+		int parentID = m_sceneData["GameObjects"][i]["parent"].get<int>();
+
+		for (GameObject* gameObject : m_gameObjects)
+		{
+			if (gameObject->GetID() == parentID)
+			{
+				if (!m_gameObjects[i]->SetParent(gameObject))
+				{
+					std::cerr << "Game object " << m_gameObjects[i]->GetName() << " cannot be parented to one of its children."
+						<< std::endl;
+				}
+				break;
+			}
+		}
+	}
+
 	file.close();
 }
 
@@ -970,6 +1063,8 @@ std::wstring StringToWString(const std::string& str)
 
 void DX11Framework::LoadGameObject(int i)
 {
+	PROFILE_FUNCTION();
+
 	// Load the game objects paths
 	auto tempOBJfilepath = m_sceneData["GameObjects"][i]["OBJfilepath"].get<std::string>();
 	auto tempTexturefilepath = m_sceneData["GameObjects"][i]["TEXfilepath"].get<std::string>();
@@ -1000,8 +1095,18 @@ void DX11Framework::LoadGameObject(int i)
 	std::wstring tempTextureWfilepath = StringToWString(tempTexturefilepath);
 
 	// Create the game object
-	auto tempGameObject = new GameObject(m_device, tempOBJfilepath.c_str(), tempTextureWfilepath.c_str(), tempPosition,
-		tempRotation, tempScale, tempID, tempName);
+	auto tempGameObject = new GameObject(m_renderDevice, tempOBJfilepath.c_str(), tempTextureWfilepath.c_str(),
+		tempPosition, tempRotation, tempScale, tempID, tempName);
+
+	// Scene graph objects are culled and drawn in the instanced pass, glass goes in with the transparent batches
+	EntityRegistry::GetInstance()->AddComponents(tempGameObject->GetEntity(), Component_SceneGraph);
+	tempGameObject->SetTransparent(tempName == "Glass");
+
+	// Objects flagged as occluders hide whatever is behind them from the software occlusion culler
+	if (m_sceneData["GameObjects"][i].value("Occluder", false))
+	{
+		tempGameObject->SetOccluderMesh(ResourceManager::GetInstance()->LoadCPUMesh(tempOBJfilepath));
+	}
 
 	// Fancy C++ Vector
 	m_gameObjects.push_back(tempGameObject);
@@ -1027,17 +1132,19 @@ void DX11Framework::DrawKey(KeyState state, ID3D11ShaderResourceView* texture, X
 void DX11Framework::RenderTransparent() const
 {
 	// Set the blend state for transparency
-	m_immediateContext->OMSetBlendState(m_transparency, m_transparencyBlendFactor, 0xffffffff);
+	m_renderContext->OMSetBlendState(m_transparency, m_transparencyBlendFactor, 0xffffffff);
 }
 
 void DX11Framework::RenderOpaque() const
 {
 	// Set the blend state for opaque objects
-	m_immediateContext->OMSetBlendState(nullptr, m_blendfactor, 0xffffffff);
+	m_renderContext->OMSetBlendState(nullptr, m_blendfactor, 0xffffffff);
 }
 
 void DX11Framework::DrawUI()
 {
+	PROFILE_FUNCTION();
+
 	// Draw the UI, if the text rendering is enabled
 	if (m_textRendering)
 	{
@@ -1048,7 +1155,7 @@ void DX11Framework::DrawUI()
 		m_spriteBatch->Draw(m_ryanlabsTexture, XMFLOAT2(1800, 0), nullptr, Colors::White, 0.0f, XMFLOAT2(0, 0), 0.02f);
 
 		// Debug Camera Controls
-		if (m_cameraNumActive == 0)
+		if (m_cameraSystem.IsDebugCameraActive())
 		{
 			DrawKey(m_WState, m_wTexture, XMFLOAT2(1300, 790));
 			DrawKey(m_AState, m_aTexture, XMFLOAT2(1190, 900));
@@ -1209,77 +1316,54 @@ void DX11Framework::DrawUI()
 				Colors::Green);
 		}
 
-		// Determine which camera is active and display it
-		switch (m_cameraNumActive)
+		// Monitor Wall UI
+		if (m_viewCount > 1)
 		{
-		case 0:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Debug Camera Active", XMFLOAT2(0, 300), Colors::Purple);
-			break;
-
-		case 1:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 1 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		case 2:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 3 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		case 3:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 2 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		case 4:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 4 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		case 5:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 5 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		case 6:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 6 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		case 7:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 7 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		case 8:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 8 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		case 9:
-			m_spriteFont->DrawString(m_spriteBatch.get(), L"Camera 9 Active", XMFLOAT2(0, 300), Colors::White);
-			break;
-
-		default: break;
+			m_spriteFont->DrawString(m_spriteBatch.get(), L"M - Monitor Wall: ON", XMFLOAT2(1515, 650), Colors::Green);
 		}
-
-		// Draw the active UI
-		if (m_cameraNumActive == 0)
+		else
 		{
-			std::string countStr = "Time Running: " + std::to_string(m_timeRunning);
-			m_spriteFont->DrawString(m_spriteBatch.get(), countStr.c_str(), XMFLOAT2(0, 1010), Colors::Purple);
-
-			std::string cameraPosStrX = "X POS: " + std::to_string(m_debugCamera.GetPosition().x);
-			std::string cameraPosStrY = "Y POS: " + std::to_string(m_debugCamera.GetPosition().y);
-			std::string cameraPosStrZ = "Z POS: " + std::to_string(m_debugCamera.GetPosition().z);
-
-			std::string cameraPos = cameraPosStrX + " " + cameraPosStrY + " " + cameraPosStrZ;
+			m_spriteFont->DrawString(m_spriteBatch.get(), L"M - Monitor Wall: OFF", XMFLOAT2(1515, 650), Colors::Red);
+		}
 
-			std::string cameraRotStrX = "X ROT: " + std::to_string(m_debugCamera.GetRotation().x);
-			std::string cameraRotStrY = "Y ROT: " + std::to_string(m_debugCamera.GetRotation().y);
+		// Culling statistics of the active camera, the UI strings are formatted into the frame arena rather than the heap
+		FrameArena* frameArena = FrameArena::GetInstance();
+		UINT activeCamera = m_cameraSystem.GetActiveIndex();
 
-			std::string cameraRot = cameraRotStrX + " " + cameraRotStrY;
+		// Display the active camera
+		m_spriteFont->DrawString(m_spriteBatch.get(), frameArena->Format("%s Active", m_cameraSystem.GetLabel(
+			activeCamera)), XMFLOAT2(0, 300), m_cameraSystem.IsDebugCameraActive() ? Colors::Purple : Colors::White);
 
-			m_spriteFont->DrawString(m_spriteBatch.get(), cameraRot.c_str(), XMFLOAT2(0, 980), Colors::Purple);
-			m_spriteFont->DrawString(m_spriteBatch.get(), cameraPos.c_str(), XMFLOAT2(0, 960), Colors::Purple);
+		m_spriteFont->DrawString(m_spriteBatch.get(), frameArena->Format("Frustum Culled: %u Occlusion Culled: %u",
+			m_frustumCulledCount[activeCamera], m_occlusionCulledCount[activeCamera]), XMFLOAT2(0, 350),
+			Colors::White);
 
-			std::string mouseposXStr = "Mouse X: " + std::to_string(g_mouseX);
-			std::string mouseposYStr = "Mouse Y: " + std::to_string(g_mouseY);
+#ifdef MEMORY_TRACKING
+		// The allocation count should stay at zero once the scene has settled
+		MemoryTagStats memoryStats = MemoryTracker::GetInstance()->GetTotalStats();
+		m_spriteFont->DrawString(m_spriteBatch.get(), frameArena->Format("Heap: %.1f MB Allocations Last Frame: %lld",
+			memoryStats.CurrentBytes / (1024.0 * 1024.0), memoryStats.FrameCount), XMFLOAT2(0, 1040), Colors::White);
+#endif
 
-			m_spriteFont->DrawString(m_spriteBatch.get(), mouseposXStr.c_str(), XMFLOAT2(0, 920), Colors::Purple);
-			m_spriteFont->DrawString(m_spriteBatch.get(), mouseposYStr.c_str(), XMFLOAT2(0, 940), Colors::Purple);
+		// Draw the active UI
+		if (m_cameraSystem.IsDebugCameraActive())
+		{
+			m_spriteFont->DrawString(m_spriteBatch.get(), frameArena->Format("Time Running: %f", m_timeRunning),
+				XMFLOAT2(0, 1010), Colors::Purple);
+
+			XMFLOAT3 debugRotation = m_cameraSystem.GetDebugCamera().GetRotation();
+			XMFLOAT3 debugPosition = m_cameraSystem.GetDebugCamera().GetPosition();
+
+			m_spriteFont->DrawString(m_spriteBatch.get(), frameArena->Format("X ROT: %f Y ROT: %f",
+				debugRotation.x, debugRotation.y), XMFLOAT2(0, 980), Colors::Purple);
+			m_spriteFont->DrawString(m_spriteBatch.get(), frameArena->Format("X POS: %f Y POS: %f Z POS: %f",
+				debugPosition.x, debugPosition.y, debugPosition.z), XMFLOAT2(0, 960), Colors::Purple);
+
+			const InputSystem* input = InputSystem::GetInstance();
+			m_spriteFont->DrawString(m_spriteBatch.get(), frameArena->Format("Mouse X: %d", input->GetMouseX()),
+				XMFLOAT2(0, 920), Colors::Purple);
+			m_spriteFont->DrawString(m_spriteBatch.get(), frameArena->Format("Mouse Y: %d", input->GetMouseY()),
+				XMFLOAT2(0, 940), Colors::Purple);
 		}
 
 		// End the sprite batch
@@ -1339,6 +1423,11 @@ void DX11Framework::DrawMainMenu() const
 
 void DX11Framework::Draw()
 {
+	PROFILE_FUNCTION();
+
+	// Batches, culling lists and anything else the frame grows
+	MemoryTagScope renderingTag(MemoryTag_Rendering);
+
 	// Create the stride and offset
 	UINT stride = sizeof(SimpleVertex);
 	UINT offset = 0;
@@ -1351,163 +1440,435 @@ void DX11Framework::Draw()
 
 	if (m_mainMenu == false)
 	{
-		// Draw the first cube
-		m_cbData.World = XMMatrixTranspose(XMLoadFloat4x4(&m_World));
-		D3D11_MAPPED_SUBRESOURCE mappedSubresourceCube1{};
-		m_immediateContext->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresourceCube1);
-		memcpy(mappedSubresourceCube1.pData, &m_cbData, sizeof(m_cbData));
-		m_immediateContext->Unmap(m_constantBuffer, 0);
-		m_immediateContext->DrawIndexed(36, 0, 0);
-		///////////////////////////////////////////////////////////
-		// Draw the second cube
-		m_cbData.World = XMMatrixTranspose(XMLoadFloat4x4(&m_World2));
-		D3D11_MAPPED_SUBRESOURCE mappedSubresourceCube2{};
-		m_immediateContext->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresourceCube2);
-		memcpy(mappedSubresourceCube2.pData, &m_cbData, sizeof(m_cbData));
-		m_immediateContext->Unmap(m_constantBuffer, 0);
-		m_immediateContext->DrawIndexed(36, 0, 0);
-		///////////////////////////////////////////////////////////
-		// Draw the third cube
-		m_cbData.World = XMMatrixTranspose(XMLoadFloat4x4(&m_World3));
-		D3D11_MAPPED_SUBRESOURCE mappedSubresourceCube3{};
-		m_immediateContext->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresourceCube3);
-		memcpy(mappedSubresourceCube3.pData, &m_cbData, sizeof(m_cbData));
-		m_immediateContext->Unmap(m_constantBuffer, 0);
-		m_immediateContext->DrawIndexed(36, 0, 0);
-		///////////////////////////////////////////////////////////
-		// Draw the pyramid
-		m_cbData.World = XMMatrixTranspose(XMLoadFloat4x4(&m_Pyramid));
-		D3D11_MAPPED_SUBRESOURCE mappedSubresourcePyramid{};
-		m_immediateContext->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresourcePyramid);
-		memcpy(mappedSubresourcePyramid.pData, &m_cbData, sizeof(m_cbData));
-		m_immediateContext->Unmap(m_constantBuffer, 0);
-		m_immediateContext->IASetVertexBuffers(0, 1, &m_pyramidVertexBuffer, &stride, &offset);
-		m_immediateContext->IASetIndexBuffer(m_pyramidIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
-		m_immediateContext->DrawIndexed(18, 0, 0);
-
-		// Draw the game objects
-		for (const auto& gameObject : m_gameObjects)
-		{
-			// If the game object is transparent, render it as such
-			if (gameObject->m_Name == "Glass")
-			{
-				RenderTransparent();
-				gameObject->Draw(m_cbData, m_immediateContext, m_constantBuffer);
-				RenderOpaque();
-			}
-			else
+		// Throw away everything outside the camera frustums before it reaches the batches
+		CullScene();
+
+		// Page the heightmap tiles in around the first view's camera, before any view samples them
+		m_terrain->StreamTiles(m_renderContext, m_cameraSystem.GetCamera(GetViewCamera(0)).GetPosition());
+
+		// Nothing of the terrain is drawn unless the first view's RenderTerrain says otherwise
+		m_terrainViewStats = {};
+		m_terrainViewStats.TotalChunks = m_terrain->GetQuadtree().GetChunkCount();
+
+		for (UINT view = 0; view < m_viewCount; view++)
+		{
+			// A single view keeps the active camera state UpdatePipelineVariables already set
+			if (m_viewCount > 1)
 			{
-				gameObject->Draw(m_cbData, m_immediateContext, m_constantBuffer);
+				BeginView(view, stride, offset);
 			}
-		}
 
-		// Render the terrain
-		RenderTerrain(stride, offset);
+			// The per-frame constants are shared by every instance, so they are only uploaded once per view
+			D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
+			m_renderContext->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+			memcpy(mappedSubresource.pData, &m_cbData, sizeof(m_cbData));
+			m_renderContext->Unmap(m_constantBuffer, 0);
+			CounterRegistry::GetInstance()->Add(Counter_ConstantBufferBytes, sizeof(m_cbData));
 
-		///////////////////////////////////////////////////////////
-		// UI Drawing
+			RenderSceneView(view);
+		}
+
+		if (m_terrainViewStats.TotalChunks > 0)
+		{
+			CounterRegistry::GetInstance()->Set(m_terrainVisibleCounter,
+				100.0 * m_terrainViewStats.VisibleChunks / m_terrainViewStats.TotalChunks);
+		}
+
+		if (m_benchmarking)
+		{
+			m_terrainVisibility.push_back({ m_cameraSystem.GetCamera(GetViewCamera(0)).GetPosition(),
+				m_terrainViewStats });
+		}
+
+		// The UI covers the whole screen again
+		if (m_viewCount > 1)
+		{
+			m_renderContext->RSSetViewports(1, &m_viewport);
+		}
+
+		///////////////////////////////////////////////////////////
+		// UI Drawing
 		// Using DirectX11 Toolkit by Microsoft Library for SpriteBatching and SpriteFonts (Not Mine!)
 		// Designed for 1080p resolution
-		DrawUI();
+		if (!m_headless)
+		{
+			DrawUI();
+		}
+
+		// The performance HUD is drawn even with the rest of the UI turned off
+		if (m_performanceHUD.IsVisible() && !m_headless)
+		{
+			m_spriteBatch->Begin();
+			m_performanceHUD.Draw(m_spriteBatch.get(), m_spriteFont.get(), XMFLOAT2(560, 80));
+			m_spriteBatch->End();
+		}
 	}
 	else
 	{
 		// Set the main menu to render transparent
 		RenderTransparent();
 
-		m_mainMenuObject->Draw(m_cbData, m_immediateContext, m_constantBuffer);
+		m_mainMenuObject->Draw(m_cbData, m_renderContext, m_constantBuffer);
 
 		// Set the main menu to render opaque
 		RenderOpaque();
 
 		// Draw the main menu UI
-		DrawMainMenu();
+		if (!m_headless)
+		{
+			DrawMainMenu();
+		}
 	}
 
 	// Present Backbuffer to screen
-	m_swapChain->Present(0, 0);
+	if (!m_headless)
+	{
+		m_occluded = m_swapChain->Present(0, 0) == DXGI_STATUS_OCCLUDED;
+	}
+
+	// Benchmarks run flat out, whatever the target rate
+	if (!m_benchmarking)
+	{
+		PROFILE_SCOPE("Frame Limiter");
+		m_frameLimiter.Wait();
+	}
+}
+
+// Draw the visible objects and terrain of the current view
+void DX11Framework::RenderSceneView(UINT view)
+{
+	PROFILE_FUNCTION();
+
+	// Gather the visible game objects, cubes and pyramid into instance batches
+	{
+		PROFILE_SCOPE("Submit Instances");
+
+		m_instanceRenderer->Begin();
+
+		const UINT entityCount = static_cast<UINT>(m_cullRenders.size());
+		const XMFLOAT4X4* shapeWorlds[] = { &m_World, &m_World2, &m_World3, &m_Pyramid };
+
+		for (UINT index : m_visibleObjects)
+		{
+			if (index < entityCount)
+			{
+				const RenderComponent& render = *m_cullRenders[index];
+
+				// If the entity is transparent, it goes into the transparent pass
+				m_instanceRenderer->Submit(render.Mesh, render.Texture, m_pixelShader, render.Transparent,
+					TransformStore::GetInstance()->GetWorldMatrix(m_cullTransforms[index]));
+			}
+			else if (index < entityCount + ARRAYSIZE(shapeWorlds))
+			{
+				UINT shape = index - entityCount;
+
+				// The last hard coded shape is the pyramid
+				m_instanceRenderer->Submit(shape == 3 ? m_pyramidMeshData : m_cubeMeshData, m_crateTexture,
+					m_pixelShader, false, *shapeWorlds[shape]);
+			}
+		}
+	}
+
+	m_instanceRenderer->Upload(m_renderContext);
+
+	// Draw the batches, opaque first and then the transparent ones on top
+	m_renderContext->IASetInputLayout(m_instancedInputLayout);
+	m_renderContext->VSSetShader(m_vertexShaderInstanced, nullptr, 0);
+
+	m_instanceRenderer->Draw(m_renderContext, false);
+
+	RenderTransparent();
+	m_instanceRenderer->Draw(m_renderContext, true);
+	RenderOpaque();
+
+	// Render the terrain
+	if (m_terrainVisible)
+	{
+		RenderTerrain(view);
+	}
+}
+
+// Cull the scene against the active camera, or against every camera of the monitor wall
+void DX11Framework::CullScene()
+{
+	PROFILE_FUNCTION();
+
+	m_cullCenters.clear();
+	m_cullExtents.clear();
+
+	XMFLOAT3 worldCenter;
+	XMFLOAT3 worldExtents;
+
+	m_cullRenders.clear();
+	m_cullTransforms.clear();
+	m_cullOccluders.clear();
+
+	// Walk the scene archetypes row by row, every component read here sits in a packed array
+	const TransformStore* transformStore = TransformStore::GetInstance();
+	EntityRegistry::GetInstance()->ForEach(Component_SceneGraph | Component_Transform | Component_Render,
+		[&](const EntityArchetype& archetype)
+	{
+		const bool occluders = archetype.HasComponents(Component_Occluder);
+
+		for (UINT row = 0; row < archetype.GetCount(); row++)
+		{
+			const RenderComponent& render = archetype.GetRenders()[row];
+			const UINT transform = archetype.GetTransforms()[row];
+
+			FrustumCuller::TransformBounds(render.Mesh.BoundsCenter, render.Mesh.BoundsExtents,
+				XMLoadFloat4x4(&transformStore->GetWorldMatrix(transform)), worldCenter, worldExtents);
+			m_cullCenters.push_back(worldCenter);
+			m_cullExtents.push_back(worldExtents);
+
+			m_cullRenders.push_back(&render);
+			m_cullTransforms.push_back(transform);
+			m_cullOccluders.push_back(occluders ? archetype.GetOccluders()[row] : nullptr);
+		}
+	});
+
+	// Same order as the shapes submitted in Draw
+	const XMFLOAT4X4* shapeWorlds[] = { &m_World, &m_World2, &m_World3, &m_Pyramid };
+	for (UINT shape = 0; shape < ARRAYSIZE(shapeWorlds); shape++)
+	{
+		const MeshData& meshData = shape == 3 ? m_pyramidMeshData : m_cubeMeshData;
+		FrustumCuller::TransformBounds(meshData.BoundsCenter, meshData.BoundsExtents,
+			XMLoadFloat4x4(shapeWorlds[shape]), worldCenter, worldExtents);
+		m_cullCenters.push_back(worldCenter);
+		m_cullExtents.push_back(worldExtents);
+	}
+
+	FrustumCuller::TransformBounds(m_terrain->GetBoundsCenter(), m_terrain->GetBoundsExtents(),
+		XMLoadFloat4x4(&m_terrain->m_matrix), worldCenter, worldExtents);
+	m_cullCenters.push_back(worldCenter);
+	m_cullExtents.push_back(worldExtents);
+
+	const UINT primitiveCount = static_cast<UINT>(m_cullCenters.size());
+	const UINT terrainIndex = primitiveCount - 1;
+
+	// Objects only move between frames, so the tree is refitted and only rebuilt when objects are added or removed
+	if (m_sceneBVH.GetPrimitiveCount() != primitiveCount)
+	{
+		m_sceneBVH.Build(m_cullCenters, m_cullExtents);
+	}
+	else
+	{
+		for (UINT i = 0; i < primitiveCount; i++)
+		{
+			m_sceneBVH.UpdatePrimitive(i, m_cullCenters[i], m_cullExtents[i]);
+		}
+		m_sceneBVH.Refit();
+	}
+
+	// Every view of the monitor wall is culled in one walk of the tree, BeginView picks out each view's objects
+	if (m_viewCount > 1)
+	{
+		for (UINT view = 0; view < m_viewCount; view++)
+		{
+			m_viewFrustums[view].SetPlanes(m_cameraSystem.GetCamera(GetViewCamera(view)).GetFrustumPlanes());
+		}
+
+		PROFILE_SCOPE("Query Views");
+		m_sceneBVH.QueryFrustums(m_viewFrustums.data(), m_viewCount, m_viewVisibility);
+		return;
+	}
+
+	// The camera caches its planes, they are only extracted again after it moves
+	const Camera& activeCamera = m_cameraSystem.GetActiveCamera();
+	XMMATRIX viewProjection = activeCamera.GetViewProjectionMatrix();
+	m_frustumCuller.SetPlanes(activeCamera.GetFrustumPlanes());
+
+	m_sceneBVH.QueryFrustum(m_frustumCuller, m_visibleObjects);
+
+	// Back into scene order, so the transparent objects keep their draw order and the terrain is the last index
+	std::sort(m_visibleObjects.begin(), m_visibleObjects.end());
+	const UINT frustumVisibleCount = static_cast<UINT>(m_visibleObjects.size());
+
+	// Draw the occluders that survived the frustum test into the coarse depth buffer
+	const UINT entityCount = static_cast<UINT>(m_cullOccluders.size());
+	m_occlusionCuller.Clear(viewProjection);
+	for (UINT index : m_visibleObjects)
+	{
+		if (index < entityCount && m_cullOccluders[index])
+		{
+			m_occlusionCuller.RasterizeOccluder(*m_cullOccluders[index],
+				XMLoadFloat4x4(&transformStore->GetWorldMatrix(m_cullTransforms[index])));
+		}
+	}
+
+	// Then drop everything hidden behind them, occluders are never tested against themselves
+	m_visibleObjects.erase(std::remove_if(m_visibleObjects.begin(), m_visibleObjects.end(), [&](UINT index)
+	{
+		if (index < entityCount && m_cullOccluders[index])
+		{
+			return false;
+		}
+
+		return m_occlusionCuller.IsOccluded(m_cullCenters[index], m_cullExtents[index]);
+	}), m_visibleObjects.end());
+
+	m_terrainVisible = !m_visibleObjects.empty() && m_visibleObjects.back() == terrainIndex;
+
+	// Keep the counts per camera, the UI shows the ones for the active camera
+	UINT activeIndex = m_cameraSystem.GetActiveIndex();
+	m_frustumCulledCount[activeIndex] = primitiveCount - frustumVisibleCount;
+	m_occlusionCulledCount[activeIndex] = frustumVisibleCount - static_cast<UINT>(m_visibleObjects.size());
+}
+
+// Point the pipeline at one tile of the monitor wall and pick out what its camera sees
+void DX11Framework::BeginView(UINT view, UINT stride, UINT offset)
+{
+	PROFILE_FUNCTION();
+
+	// A square grid keeps every tile at the screen's aspect ratio, so the cameras' projections still fit
+	const UINT columns = GetViewColumns();
+	const float tileWidth = m_viewport.Width / columns;
+	const float tileHeight = m_viewport.Height / columns;
+
+	D3D11_VIEWPORT viewport = { (view % columns) * tileWidth, (view / columns) * tileHeight, tileWidth, tileHeight,
+		0.0f, 1.0f };
+	m_renderContext->RSSetViewports(1, &viewport);
+
+	const UINT cameraIndex = GetViewCamera(view);
+	const Camera& camera = m_cameraSystem.GetCamera(cameraIndex);
+	const CameraShaderMatrices& cameraMatrices = camera.GetShaderMatrices();
+	m_cbData.View = cameraMatrices.View;
+	m_cbData.Projection = cameraMatrices.Projection;
+
+	// The previous view left the instanced and terrain layouts bound
+	m_renderContext->IASetInputLayout(m_inputLayout);
+	m_renderContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	RenderSkybox(stride, offset);
+
+	// The skybox follows the debug camera, the lighting follows the camera of this tile
+	m_cbData.CameraPosition = camera.GetPosition();
+
+	// Pick this view's objects out of the visibility masks, in scene order like the single view list
+	const UINT64 viewBit = 1ull << view;
+	const UINT primitiveCount = static_cast<UINT>(m_viewVisibility.size());
+
+	m_visibleObjects.clear();
+	for (UINT i = 0; i < primitiveCount; i++)
+	{
+		if (m_viewVisibility[i] & viewBit)
+		{
+			m_visibleObjects.push_back(i);
+		}
+	}
+
+	m_terrainVisible = !m_visibleObjects.empty() && m_visibleObjects.back() == primitiveCount - 1;
+
+	// Views are not occlusion culled, the coarse depth buffer is only drawn for a single view
+	m_frustumCulledCount[cameraIndex] = primitiveCount - static_cast<UINT>(m_visibleObjects.size());
+	m_occlusionCulledCount[cameraIndex] = 0;
+}
+
+UINT DX11Framework::GetViewCamera(UINT view) const
+{
+	// A single view shows the active camera, a wall shows the cameras in order and repeats them if it runs out
+	return m_viewCount > 1 ? view % m_cameraSystem.GetCameraCount() : m_cameraSystem.GetActiveIndex();
+}
+
+UINT DX11Framework::GetViewColumns() const
+{
+	return static_cast<UINT>(ceilf(sqrtf(static_cast<float>(m_viewCount))));
+}
+
+void DX11Framework::SetViewCount(UINT viewCount)
+{
+	viewCount = viewCount < 1 ? 1 : viewCount;
+	m_viewCount = viewCount < MaxQueryFrustums ? viewCount : MaxQueryFrustums;
+
+	m_viewFrustums.resize(m_viewCount);
 }
 
 // Render the terrain (Should be moved into the class)
-void DX11Framework::RenderTerrain(UINT stride, UINT offset)
+void DX11Framework::RenderTerrain(UINT view)
 {
+	PROFILE_FUNCTION();
+
 	D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
 
 	m_cbData.World = XMMatrixTranspose(XMLoadFloat4x4(&m_terrain->m_matrix));
 
-	m_immediateContext->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+	m_renderContext->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
 	memcpy(mappedSubresource.pData, &m_cbData, sizeof(m_cbData));
-	m_immediateContext->Unmap(m_constantBuffer, 0);
+	m_renderContext->Unmap(m_constantBuffer, 0);
 
-	m_immediateContext->VSSetShader(m_vertexShaderHeightmap, nullptr, 0);
-	m_immediateContext->PSSetShader(m_pixelShaderHeightmap, nullptr, 0);
+	// Pick the nodes for this view's camera, the screen-space error is measured against the height of its tile
+	const Camera& camera = m_cameraSystem.GetCamera(GetViewCamera(view));
+	const float tileHeight = m_viewport.Height / GetViewColumns();
+	const float projectionScale = 0.5f * tileHeight * XMVectorGetY(camera.GetShaderMatrices().Projection.r[1]);
 
-	m_immediateContext->IASetInputLayout(m_terrainInputLayout);
+	m_terrain->Select(camera.GetPosition(), camera.GetFrustumPlanes(), projectionScale);
+	if (view == 0)
+	{
+		m_terrainViewStats = m_terrain->GetSelectionStats();
+	}
+
+	m_renderContext->VSSetShader(m_vertexShaderHeightmap, nullptr, 0);
+	m_renderContext->PSSetShader(m_pixelShaderHeightmap, nullptr, 0);
 
-	m_immediateContext->VSSetShaderResources(0, 1, &m_terrain->m_HeightMapSRV);
-	m_immediateContext->VSSetSamplers(0, 1, &m_bilinearSamplerState);
-	m_immediateContext->PSSetShaderResources(0, 1, &m_terrain->m_HeightMapSRV);
-	m_immediateContext->PSSetSamplers(0, 1, &m_bilinearSamplerState);
+	m_renderContext->IASetInputLayout(m_terrainInputLayout);
 
-	m_immediateContext->IASetVertexBuffers(0, 1, &m_terrain->m_TriFlatGridVB, &stride, &offset);
-	m_immediateContext->IASetIndexBuffer(m_terrain->m_TriFlatGridIB, DXGI_FORMAT_R32_UINT, 0);
+	m_renderContext->VSSetShaderResources(0, 1, &m_terrain->m_HeightMapSRV);
+	m_renderContext->VSSetSamplers(0, 1, &m_bilinearSamplerState);
+	m_renderContext->PSSetShaderResources(0, 1, &m_terrain->m_HeightMapSRV);
+	m_renderContext->PSSetSamplers(0, 1, &m_bilinearSamplerState);
 
-	m_immediateContext->DrawIndexed(m_terrain->m_indices.size(), 0, 0);
+	m_terrain->Draw(m_renderContext);
+
+	CounterRegistry::GetInstance()->Add(Counter_ConstantBufferBytes, sizeof(m_cbData));
 }
 
 // Render the skybox
 void DX11Framework::RenderSkybox(UINT stride, UINT offset)
 {
-	D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
+	PROFILE_FUNCTION();
 
-	m_immediateContext->VSSetShader(m_vertexShaderSkybox, nullptr, 0);
-	m_immediateContext->PSSetShader(m_pixelShaderSkybox, nullptr, 0);
-	m_immediateContext->OMSetDepthStencilState(m_depthStencilSkybox, 1);
-	m_immediateContext->PSSetShaderResources(0, 1, &m_skyboxTexture);
-	m_immediateContext->Map(m_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
-	m_skybox->Draw(m_cbData, m_immediateContext, m_constantBuffer);
+	m_renderContext->VSSetShader(m_vertexShaderSkybox, nullptr, 0);
+	m_renderContext->PSSetShader(m_pixelShaderSkybox, nullptr, 0);
+	m_renderContext->OMSetDepthStencilState(m_depthStencilSkybox, 1);
+	m_renderContext->PSSetShaderResources(0, 1, &m_skyboxTexture);
+	m_skybox->Draw(m_cbData, m_renderContext, m_constantBuffer);
 
 	// Move the skybox with the camera
-	if (m_debugCamera.GetPosition().z > 0)
+	const Camera& debugCamera = m_cameraSystem.GetDebugCamera();
+	if (debugCamera.GetPosition().z > 0)
 	{
 		m_cbData.CameraPosition = m_startingCameraPosition;
 	}
-	else if (m_debugCamera.GetPosition().z < 0)
+	else if (debugCamera.GetPosition().z < 0)
 	{
-		m_cbData.CameraPosition = m_debugCamera.GetPosition();
+		m_cbData.CameraPosition = debugCamera.GetPosition();
 	}
 
-	m_cbData.View = XMMatrixTranspose(XMLoadFloat4x4(&m_View));
-	m_cbData.Projection = XMMatrixTranspose(XMLoadFloat4x4(&m_Projection));
-
 	if (m_fill)
 	{
-		m_immediateContext->RSSetState(m_fillState);
+		m_renderContext->RSSetState(m_fillState);
 	}
 	else if (!m_fill && !m_nobackfaceCulling)
 	{
-		m_immediateContext->RSSetState(m_wireframeState);
+		m_renderContext->RSSetState(m_wireframeState);
 	}
 	else if (!m_fill && m_nobackfaceCulling)
 	{
-		m_immediateContext->RSSetState(m_dontCullBackState);
+		m_renderContext->RSSetState(m_dontCullBackState);
 	}
 
 	// Write constant buffer data onto GPU
-	m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	m_immediateContext->IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &offset);
-	m_immediateContext->IASetIndexBuffer(m_indexBuffer, DXGI_FORMAT_R16_UINT, 0);
-	m_immediateContext->IASetInputLayout(m_inputLayout);
-	m_immediateContext->VSSetConstantBuffers(0, 1, &m_constantBuffer);
-	m_immediateContext->PSSetConstantBuffers(0, 1, &m_constantBuffer);
-	m_immediateContext->VSSetShader(m_vertexShader, nullptr, 0);
-	m_immediateContext->PSSetShader(m_pixelShader, nullptr, 0);
-	m_immediateContext->PSSetSamplers(0, 1, &m_bilinearSamplerState);
-	m_immediateContext->PSSetShaderResources(0, 1, &m_crateTexture);
-	m_immediateContext->PSSetShaderResources(1, 1, &m_ryanlabsTexture);
-	m_immediateContext->RSSetViewports(1, &m_viewport);
+	m_renderContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	m_renderContext->IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &offset);
+	m_renderContext->IASetIndexBuffer(m_indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+	m_renderContext->IASetInputLayout(m_inputLayout);
+	m_renderContext->VSSetConstantBuffers(0, 1, &m_constantBuffer);
+	m_renderContext->PSSetConstantBuffers(0, 1, &m_constantBuffer);
+	m_renderContext->VSSetShader(m_vertexShader, nullptr, 0);
+	m_renderContext->PSSetShader(m_pixelShader, nullptr, 0);
+	m_renderContext->PSSetSamplers(0, 1, &m_bilinearSamplerState);
+	m_renderContext->PSSetShaderResources(0, 1, &m_crateTexture);
+	m_renderContext->PSSetShaderResources(1, 1, &m_ryanlabsTexture);
 	RenderOpaque();
-	m_immediateContext->OMSetDepthStencilState(nullptr, 0);
+	m_renderContext->OMSetDepthStencilState(nullptr, 0);
 }
 
 #pragma endregion
@@ -1516,76 +1877,79 @@ void DX11Framework::RenderSkybox(UINT stride, UINT offset)
 
 void DX11Framework::HandleDebugMovement(float deltatime)
 {
+	Camera& debugCamera = m_cameraSystem.GetDebugCamera();
+	const InputSystem* input = InputSystem::GetInstance();
+
 	// Move the camera with the WASD keys
-	if (GetAsyncKeyState(87) & 0xFFFF) // W
+	if (input->IsActionDown(Action_MoveForward))
 	{
 		m_WState = Key_DOWN;
-		m_debugCamera.AddToPosition((m_debugCamera.GetForwardVector() * m_cameraSpeed) * deltatime);
+		debugCamera.AddToPosition((debugCamera.GetForwardVector() * m_cameraSpeed) * deltatime);
 	}
-	if (GetAsyncKeyState(83) & 0xFFFF) // S
+	if (input->IsActionDown(Action_MoveBack))
 	{
 		m_SState = Key_DOWN;
-		m_debugCamera.AddToPosition((m_debugCamera.GetBackVector() * m_cameraSpeed) * deltatime);
+		debugCamera.AddToPosition((debugCamera.GetBackVector() * m_cameraSpeed) * deltatime);
 	}
-	if (GetAsyncKeyState(65) & 0xFFFF) // A
+	if (input->IsActionDown(Action_MoveLeft))
 	{
 		m_AState = Key_DOWN;
-		m_debugCamera.AddToPosition((m_debugCamera.GetLeftVector() * m_cameraSpeed) * deltatime);
+		debugCamera.AddToPosition((debugCamera.GetLeftVector() * m_cameraSpeed) * deltatime);
 	}
-	if (GetAsyncKeyState(68) & 0xFFFF) // D
+	if (input->IsActionDown(Action_MoveRight))
 	{
 		m_DState = Key_DOWN;
-		m_debugCamera.AddToPosition((m_debugCamera.GetRightVector() * m_cameraSpeed) * deltatime);
+		debugCamera.AddToPosition((debugCamera.GetRightVector() * m_cameraSpeed) * deltatime);
 	}
-	if (GetAsyncKeyState(81) & 0xFFFF) // Q
+	if (input->IsActionDown(Action_MoveUp))
 	{
 		m_QState = Key_DOWN;
-		m_debugCamera.AddToPosition(0.0f, m_cameraSpeed * deltatime, 0.0f);
+		debugCamera.AddToPosition(0.0f, m_cameraSpeed * deltatime, 0.0f);
 	}
-	if (GetAsyncKeyState(69) & 0xFFFF) // E
+	if (input->IsActionDown(Action_MoveDown))
 	{
 		m_EState = Key_DOWN;
-		m_debugCamera.AddToPosition(0, -m_cameraSpeed * deltatime, 0);
+		debugCamera.AddToPosition(0, -m_cameraSpeed * deltatime, 0);
 	}
-	if (GetAsyncKeyState(82) & 0xFFFF) // R
+	if (input->IsActionDown(Action_ResetCamera))
 	{
 		m_cbData.waveFilter = 0;
 		m_nobackfaceCulling = false;
 		m_fill = true;
-		m_cameraNumActive = 0;
+		m_cameraSystem.SetActive(0);
 		m_cbData.LightON = 1;
 		m_cbData.hasTexture = 1;
 		m_rotate = false;
 		m_fill = true;
 		m_textRendering = true;
-		m_debugCamera.SetPosition(m_startingCameraPosition.x, m_startingCameraPosition.y, m_startingCameraPosition.z);
-		m_debugCamera.SetRotation(0, 0, 0);
+		debugCamera.SetPosition(m_startingCameraPosition.x, m_startingCameraPosition.y, m_startingCameraPosition.z);
+		debugCamera.SetRotation(0, 0, 0);
 	}
 
 	// Rotate the camera with the arrow keys
-	if (GetAsyncKeyState(VK_UP) & 0xFFFF)
+	if (input->IsActionDown(Action_LookUp))
 	{
 		m_UPState = Key_DOWN;
-		m_debugCamera.AddToRotation(-m_rotationSpeed * deltatime, 0.0f, 0.0f);
+		debugCamera.AddToRotation(-m_rotationSpeed * deltatime, 0.0f, 0.0f);
 	}
-	if (GetAsyncKeyState(VK_DOWN) & 0xFFFF)
+	if (input->IsActionDown(Action_LookDown))
 	{
 		m_DOWNState = Key_DOWN;
-		m_debugCamera.AddToRotation(m_rotationSpeed * deltatime, 0.0f, 0.0f);
+		debugCamera.AddToRotation(m_rotationSpeed * deltatime, 0.0f, 0.0f);
 	}
-	if (GetAsyncKeyState(VK_LEFT) & 0xFFFF)
+	if (input->IsActionDown(Action_LookLeft))
 	{
 		m_LEFTState = Key_DOWN;
-		m_debugCamera.AddToRotation(0.0f, -m_rotationSpeed * deltatime, 0.0f);
+		debugCamera.AddToRotation(0.0f, -m_rotationSpeed * deltatime, 0.0f);
 	}
-	if (GetAsyncKeyState(VK_RIGHT) & 0xFFFF)
+	if (input->IsActionDown(Action_LookRight))
 	{
 		m_RIGHTState = Key_DOWN;
-		m_debugCamera.AddToRotation(0.0f, m_rotationSpeed * deltatime, 0.0f);
+		debugCamera.AddToRotation(0.0f, m_rotationSpeed * deltatime, 0.0f);
 	}
 
 	// Activate mouse features
-	if (GetAsyncKeyState(VK_F9) & 0x0001)
+	if (input->WasActionPressed(Action_ToggleMouseLook))
 	{
 		if (m_mouseMode)
 		{
@@ -1599,197 +1963,149 @@ void DX11Framework::HandleDebugMovement(float deltatime)
 
 	if (m_mouseMode)
 	{
-		// Find the change in mouse position
-		float deltaX = (g_mouseX - g_lastMouseX) * (0.1 * deltatime);
-		float deltaY = (g_mouseY - g_lastMouseY) * (0.1 * deltatime);
+		// Raw mouse motion, so the look speed does not depend on the frame rate or the pointer settings
+		float deltaX = input->GetMouseDeltaX() * m_mouseSensitivity;
+		float deltaY = input->GetMouseDeltaY() * m_mouseSensitivity;
 
-		// Add the change to the camera rotation
-		if (abs(g_mouseX - g_lastMouseX) > m_deadZone || abs(g_mouseY - g_lastMouseY) > m_deadZone)
+		if (deltaX != 0.0f || deltaY != 0.0f)
 		{
-			m_debugCamera.AddToRotation(deltaY, deltaX, 0.0f);
+			debugCamera.AddToRotation(deltaY, deltaX, 0.0f);
 
-			g_lastMouseX = 960;
-			g_lastMouseY = 540;
+			// Keep the hidden cursor in the middle of the screen, so a click never lands outside the window
 			SetCursorPos(960, 540);
 		}
 
-		// Move the camera with the mouse wheel
-		if (g_mouseWheelUP)
-		{
-			m_debugCamera.AddToPosition(m_debugCamera.GetForwardVector() * 1);
-			g_mouseWheelUP = false;
-		}
-		if (g_mouseWheelDOWN)
+		// Move the camera with the mouse wheel, one unit a notch
+		if (input->GetWheelDelta() != 0)
 		{
-			m_debugCamera.AddToPosition(m_debugCamera.GetBackVector() * 1);
-			g_mouseWheelDOWN = false;
+			debugCamera.AddToPosition(debugCamera.GetForwardVector() *
+				(static_cast<float>(input->GetWheelDelta()) / WHEEL_DELTA));
 		}
 	}
 }
 
 void DX11Framework::UpdatePipelineVariables(UINT stride, UINT offset)
 {
+	PROFILE_FUNCTION();
+
 	// Present unbinds render target, so rebind and clear at the start of each frame
 	float backgroundColor[4] = { 0.025f, 0.025f, 0.095f, 1.0f };
-	m_immediateContext->OMSetRenderTargets(1, &m_frameBufferView, m_depthStencilView);
-	m_immediateContext->ClearRenderTargetView(m_frameBufferView, backgroundColor);
-	m_immediateContext->ClearDepthStencilView(m_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
+	m_renderContext->OMSetRenderTargets(1, &m_frameBufferView, m_depthStencilView);
+	m_renderContext->ClearRenderTargetView(m_frameBufferView, backgroundColor);
+	m_renderContext->ClearDepthStencilView(m_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 
-	if (m_debugCamera.GetPosition().z > 0)
+	const Camera& debugCamera = m_cameraSystem.GetDebugCamera();
+	if (debugCamera.GetPosition().z > 0)
 	{
 		m_cbData.CameraPosition = m_startingCameraPosition;
 	}
-	else if (m_debugCamera.GetPosition().z < 0)
-	{
-		m_cbData.CameraPosition = m_debugCamera.GetPosition();
-	}
-
-	// Update the active camera
-	switch (m_cameraNumActive)
+	else if (debugCamera.GetPosition().z < 0)
 	{
-	case 0:
-		// Use the debug camera
-		XMStoreFloat4x4(&m_View, m_debugCamera.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_debugCamera.GetProjectionMatrix());
-		break;
-
-	case 1:
-		// Camera 1
-		m_debugCamera.SetPosition(m_camera1.GetPosition().x, m_camera1.GetPosition().y, m_camera1.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera1.GetRotation().x, m_camera1.GetRotation().y, m_camera1.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera1.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera1.GetProjectionMatrix());
-		break;
-
-	case 2:
-		// Camera 2
-		m_debugCamera.SetPosition(m_camera2.GetPosition().x, m_camera2.GetPosition().y, m_camera2.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera2.GetRotation().x, m_camera2.GetRotation().y, m_camera2.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera2.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera2.GetProjectionMatrix());
-		break;
-
-	case 3:
-		// Camera 3
-		m_debugCamera.SetPosition(m_camera3.GetPosition().x, m_camera3.GetPosition().y, m_camera3.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera3.GetRotation().x, m_camera3.GetRotation().y, m_camera3.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera3.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera3.GetProjectionMatrix());
-		break;
-
-	case 4:
-		// Camera 4
-		m_debugCamera.SetPosition(m_camera4.GetPosition().x, m_camera4.GetPosition().y, m_camera4.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera4.GetRotation().x, m_camera4.GetRotation().y, m_camera4.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera4.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera4.GetProjectionMatrix());
-		break;
-
-	case 5:
-		// Camera 5
-		m_debugCamera.SetPosition(m_camera5.GetPosition().x, m_camera5.GetPosition().y, m_camera5.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera5.GetRotation().x, m_camera5.GetRotation().y, m_camera5.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera5.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera5.GetProjectionMatrix());
-		break;
-
-	case 6:
-		// Camera 6
-		m_debugCamera.SetPosition(m_camera6.GetPosition().x, m_camera6.GetPosition().y, m_camera6.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera6.GetRotation().x, m_camera6.GetRotation().y, m_camera6.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera6.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera6.GetProjectionMatrix());
-		break;
-
-	case 7:
-		// Camera 7
-		m_debugCamera.SetPosition(m_camera7.GetPosition().x, m_camera7.GetPosition().y, m_camera7.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera7.GetRotation().x, m_camera7.GetRotation().y, m_camera7.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera7.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera7.GetProjectionMatrix());
-		break;
-
-	case 8:
-		// Camera 8
-		m_debugCamera.SetPosition(m_camera8.GetPosition().x, m_camera8.GetPosition().y, m_camera8.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera8.GetRotation().x, m_camera8.GetRotation().y, m_camera8.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera8.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera8.GetProjectionMatrix());
-		break;
-
-	case 9:
-		// Camera 9
-		m_debugCamera.SetPosition(m_camera9.GetPosition().x, m_camera9.GetPosition().y, m_camera9.GetPosition().z);
-		m_debugCamera.SetRotation(m_camera9.GetRotation().x, m_camera9.GetRotation().y, m_camera9.GetRotation().z);
-		XMStoreFloat4x4(&m_View, m_camera9.GetViewMatrix());
-		XMStoreFloat4x4(&m_Projection, m_camera9.GetProjectionMatrix());
-		break;
-
-	default:
-
-		break;
+		m_cbData.CameraPosition = debugCamera.GetPosition();
 	}
 
-	// Update the view and projection matrices
-	m_cbData.View = XMMatrixTranspose(XMLoadFloat4x4(&m_View));
-	m_cbData.Projection = XMMatrixTranspose(XMLoadFloat4x4(&m_Projection));
+	// Update the view and projection matrices from the active camera, switching cameras only changed which one this
+	// reads, and the camera only rebuilds them if it moved
+	const CameraShaderMatrices& cameraMatrices = m_cameraSystem.GetActiveCamera().GetShaderMatrices();
+	m_cbData.View = cameraMatrices.View;
+	m_cbData.Projection = cameraMatrices.Projection;
 
 	// Update the rasterizer state
 	if (m_fill)
 	{
-		m_immediateContext->RSSetState(m_fillState);
+		m_renderContext->RSSetState(m_fillState);
 	}
 	else if (!m_fill && !m_nobackfaceCulling)
 	{
-		m_immediateContext->RSSetState(m_wireframeState);
+		m_renderContext->RSSetState(m_wireframeState);
 	}
 	else if (!m_fill && m_nobackfaceCulling)
 	{
-		m_immediateContext->RSSetState(m_dontCullBackState);
+		m_renderContext->RSSetState(m_dontCullBackState);
 	}
 
 	// Write constant buffer data onto GPU
-	m_immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	m_immediateContext->IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &offset);
-	m_immediateContext->IASetIndexBuffer(m_indexBuffer, DXGI_FORMAT_R16_UINT, 0);
-	m_immediateContext->IASetInputLayout(m_inputLayout);
-	m_immediateContext->VSSetConstantBuffers(0, 1, &m_constantBuffer);
-	m_immediateContext->PSSetConstantBuffers(0, 1, &m_constantBuffer);
-	m_immediateContext->VSSetShader(m_vertexShader, nullptr, 0);
-	m_immediateContext->PSSetShader(m_pixelShader, nullptr, 0);
-	m_immediateContext->PSSetSamplers(0, 1, &m_bilinearSamplerState);
-	m_immediateContext->PSSetShaderResources(0, 1, &m_crateTexture);
-	m_immediateContext->PSSetShaderResources(1, 1, &m_ryanlabsTexture);
-
-	m_immediateContext->RSSetViewports(1, &m_viewport);
+	m_renderContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	m_renderContext->IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &offset);
+	m_renderContext->IASetIndexBuffer(m_indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+	m_renderContext->IASetInputLayout(m_inputLayout);
+	m_renderContext->VSSetConstantBuffers(0, 1, &m_constantBuffer);
+	m_renderContext->PSSetConstantBuffers(0, 1, &m_constantBuffer);
+	m_renderContext->VSSetShader(m_vertexShader, nullptr, 0);
+	m_renderContext->PSSetShader(m_pixelShader, nullptr, 0);
+	m_renderContext->PSSetSamplers(0, 1, &m_bilinearSamplerState);
+	m_renderContext->PSSetShaderResources(0, 1, &m_crateTexture);
+	m_renderContext->PSSetShaderResources(1, 1, &m_ryanlabsTexture);
+
+	m_renderContext->RSSetViewports(1, &m_viewport);
 	// Render the scene as opaque by default
 	RenderOpaque();
-	m_immediateContext->OMSetDepthStencilState(nullptr, 0);
+	m_renderContext->OMSetDepthStencilState(nullptr, 0);
 }
 
 void DX11Framework::Update()
 {
-	//Static initializes this value only once
-	static ULONGLONG frameStart = GetTickCount64();
+	// Everything allocated from the frame arena two frames ago is released here
+	FrameArena::GetInstance()->BeginFrame();
+	MemoryTracker::GetInstance()->BeginFrame();
+	CounterRegistry::GetInstance()->BeginFrame();
+	PROFILE_BEGIN_FRAME();
+	PROFILE_FUNCTION();
 
-	// Get the time that has passed since the last frame
-	ULONGLONG frameNow = GetTickCount64();
-	float deltaTime = (frameNow - frameStart) / 1000.0f;
-	frameStart = frameNow;
+	// Everything the window received since the last update is handled now, before anything reads the input
+	InputSystem* input = InputSystem::GetInstance();
+	double inputTime = m_clock.GetSeconds();
 
-	static float _angle = 0.0f;
-	_angle += deltaTime;
+	// A replay takes the input and the clock reading of the recorded update instead
+	if (m_replayingInput && !m_inputReplayer.IsFinished())
+	{
+		m_replayClock.SetSeconds(m_inputReplayer.BeginFrame(input).ClockTime);
+	}
+	else
+	{
+		input->BeginFrame(inputTime);
+	}
+
+	// Holds the longest wait of the last frame that had any input, so the HUD does not drop to zero between presses
+	if (input->GetLatency().EventCount > 0)
+	{
+		CounterRegistry::GetInstance()->Set(m_inputLatencyCounter, input->GetLatency().Max * 1000.0);
+	}
+
+	// Heap in use is sampled once a frame, the rest of the counters are published by the draw code
+	CounterRegistry::GetInstance()->Set(Counter_MemoryInUse,
+		static_cast<double>(MemoryTracker::GetInstance()->GetTotalStats().CurrentBytes));
+
+	// Benchmarks step a fixed time every frame so every run animates the scene the same way
+	if (m_benchmarking)
+	{
+		m_benchmarkClock.Advance(m_benchmarkScript.Timestep);
+	}
+
+	// Animation advances in fixed steps, the camera still moves by the real frame time
+	UINT simulationSteps = m_simulationLoop.BeginFrame();
+	float deltaTime = static_cast<float>(m_simulationLoop.GetFrameTime());
+	float timestep = static_cast<float>(m_simulationLoop.GetTimestep());
+
+	for (UINT step = 0; step < simulationSteps; step++)
+	{
+		m_previousSimulationAngle = m_simulationAngle;
+		m_simulationAngle += timestep;
+		m_timeRunning += timestep;
+	}
 
-	m_timeRunning += deltaTime;
+	// Blend between the last two steps so the motion is smooth at any frame rate
+	float _angle = m_previousSimulationAngle + (m_simulationAngle - m_previousSimulationAngle) *
+		m_simulationLoop.GetAlpha();
 	m_cbData.count = _angle;
 
 	// Rotate the main menu object
 	m_mainMenuObject->SetRotation(90, -_angle, -_angle);
 
 	// Rotate the skybox and move it with the camera
-	m_skybox->SetPosition(m_debugCamera.GetPosition().x, m_debugCamera.GetPosition().y, m_debugCamera.GetPosition().z);
-	m_skybox->SetRotation(m_skybox->GetRotation().x + 0.1 * deltaTime, m_skybox->GetRotation().y + 0.1 * deltaTime,
-		m_skybox->GetRotation().z + 0.1 * deltaTime);
+	XMFLOAT3 debugPosition = m_cameraSystem.GetDebugCamera().GetPosition();
+	m_skybox->SetPosition(debugPosition.x, debugPosition.y, debugPosition.z);
+	m_skybox->SetRotation(0.1f * _angle, 0.1f * _angle, 0.1f * _angle);
 
 	// Sending it to hell because it's the worst
 	XMStoreFloat4x4(&m_terrain->m_matrix, XMMatrixIdentity() * XMMatrixTranslation(666, 666, 666));
@@ -1797,7 +2113,7 @@ void DX11Framework::Update()
 	if (m_mainMenu == false)
 	{
 		// Stop/Start Filling the cube by pressing F3
-		if (GetAsyncKeyState(VK_F3) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleFill))
 		{
 			if (m_fill)
 			{
@@ -1810,7 +2126,7 @@ void DX11Framework::Update()
 			}
 		}
 		// Stop/Start Backface Culling by pressing F6
-		if (GetAsyncKeyState(VK_F6) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleBackfaceCulling))
 		{
 			if (m_nobackfaceCulling)
 			{
@@ -1824,7 +2140,7 @@ void DX11Framework::Update()
 		}
 
 		// Stop/Start Wave Filter the cube by pressing F7
-		if (GetAsyncKeyState(VK_F7) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleWaveFilter))
 		{
 			if (m_cbData.waveFilter == 1)
 			{
@@ -1837,7 +2153,7 @@ void DX11Framework::Update()
 		}
 
 		// Stop/Start Wave Filter X the cube by pressing F7
-		if (GetAsyncKeyState(VK_F8) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleWaveFilterX))
 		{
 			if (m_cbData.waveFilterX == 1)
 			{
@@ -1850,7 +2166,7 @@ void DX11Framework::Update()
 		}
 
 		// Stop/Start Pixelate Filter the cube by pressing TAB
-		if (GetAsyncKeyState(VK_TAB) & 0x0001)
+		if (input->WasActionPressed(Action_TogglePixelate))
 		{
 			if (m_cbData.pixelateFilter == 1)
 			{
@@ -1862,7 +2178,7 @@ void DX11Framework::Update()
 			}
 		}
 		// Stop/Start Gooch Shader the cube by pressing F11
-		if (GetAsyncKeyState(VK_F11) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleGoochShading))
 		{
 			if (m_cbData.goochShading == 1)
 			{
@@ -1879,7 +2195,7 @@ void DX11Framework::Update()
 		}
 
 		// Stop/Start Light by pressing F2
-		if (GetAsyncKeyState(VK_F2) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleLighting))
 		{
 			if (m_cbData.LightON == 1)
 			{
@@ -1892,7 +2208,7 @@ void DX11Framework::Update()
 		}
 
 		// Stop/Start Texture by pressing F1
-		if (GetAsyncKeyState(VK_F1) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleTexture))
 		{
 			if (m_cbData.hasTexture == 1)
 			{
@@ -1904,7 +2220,7 @@ void DX11Framework::Update()
 			}
 		}
 		///////////////////////////////////////////////////////////
-		if (GetAsyncKeyState(VK_F5) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleUI))
 		{
 			if (m_textRendering)
 			{
@@ -1916,26 +2232,38 @@ void DX11Framework::Update()
 			}
 		}
 
+		// Show/Hide the performance HUD by pressing F10
+		if (input->WasActionPressed(Action_TogglePerformanceHUD))
+		{
+			m_performanceHUD.SetVisible(!m_performanceHUD.IsVisible());
+		}
+
+		// Show every camera at once as a monitor wall by pressing M
+		if (input->WasActionPressed(Action_ToggleMonitorWall))
+		{
+			SetViewCount(m_viewCount > 1 ? 1 : m_cameraSystem.GetCameraCount());
+		}
+
 		// Stop/Start Rotating the cube by pressing F4
-		if (GetAsyncKeyState(VK_F4) & 0x0001)
+		if (input->WasActionPressed(Action_ToggleRotation))
 		{
 			if (m_rotate)
 			{
 				m_nobackfaceCulling = false;
 				m_fill = true;
 				m_rotate = false;
-				m_debugCamera.SetPosition(m_startingCameraPosition.x, m_startingCameraPosition.y,
+				m_cameraSystem.GetDebugCamera().SetPosition(m_startingCameraPosition.x, m_startingCameraPosition.y,
 					m_startingCameraPosition.z);
-				m_debugCamera.SetRotation(0, 0, 0);
+				m_cameraSystem.GetDebugCamera().SetRotation(0, 0, 0);
 			}
 			else
 			{
 				m_nobackfaceCulling = false;
 				m_fill = true;
 				m_rotate = true;
-				m_debugCamera.SetPosition(m_startingCameraPosition.x, m_startingCameraPosition.y,
+				m_cameraSystem.GetDebugCamera().SetPosition(m_startingCameraPosition.x, m_startingCameraPosition.y,
 					m_startingCameraPosition.z);
-				m_debugCamera.SetRotation(0, 0, 0);
+				m_cameraSystem.GetDebugCamera().SetRotation(0, 0, 0);
 			}
 		}
 
@@ -1953,11 +2281,11 @@ void DX11Framework::Update()
 			// Rotate some of the game objects
 			for (const auto& gameObject : m_gameObjects)
 			{
-				if (gameObject->m_Name == "Airplane")
+				if (gameObject->GetName() == "Airplane")
 				{
 					gameObject->SetRotation(0, -_angle, 0);
 				}
-				else if (gameObject->m_Name == "Car")
+				else if (gameObject->GetName() == "Car")
 				{
 					gameObject->SetRotation(-_angle, -_angle, 0);
 				}
@@ -1984,12 +2312,12 @@ void DX11Framework::Update()
 			// Rotate some of the game objects
 			for (const auto& gameObject : m_gameObjects)
 			{
-				if (gameObject->m_Name == "Airplane")
+				if (gameObject->GetName() == "Airplane")
 				{
 					gameObject->SetRotation(0, 0, 0);
 				}
 
-				else if (gameObject->m_Name == "Car")
+				else if (gameObject->GetName() == "Car")
 				{
 					gameObject->SetRotation(-_angle, -_angle, 0);
 				}
@@ -2005,19 +2333,19 @@ void DX11Framework::Update()
 		}
 
 		// Reset the filters and go back to the main menu
-		if (GetAsyncKeyState(VK_ESCAPE) & 0x0001)
+		if (input->WasActionPressed(Action_Back))
 		{
 			m_mainMenu = true;
-			m_debugCamera.SetPosition(m_startingCameraPosition.x, m_startingCameraPosition.y,
+			m_cameraSystem.GetDebugCamera().SetPosition(m_startingCameraPosition.x, m_startingCameraPosition.y,
 				m_startingCameraPosition.z);
-			m_debugCamera.SetRotation(0, 0, 0);
+			m_cameraSystem.GetDebugCamera().SetRotation(0, 0, 0);
 			m_cbData.pixelateFilter = 0;
 			m_cbData.goochShading = 0;
 			m_cbData.waveFilterX = 0;
 			m_cbData.waveFilter = 0;
 			m_nobackfaceCulling = false;
 			m_fill = true;
-			m_cameraNumActive = 0;
+			m_cameraSystem.SetActive(0);
 			m_cbData.LightON = 1;
 			m_cbData.hasTexture = 1;
 			m_rotate = false;
@@ -2026,13 +2354,13 @@ void DX11Framework::Update()
 		}
 
 		// Change the active camera by pressing the number keys
-		if (GetAsyncKeyState(VK_NUMPAD0) & 0xFFFF)
+		if (input->WasActionPressed(Action_Camera0))
 		{
-			m_cameraNumActive = 0;
+			m_cameraSystem.SetActive(0);
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD1) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera1))
 		{
-			m_cameraNumActive = 1;
+			m_cameraSystem.ActivateHotkey(1);
 			m_nobackfaceCulling = false;
 			m_fill = true;
 			m_cbData.waveFilter = 0;
@@ -2040,9 +2368,9 @@ void DX11Framework::Update()
 			m_cbData.goochShading = 0;
 			m_cbData.pixelateFilter = 0;
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD3) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera3))
 		{
-			m_cameraNumActive = 2;
+			m_cameraSystem.ActivateHotkey(3);
 			m_nobackfaceCulling = true;
 			m_fill = false;
 			m_cbData.waveFilter = 1;
@@ -2050,9 +2378,9 @@ void DX11Framework::Update()
 			m_cbData.goochShading = 0;
 			m_cbData.pixelateFilter = 0;
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD2) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera2))
 		{
-			m_cameraNumActive = 3;
+			m_cameraSystem.ActivateHotkey(2);
 			m_cbData.waveFilterX = 1;
 			m_cbData.waveFilter = 0;
 			m_nobackfaceCulling = false;
@@ -2060,9 +2388,9 @@ void DX11Framework::Update()
 			m_cbData.pixelateFilter = 0;
 			m_fill = true;
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD4) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera4))
 		{
-			m_cameraNumActive = 4;
+			m_cameraSystem.ActivateHotkey(4);
 			m_nobackfaceCulling = true;
 			m_cbData.waveFilter = 0;
 			m_cbData.waveFilterX = 0;
@@ -2070,9 +2398,9 @@ void DX11Framework::Update()
 			m_cbData.pixelateFilter = 0;
 			m_fill = false;
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD5) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera5))
 		{
-			m_cameraNumActive = 5;
+			m_cameraSystem.ActivateHotkey(5);
 			m_nobackfaceCulling = false;
 			m_cbData.waveFilter = 0;
 			m_cbData.waveFilterX = 0;
@@ -2080,9 +2408,9 @@ void DX11Framework::Update()
 			m_cbData.pixelateFilter = 0;
 			m_fill = true;
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD6) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera6))
 		{
-			m_cameraNumActive = 6;
+			m_cameraSystem.ActivateHotkey(6);
 			m_nobackfaceCulling = true;
 			m_cbData.waveFilter = 0;
 			m_cbData.waveFilterX = 0;
@@ -2090,9 +2418,9 @@ void DX11Framework::Update()
 			m_cbData.pixelateFilter = 0;
 			m_fill = false;
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD7) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera7))
 		{
-			m_cameraNumActive = 7;
+			m_cameraSystem.ActivateHotkey(7);
 			m_nobackfaceCulling = false;
 			m_cbData.waveFilter = 0;
 			m_cbData.waveFilterX = 0;
@@ -2100,9 +2428,9 @@ void DX11Framework::Update()
 			m_cbData.pixelateFilter = 0;
 			m_fill = true;
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD8) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera8))
 		{
-			m_cameraNumActive = 8;
+			m_cameraSystem.ActivateHotkey(8);
 			m_nobackfaceCulling = false;
 			m_cbData.waveFilter = 0;
 			m_cbData.waveFilterX = 0;
@@ -2110,9 +2438,9 @@ void DX11Framework::Update()
 			m_cbData.pixelateFilter = 1;
 			m_fill = true;
 		}
-		else if (GetAsyncKeyState(VK_NUMPAD9) & 0xFFFF)
+		else if (input->WasActionPressed(Action_Camera9))
 		{
-			m_cameraNumActive = 9;
+			m_cameraSystem.ActivateHotkey(9);
 			m_nobackfaceCulling = false;
 			m_cbData.waveFilter = 0;
 			m_cbData.waveFilterX = 0;
@@ -2121,7 +2449,17 @@ void DX11Framework::Update()
 			m_fill = false;
 		}
 
-		if (m_cameraNumActive == 0)
+		// Page Up and Page Down step through every camera, including any past the number keys
+		if (input->WasActionPressed(Action_NextCamera))
+		{
+			m_cameraSystem.CycleActive(1);
+		}
+		else if (input->WasActionPressed(Action_PreviousCamera))
+		{
+			m_cameraSystem.CycleActive(-1);
+		}
+
+		if (m_cameraSystem.IsDebugCameraActive())
 		{
 			// I should move this to the camera class, but it was a little tricky parsing UI side of things,
 			// so for now, I'm just going to leave it here.
@@ -2131,7 +2469,7 @@ void DX11Framework::Update()
 	else
 	{
 		// Main Menu Control Logic
-		if (GetAsyncKeyState(VK_LEFT) & 0x0001)
+		if (input->WasActionPressed(Action_MenuLeft))
 		{
 			if (m_start == false && m_playVideo == false)
 			{
@@ -2142,7 +2480,7 @@ void DX11Framework::Update()
 				m_playVideo = false;
 			}
 		}
-		if (GetAsyncKeyState(VK_RIGHT) & 0x0001)
+		if (input->WasActionPressed(Action_MenuRight))
 		{
 			if (m_start == false && m_playVideo == false)
 			{
@@ -2154,7 +2492,7 @@ void DX11Framework::Update()
 				m_start = false;
 			}
 		}
-		if (GetAsyncKeyState(VK_RETURN) & 0x0001)
+		if (input->WasActionPressed(Action_MenuSelect))
 		{
 			if (m_start)
 			{
@@ -2177,17 +2515,215 @@ void DX11Framework::Update()
 			}
 		}
 
-		if (GetAsyncKeyState(VK_ESCAPE) & 0x0001)
+		if (input->WasActionPressed(Action_Back))
 		{
 			PostQuitMessage(0);
 		}
 	}
+
+	// Benchmarks keep the debug camera on the scripted path, whatever keys are pressed
+	if (m_benchmarking)
+	{
+		XMFLOAT3 pathPosition;
+		XMFLOAT3 pathRotation;
+		m_benchmarkScript.Path.Evaluate(m_benchmarkFrame * m_benchmarkScript.Timestep, pathPosition, pathRotation);
+
+		m_mainMenu = false;
+		m_cameraSystem.SetActive(0);
+		m_cameraSystem.GetDebugCamera().SetPosition(pathPosition.x, pathPosition.y, pathPosition.z);
+		m_cameraSystem.GetDebugCamera().SetRotation(pathRotation.x, pathRotation.y, pathRotation.z);
+
+		m_benchmarkFrame++;
+	}
+
+	// Record what this update did, or check the replay did the same
+	if (m_recordingInput)
+	{
+		m_inputRecording.AddFrame(m_simulationLoop.GetClockTime(), inputTime, input->GetFrameEvents(),
+			CaptureFrameState());
+	}
+	else if (m_replayingInput && !m_inputReplayer.IsFinished())
+	{
+		m_inputReplayer.EndFrame(CaptureFrameState());
+	}
+
+	// Rebuild the world matrices of everything that moved this frame, static objects are skipped
+	TransformStore::GetInstance()->UpdateDirtyTransforms();
+}
+#pragma endregion
+
+#pragma region Timing Methods
+bool DX11Framework::WaitIfIdle()
+{
+	FramePacingState state = { g_windowMinimized && !m_headless, m_occluded, g_windowFocused || m_headless,
+		m_mainMenu, m_benchmarking };
+	FramePacingDecision decision = m_framePacingPolicy.Decide(state);
+
+	if (decision.Render)
+	{
+		m_frameLimiter.SetTargetRate(decision.TargetRate);
+		return false;
+	}
+
+	PROFILE_SCOPE("Idle");
+
+	if (!decision.Poll)
+	{
+		WaitMessage();
+		return true;
+	}
+
+	if (decision.TargetRate > 0.0)
+	{
+		m_clock.SleepFor(1.0 / decision.TargetRate);
+	}
+
+	// Test present draws nothing, it only says whether the window can be seen again
+	m_occluded = m_swapChain->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED;
+
+	return true;
+}
+#pragma endregion
+
+#pragma region Benchmark Methods
+HRESULT DX11Framework::StartBenchmark(const std::string& scriptPath, UINT viewCount)
+{
+	if (!LoadBenchmarkScript(scriptPath, m_benchmarkScript))
+	{
+		return E_FAIL;
+	}
+
+	if (viewCount > 0)
+	{
+		m_benchmarkScript.Views = viewCount;
+	}
+	SetViewCount(m_benchmarkScript.Views);
+
+	// Same starting state as picking start on the main menu
+	m_cbData.waveFilter = 0;
+	m_cbData.LightON = 1;
+	m_cbData.hasTexture = 1;
+	m_rotate = false;
+	m_fill = true;
+	m_textRendering = true;
+	m_mainMenu = false;
+	m_cameraSystem.SetActive(0);
+
+	m_benchmarking = true;
+	m_benchmarkFrame = 0;
+	m_terrainVisibility.clear();
+	m_terrainVisibility.reserve(m_benchmarkScript.Frames);
+	m_simulationLoop.SetClock(&m_benchmarkClock);
+
+	return S_OK;
+}
+
+HRESULT DX11Framework::WriteTerrainVisibility(const std::string& path) const
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+	{
+		std::cerr << "Failed to open " << path << " for the terrain visibility." << std::endl;
+		return E_FAIL;
+	}
+
+	file << "frame,camera_x,camera_y,camera_z,nodes,triangles,visible_chunks,total_chunks,visible_percent\n";
+	file << std::fixed << std::setprecision(2);
+
+	for (size_t frame = 0; frame < m_terrainVisibility.size(); frame++)
+	{
+		const TerrainVisibilitySample& sample = m_terrainVisibility[frame];
+
+		// A frame without terrain has no share to report
+		if (sample.Stats.TotalChunks == 0)
+		{
+			continue;
+		}
+
+		file << frame << ',' << sample.CameraPosition.x << ',' << sample.CameraPosition.y << ','
+			<< sample.CameraPosition.z << ',' << sample.Stats.Nodes << ',' << sample.Stats.Triangles << ','
+			<< sample.Stats.VisibleChunks << ',' << sample.Stats.TotalChunks << ','
+			<< 100.0 * sample.Stats.VisibleChunks / sample.Stats.TotalChunks << '\n';
+	}
+
+	return S_OK;
+}
+#pragma endregion
+
+#pragma region Recording Methods
+void DX11Framework::StartInputRecording()
+{
+	m_inputRecording.Clear();
+	m_recordingInput = true;
+
+	// The first recorded update starts the simulation clock, as the first replayed one will
+	m_simulationLoop.Reset();
+}
+
+HRESULT DX11Framework::StopInputRecording(const std::string& path)
+{
+	m_recordingInput = false;
+
+	return m_inputRecording.Write(path) ? S_OK : E_FAIL;
+}
+
+HRESULT DX11Framework::StartInputReplay(const std::string& path)
+{
+	if (!m_inputRecording.Read(path))
+	{
+		return E_FAIL;
+	}
+
+	m_recordingInput = false;
+	m_replayingInput = true;
+	m_inputReplayer.Start(&m_inputRecording);
+	m_simulationLoop.SetClock(&m_replayClock);
+
+	return S_OK;
+}
+
+RecordedFrameState DX11Framework::CaptureFrameState() const
+{
+	RecordedFrameState state = {};
+	state.ActiveCamera = m_cameraSystem.GetActiveIndex();
+
+	auto setToggle = [&state](RecordedToggle toggle, bool on)
+	{
+		if (on)
+		{
+			state.Toggles |= toggle;
+		}
+	};
+
+	setToggle(RecordedToggle_MainMenu, m_mainMenu);
+	setToggle(RecordedToggle_Fill, m_fill);
+	setToggle(RecordedToggle_NoBackfaceCulling, m_nobackfaceCulling);
+	setToggle(RecordedToggle_WaveFilter, m_cbData.waveFilter != 0);
+	setToggle(RecordedToggle_WaveFilterX, m_cbData.waveFilterX != 0);
+	setToggle(RecordedToggle_Pixelate, m_cbData.pixelateFilter != 0);
+	setToggle(RecordedToggle_GoochShading, m_cbData.goochShading != 0);
+	setToggle(RecordedToggle_Lighting, m_cbData.LightON != 0);
+	setToggle(RecordedToggle_Texture, m_cbData.hasTexture != 0);
+	setToggle(RecordedToggle_UI, m_textRendering);
+	setToggle(RecordedToggle_PerformanceHUD, m_performanceHUD.IsVisible());
+	setToggle(RecordedToggle_MonitorWall, m_viewCount > 1);
+	setToggle(RecordedToggle_Rotation, m_rotate);
+	setToggle(RecordedToggle_MouseLook, m_mouseMode);
+
+	return state;
 }
 #pragma endregion
 
 #pragma region Destructor
 DX11Framework::~DX11Framework()
 {
+	// The backends only borrow the device and context
+	delete m_renderContext;
+	m_renderContext = nullptr;
+	delete m_renderDevice;
+	m_renderDevice = nullptr;
+
 	// Check if the objects are not null before releasing them
 	if (m_immediateContext)
 	{
@@ -2389,10 +2925,28 @@ DX11Framework::~DX11Framework()
 		m_pyramidIndexBuffer->Release();
 		m_pyramidIndexBuffer = nullptr;
 	}
-	vsBlob->Release();
-	vsBlob = nullptr;
-	psBlob->Release();
-	psBlob = nullptr;
+	if (m_vertexShaderInstanced)
+	{
+		m_vertexShaderInstanced->Release();
+		m_vertexShaderInstanced = nullptr;
+	}
+	if (m_instancedInputLayout)
+	{
+		m_instancedInputLayout->Release();
+		m_instancedInputLayout = nullptr;
+	}
+	if (vsBlob)
+	{
+		vsBlob->Release();
+		vsBlob = nullptr;
+	}
+	if (psBlob)
+	{
+		psBlob->Release();
+		psBlob = nullptr;
+	}
+	delete m_instanceRenderer;
+	m_instanceRenderer = nullptr;
 	delete m_terrain;
 	m_terrain = nullptr;
 	delete m_mainMenuObject;
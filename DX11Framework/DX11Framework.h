@@ -2,8 +2,22 @@
 
 // Include{s}
 #include "GameObject.h"
-#include "Camera.h"
+#include "CameraSystem.h"
 #include "Terrain.h"
+#include "InstanceRenderer.h"
+#include "SceneBVH.h"
+#include "OcclusionCuller.h"
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "PerformanceHUD.h"
+#include "Benchmark.h"
+#include "D3D11RenderContext.h"
+#include "NullRenderContext.h"
+#include "FixedTimestepLoop.h"
+#include "HighResolutionClock.h"
+#include "FramePacingPolicy.h"
+#include "InputRecording.h"
 
 class DX11Framework
 {
@@ -12,6 +26,9 @@ public:
 	// Initializes the DX11 framework, including creating the window handle, D3D device, shaders, and buffers
 	HRESULT Initialise(HINSTANCE hInstance, int nCmdShow);
 
+	// Initializes the scene on the null backend, with no window, swap chain, shaders or UI
+	HRESULT InitialiseHeadless();
+
 	// Creates the window handle for the application
 	HRESULT CreateWindowHandle(HINSTANCE hInstance, int nCmdShow);
 
@@ -48,6 +65,9 @@ public:
 	// Initializes runtime data such as the gameobjects and lights
 	HRESULT InitRunTimeData();
 
+	// Sets the viewport and creates the per-frame constant buffer
+	HRESULT InitConstantBuffer();
+
 	// Loads UI components
 	HRESULT LoadUI(HRESULT hr);
 
@@ -75,6 +95,76 @@ public:
 	void UpdatePipelineVariables(UINT stride, UINT offset);
 #pragma endregion
 
+#pragma region Benchmark Methods
+	// Loads a benchmark script and skips the main menu, every update after this steps the fixed timestep and moves
+	// the debug camera along the scripted path. A view count other than zero replaces the one in the script
+	HRESULT StartBenchmark(const std::string& scriptPath, UINT viewCount = 0);
+
+	// Gets the running benchmark script
+	// Returns BenchmarkScript - The script
+	const BenchmarkScript& GetBenchmarkScript() const { return m_benchmarkScript; }
+
+	// Gets how much of the terrain the first view drew on each benchmark frame
+	// Returns std::vector<TerrainVisibilitySample> - One sample per frame, in the order they ran
+	const std::vector<TerrainVisibilitySample>& GetTerrainVisibility() const { return m_terrainVisibility; }
+
+	// Writes one row per benchmark frame with the camera position and the terrain chunks drawn
+	// Returns HRESULT - E_FAIL if the file could not be opened
+	HRESULT WriteTerrainVisibility(const std::string& path) const;
+
+	// Gets the null backend of a headless run
+	// Returns NullRenderContext* - The context, null when rendering through D3D11
+	const NullRenderContext* GetNullRenderContext() const
+	{
+		return m_headless ? static_cast<const NullRenderContext*>(m_renderContext) : nullptr;
+	}
+#pragma endregion
+
+#pragma region Recording Methods
+	// Starts recording the input, time and state of every update from the next one on
+	void StartInputRecording();
+
+	// Stops recording and writes out everything recorded
+	// Returns HRESULT - E_FAIL if the file could not be written
+	HRESULT StopInputRecording(const std::string& path);
+
+	// Loads a recording made from the start of a run, every update after this takes its input and clock readings
+	// from the recording instead, so the same frames are simulated again
+	HRESULT StartInputReplay(const std::string& path);
+
+	// Gets the state the last update left behind, the part of it a recording checks
+	// Returns RecordedFrameState - The active camera and toggles
+	RecordedFrameState CaptureFrameState() const;
+
+	// Gets the recording being made or replayed
+	// Returns InputRecording - The recording
+	const InputRecording& GetInputRecording() const { return m_inputRecording; }
+
+	// Gets how far the replay has got and how many frames did not match the recording
+	// Returns InputReplayer - The replayer
+	const InputReplayer& GetInputReplayer() const { return m_inputReplayer; }
+#pragma endregion
+
+#pragma region View Methods
+	// Sets how many cameras are drawn each frame. One fills the screen with the active camera, more tile the screen as
+	// a monitor wall showing the cameras in order, repeating them if there are more views than cameras
+	void SetViewCount(UINT viewCount);
+
+	// Gets how many cameras are drawn each frame
+	// Returns UINT - The view count
+	UINT GetViewCount() const { return m_viewCount; }
+#pragma endregion
+
+#pragma region Timing Methods
+	// Sets the frame rate cap while playing, zero turns the cap off. The menu and background caps still apply
+	void SetTargetFrameRate(double framesPerSecond) { m_framePacingPolicy.SetActiveRate(framesPerSecond); }
+
+	// Asks the pacing policy what the next frame does, sets the frame limiter's rate for it and waits instead when
+	// the window is minimized or covered
+	// Returns bool - True if the frame should be skipped
+	bool WaitIfIdle();
+#pragma endregion
+
 #pragma region Draw Methods
 	// Draws a UI key state indicator at a specific screen position
 	void DrawKey(KeyState state, ID3D11ShaderResourceView* texture, XMFLOAT2 position) const;
@@ -85,12 +175,30 @@ public:
 	// Draws the main menu UI
 	void DrawMainMenu() const;
 
-	// Renders the terrain
-	void RenderTerrain(UINT stride, UINT offset);
+	// Picks the terrain nodes for a view's camera and renders them
+	void RenderTerrain(UINT view);
 
 	// Renders the skybox
 	void RenderSkybox(UINT stride, UINT offset);
 
+	// Tests the game objects, hard coded shapes and terrain against the camera frustum, or against every camera of
+	// the monitor wall at once
+	void CullScene();
+
+	// Draws the visible objects and terrain of the current view
+	void RenderSceneView(UINT view);
+
+	// Sets the viewport and camera of one monitor wall tile and picks out the objects its camera sees
+	void BeginView(UINT view, UINT stride, UINT offset);
+
+	// Gets the camera a view shows
+	// Returns UINT - The camera index
+	UINT GetViewCamera(UINT view) const;
+
+	// Gets the number of tiles along each side of the monitor wall, 1 for a single view
+	// Returns UINT - The column count
+	UINT GetViewColumns() const;
+
 	// Draws the entire scene
 	void Draw();
 
@@ -129,17 +237,51 @@ private:
 	// Miscellaneous variables for angles, time, camera and speed settings
 	float m_tempAngle = 0.0f;
 	float m_timeRunning = 0.0f;
-	int m_cameraNumActive = 0;
 	const float m_cameraSpeed = 20.0f;
 	const float m_rotationSpeed = 1.0f;
-	const float m_deadZone = 50.0f;
+	const float m_mouseSensitivity = 0.002f;
+#pragma endregion
+
+#pragma region Timing Variables
+	// Animation is simulated in fixed steps on the high resolution clock and drawn blended between the last two
+	HighResolutionClock m_clock;
+	FixedTimestepLoop m_simulationLoop{ &m_clock, 1.0 / 120.0 };
+	FrameLimiter m_frameLimiter{ &m_clock };
+	FramePacingPolicy m_framePacingPolicy;
+	bool m_occluded = false;
+	float m_simulationAngle = 0.0f;
+	float m_previousSimulationAngle = 0.0f;
+#pragma endregion
+
+#pragma region Benchmark Variables
+	// Script of the running benchmark and the number of frames it has stepped
+	bool m_benchmarking = false;
+	size_t m_benchmarkFrame = 0;
+	BenchmarkScript m_benchmarkScript = {};
+	std::vector<TerrainVisibilitySample> m_terrainVisibility;
+
+	// Moved on by the script's timestep every frame, so a benchmark simulates the same steps on any machine
+	FakeClock m_benchmarkClock;
+
+	// Set when running on the null backend
+	bool m_headless = false;
+#pragma endregion
+
+#pragma region Recording Variables
+	// Input, clock readings and state of each update, being recorded or replayed
+	bool m_recordingInput = false;
+	bool m_replayingInput = false;
+	InputRecording m_inputRecording;
+	InputReplayer m_inputReplayer;
+
+	// Set to each recorded clock reading in turn, so a replay steps the simulation as the recording did
+	FakeClock m_replayClock;
 #pragma endregion
 
 #pragma region JSON Data Variables
 	// JSON objects for storing scene, light, and camera variables
 	nlohmann::json m_sceneData;
 	nlohmann::json m_lightVariables;
-	nlohmann::json m_sceneCameraVariables;
 #pragma endregion
 
 #pragma region Light Variables
@@ -163,6 +305,8 @@ private:
 	ID3D11DepthStencilView* m_depthStencilView = nullptr;
 	ID3D11DeviceContext* m_immediateContext = nullptr;
 	ID3D11Device* m_device = nullptr;
+	RenderDevice* m_renderDevice = nullptr;
+	RenderContext* m_renderContext = nullptr;
 	IDXGIDevice* m_dxgiDevice = nullptr;
 	IDXGIFactory2* m_dxgiFactory = nullptr;
 	ID3D11RenderTargetView* m_frameBufferView = nullptr;
@@ -174,9 +318,11 @@ private:
 	ID3D11VertexShader* m_vertexShader = nullptr;
 	ID3D11VertexShader* m_vertexShaderSkybox = nullptr;
 	ID3D11VertexShader* m_vertexShaderHeightmap = nullptr;
+	ID3D11VertexShader* m_vertexShaderInstanced = nullptr;
 	ID3D11DepthStencilState* m_depthStencilSkybox = nullptr;
 	ID3D11InputLayout* m_inputLayout = nullptr;
 	ID3D11InputLayout* m_terrainInputLayout = nullptr;
+	ID3D11InputLayout* m_instancedInputLayout = nullptr;
 	ID3D11PixelShader* m_pixelShader = nullptr;
 	ID3D11PixelShader* m_pixelShaderSkybox = nullptr;
 	ID3D11PixelShader* m_pixelShaderHeightmap = nullptr;
@@ -227,6 +373,12 @@ private:
 	// Objects for sprite batch and font rendering
 	std::unique_ptr<SpriteBatch> m_spriteBatch;
 	std::unique_ptr<SpriteFont> m_spriteFont;
+
+	// Frame time graph and counters overlay, toggled with F10
+	PerformanceHUD m_performanceHUD;
+
+	// Longest wait between the window receiving an input event and the update handling it, shown on the HUD
+	CounterID m_inputLatencyCounter = 0;
 #pragma endregion
 
 #pragma region Window Handle
@@ -241,13 +393,53 @@ private:
 	XMFLOAT4X4 m_World2 = {};
 	XMFLOAT4X4 m_World3 = {};
 	XMFLOAT4X4 m_Pyramid = {};
-	XMFLOAT4X4 m_View = {};
-	XMFLOAT4X4 m_Projection = {};
 #pragma endregion
 
 #pragma region Terrain
 	// Pointer to the terrain object
 	Terrain* m_terrain = nullptr;
+
+	// What the terrain drew for the first view this frame, published as a percentage of its chunks
+	TerrainSelectionStats m_terrainViewStats = {};
+	CounterID m_terrainVisibleCounter = 0;
+#pragma endregion
+
+#pragma region Instancing
+	// Batches objects that share a mesh, material and shader into instanced draws
+	InstanceRenderer* m_instanceRenderer = nullptr;
+
+	// Mesh descriptions of the hard coded cube and pyramid
+	MeshData m_cubeMeshData = {};
+	MeshData m_pyramidMeshData = {};
+#pragma endregion
+
+#pragma region Culling
+	// Frustum planes of the active camera
+	FrustumCuller m_frustumCuller = {};
+
+	// Hierarchy over the world bounds, stored as scene entities first, then the hard coded shapes, then the terrain
+	SceneBVH m_sceneBVH = {};
+	std::vector<XMFLOAT3> m_cullCenters;
+	std::vector<XMFLOAT3> m_cullExtents;
+
+	// Components of the scene entities in cull order, gathered straight from the entity registry archetypes
+	std::vector<const RenderComponent*> m_cullRenders;
+	std::vector<UINT> m_cullTransforms;
+	std::vector<const CPUMeshData*> m_cullOccluders;
+	std::vector<UINT> m_visibleObjects;
+	bool m_terrainVisible = true;
+
+	// Coarse CPU depth buffer the occluders are rasterized into
+	OcclusionCuller m_occlusionCuller = {};
+
+	// Monitor wall views, with bit v of each object's mask set if view v sees it
+	UINT m_viewCount = 1;
+	std::vector<FrustumCuller> m_viewFrustums;
+	std::vector<uint64_t> m_viewVisibility;
+
+	// Objects removed by each test, indexed by camera
+	std::vector<UINT> m_frustumCulledCount;
+	std::vector<UINT> m_occlusionCulledCount;
 #pragma endregion
 
 #pragma region Constant Buffer
@@ -256,17 +448,8 @@ private:
 #pragma endregion
 
 #pragma region Cameras
-	// Camera objects for various viewpoints
-	Camera m_debugCamera = {};
-	Camera m_camera1 = {};
-	Camera m_camera2 = {};
-	Camera m_camera3 = {};
-	Camera m_camera4 = {};
-	Camera m_camera5 = {};
-	Camera m_camera6 = {};
-	Camera m_camera7 = {};
-	Camera m_camera8 = {};
-	Camera m_camera9 = {};
+	// Every viewpoint in the scene, the debug camera is slot 0
+	CameraSystem m_cameraSystem;
 	XMFLOAT3 m_startingCameraPosition = { 0, 0, 0 };
 #pragma endregion
 
@@ -0,0 +1,222 @@
+// Include{s}
+#include "EntityRegistry.h"
+#include "TransformStore.h"
+
+#pragma region Row Methods
+UINT EntityArchetype::AddRow(Entity entity)
+{
+	m_entities.push_back(entity);
+
+	if (m_components & Component_Transform)
+	{
+		m_transforms.push_back(InvalidTransform);
+	}
+
+	if (m_components & Component_Render)
+	{
+		m_renders.push_back(RenderComponent{});
+	}
+
+	if (m_components & Component_Occluder)
+	{
+		m_occluders.push_back(nullptr);
+	}
+
+	return static_cast<UINT>(m_entities.size() - 1);
+}
+
+void EntityArchetype::CopyRow(UINT row, const EntityArchetype& source, UINT sourceRow)
+{
+	UINT shared = m_components & source.m_components;
+
+	if (shared & Component_Transform)
+	{
+		m_transforms[row] = source.m_transforms[sourceRow];
+	}
+
+	if (shared & Component_Render)
+	{
+		m_renders[row] = source.m_renders[sourceRow];
+	}
+
+	if (shared & Component_Occluder)
+	{
+		m_occluders[row] = source.m_occluders[sourceRow];
+	}
+}
+
+Entity EntityArchetype::RemoveRow(UINT row)
+{
+	UINT last = static_cast<UINT>(m_entities.size() - 1);
+	Entity moved = row == last ? InvalidEntity : m_entities[last];
+
+	// Swap and pop keeps the arrays packed, the last row fills the hole
+	m_entities[row] = m_entities[last];
+	m_entities.pop_back();
+
+	if (m_components & Component_Transform)
+	{
+		m_transforms[row] = m_transforms[last];
+		m_transforms.pop_back();
+	}
+
+	if (m_components & Component_Render)
+	{
+		m_renders[row] = m_renders[last];
+		m_renders.pop_back();
+	}
+
+	if (m_components & Component_Occluder)
+	{
+		m_occluders[row] = m_occluders[last];
+		m_occluders.pop_back();
+	}
+
+	return moved;
+}
+#pragma endregion
+
+#pragma region Entity Methods
+Entity EntityRegistry::Create(UINT components, int id, const std::string& name)
+{
+	UINT slot;
+
+	if (!m_freeSlots.empty())
+	{
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		slot = static_cast<UINT>(m_records.size());
+		m_records.push_back(EntityRecord{ InvalidEntity, 0, 0 });
+		m_ids.push_back(0);
+		m_names.emplace_back();
+	}
+
+	Entity entity = (m_records[slot].Generation << EntitySlotBits) | slot;
+
+	UINT archetypeIndex = FindArchetype(components);
+	m_records[slot].Archetype = archetypeIndex;
+	m_records[slot].Row = m_archetypes[archetypeIndex].AddRow(entity);
+
+	m_ids[slot] = id;
+	m_names[slot] = name;
+
+	return entity;
+}
+
+void EntityRegistry::Destroy(Entity entity)
+{
+	if (!IsAlive(entity))
+	{
+		return;
+	}
+
+	UINT slot = entity & EntitySlotMask;
+	RemoveFromArchetype(m_records[slot].Archetype, m_records[slot].Row);
+
+	// Bumping the generation kills every handle still pointing at the slot
+	m_records[slot].Archetype = InvalidEntity;
+	m_records[slot].Generation = (m_records[slot].Generation + 1) & (0xFFFFFFFF >> EntitySlotBits);
+	m_names[slot].clear();
+	m_freeSlots.push_back(slot);
+}
+
+bool EntityRegistry::IsAlive(Entity entity) const
+{
+	UINT slot = entity & EntitySlotMask;
+
+	return entity != InvalidEntity && slot < m_records.size() && m_records[slot].Archetype != InvalidEntity &&
+		m_records[slot].Generation == entity >> EntitySlotBits;
+}
+
+void EntityRegistry::AddComponents(Entity entity, UINT components)
+{
+	MoveEntity(entity, GetComponents(entity) | components);
+}
+
+void EntityRegistry::RemoveComponents(Entity entity, UINT components)
+{
+	MoveEntity(entity, GetComponents(entity) & ~components);
+}
+#pragma endregion
+
+#pragma region Getters
+UINT EntityRegistry::GetComponents(Entity entity) const
+{
+	return m_archetypes[m_records[entity & EntitySlotMask].Archetype].m_components;
+}
+
+UINT& EntityRegistry::GetTransform(Entity entity)
+{
+	const EntityRecord& record = m_records[entity & EntitySlotMask];
+
+	return m_archetypes[record.Archetype].m_transforms[record.Row];
+}
+
+RenderComponent& EntityRegistry::GetRender(Entity entity)
+{
+	const EntityRecord& record = m_records[entity & EntitySlotMask];
+
+	return m_archetypes[record.Archetype].m_renders[record.Row];
+}
+
+const CPUMeshData*& EntityRegistry::GetOccluder(Entity entity)
+{
+	const EntityRecord& record = m_records[entity & EntitySlotMask];
+
+	return m_archetypes[record.Archetype].m_occluders[record.Row];
+}
+#pragma endregion
+
+#pragma region Private Methods
+UINT EntityRegistry::FindArchetype(UINT components)
+{
+	// Only a handful of component combinations ever exist, a linear search beats a map here
+	for (UINT i = 0; i < static_cast<UINT>(m_archetypes.size()); i++)
+	{
+		if (m_archetypes[i].m_components == components)
+		{
+			return i;
+		}
+	}
+
+	m_archetypes.emplace_back();
+	m_archetypes.back().m_components = components;
+
+	return static_cast<UINT>(m_archetypes.size() - 1);
+}
+
+void EntityRegistry::MoveEntity(Entity entity, UINT components)
+{
+	UINT slot = entity & EntitySlotMask;
+	UINT oldArchetype = m_records[slot].Archetype;
+	UINT oldRow = m_records[slot].Row;
+
+	if (m_archetypes[oldArchetype].m_components == components)
+	{
+		return;
+	}
+
+	// Found first, creating the archetype can move the others
+	UINT newArchetype = FindArchetype(components);
+	UINT newRow = m_archetypes[newArchetype].AddRow(entity);
+	m_archetypes[newArchetype].CopyRow(newRow, m_archetypes[oldArchetype], oldRow);
+
+	RemoveFromArchetype(oldArchetype, oldRow);
+
+	m_records[slot].Archetype = newArchetype;
+	m_records[slot].Row = newRow;
+}
+
+void EntityRegistry::RemoveFromArchetype(UINT archetypeIndex, UINT row)
+{
+	Entity moved = m_archetypes[archetypeIndex].RemoveRow(row);
+
+	if (moved != InvalidEntity)
+	{
+		m_records[moved & EntitySlotMask].Row = row;
+	}
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,208 @@
+#pragma once
+
+// Include{s}
+#include "Structures.h"
+#include "OcclusionCuller.h"
+
+// Entity handles pack a slot index (low bits) with a generation (high bits), so a handle to a destroyed entity
+// is never mistaken for whatever reuses its slot
+typedef UINT Entity;
+constexpr Entity InvalidEntity = 0xFFFFFFFF;
+constexpr UINT EntitySlotBits = 24;
+constexpr UINT EntitySlotMask = (1u << EntitySlotBits) - 1;
+
+// Component flags, an archetype holds every entity with exactly the same set
+enum ComponentFlags : UINT
+{
+	Component_Transform = 1 << 0, // Handle into the transform store
+	Component_Render = 1 << 1, // Mesh, texture and blend state
+	Component_Occluder = 1 << 2, // CPU mesh rasterized by the occlusion culler
+	Component_SceneGraph = 1 << 3, // Loaded from the scene graph, culled and drawn in the instanced pass
+};
+
+// Struct to hold everything needed to draw an entity
+struct RenderComponent
+{
+	MeshData Mesh;
+	ID3D11ShaderResourceView* Texture;
+	bool Transparent;
+};
+
+// Contiguous storage for every entity sharing one set of components, arrays of absent components stay empty
+class EntityArchetype
+{
+public:
+#pragma region Getters
+	// Gets the component flags of the archetype
+	// Returns UINT - The component flags
+	UINT GetComponents() const { return m_components; }
+
+	// Checks the archetype holds every component in a set
+	// Returns bool - True if all the flags are present
+	bool HasComponents(UINT components) const { return (m_components & components) == components; }
+
+	// Gets the number of entities in the archetype
+	// Returns UINT - The entity count
+	UINT GetCount() const { return static_cast<UINT>(m_entities.size()); }
+
+	// Gets the entity handles, row i of every component array belongs to entity i
+	// Returns std::vector<Entity> - The entity handles
+	const std::vector<Entity>& GetEntities() const { return m_entities; }
+
+	// Gets the transform store handles
+	// Returns std::vector<UINT> - The transform handles
+	const std::vector<UINT>& GetTransforms() const { return m_transforms; }
+
+	// Gets the render components
+	// Returns std::vector<RenderComponent> - The render components
+	const std::vector<RenderComponent>& GetRenders() const { return m_renders; }
+
+	// Gets the occluder meshes
+	// Returns std::vector<const CPUMeshData*> - The occluder meshes, owned by the resource manager
+	const std::vector<const CPUMeshData*>& GetOccluders() const { return m_occluders; }
+#pragma endregion
+
+private:
+	friend class EntityRegistry;
+
+#pragma region Row Methods
+	// Appends a row with default components for an entity
+	// Returns UINT - The new row
+	UINT AddRow(Entity entity);
+
+	// Copies the components both archetypes share from a row of another archetype
+	void CopyRow(UINT row, const EntityArchetype& source, UINT sourceRow);
+
+	// Removes a row by moving the last row into it
+	// Returns Entity - The entity that moved into the row, InvalidEntity if the last row was removed
+	Entity RemoveRow(UINT row);
+#pragma endregion
+
+#pragma region Member Variables
+	UINT m_components = 0;
+	std::vector<Entity> m_entities;
+	std::vector<UINT> m_transforms;
+	std::vector<RenderComponent> m_renders;
+	std::vector<const CPUMeshData*> m_occluders;
+#pragma endregion
+};
+
+class EntityRegistry
+{
+public:
+#pragma region Singleton
+	// Only allow one instance of the EntityRegistry
+	// Singleton Pattern
+	EntityRegistry(const EntityRegistry&) = delete;
+	EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+	// Get the instance of the EntityRegistry
+	// Returns EntityRegistry* - The instance of the EntityRegistry
+	static EntityRegistry* GetInstance()
+	{
+		static EntityRegistry instance;
+		return &instance;
+	}
+#pragma endregion
+
+#pragma region Entity Methods
+	// Creates an entity with a set of components, each one starts zeroed
+	// Returns Entity - The handle used to access the entity
+	Entity Create(UINT components, int id, const std::string& name);
+
+	// Destroys an entity, its handle stops being alive and its slot is reused
+	void Destroy(Entity entity);
+
+	// Checks a handle still refers to a living entity
+	// Returns bool - True if the entity has not been destroyed
+	bool IsAlive(Entity entity) const;
+
+	// Adds components to an entity, moving it to the matching archetype
+	void AddComponents(Entity entity, UINT components);
+
+	// Removes components from an entity, moving it to the matching archetype
+	void RemoveComponents(Entity entity, UINT components);
+#pragma endregion
+
+#pragma region Iteration Methods
+	// Calls a function with every non-empty archetype holding all the given components, use the archetype arrays
+	// to walk the entities rather than looking each one up
+	template <typename Function>
+	void ForEach(UINT components, Function function) const
+	{
+		for (const EntityArchetype& archetype : m_archetypes)
+		{
+			if (archetype.HasComponents(components) && archetype.GetCount() > 0)
+			{
+				function(archetype);
+			}
+		}
+	}
+#pragma endregion
+
+#pragma region Getters
+	// Gets the components of an entity
+	// Returns UINT - The component flags
+	UINT GetComponents(Entity entity) const;
+
+	// Gets the transform handle of an entity
+	// Returns UINT - The transform handle, valid until entities are added, removed or change components
+	UINT& GetTransform(Entity entity);
+
+	// Gets the render component of an entity
+	// Returns RenderComponent - The render component, valid until entities are added, removed or change components
+	RenderComponent& GetRender(Entity entity);
+
+	// Gets the occluder mesh of an entity
+	// Returns CPUMeshData* - The occluder mesh, valid until entities are added, removed or change components
+	const CPUMeshData*& GetOccluder(Entity entity);
+
+	// Gets the ID of an entity
+	// Returns int - The ID
+	int GetID(Entity entity) const { return m_ids[entity & EntitySlotMask]; }
+
+	// Gets the name of an entity
+	// Returns std::string - The name
+	const std::string& GetName(Entity entity) const { return m_names[entity & EntitySlotMask]; }
+
+	// Gets the number of living entities
+	// Returns UINT - The entity count
+	UINT GetEntityCount() const { return static_cast<UINT>(m_records.size() - m_freeSlots.size()); }
+#pragma endregion
+
+private:
+#pragma region Constructor
+	// Default constructor
+	EntityRegistry() = default;
+#pragma endregion
+
+#pragma region Private Methods
+	// Finds the archetype for a set of components, creating it the first time
+	// Returns UINT - The archetype index
+	UINT FindArchetype(UINT components);
+
+	// Moves an entity's row to the archetype for a new set of components
+	void MoveEntity(Entity entity, UINT components);
+
+	// Takes an entity out of its archetype, fixing up the record of the entity moved into its row
+	void RemoveFromArchetype(UINT archetypeIndex, UINT row);
+#pragma endregion
+
+#pragma region Member Variables
+	// Where each slot's entity lives
+	struct EntityRecord
+	{
+		UINT Archetype;
+		UINT Row;
+		UINT Generation;
+	};
+
+	std::vector<EntityArchetype> m_archetypes;
+	std::vector<EntityRecord> m_records;
+	std::vector<UINT> m_freeSlots;
+
+	// Cold data, only read for lookups and the UI, kept out of the archetype arrays and indexed by slot
+	std::vector<int> m_ids;
+	std::vector<std::string> m_names;
+#pragma endregion
+};
@@ -0,0 +1,123 @@
+// Include{s}
+#include "FixedTimestepLoop.h"
+#include <cmath>
+
+#pragma region FixedTimestepLoop
+FixedTimestepLoop::FixedTimestepLoop(Clock* clock, double timestep, uint32_t maxStepsPerFrame)
+{
+	m_clock = clock;
+	m_timestep = timestep > 0.0 ? timestep : 1.0 / 60.0;
+	m_maxStepsPerFrame = maxStepsPerFrame > 0 ? maxStepsPerFrame : 1;
+}
+
+uint32_t FixedTimestepLoop::BeginFrame()
+{
+	double now = m_clock->GetSeconds();
+
+	if (!m_started)
+	{
+		m_started = true;
+		m_lastTime = now;
+		m_frameTime = 0.0;
+
+		return 0;
+	}
+
+	double frameTime = now - m_lastTime;
+	m_lastTime = now;
+
+	// Breakpoints and window drags are a single long frame, simulating all of it would only make the next frame longer
+	m_frameTime = frameTime < MaxFrameTime ? frameTime : MaxFrameTime;
+	m_accumulator += m_frameTime;
+
+	uint32_t steps = static_cast<uint32_t>(m_accumulator / m_timestep);
+
+	if (steps > m_maxStepsPerFrame)
+	{
+		// Keep the fraction so the blend stays continuous, the whole steps past the limit are lost
+		double remainder = std::fmod(m_accumulator, m_timestep);
+		m_droppedTime += m_accumulator - remainder - m_maxStepsPerFrame * m_timestep;
+		m_accumulator = remainder + m_maxStepsPerFrame * m_timestep;
+		steps = m_maxStepsPerFrame;
+	}
+
+	m_accumulator -= steps * m_timestep;
+
+	// Rounding can leave a hair under zero
+	if (m_accumulator < 0.0)
+	{
+		m_accumulator = 0.0;
+	}
+
+	return steps;
+}
+
+void FixedTimestepLoop::Reset()
+{
+	m_started = false;
+	m_accumulator = 0.0;
+	m_frameTime = 0.0;
+}
+
+void FixedTimestepLoop::SetClock(Clock* clock)
+{
+	m_clock = clock;
+	Reset();
+}
+#pragma endregion
+
+#pragma region FrameLimiter
+FrameLimiter::FrameLimiter(Clock* clock, double targetRate)
+{
+	m_clock = clock;
+	SetTargetRate(targetRate);
+}
+
+double FrameLimiter::Wait()
+{
+	if (m_targetInterval <= 0.0)
+	{
+		return 0.0;
+	}
+
+	double now = m_clock->GetSeconds();
+
+	if (!m_started)
+	{
+		m_started = true;
+		m_nextFrame = now;
+	}
+
+	m_nextFrame += m_targetInterval;
+	double wait = m_nextFrame - now;
+
+	if (wait <= 0.0)
+	{
+		// More than a whole slot behind, start counting again from now instead of rushing to catch up
+		if (-wait > m_targetInterval)
+		{
+			m_nextFrame = now;
+		}
+
+		return 0.0;
+	}
+
+	m_clock->SleepFor(wait);
+
+	return wait;
+}
+
+void FrameLimiter::SetTargetRate(double targetRate)
+{
+	double targetInterval = targetRate > 0.0 ? 1.0 / targetRate : 0.0;
+
+	// Called every frame by the pacing, only a real change restarts the slots
+	if (targetInterval == m_targetInterval)
+	{
+		return;
+	}
+
+	m_targetInterval = targetInterval;
+	m_started = false;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+// Include{s}
+#include "Clock.h"
+#include <cstdint>
+
+// Turns the real frame time into a whole number of fixed simulation steps. Whatever is left over stays in the
+// accumulator for the next frame, and the fraction of a step it makes up is what rendering blends by
+class FixedTimestepLoop
+{
+public:
+#pragma region Constructor
+	// Constructor, the clock is borrowed and has to outlive the loop
+	FixedTimestepLoop(Clock* clock, double timestep, uint32_t maxStepsPerFrame = 8);
+#pragma endregion
+
+#pragma region Loop Methods
+	// Reads the clock, adds the time since the last call to the accumulator and takes the whole steps out of it. The
+	// first call only starts the clock
+	// Returns uint32_t - The number of fixed steps to simulate this frame
+	uint32_t BeginFrame();
+
+	// Drops the accumulated time and starts the clock again on the next BeginFrame
+	void Reset();
+
+	// Swaps the clock the loop reads, and resets it
+	void SetClock(Clock* clock);
+#pragma endregion
+
+#pragma region Getters
+	// Gets how far the accumulator is into the next step, blend the previous and current simulation states by this
+	// Returns float - Between 0 and 1
+	float GetAlpha() const { return static_cast<float>(m_accumulator / m_timestep); }
+
+	// Gets the length of one simulation step
+	// Returns double - The step in seconds
+	double GetTimestep() const { return m_timestep; }
+
+	// Gets the real time the last frame took, capped so a stall does not teleport anything moved by it
+	// Returns double - The frame time in seconds
+	double GetFrameTime() const { return m_frameTime; }
+
+	// Gets the clock reading taken by the last BeginFrame, setting a FakeClock to it steps the loop the same way again
+	// Returns double - The time in seconds
+	double GetClockTime() const { return m_lastTime; }
+
+	// Gets the time dropped because a frame needed more than the step limit
+	// Returns double - The dropped time in seconds
+	double GetDroppedTime() const { return m_droppedTime; }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	// Longest frame that is still simulated in full, anything past this is a stall
+	static constexpr double MaxFrameTime = 0.25;
+
+	Clock* m_clock = nullptr;
+	double m_timestep = 0.0;
+	uint32_t m_maxStepsPerFrame = 0;
+
+	bool m_started = false;
+	double m_lastTime = 0.0;
+	double m_accumulator = 0.0;
+	double m_frameTime = 0.0;
+	double m_droppedTime = 0.0;
+#pragma endregion
+};
+
+// Holds each frame to a target rate by sleeping out the rest of its time slot. The slots are laid end to end, so a
+// frame that finishes early does not push every later frame back
+class FrameLimiter
+{
+public:
+#pragma region Constructor
+	// Constructor, the clock is borrowed and has to outlive the limiter. A rate of zero does not limit
+	explicit FrameLimiter(Clock* clock, double targetRate = 0.0);
+#pragma endregion
+
+#pragma region Limiter Methods
+	// Waits for the end of the current frame's time slot
+	// Returns double - The time waited in seconds
+	double Wait();
+
+	// Sets the frame rate to hold, zero turns the limiter off
+	void SetTargetRate(double targetRate);
+
+	// Gets the frame rate being held
+	// Returns double - Frames per second, zero when not limiting
+	double GetTargetRate() const { return m_targetInterval > 0.0 ? 1.0 / m_targetInterval : 0.0; }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	Clock* m_clock = nullptr;
+	double m_targetInterval = 0.0;
+
+	bool m_started = false;
+	double m_nextFrame = 0.0;
+#pragma endregion
+};
\ No newline at end of file
@@ -0,0 +1,135 @@
+// Include{s}
+#include "FrameArena.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+// Starting size of each buffer, enough for a frame of UI strings and occluder vertices
+constexpr size_t InitialArenaSize = 256 * 1024;
+
+#pragma region Helper Functions
+// Allocates a heap block on an alignment, which has to be a power of two
+// Returns void* - The block, release it with FreeAligned
+static void* AllocateAligned(size_t size, size_t alignment)
+{
+	alignment = alignment > alignof(std::max_align_t) ? alignment : alignof(std::max_align_t);
+	size = size > 0 ? size : 1;
+
+#if defined(_WIN32)
+	return _aligned_malloc(size, alignment);
+#else
+	// aligned_alloc wants the size to be a multiple of the alignment
+	return aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+// Releases a block from AllocateAligned
+static void FreeAligned(void* block)
+{
+#if defined(_WIN32)
+	_aligned_free(block);
+#else
+	free(block);
+#endif
+}
+#pragma endregion
+
+#pragma region Constructor & Destructor
+// Constructor
+FrameArena::FrameArena()
+{
+	for (Buffer& buffer : m_buffers)
+	{
+		buffer.Memory.resize(InitialArenaSize);
+	}
+}
+
+// Destructor
+FrameArena::~FrameArena()
+{
+	for (Buffer& buffer : m_buffers)
+	{
+		for (void* block : buffer.Overflow)
+		{
+			FreeAligned(block);
+		}
+	}
+}
+#pragma endregion
+
+#pragma region Frame Methods
+void FrameArena::BeginFrame()
+{
+	m_current ^= 1;
+	Buffer& buffer = m_buffers[m_current];
+
+	// Anything that spilled to the heap last time round is freed, and the buffer grows so it fits next time
+	for (void* block : buffer.Overflow)
+	{
+		FreeAligned(block);
+	}
+	buffer.Overflow.clear();
+
+	if (buffer.Peak > buffer.Memory.size())
+	{
+		buffer.Memory.resize(buffer.Peak + buffer.Peak / 2);
+	}
+
+	buffer.Used = 0;
+	buffer.Peak = 0;
+}
+#pragma endregion
+
+#pragma region Allocation Methods
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	Buffer& buffer = m_buffers[m_current];
+
+	uintptr_t base = reinterpret_cast<uintptr_t>(buffer.Memory.data());
+	uintptr_t aligned = (base + buffer.Used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+	size_t end = static_cast<size_t>(aligned - base) + size;
+
+	if (end <= buffer.Memory.size())
+	{
+		buffer.Used = end;
+		buffer.Peak = end > buffer.Peak ? end : buffer.Peak;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	// The peak carries on past the end of the buffer, so it covers every overflow this frame
+	buffer.Peak = (buffer.Used > buffer.Peak ? buffer.Used : buffer.Peak) + size + alignment;
+
+	// Full, the heap block keeps the alignment that was asked for
+	void* block = AllocateAligned(size, alignment);
+	buffer.Overflow.push_back(block);
+
+	return block;
+}
+
+const char* FrameArena::Format(const char* format, ...)
+{
+	va_list arguments;
+	va_start(arguments, format);
+	va_list argumentsCopy;
+	va_copy(argumentsCopy, arguments);
+
+	// First pass measures, second pass writes
+	int length = vsnprintf(nullptr, 0, format, arguments);
+	va_end(arguments);
+
+	if (length < 0)
+	{
+		va_end(argumentsCopy);
+		return "";
+	}
+
+	char* text = AllocateArray<char>(length + 1);
+	vsnprintf(text, length + 1, format, argumentsCopy);
+	va_end(argumentsCopy);
+
+	return text;
+}
+#pragma endregion
\ No newline at end of file
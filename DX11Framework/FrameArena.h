@@ -0,0 +1,115 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, so the arena builds and is tested without D3D or Windows
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Double-buffered bump allocator for data that only lives for a frame or two, everything allocated during a frame is
+// released at once when that buffer comes round again, two frames later. Main thread only.
+class FrameArena
+{
+public:
+#pragma region Singleton
+	// Only allow one instance of the FrameArena
+	// Singleton Pattern
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	// Get the instance of the FrameArena
+	// Returns FrameArena* - The instance of the FrameArena
+	static FrameArena* GetInstance()
+	{
+		static FrameArena instance;
+		return &instance;
+	}
+#pragma endregion
+
+#pragma region Frame Methods
+	// Swaps to the other buffer and empties it, call once at the start of the frame
+	void BeginFrame();
+#pragma endregion
+
+#pragma region Allocation Methods
+	// Bumps a block out of the current buffer, falling back to the heap if it is full (the buffer grows to fit the
+	// peak the next time it is reset)
+	// Returns void* - The block, valid until the end of the next frame
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	// Allocates space for an array without constructing it
+	// Returns T* - The array, valid until the end of the next frame
+	template <typename T>
+	T* AllocateArray(size_t count) { return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T))); }
+
+	// Formats a string (printf style) into the current buffer
+	// Returns const char* - The string, valid until the end of the next frame
+	const char* Format(const char* format, ...);
+#pragma endregion
+
+#pragma region Getters
+	// Gets the bytes handed out from the current buffer this frame
+	// Returns size_t - The used bytes
+	size_t GetUsedBytes() const { return m_buffers[m_current].Used; }
+
+	// Gets the size of the current buffer
+	// Returns size_t - The capacity in bytes
+	size_t GetCapacity() const { return m_buffers[m_current].Memory.size(); }
+
+	// Gets the number of allocations that did not fit and went to the heap this frame
+	// Returns uint32_t - The overflow count
+	uint32_t GetOverflowCount() const { return static_cast<uint32_t>(m_buffers[m_current].Overflow.size()); }
+#pragma endregion
+
+private:
+#pragma region Constructor & Destructor
+	// Constructor reserves both buffers
+	FrameArena();
+
+	// Destructor releases any overflow blocks
+	~FrameArena();
+#pragma endregion
+
+#pragma region Member Variables
+	// One half of the double buffer
+	struct Buffer
+	{
+		std::vector<unsigned char> Memory;
+		size_t Used = 0;
+		size_t Peak = 0;
+		std::vector<void*> Overflow;
+	};
+
+	Buffer m_buffers[2];
+	uint32_t m_current = 0;
+#pragma endregion
+};
+
+// STL allocator that takes its memory from the frame arena, deallocation is a no-op
+template <typename T>
+class ArenaAllocator
+{
+public:
+	typedef T value_type;
+
+	ArenaAllocator() = default;
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>&) {}
+
+	T* allocate(size_t count) { return FrameArena::GetInstance()->AllocateArray<T>(count); }
+
+	void deallocate(T*, size_t) {}
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U>&) const { return true; }
+
+	template <typename U>
+	bool operator!=(const ArenaAllocator<U>&) const { return false; }
+};
+
+// Containers for per-frame data, never keep one past the end of the next frame
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
@@ -0,0 +1,58 @@
+// Include{s}
+#include "FramePacingPolicy.h"
+
+#pragma region Constructor
+FramePacingPolicy::FramePacingPolicy()
+{
+	m_rates.Active = 0.0;
+	m_rates.MainMenu = 30.0;
+	m_rates.Background = 15.0;
+	m_rates.OccludedPoll = 4.0;
+}
+#pragma endregion
+
+#pragma region Policy Methods
+FramePacingDecision FramePacingPolicy::Decide(const FramePacingState& state) const
+{
+	// Benchmarks measure the frame, so nothing is held back
+	if (state.Benchmarking)
+	{
+		return { true, true, 0.0 };
+	}
+
+	// A minimized window only comes back through a message, so there is nothing to do until one arrives
+	if (state.Minimized)
+	{
+		return { false, false, 0.0 };
+	}
+
+	// Covered windows never say when they are uncovered, so keep checking at a low rate
+	if (state.Occluded)
+	{
+		return { false, true, m_rates.OccludedPoll };
+	}
+
+	double rate = m_rates.Active;
+
+	if (state.MainMenu)
+	{
+		rate = LowerCap(rate, m_rates.MainMenu);
+	}
+	if (!state.Focused)
+	{
+		rate = LowerCap(rate, m_rates.Background);
+	}
+
+	return { true, true, rate };
+}
+#pragma endregion
+
+#pragma region Private Methods
+double FramePacingPolicy::LowerCap(double a, double b)
+{
+	if (a <= 0.0) return b;
+	if (b <= 0.0) return a;
+
+	return a < b ? a : b;
+}
+#pragma endregion
\ No newline at end of file
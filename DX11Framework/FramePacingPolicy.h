@@ -0,0 +1,75 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, so the pacing rules can be checked without a window or a device
+
+// Struct to hold what the main loop knows about the window and the app when pacing a frame
+struct FramePacingState
+{
+	bool Minimized;
+	bool Occluded;
+	bool Focused;
+	bool MainMenu;
+	bool Benchmarking;
+};
+
+// Struct to hold what the main loop should do with the next frame
+struct FramePacingDecision
+{
+	// False means skip the frame entirely, nothing can be seen
+	bool Render;
+
+	// False means there is nothing to poll for either, block until a window message arrives
+	bool Poll;
+
+	// Frames per second to hold, or to poll at when not rendering, zero for as fast as possible
+	double TargetRate;
+};
+
+// Frame rates for each situation the app can be in, zero means uncapped
+struct FramePacingRates
+{
+	double Active;
+	double MainMenu;
+	double Background;
+	double OccludedPoll;
+};
+
+// Decides how fast the main loop runs. The menu is static and unfocused windows are only glanced at, so both run
+// slower, and a window nobody can see stops drawing altogether. Leaves the CPU to other instances on shared machines
+class FramePacingPolicy
+{
+public:
+#pragma region Constructor
+	// Constructor, active play is uncapped unless set otherwise
+	FramePacingPolicy();
+#pragma endregion
+
+#pragma region Policy Methods
+	// Decides what the next frame does
+	// Returns FramePacingDecision - Whether to render, poll or wait and at what rate
+	FramePacingDecision Decide(const FramePacingState& state) const;
+#pragma endregion
+
+#pragma region Getters & Setters
+	// Sets the frame rates used for each situation
+	void SetRates(const FramePacingRates& rates) { m_rates = rates; }
+
+	// Sets the cap while playing, zero for uncapped
+	void SetActiveRate(double rate) { m_rates.Active = rate; }
+
+	// Gets the frame rates used for each situation
+	// Returns FramePacingRates - The rates
+	const FramePacingRates& GetRates() const { return m_rates; }
+#pragma endregion
+
+private:
+#pragma region Private Methods
+	// Picks the lower of two caps, a zero cap does not limit
+	static double LowerCap(double a, double b);
+#pragma endregion
+
+#pragma region Member Variables
+	FramePacingRates m_rates;
+#pragma endregion
+};
\ No newline at end of file
@@ -0,0 +1,312 @@
+// Include{s}
+#include "FrustumCuller.h"
+#include <cmath>
+
+// The 8 wide path is built on every x86/x64 compiler and picked at runtime, so the app does not need /arch:AVX and
+// still runs on CPUs without it. GCC and Clang only allow AVX intrinsics in functions marked for AVX
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define FRUSTUM_CULLER_AVX
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AVX_FUNCTION
+#else
+#define AVX_FUNCTION __attribute__((target("avx")))
+#endif
+#endif
+
+using namespace DirectX;
+
+#pragma region Helper Functions
+// Checks the CPU has AVX and the OS saves the upper halves of the YMM registers on a context switch
+static bool CPUSupportsAVX()
+{
+#if defined(FRUSTUM_CULLER_AVX) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+
+	// OSXSAVE (bit 27) and AVX (bit 28) of ECX, then XCR0 must have the SSE and AVX state bits set
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+
+	return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#elif defined(FRUSTUM_CULLER_AVX)
+	return __builtin_cpu_supports("avx");
+#else
+	return false;
+#endif
+}
+
+// Whether Cull takes the 8 wide path, shared by every culler
+static bool g_useAVX = CPUSupportsAVX();
+
+#if defined(FRUSTUM_CULLER_AVX)
+// Tests 8 boxes per iteration against the planes, stopping before the last partial group of 8
+// Returns uint32_t - The number of boxes tested
+AVX_FUNCTION static uint32_t CullAVX(const XMFLOAT4* planes, const float* centerXs, const float* centerYs,
+	const float* centerZs, const float* extentXs, const float* extentYs, const float* extentZs, uint32_t count,
+	std::vector<uint32_t>& visibleIndices)
+{
+	__m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+	__m256 absPlaneX[6], absPlaneY[6], absPlaneZ[6];
+	for (int p = 0; p < 6; p++)
+	{
+		planeX[p] = _mm256_set1_ps(planes[p].x);
+		planeY[p] = _mm256_set1_ps(planes[p].y);
+		planeZ[p] = _mm256_set1_ps(planes[p].z);
+		planeW[p] = _mm256_set1_ps(planes[p].w);
+		absPlaneX[p] = _mm256_set1_ps(fabsf(planes[p].x));
+		absPlaneY[p] = _mm256_set1_ps(fabsf(planes[p].y));
+		absPlaneZ[p] = _mm256_set1_ps(fabsf(planes[p].z));
+	}
+
+	const __m256 zero = _mm256_setzero_ps();
+	uint32_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 centerX = _mm256_loadu_ps(centerXs + i);
+		__m256 centerY = _mm256_loadu_ps(centerYs + i);
+		__m256 centerZ = _mm256_loadu_ps(centerZs + i);
+		__m256 extentX = _mm256_loadu_ps(extentXs + i);
+		__m256 extentY = _mm256_loadu_ps(extentYs + i);
+		__m256 extentZ = _mm256_loadu_ps(extentZs + i);
+
+		__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (int p = 0; p < 6; p++)
+		{
+			// Signed distance of the centre and the projected radius of the box onto the plane normal
+			__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(centerX, planeX[p]),
+				_mm256_mul_ps(centerY, planeY[p])), _mm256_add_ps(_mm256_mul_ps(centerZ, planeZ[p]), planeW[p]));
+			__m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(extentX, absPlaneX[p]),
+				_mm256_mul_ps(extentY, absPlaneY[p])), _mm256_mul_ps(extentZ, absPlaneZ[p]));
+
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+		}
+
+		int mask = _mm256_movemask_ps(visible);
+		for (int lane = 0; lane < 8; lane++)
+		{
+			if (mask & (1 << lane))
+			{
+				visibleIndices.push_back(i + lane);
+			}
+		}
+	}
+
+	// Avoid the penalty of mixing the dirty upper halves with the SSE code that follows
+	_mm256_zeroupper();
+
+	return i;
+}
+#endif
+#pragma endregion
+
+#pragma region Frustum Methods
+void FrustumCuller::ExtractPlanes(FXMMATRIX viewProjection)
+{
+	ComputePlanes(viewProjection, m_planes);
+}
+
+void FrustumCuller::SetPlanes(const XMFLOAT4* planes)
+{
+	for (int i = 0; i < 6; i++)
+	{
+		m_planes[i] = planes[i];
+	}
+}
+
+void FrustumCuller::ComputePlanes(FXMMATRIX viewProjection, XMFLOAT4* planes)
+{
+	// With row vectors clip = v * M, so each clip component is a dot product with a column of M.
+	// Transposing turns those columns into rows (Gribb & Hartmann plane extraction).
+	XMMATRIX columns = XMMatrixTranspose(viewProjection);
+
+	XMVECTOR clipPlanes[6] =
+	{
+		XMVectorAdd(columns.r[3], columns.r[0]), // Left
+		XMVectorSubtract(columns.r[3], columns.r[0]), // Right
+		XMVectorAdd(columns.r[3], columns.r[1]), // Bottom
+		XMVectorSubtract(columns.r[3], columns.r[1]), // Top
+		columns.r[2], // Near (D3D clip space depth starts at 0)
+		XMVectorSubtract(columns.r[3], columns.r[2]), // Far
+	};
+
+	for (int i = 0; i < 6; i++)
+	{
+		XMStoreFloat4(&planes[i], XMPlaneNormalize(clipPlanes[i]));
+	}
+}
+#pragma endregion
+
+#pragma region Bounds Methods
+void FrustumCuller::Clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_extentX.clear();
+	m_extentY.clear();
+	m_extentZ.clear();
+}
+
+uint32_t FrustumCuller::AddBounds(const XMFLOAT3& center, const XMFLOAT3& extents)
+{
+	m_centerX.push_back(center.x);
+	m_centerY.push_back(center.y);
+	m_centerZ.push_back(center.z);
+	m_extentX.push_back(extents.x);
+	m_extentY.push_back(extents.y);
+	m_extentZ.push_back(extents.z);
+
+	return static_cast<uint32_t>(m_centerX.size()) - 1;
+}
+
+void FrustumCuller::TransformBounds(const XMFLOAT3& localCenter, const XMFLOAT3& localExtents, FXMMATRIX world,
+	XMFLOAT3& worldCenter, XMFLOAT3& worldExtents)
+{
+	// Arvo's method, the new extents are the local extents projected onto the absolute basis vectors
+	XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&localCenter), world);
+
+	XMVECTOR extents = XMVectorMultiply(XMVectorAbs(world.r[0]), XMVectorReplicate(localExtents.x));
+	extents = XMVectorMultiplyAdd(XMVectorAbs(world.r[1]), XMVectorReplicate(localExtents.y), extents);
+	extents = XMVectorMultiplyAdd(XMVectorAbs(world.r[2]), XMVectorReplicate(localExtents.z), extents);
+
+	XMStoreFloat3(&worldCenter, center);
+	XMStoreFloat3(&worldExtents, extents);
+}
+#pragma endregion
+
+#pragma region Culling Methods
+uint32_t FrustumCuller::Cull(std::vector<uint32_t>& visibleIndices) const
+{
+	visibleIndices.clear();
+
+	const uint32_t count = static_cast<uint32_t>(m_centerX.size());
+	uint32_t i = 0;
+
+#if defined(FRUSTUM_CULLER_AVX)
+	if (g_useAVX)
+	{
+		i = CullAVX(m_planes, m_centerX.data(), m_centerY.data(), m_centerZ.data(), m_extentX.data(),
+			m_extentY.data(), m_extentZ.data(), count, visibleIndices);
+	}
+#endif
+
+	// 4 boxes per iteration (DirectXMath maps onto SSE/NEON)
+	XMVECTOR planeX4[6], planeY4[6], planeZ4[6], planeW4[6];
+	XMVECTOR absPlaneX4[6], absPlaneY4[6], absPlaneZ4[6];
+	for (int p = 0; p < 6; p++)
+	{
+		planeX4[p] = XMVectorReplicate(m_planes[p].x);
+		planeY4[p] = XMVectorReplicate(m_planes[p].y);
+		planeZ4[p] = XMVectorReplicate(m_planes[p].z);
+		planeW4[p] = XMVectorReplicate(m_planes[p].w);
+		absPlaneX4[p] = XMVectorAbs(planeX4[p]);
+		absPlaneY4[p] = XMVectorAbs(planeY4[p]);
+		absPlaneZ4[p] = XMVectorAbs(planeZ4[p]);
+	}
+
+	for (; i + 4 <= count; i += 4)
+	{
+		XMVECTOR centerX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_centerX[i]));
+		XMVECTOR centerY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_centerY[i]));
+		XMVECTOR centerZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_centerZ[i]));
+		XMVECTOR extentX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_extentX[i]));
+		XMVECTOR extentY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_extentY[i]));
+		XMVECTOR extentZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_extentZ[i]));
+
+		XMVECTOR visible = XMVectorTrueInt();
+
+		for (int p = 0; p < 6; p++)
+		{
+			XMVECTOR distance = XMVectorMultiplyAdd(centerZ, planeZ4[p],
+				XMVectorMultiplyAdd(centerY, planeY4[p], XMVectorMultiplyAdd(centerX, planeX4[p], planeW4[p])));
+			XMVECTOR radius = XMVectorMultiplyAdd(extentZ, absPlaneZ4[p],
+				XMVectorMultiplyAdd(extentY, absPlaneY4[p], XMVectorMultiply(extentX, absPlaneX4[p])));
+
+			visible = XMVectorAndInt(visible, XMVectorGreaterOrEqual(XMVectorAdd(distance, radius), XMVectorZero()));
+		}
+
+		uint32_t mask[4];
+		XMStoreInt4(mask, visible);
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			if (mask[lane])
+			{
+				visibleIndices.push_back(i + lane);
+			}
+		}
+	}
+
+	// Whatever is left over is tested one box at a time
+	for (; i < count; i++)
+	{
+		if (IsVisible(XMFLOAT3(m_centerX[i], m_centerY[i], m_centerZ[i]),
+			XMFLOAT3(m_extentX[i], m_extentY[i], m_extentZ[i])))
+		{
+			visibleIndices.push_back(i);
+		}
+	}
+
+	return static_cast<uint32_t>(visibleIndices.size());
+}
+
+bool FrustumCuller::IsVisible(const XMFLOAT3& center, const XMFLOAT3& extents) const
+{
+	for (int p = 0; p < 6; p++)
+	{
+		const XMFLOAT4& plane = m_planes[p];
+
+		float distance = center.x * plane.x + center.y * plane.y + center.z * plane.z + plane.w;
+		float radius = extents.x * fabsf(plane.x) + extents.y * fabsf(plane.y) + extents.z * fabsf(plane.z);
+
+		// Completely behind one plane means outside the frustum
+		if (distance + radius < 0.0f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FrustumTest FrustumCuller::Classify(const XMFLOAT3& center, const XMFLOAT3& extents) const
+{
+	FrustumTest result = Frustum_Inside;
+
+	for (int p = 0; p < 6; p++)
+	{
+		const XMFLOAT4& plane = m_planes[p];
+
+		float distance = center.x * plane.x + center.y * plane.y + center.z * plane.z + plane.w;
+		float radius = extents.x * fabsf(plane.x) + extents.y * fabsf(plane.y) + extents.z * fabsf(plane.z);
+
+		if (distance + radius < 0.0f)
+		{
+			return Frustum_Outside;
+		}
+
+		// Part of the box is behind this plane
+		if (distance - radius < 0.0f)
+		{
+			result = Frustum_Intersecting;
+		}
+	}
+
+	return result;
+}
+#pragma endregion
+
+#pragma region AVX Methods
+void FrustumCuller::SetAVXEnabled(bool enabled)
+{
+	g_useAVX = enabled && CPUSupportsAVX();
+}
+
+bool FrustumCuller::IsAVXEnabled()
+{
+	return g_useAVX;
+}
+#pragma endregion
\ No newline at end of file
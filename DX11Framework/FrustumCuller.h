@@ -0,0 +1,88 @@
+#pragma once
+
+// Include{s}
+// Only the standard library and DirectXMath, so culling builds and is tested without D3D or Windows
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// Result of testing a bounding box against the frustum
+enum FrustumTest
+{
+	Frustum_Outside,
+	Frustum_Intersecting,
+	Frustum_Inside
+};
+
+class FrustumCuller
+{
+public:
+#pragma region Frustum Methods
+	// Extracts and normalises the six frustum planes from a (row-vector) view-projection matrix
+	void ExtractPlanes(DirectX::FXMMATRIX viewProjection);
+
+	// Copies in six planes already extracted elsewhere, such as the ones a camera caches
+	void SetPlanes(const DirectX::XMFLOAT4* planes);
+
+	// Extracts and normalises the six frustum planes from a (row-vector) view-projection matrix into an array
+	static void ComputePlanes(DirectX::FXMMATRIX viewProjection, DirectX::XMFLOAT4* planes);
+
+	// Gets the frustum planes, in left, right, bottom, top, near, far order
+	// Returns XMFLOAT4* - The six planes as (normal, distance)
+	const DirectX::XMFLOAT4* GetPlanes() const { return m_planes; }
+#pragma endregion
+
+#pragma region Bounds Methods
+	// Removes every bounding box from the culler, the storage is kept for the next frame
+	void Clear();
+
+	// Adds a world-space axis aligned bounding box
+	// Returns uint32_t - The index reported by Cull when the box is visible
+	uint32_t AddBounds(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents);
+
+	// Gets the number of bounding boxes added since the last clear
+	// Returns uint32_t - The bounding box count
+	uint32_t GetBoundsCount() const { return static_cast<uint32_t>(m_centerX.size()); }
+
+	// Transforms a local-space bounding box by a world matrix, giving the world-space box that encloses it
+	static void TransformBounds(const DirectX::XMFLOAT3& localCenter, const DirectX::XMFLOAT3& localExtents,
+		DirectX::FXMMATRIX world, DirectX::XMFLOAT3& worldCenter, DirectX::XMFLOAT3& worldExtents);
+#pragma endregion
+
+#pragma region Culling Methods
+	// Tests every bounding box against the frustum, 8 boxes at a time on CPUs with AVX and 4 (SSE) otherwise
+	// Returns uint32_t - The number of visible boxes, their indices are written to visibleIndices
+	uint32_t Cull(std::vector<uint32_t>& visibleIndices) const;
+
+	// Tests a single bounding box against the frustum
+	// Returns bool - True if the box is inside or intersecting the frustum
+	bool IsVisible(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents) const;
+
+	// Tests a single bounding box against the frustum, telling apart boxes that straddle a plane
+	// Returns FrustumTest - Whether the box is outside, intersecting or fully inside the frustum
+	FrustumTest Classify(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents) const;
+#pragma endregion
+
+#pragma region AVX Methods
+	// Turns the 8 wide path of Cull on or off for every culler, it stays off on CPUs or OSes without AVX
+	static void SetAVXEnabled(bool enabled);
+
+	// Checks if Cull uses the 8 wide path, on by default when the CPU and OS support AVX
+	// Returns bool - True if AVX is in use
+	static bool IsAVXEnabled();
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	// Frustum planes (normal xyz, distance w)
+	DirectX::XMFLOAT4 m_planes[6] = {};
+
+	// Bounding boxes kept as a structure of arrays, so a batch of boxes loads straight into SIMD lanes
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_extentX;
+	std::vector<float> m_extentY;
+	std::vector<float> m_extentZ;
+#pragma endregion
+};
@@ -1,31 +1,24 @@
 // Include{s}
 #include "GameObject.h"
+#include "Profiler.h"
+#include "CounterRegistry.h"
 
 #pragma region Constructor & Destructor
 // Constructor
-GameObject::GameObject(ID3D11Device* device, const char* OBJfilepath, const wchar_t* TEXfilepath, XMFLOAT3 Position,
+GameObject::GameObject(RenderDevice* device, const char* OBJfilepath, const wchar_t* TEXfilepath, XMFLOAT3 Position,
 	XMFLOAT3 Rotation, XMFLOAT3 Scale, int ID, std::string ObjectName)
 {
-	// Set member variables to the values passed in
-	m_OBJfilepath = OBJfilepath;
-	m_TEXfilepath = TEXfilepath;
-	m_device = device;
-	m_Position = Position;
-	m_Rotation = Rotation;
-	m_Scale = Scale;
-	m_ID = ID;
-	m_Name = ObjectName;
-
-	// Set the world matrix to the transformation values
-	XMStoreFloat4x4(&m_worldMatrix,
-		XMMatrixIdentity() * XMMatrixTranslation(m_Position.x, m_Position.y, m_Position.z) * (
-			XMMatrixRotationX(m_Rotation.x) * XMMatrixRotationY(m_Rotation.y) *
-			XMMatrixRotationZ(m_Rotation.z)) * XMMatrixScaling(m_Scale.x, m_Scale.y, m_Scale.z));
+	// The ID and name are cold data, the registry keeps them away from the components that are iterated every frame
+	m_entity = EntityRegistry::GetInstance()->Create(Component_Transform | Component_Render, ID, ObjectName);
+
+	// The transform lives in the transform store, which builds the world matrix
+	m_transform = TransformStore::GetInstance()->Allocate(Position, Rotation, Scale);
+	EntityRegistry::GetInstance()->GetTransform(m_entity) = m_transform;
 
 	// OH YEAH IM MULTITHREADING BABY
 	// Bullied to change the names of the threads (The voices)
-	std::thread loadTexDataThread(&GameObject::LoadTexture, this);
-	std::thread loadMeshDataThread(&GameObject::LoadMesh, this);
+	std::thread loadTexDataThread(&GameObject::LoadTexture, this, device, TEXfilepath);
+	std::thread loadMeshDataThread(&GameObject::LoadMesh, this, device, OBJfilepath);
 
 	loadTexDataThread.join();
 	loadMeshDataThread.join();
@@ -34,76 +27,71 @@ GameObject::GameObject(ID3D11Device* device, const char* OBJfilepath, const wcha
 // Destructor
 GameObject::~GameObject()
 {
-	if (m_texture)
-	{
-		m_texture->Release();
-		m_texture = nullptr;
-	}
-
-	if (m_meshData.VertexBuffer)
-	{
-		m_meshData.VertexBuffer->Release();
-		m_meshData.VertexBuffer = nullptr;
-	}
-
-	if (m_meshData.IndexBuffer)
-	{
-		m_meshData.IndexBuffer->Release();
-		m_meshData.IndexBuffer = nullptr;
-	}
+	// The texture and mesh are shared through the resource manager, which releases them
+	TransformStore::GetInstance()->Free(m_transform);
+	EntityRegistry::GetInstance()->Destroy(m_entity);
 }
 #pragma endregion
 
 #pragma region Loading Methods
 // Load texture for the game object
-void GameObject::LoadTexture()
+void GameObject::LoadTexture(RenderDevice* device, const wchar_t* TEXfilepath)
 {
-	if (std::wstring(m_TEXfilepath) == L"NULL")
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Loader");
+
+	if (std::wstring(TEXfilepath) == L"NULL")
 	{
 		return;
 	}
 
 	// Load the texture via the resource manager
-	m_texture = ResourceManager::GetInstance()->LoadTexture(m_device, m_TEXfilepath);
+	SetShaderResource(ResourceManager::GetInstance()->LoadTexture(device, TEXfilepath));
 }
 
 // Load mesh for the game object
-void GameObject::LoadMesh()
+void GameObject::LoadMesh(RenderDevice* device, const char* OBJfilepath)
 {
-	if (std::string(m_OBJfilepath) == "NULL")
+	PROFILE_FUNCTION();
+	PROFILE_THREAD("Loader");
+
+	if (std::string(OBJfilepath) == "NULL")
 	{
 		return;
 	}
 
 	// Load the mesh via the resource manager
-	m_meshData = ResourceManager::GetInstance()->LoadMesh(m_device, m_OBJfilepath);
+	SetMeshData(ResourceManager::GetInstance()->LoadMesh(device, OBJfilepath));
 }
 #pragma endregion
 
 #pragma region Drawing Method
 // Draw the game object
-void GameObject::Draw(ConstantBuffer _cbData, ID3D11DeviceContext* _immediateContext, ID3D11Buffer* _constantBuffer)
+void GameObject::Draw(const ConstantBuffer& _cbData, RenderContext* _immediateContext,
+	ID3D11Buffer* _constantBuffer)
 {
 	D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
+	RenderComponent& render = EntityRegistry::GetInstance()->GetRender(m_entity);
 
-	// Set the world matrix to current transformation values
-	XMStoreFloat4x4(&m_worldMatrix,
-		XMMatrixIdentity() * XMMatrixScaling(m_Scale.x, m_Scale.y, m_Scale.z) * (
-			XMMatrixRotationX(m_Rotation.x) * XMMatrixRotationY(m_Rotation.y) *
-			XMMatrixRotationZ(m_Rotation.z)) *
-		XMMatrixTranslation(m_Position.x, m_Position.y, m_Position.z));
-
-	_cbData.World = XMMatrixTranspose(XMLoadFloat4x4(&m_worldMatrix));
-	_immediateContext->PSSetShaderResources(0, 1, &m_texture);
+	_immediateContext->PSSetShaderResources(0, 1, &render.Texture);
 	_immediateContext->Map(_constantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+
+	// Copied straight into the mapped buffer, then the world matrix (kept transposed by the transform store) on top
 	memcpy(mappedSubresource.pData, &_cbData, sizeof(_cbData));
+	static_cast<ConstantBuffer*>(mappedSubresource.pData)->World =
+		XMLoadFloat4x4(&TransformStore::GetInstance()->GetWorldMatrixTransposed(m_transform));
 	_immediateContext->Unmap(_constantBuffer, 0);
 
-	_immediateContext->IASetVertexBuffers(0, 1, &m_meshData.VertexBuffer, &m_meshData.VBStride,
-		&m_meshData.VBOffset);
-	_immediateContext->IASetIndexBuffer(m_meshData.IndexBuffer, DXGI_FORMAT_R16_UINT, 0);
+	_immediateContext->IASetVertexBuffers(0, 1, &render.Mesh.VertexBuffer, &render.Mesh.VBStride,
+		&render.Mesh.VBOffset);
+	_immediateContext->IASetIndexBuffer(render.Mesh.IndexBuffer, DXGI_FORMAT_R16_UINT, 0);
 
-	_immediateContext->DrawIndexed(m_meshData.IndexCount, 0, 0);
+	_immediateContext->DrawIndexed(render.Mesh.IndexCount, 0, 0);
+
+	CounterRegistry* counters = CounterRegistry::GetInstance();
+	counters->Add(Counter_DrawCalls, 1);
+	counters->Add(Counter_ConstantBufferBytes, sizeof(_cbData));
+	counters->Add(Counter_TrianglesSubmitted, render.Mesh.IndexCount / 3);
 }
 #pragma endregion
 
@@ -111,19 +99,66 @@ void GameObject::Draw(ConstantBuffer _cbData, ID3D11DeviceContext* _immediateCon
 // Set the position of the game object
 void GameObject::SetPosition(float x, float y, float z)
 {
-	this->m_Position = XMFLOAT3(x, y, z);
+	TransformStore::GetInstance()->SetPosition(m_transform, XMFLOAT3(x, y, z));
 }
 
 // Set the rotation of the game object
 void GameObject::SetRotation(float x, float y, float z)
 {
-	this->m_Rotation = XMFLOAT3(x, y, z);
+	TransformStore::GetInstance()->SetRotation(m_transform, XMFLOAT3(x, y, z));
 }
 
 // Set the scale of the game object
 void GameObject::SetScale(float x, float y, float z)
 {
-	this->m_Scale = XMFLOAT3(x, y, z);
+	TransformStore::GetInstance()->SetScale(m_transform, XMFLOAT3(x, y, z));
+}
+
+// Set the world matrix of the game object
+void GameObject::SetWorldMatrix(XMMATRIX worldMatrix)
+{
+	TransformStore::GetInstance()->SetWorldMatrix(m_transform, worldMatrix);
+}
+
+// Set the texture of the game object
+void GameObject::SetShaderResource(ID3D11ShaderResourceView* texture)
+{
+	EntityRegistry::GetInstance()->GetRender(m_entity).Texture = texture;
+}
+
+// Set the mesh data of the game object
+void GameObject::SetMeshData(MeshData meshData)
+{
+	EntityRegistry::GetInstance()->GetRender(m_entity).Mesh = meshData;
+}
+
+// Set whether the game object is transparent
+void GameObject::SetTransparent(bool transparent)
+{
+	EntityRegistry::GetInstance()->GetRender(m_entity).Transparent = transparent;
+}
+
+// Set the occluder mesh of the game object
+void GameObject::SetOccluderMesh(const CPUMeshData* occluderMesh)
+{
+	EntityRegistry* registry = EntityRegistry::GetInstance();
+
+	// Only occluders carry the component, so the culler can find them without checking every entity
+	if (occluderMesh)
+	{
+		registry->AddComponents(m_entity, Component_Occluder);
+		registry->GetOccluder(m_entity) = occluderMesh;
+	}
+	else
+	{
+		registry->RemoveComponents(m_entity, Component_Occluder);
+	}
+}
+
+// Set the parent of the game object
+bool GameObject::SetParent(const GameObject* parent)
+{
+	return TransformStore::GetInstance()->SetParent(m_transform, parent ? parent->GetTransformHandle() : InvalidTransform);
 }
 #pragma endregion
 
@@ -131,12 +166,38 @@ void GameObject::SetScale(float x, float y, float z)
 // Get the rotation of the game object
 XMFLOAT3 GameObject::GetRotation() const
 {
-	return m_Rotation;
+	return TransformStore::GetInstance()->GetRotation(m_transform);
 }
 
 // Get the position of the game object
 XMFLOAT3 GameObject::GetPosition() const
 {
-	return m_Position;
+	return TransformStore::GetInstance()->GetPosition(m_transform);
+}
+
+// Get the texture of the game object
+ID3D11ShaderResourceView* GameObject::GetShaderResource() const
+{
+	return EntityRegistry::GetInstance()->GetRender(m_entity).Texture;
+}
+
+// Get the mesh data of the game object
+const MeshData& GameObject::GetMeshData() const
+{
+	return EntityRegistry::GetInstance()->GetRender(m_entity).Mesh;
+}
+
+// Get the occluder mesh of the game object
+const CPUMeshData* GameObject::GetOccluderMesh() const
+{
+	EntityRegistry* registry = EntityRegistry::GetInstance();
+
+	return registry->GetComponents(m_entity) & Component_Occluder ? registry->GetOccluder(m_entity) : nullptr;
+}
+
+// Get the world matrix of the game object
+const XMFLOAT4X4& GameObject::GetWorldMatrix() const
+{
+	return TransformStore::GetInstance()->GetWorldMatrix(m_transform);
 }
 #pragma endregion
\ No newline at end of file
@@ -1,12 +1,16 @@
 #pragma once
 #include "ResourceManager.h"
+#include "TransformStore.h"
+#include "EntityRegistry.h"
+
+// Thin facade over an entity, the transform lives in the transform store and everything else in the entity registry
 
 class GameObject
 {
 public:
 #pragma region Constructors
 	// Constructor
-	GameObject(ID3D11Device* device, const char* OBJfilepath, const wchar_t* TEXfilepath, XMFLOAT3 Position,
+	GameObject(RenderDevice* device, const char* OBJfilepath, const wchar_t* TEXfilepath, XMFLOAT3 Position,
 		XMFLOAT3 Rotation, XMFLOAT3 Scale, int ID, std::string ObjectName);
 
 	// Destructor
@@ -15,15 +19,15 @@ public:
 
 #pragma region Load Methods
 	// Loads the texture for the game object
-	void LoadTexture();
+	void LoadTexture(RenderDevice* device, const wchar_t* TEXfilepath);
 
 	// Loads the mesh for the game object
-	void LoadMesh();
+	void LoadMesh(RenderDevice* device, const char* OBJfilepath);
 #pragma endregion
 
 #pragma region Draw Method
 	// Draws the game object
-	void Draw(ConstantBuffer cbData, ID3D11DeviceContext* immediateContext, ID3D11Buffer* constantBuffer);
+	void Draw(const ConstantBuffer& cbData, RenderContext* immediateContext, ID3D11Buffer* constantBuffer);
 #pragma endregion
 
 #pragma region Setters
@@ -31,19 +35,29 @@ public:
 	void SetScale(float x, float y, float z);
 
 	// Sets the world matrix of the game object
-	void SetWorldMatrix(XMMATRIX worldMatrix) { XMStoreFloat4x4(&m_worldMatrix, worldMatrix); }
+	void SetWorldMatrix(XMMATRIX worldMatrix);
 
 	// Sets the shader resource of the game object
-	void SetShaderResource(ID3D11ShaderResourceView* texture) { m_texture = texture; }
+	void SetShaderResource(ID3D11ShaderResourceView* texture);
 
 	// Sets the mesh data of the game object
-	void SetMeshData(MeshData meshData) { m_meshData = meshData; }
+	void SetMeshData(MeshData meshData);
+
+	// Sets whether the game object is drawn in the transparent pass
+	void SetTransparent(bool transparent);
+
+	// Sets the CPU mesh used to rasterize the game object into the occlusion buffer, nullptr stops it occluding
+	void SetOccluderMesh(const CPUMeshData* occluderMesh);
 
 	// Sets the position of the game object
-	virtual void SetPosition(float x, float y, float z);
+	void SetPosition(float x, float y, float z);
 
 	// Sets the rotation of the game object
-	virtual void SetRotation(float x, float y, float z);
+	void SetRotation(float x, float y, float z);
+
+	// Attaches the game object to a parent (nullptr detaches it), its position, rotation and scale become relative to it
+	// Returns bool - False if the parent is the game object itself or one of its children
+	bool SetParent(const GameObject* parent);
 #pragma endregion
 
 #pragma region Getters
@@ -57,49 +71,44 @@ public:
 
 	// Gets the shader resource of the game object
 	// Returns ID3D11ShaderResourceView - The gameobject texture
-	ID3D11ShaderResourceView** GetShaderResource() { return &m_texture; }
+	ID3D11ShaderResourceView* GetShaderResource() const;
 
 	// Gets the mesh data of the game object
 	// Returns MeshData - The gameobject MeshData
-	MeshData* GetMeshData() { return &m_meshData; }
+	const MeshData& GetMeshData() const;
 
-#pragma endregion
+	// Gets the world matrix of the game object (untransposed), as of the last transform store update
+	// Returns XMFLOAT4X4 - The gameobject world matrix
+	const XMFLOAT4X4& GetWorldMatrix() const;
 
-#pragma region Public Member Variables
-	// Position of the game object
-	XMFLOAT3 m_Position = { 0, 0, 0 };
+	// Gets the handle of the game object's transform in the transform store
+	// Returns UINT - The transform handle
+	UINT GetTransformHandle() const { return m_transform; }
 
-	// Rotation of the game object
-	XMFLOAT3 m_Rotation = { 0, 0, 0 };
+	// Gets the handle of the game object's entity in the entity registry
+	// Returns Entity - The entity handle
+	Entity GetEntity() const { return m_entity; }
 
-	// Scale of the game object
-	XMFLOAT3 m_Scale = { 1, 1, 1 };
+	// Gets the CPU mesh of the game object if it is an occluder
+	// Returns CPUMeshData* - The occluder mesh, nullptr if the game object does not occlude
+	const CPUMeshData* GetOccluderMesh() const;
 
-	// ID of the game object
-	int m_ID = 0;
+	// Gets the ID of the game object
+	// Returns int - The gameobject ID
+	int GetID() const { return EntityRegistry::GetInstance()->GetID(m_entity); }
 
-	// Name of the game object
-	std::string m_Name = "NULL";
+	// Gets the name of the game object
+	// Returns std::string - The gameobject name
+	const std::string& GetName() const { return EntityRegistry::GetInstance()->GetName(m_entity); }
 #pragma endregion
 
 private:
 #pragma region Private Member Variables
-	// Texture of the game object
-	ID3D11ShaderResourceView* m_texture = nullptr;
-
-	// Mesh data of the game object
-	MeshData m_meshData = {};
-
-	// World matrix of the game object
-	XMFLOAT4X4 m_worldMatrix = {};
-
-	// File path to the OBJ file
-	const char* m_OBJfilepath = nullptr;
-
-	// File path to the texture file
-	const wchar_t* m_TEXfilepath = nullptr;
+	// Handle of the mesh, texture, occluder, ID and name in the entity registry
+	Entity m_entity = InvalidEntity;
 
-	// Device for rendering
-	ID3D11Device* m_device = nullptr;
+	// Handle of the position, rotation, scale and world matrix in the transform store, copied from the entity since
+	// it never changes
+	UINT m_transform = 0;
 #pragma endregion
 };
@@ -1,5 +1,6 @@
 // Load the heightmap texture and sampler
 Texture2D heightmapTexture : register(t0);
+Texture2D tileAtlasTexture : register(t1);
 SamplerState bilinearSampler : register(s0);
 
 // Constant buffer passed from the application
@@ -32,6 +33,23 @@ register (b0)
 	float3 padding;
 }
 
+// Constant buffer of the terrain's level of detail
+cbuffer TerrainConstantBuffer : register(b1)
+{
+	float4 MorphConstants[8];
+	float4 TerrainCameraPosition;
+	float4 GridInfo;
+	float4 TerrainOrigin;
+	float4 TileInfo;
+	float4 AtlasInfo;
+}
+
+// Atlas slot plus one of every heightmap tile, 0 while the tile is not resident
+cbuffer TerrainTileTable : register(b2)
+{
+	uint4 TileSlots[1024];
+}
+
 // Input structure
 struct VS_Out
 {
@@ -39,15 +57,64 @@ struct VS_Out
 	float2 texCoord : TEXCOORD;
 };
 
-// Vertex shader
-VS_Out VS_main(float3 position : POSITION, float2 Texcoord : TEXCOORD)
+// Gets the heightmap coordinates of a local position, on the centre of the texel of its sample
+float2 GetHeightmapCoords(float2 localPosition)
+{
+	return ((localPosition - TerrainOrigin.xy) / GridInfo.w + 0.5f) * GridInfo.yz;
+}
+
+// Gets the height at a local position, from the tile atlas if its tile has been paged in and from the resident
+// heightmap until then
+float SampleHeight(float2 localPosition)
+{
+	float2 samplePosition = (localPosition - TerrainOrigin.xy) / GridInfo.w;
+
+	// The last row and column of samples are only in the tiles before them
+	float2 tile = clamp(floor(samplePosition / TileInfo.x), 0.0f, TileInfo.yz - 1.0f);
+	uint tileIndex = (uint)(tile.y * TileInfo.y + tile.x);
+	uint slot = TileInfo.x > 0.0f ? TileSlots[tileIndex / 4][tileIndex % 4] : 0;
+
+	if (slot == 0)
+	{
+		return heightmapTexture.SampleLevel(bilinearSampler, GetHeightmapCoords(localPosition), 0).r;
+	}
+
+	// Tiles hold (tile size + 1) samples a side, so a position inside one never blends with the next slot
+	float2 slotOrigin = float2((slot - 1) % (uint)TileInfo.w, (slot - 1) / (uint)TileInfo.w) * (TileInfo.x + 1.0f);
+	float2 tileSample = clamp(samplePosition - tile * TileInfo.x, 0.0f, TileInfo.x);
+	float2 atlasCoords = (slotOrigin + tileSample + 0.5f) * AtlasInfo.xy;
+
+	return tileAtlasTexture.SampleLevel(bilinearSampler, atlasCoords, 0).r * AtlasInfo.z;
+}
+
+// Vertex shader, the node is (x, z, size, level). There is no vertex buffer, the patch index buffer holds the
+// vertex ids of a (resolution + 1) square grid
+VS_Out VS_main(uint vertexID : SV_VertexID, float4 node : NODE)
 {
 	VS_Out output = (VS_Out)0;
-	float4 Pos4 = float4(position, 1.0f);
 
-	// Sample the heightmap texture
-	float height = heightmapTexture.SampleLevel(bilinearSampler, Texcoord, 0).r;
-	Pos4.y = height;
+	// Rebuild the patch grid position, from 0 to 1
+	uint vertsPerSide = (uint)GridInfo.x + 1;
+	float2 gridPosition = float2(vertexID % vertsPerSide, vertexID / vertsPerSide) / GridInfo.x;
+
+	// Place the vertex in the node and find its height at full detail
+	float2 localPosition = node.xy + gridPosition * node.z;
+	float height = SampleHeight(localPosition);
+
+	// Towards the end of the level's range, slide the odd vertices onto the next level's grid so it takes over
+	// without a seam or a pop
+	float4 morph = MorphConstants[(uint)node.w];
+	float distance = length(float3(localPosition.x, height, localPosition.y) - TerrainCameraPosition.xyz);
+	float morphAmount = saturate((distance - morph.x) * morph.y);
+
+	float2 morphOffset = frac(gridPosition * GridInfo.x * 0.5f) * 2.0f / GridInfo.x;
+	gridPosition -= morphOffset * morphAmount;
+
+	localPosition = node.xy + gridPosition * node.z;
+	float2 Texcoord = GetHeightmapCoords(localPosition);
+	height = SampleHeight(localPosition);
+
+	float4 Pos4 = float4(localPosition.x, height, localPosition.y, 1.0f);
 
 	// Transform position to world space
 	float4 worldPos = mul(Pos4, World);
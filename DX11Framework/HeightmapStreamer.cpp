@@ -0,0 +1,127 @@
+// Include{s}
+#include "HeightmapStreamer.h"
+
+#pragma region Constructor & Destructor
+// Destructor
+HeightmapStreamer::~HeightmapStreamer()
+{
+	Stop();
+}
+#pragma endregion
+
+#pragma region Streaming Methods
+bool HeightmapStreamer::Start(const std::string& path, uint32_t slotCount)
+{
+	Stop();
+
+	if (!m_heightmap.Open(path))
+	{
+		return false;
+	}
+
+	m_cache.Initialise(m_heightmap.GetTilesX(), m_heightmap.GetTilesZ(), slotCount);
+
+	m_stopping = false;
+	m_worker = std::thread(&HeightmapStreamer::WorkerLoop, this);
+
+	return true;
+}
+
+void HeightmapStreamer::Stop()
+{
+	if (m_worker.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_wake.notify_one();
+		m_idle.notify_all();
+		m_worker.join();
+	}
+
+	m_queued.clear();
+	m_finished.clear();
+	m_inFlight = 0;
+	m_heightmap.Close();
+}
+
+void HeightmapStreamer::Update(float cameraX, float cameraZ, float radius)
+{
+	if (!m_heightmap.IsOpen())
+	{
+		return;
+	}
+
+	const float tileSize = static_cast<float>(m_heightmap.GetTileSize());
+	m_cache.Update(cameraX / tileSize, cameraZ / tileSize, radius / tileSize, m_maxRequestsPerUpdate, m_requests);
+
+	if (m_requests.empty())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queued.insert(m_queued.end(), m_requests.begin(), m_requests.end());
+		m_inFlight += static_cast<uint32_t>(m_requests.size());
+	}
+	m_wake.notify_one();
+}
+
+void HeightmapStreamer::CollectLoaded(std::vector<HeightmapLoadedTile>& loaded)
+{
+	loaded.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		loaded.swap(m_finished);
+	}
+
+	for (const HeightmapLoadedTile& tile : loaded)
+	{
+		m_cache.MarkResident(tile.Request);
+	}
+}
+
+void HeightmapStreamer::WaitForIdle()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_idle.wait(lock, [this]() { return m_inFlight == 0 || m_stopping; });
+}
+#pragma endregion
+
+#pragma region Private Methods
+void HeightmapStreamer::WorkerLoop()
+{
+	const uint32_t sampleCount = m_heightmap.GetTileSampleCount();
+
+	for (;;)
+	{
+		HeightmapTileRequest request;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [this]() { return m_stopping || !m_queued.empty(); });
+
+			if (m_stopping)
+			{
+				return;
+			}
+
+			request = m_queued.front();
+			m_queued.pop_front();
+		}
+
+		// Touching the samples is what pages them in, done here so the main thread never waits on the disk
+		const uint16_t* samples = m_heightmap.GetTile(request.TileX, request.TileZ);
+		HeightmapLoadedTile tile = { request, std::vector<uint16_t>(samples, samples + sampleCount) };
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_finished.push_back(std::move(tile));
+			m_inFlight--;
+		}
+		m_idle.notify_all();
+	}
+}
+#pragma endregion
\ No newline at end of file
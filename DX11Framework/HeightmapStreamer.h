@@ -0,0 +1,91 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, the tiled heightmap and the tile cache, so paging can be run without a device
+#include "HeightmapTileCache.h"
+#include "TiledHeightmap.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Struct to hold a tile read off the disk, ready to be uploaded into its slot
+struct HeightmapLoadedTile
+{
+	HeightmapTileRequest Request;
+	std::vector<uint16_t> Samples;
+};
+
+// Pages heightmap tiles in around the camera on a worker thread. The main thread decides what is wanted and takes
+// the tiles that have finished, the worker only copies tiles out of the mapped file, so the page faults of a tile
+// that is not in memory yet never stall a frame
+class HeightmapStreamer
+{
+public:
+#pragma region Constructor & Destructor
+	HeightmapStreamer() = default;
+
+	// Only one owner of the worker
+	HeightmapStreamer(const HeightmapStreamer&) = delete;
+	HeightmapStreamer& operator=(const HeightmapStreamer&) = delete;
+
+	// Destructor stops the worker
+	~HeightmapStreamer();
+#pragma endregion
+
+#pragma region Streaming Methods
+	// Maps a tiled heightmap and starts the worker, with room for slotCount tiles at once
+	// Returns bool - False if the heightmap could not be opened
+	bool Start(const std::string& path, uint32_t slotCount);
+
+	// Stops the worker, anything still queued is dropped
+	void Stop();
+
+	// Works out the tiles wanted within radius of the camera and queues the ones to page in, both in samples
+	void Update(float cameraX, float cameraZ, float radius);
+
+	// Takes the tiles the worker has finished and marks them resident, the caller uploads them into their slots
+	void CollectLoaded(std::vector<HeightmapLoadedTile>& loaded);
+
+	// Blocks until everything queued has been paged in
+	void WaitForIdle();
+#pragma endregion
+
+#pragma region Getters
+	// Gets the heightmap being streamed
+	// Returns TiledHeightmap - The heightmap
+	const TiledHeightmap& GetHeightmap() const { return m_heightmap; }
+
+	// Gets the cache deciding which tiles are resident
+	// Returns HeightmapTileCache - The cache
+	const HeightmapTileCache& GetCache() const { return m_cache; }
+
+	// Sets the most tiles queued in one update, so a jump across the map pages in over a few frames
+	void SetMaxRequestsPerUpdate(uint32_t maxRequests) { m_maxRequestsPerUpdate = maxRequests; }
+#pragma endregion
+
+private:
+#pragma region Private Methods
+	// Copies queued tiles out of the mapped file until stopped
+	void WorkerLoop();
+#pragma endregion
+
+#pragma region Member Variables
+	TiledHeightmap m_heightmap;
+	HeightmapTileCache m_cache;
+	uint32_t m_maxRequestsPerUpdate = 8;
+
+	// Requests for the worker and the tiles it has finished, both behind the mutex
+	std::thread m_worker;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_idle;
+	std::deque<HeightmapTileRequest> m_queued;
+	std::vector<HeightmapLoadedTile> m_finished;
+	uint32_t m_inFlight = 0;
+	bool m_stopping = false;
+
+	// Kept to save allocating every update
+	std::vector<HeightmapTileRequest> m_requests;
+#pragma endregion
+};
@@ -0,0 +1,159 @@
+// Include{s}
+#include "HeightmapTileCache.h"
+#include <algorithm>
+#include <cmath>
+
+// Bound by reference when the tile slots are filled
+const uint32_t HeightmapTileCache::NoSlot;
+
+#pragma region Setup Methods
+void HeightmapTileCache::Initialise(uint32_t tilesX, uint32_t tilesZ, uint32_t slotCount)
+{
+	m_tilesX = tilesX;
+	m_tilesZ = tilesZ;
+
+	m_tileSlots.assign(static_cast<size_t>(tilesX) * tilesZ, NoSlot);
+	m_slots.assign(slotCount, { NoTile, 0, false });
+
+	m_update = 0;
+	m_residentCount = 0;
+	m_pendingCount = 0;
+	m_evictionCount = 0;
+}
+#pragma endregion
+
+#pragma region Paging Methods
+void HeightmapTileCache::Update(float cameraTileX, float cameraTileZ, float radiusTiles, uint32_t maxRequests,
+	std::vector<HeightmapTileRequest>& requests)
+{
+	requests.clear();
+	m_update++;
+
+	if (m_tilesX == 0 || m_tilesZ == 0)
+	{
+		return;
+	}
+
+	// Only the tiles under the square around the circle can be in it
+	const int64_t firstX = (std::max)(int64_t(0), static_cast<int64_t>(floorf(cameraTileX - radiusTiles)));
+	const int64_t firstZ = (std::max)(int64_t(0), static_cast<int64_t>(floorf(cameraTileZ - radiusTiles)));
+	const int64_t lastX = (std::min)(int64_t(m_tilesX) - 1, static_cast<int64_t>(floorf(cameraTileX + radiusTiles)));
+	const int64_t lastZ = (std::min)(int64_t(m_tilesZ) - 1, static_cast<int64_t>(floorf(cameraTileZ + radiusTiles)));
+
+	m_wanted.clear();
+	for (int64_t tileZ = firstZ; tileZ <= lastZ; tileZ++)
+	{
+		for (int64_t tileX = firstX; tileX <= lastX; tileX++)
+		{
+			// Distance to the nearest point of the tile
+			const float offsetX = cameraTileX - (std::max)(float(tileX), (std::min)(cameraTileX, float(tileX + 1)));
+			const float offsetZ = cameraTileZ - (std::max)(float(tileZ), (std::min)(cameraTileZ, float(tileZ + 1)));
+			const float distanceSquared = offsetX * offsetX + offsetZ * offsetZ;
+
+			if (distanceSquared <= radiusTiles * radiusTiles)
+			{
+				m_wanted.push_back({ distanceSquared, static_cast<uint32_t>(tileZ * m_tilesX + tileX) });
+			}
+		}
+	}
+
+	std::sort(m_wanted.begin(), m_wanted.end());
+
+	// Keep every wanted tile that already has a slot before handing any out, so none of them gets evicted
+	for (const auto& wanted : m_wanted)
+	{
+		const uint32_t slot = m_tileSlots[wanted.second];
+		if (slot != NoSlot)
+		{
+			m_slots[slot].LastWanted = m_update;
+		}
+	}
+
+	for (const auto& wanted : m_wanted)
+	{
+		if (requests.size() >= maxRequests)
+		{
+			break;
+		}
+
+		if (m_tileSlots[wanted.second] != NoSlot)
+		{
+			continue;
+		}
+
+		const uint32_t slot = FindSlot();
+		if (slot == NoSlot)
+		{
+			break;
+		}
+
+		m_slots[slot] = { wanted.second, m_update, true };
+		m_tileSlots[wanted.second] = slot;
+		m_pendingCount++;
+
+		requests.push_back({ wanted.second % m_tilesX, wanted.second / m_tilesX, slot });
+	}
+}
+
+void HeightmapTileCache::MarkResident(const HeightmapTileRequest& request)
+{
+	Slot& slot = m_slots[request.Slot];
+	if (!slot.Pending || slot.Tile != request.TileZ * m_tilesX + request.TileX)
+	{
+		return;
+	}
+
+	slot.Pending = false;
+	m_pendingCount--;
+	m_residentCount++;
+}
+#pragma endregion
+
+#pragma region Getters
+uint32_t HeightmapTileCache::GetSlot(uint32_t tileX, uint32_t tileZ) const
+{
+	if (tileX >= m_tilesX || tileZ >= m_tilesZ)
+	{
+		return NoSlot;
+	}
+
+	const uint32_t slot = m_tileSlots[tileZ * m_tilesX + tileX];
+	return slot != NoSlot && !m_slots[slot].Pending ? slot : NoSlot;
+}
+#pragma endregion
+
+#pragma region Private Methods
+uint32_t HeightmapTileCache::FindSlot()
+{
+	uint32_t oldest = NoSlot;
+
+	for (uint32_t slot = 0; slot < m_slots.size(); slot++)
+	{
+		// A free slot is as good as it gets
+		if (m_slots[slot].Tile == NoTile)
+		{
+			return slot;
+		}
+
+		if (m_slots[slot].Pending || m_slots[slot].LastWanted == m_update)
+		{
+			continue;
+		}
+
+		if (oldest == NoSlot || m_slots[slot].LastWanted < m_slots[oldest].LastWanted)
+		{
+			oldest = slot;
+		}
+	}
+
+	if (oldest != NoSlot)
+	{
+		m_tileSlots[m_slots[oldest].Tile] = NoSlot;
+		m_slots[oldest].Tile = NoTile;
+		m_residentCount--;
+		m_evictionCount++;
+	}
+
+	return oldest;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, so the paging policy can be run and checked without a device or a file
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Struct to hold a tile to page in and the slot it goes into
+struct HeightmapTileRequest
+{
+	uint32_t TileX;
+	uint32_t TileZ;
+	uint32_t Slot;
+};
+
+// Decides which heightmap tiles are kept in a fixed number of slots. Tiles within a radius of the camera are wanted,
+// the nearest first, and a wanted tile that is not resident takes a free slot or the least recently wanted one.
+// Tiles still wanted this update and tiles being paged in are never evicted
+class HeightmapTileCache
+{
+public:
+#pragma region Setup Methods
+	// Empties the cache and sizes it for a grid of tiles and a number of slots
+	void Initialise(uint32_t tilesX, uint32_t tilesZ, uint32_t slotCount);
+#pragma endregion
+
+#pragma region Paging Methods
+	// Marks the tiles within radius of the camera as wanted and hands out slots to up to maxRequests of the ones
+	// that are not resident or on their way, nearest first. The camera and radius are in tiles
+	void Update(float cameraTileX, float cameraTileZ, float radiusTiles, uint32_t maxRequests,
+		std::vector<HeightmapTileRequest>& requests);
+
+	// Marks a requested tile as paged in, it can be drawn from its slot from now on
+	void MarkResident(const HeightmapTileRequest& request);
+#pragma endregion
+
+#pragma region Getters
+	// Gets the slot a tile is resident in
+	// Returns uint32_t - The slot, NoSlot if the tile is not resident yet
+	uint32_t GetSlot(uint32_t tileX, uint32_t tileZ) const;
+
+	// Gets the number of slots
+	// Returns uint32_t - The slot count
+	uint32_t GetSlotCount() const { return static_cast<uint32_t>(m_slots.size()); }
+
+	// Gets the number of tiles resident and being paged in
+	uint32_t GetResidentCount() const { return m_residentCount; }
+	uint32_t GetPendingCount() const { return m_pendingCount; }
+
+	// Gets the number of tiles evicted to make room since the cache was initialised
+	// Returns uint64_t - The eviction count
+	uint64_t GetEvictionCount() const { return m_evictionCount; }
+
+	// Slot of a tile that is not resident
+	static const uint32_t NoSlot = 0xFFFFFFFF;
+#pragma endregion
+
+private:
+#pragma region Private Types
+	// Tile of a free slot
+	static const uint32_t NoTile = 0xFFFFFFFF;
+
+	// Struct to hold what a slot holds
+	struct Slot
+	{
+		uint32_t Tile;
+		uint64_t LastWanted;
+		bool Pending;
+	};
+#pragma endregion
+
+#pragma region Private Methods
+	// Finds a slot for a new tile, evicting the tile wanted least recently if there are no free slots
+	// Returns uint32_t - The slot, NoSlot if every slot is wanted this update or still being paged in
+	uint32_t FindSlot();
+#pragma endregion
+
+#pragma region Member Variables
+	uint32_t m_tilesX = 0;
+	uint32_t m_tilesZ = 0;
+
+	// The slot of every tile, resident or on its way, and what each slot holds
+	std::vector<uint32_t> m_tileSlots;
+	std::vector<Slot> m_slots;
+
+	// Updates so far, a slot wanted in the current one cannot be evicted
+	uint64_t m_update = 0;
+
+	uint32_t m_residentCount = 0;
+	uint32_t m_pendingCount = 0;
+	uint64_t m_evictionCount = 0;
+
+	// Tiles wanted this update with their distance, kept to save allocating every update
+	std::vector<std::pair<float, uint32_t>> m_wanted;
+#pragma endregion
+};
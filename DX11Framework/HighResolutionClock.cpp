@@ -0,0 +1,48 @@
+// Include{s}
+#include "HighResolutionClock.h"
+#include <mmsystem.h>
+
+#pragma comment(lib, "winmm.lib")
+
+#pragma region Constructor & Destructor
+HighResolutionClock::HighResolutionClock()
+{
+	QueryPerformanceFrequency(&m_frequency);
+	QueryPerformanceCounter(&m_start);
+
+	timeBeginPeriod(1);
+}
+
+HighResolutionClock::~HighResolutionClock()
+{
+	timeEndPeriod(1);
+}
+#pragma endregion
+
+#pragma region Clock Methods
+double HighResolutionClock::GetSeconds() const
+{
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	return static_cast<double>(now.QuadPart - m_start.QuadPart) / static_cast<double>(m_frequency.QuadPart);
+}
+
+void HighResolutionClock::SleepFor(double seconds)
+{
+	const double spinSeconds = 0.002;
+	double end = GetSeconds() + seconds;
+
+	// Even at 1 ms timer resolution a Sleep can wake a little late, so the last stretch is spent spinning
+	double remaining = seconds - spinSeconds;
+	if (remaining >= 0.001)
+	{
+		Sleep(static_cast<DWORD>(remaining * 1000.0));
+	}
+
+	while (GetSeconds() < end)
+	{
+		YieldProcessor();
+	}
+}
+#pragma endregion
\ No newline at end of file
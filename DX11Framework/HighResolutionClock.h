@@ -0,0 +1,27 @@
+#pragma once
+
+// Include{s}
+#include "Clock.h"
+#include <windows.h>
+
+// Clock on the performance counter, sub-microsecond resolution instead of the 15.6 ms steps of GetTickCount64
+class HighResolutionClock : public Clock
+{
+public:
+#pragma region Constructor & Destructor
+	// Constructor reads the counter frequency and raises the system timer resolution to 1 ms for SleepFor
+	HighResolutionClock();
+
+	// Destructor restores the system timer resolution
+	~HighResolutionClock() override;
+#pragma endregion
+
+	double GetSeconds() const override;
+
+	// Sleeps for most of the time and spins for the last couple of milliseconds, Sleep alone can overshoot
+	void SleepFor(double seconds) override;
+
+private:
+	LARGE_INTEGER m_frequency = {};
+	LARGE_INTEGER m_start = {};
+};
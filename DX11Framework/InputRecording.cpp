@@ -0,0 +1,213 @@
+// Include{s}
+#include "InputRecording.h"
+#include <cstring>
+#include <fstream>
+
+#pragma region Stream Helpers
+namespace
+{
+	const char FileMagic[4] = { 'R', 'L', 'I', 'R' };
+	const uint32_t FileVersion = 1;
+
+	// Fields are written one at a time so the file has no padding, the byte order is the machine's, little endian
+	// on everything this builds for
+	template <typename T>
+	void WriteValue(std::ostream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	bool ReadValue(std::istream& stream, T& value)
+	{
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+}
+#pragma endregion
+
+#pragma region Recording Methods
+void InputRecording::AddFrame(double clockTime, double inputTime, const std::vector<InputEvent>& events,
+	const RecordedFrameState& state)
+{
+	RecordedFrame frame;
+	frame.ClockTime = clockTime;
+	frame.InputTime = inputTime;
+	frame.State = state;
+	frame.FirstEvent = static_cast<uint32_t>(m_events.size());
+	frame.EventCount = static_cast<uint32_t>(events.size());
+
+	m_frames.push_back(frame);
+	m_events.insert(m_events.end(), events.begin(), events.end());
+}
+
+void InputRecording::Clear()
+{
+	m_frames.clear();
+	m_events.clear();
+}
+#pragma endregion
+
+#pragma region File Methods
+bool InputRecording::Write(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::binary);
+
+	// Check if the file is open
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	return Write(file);
+}
+
+bool InputRecording::Write(std::ostream& stream) const
+{
+	stream.write(FileMagic, sizeof(FileMagic));
+	WriteValue(stream, FileVersion);
+	WriteValue(stream, static_cast<uint32_t>(m_frames.size()));
+	WriteValue(stream, static_cast<uint32_t>(m_events.size()));
+
+	for (const RecordedFrame& frame : m_frames)
+	{
+		WriteValue(stream, frame.ClockTime);
+
+		// The input is handled within a frame of the clock reading, a float offset holds it to well under a
+		// microsecond and the simulation never reads it
+		WriteValue(stream, static_cast<float>(frame.InputTime - frame.ClockTime));
+		WriteValue(stream, frame.State.ActiveCamera);
+		WriteValue(stream, frame.State.Toggles);
+		WriteValue(stream, frame.EventCount);
+
+		for (uint32_t i = 0; i < frame.EventCount; i++)
+		{
+			const InputEvent& event = m_events[frame.FirstEvent + i];
+
+			// Only the latency is worked out from the timestamp, so it is kept as the wait before the input time
+			WriteValue(stream, static_cast<uint8_t>(event.Type));
+			WriteValue(stream, event.Key);
+			WriteValue(stream, event.X);
+			WriteValue(stream, event.Y);
+			WriteValue(stream, static_cast<float>(frame.InputTime - event.Timestamp));
+		}
+	}
+
+	return static_cast<bool>(stream);
+}
+
+bool InputRecording::Read(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	// Check if the file is open
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	return Read(file);
+}
+
+bool InputRecording::Read(std::istream& stream)
+{
+	Clear();
+
+	char magic[sizeof(FileMagic)];
+	uint32_t version = 0;
+	uint32_t frameCount = 0;
+	uint32_t eventCount = 0;
+
+	if (!stream.read(magic, sizeof(magic)) || memcmp(magic, FileMagic, sizeof(FileMagic)) != 0 ||
+		!ReadValue(stream, version) || version != FileVersion || !ReadValue(stream, frameCount) ||
+		!ReadValue(stream, eventCount))
+	{
+		return false;
+	}
+
+	m_frames.reserve(frameCount);
+	m_events.reserve(eventCount);
+
+	for (uint32_t frameIndex = 0; frameIndex < frameCount; frameIndex++)
+	{
+		RecordedFrame frame;
+		float inputOffset = 0.0f;
+
+		if (!ReadValue(stream, frame.ClockTime) || !ReadValue(stream, inputOffset) ||
+			!ReadValue(stream, frame.State.ActiveCamera) || !ReadValue(stream, frame.State.Toggles) ||
+			!ReadValue(stream, frame.EventCount))
+		{
+			Clear();
+			return false;
+		}
+
+		frame.InputTime = frame.ClockTime + inputOffset;
+		frame.FirstEvent = static_cast<uint32_t>(m_events.size());
+
+		for (uint32_t i = 0; i < frame.EventCount; i++)
+		{
+			InputEvent event;
+			uint8_t type = 0;
+			float wait = 0.0f;
+
+			if (!ReadValue(stream, type) || !ReadValue(stream, event.Key) || !ReadValue(stream, event.X) ||
+				!ReadValue(stream, event.Y) || !ReadValue(stream, wait))
+			{
+				Clear();
+				return false;
+			}
+
+			event.Type = static_cast<InputEventType>(type);
+			event.Timestamp = frame.InputTime - wait;
+			m_events.push_back(event);
+		}
+
+		m_frames.push_back(frame);
+	}
+
+	// The header has to agree with what was actually in the file
+	if (m_events.size() != eventCount)
+	{
+		Clear();
+		return false;
+	}
+
+	return true;
+}
+#pragma endregion
+
+#pragma region Replay Methods
+void InputReplayer::Start(const InputRecording* recording)
+{
+	m_recording = recording;
+	m_frame = 0;
+	m_mismatches = 0;
+	m_firstMismatch = recording ? recording->GetFrameCount() : 0;
+}
+
+const RecordedFrame& InputReplayer::BeginFrame(InputSystem* input)
+{
+	const RecordedFrame& frame = m_recording->GetFrame(m_frame);
+	input->BeginReplayFrame(m_recording->GetEvents(frame), frame.EventCount, frame.InputTime);
+
+	return frame;
+}
+
+bool InputReplayer::EndFrame(const RecordedFrameState& state)
+{
+	const RecordedFrameState& recorded = m_recording->GetFrame(m_frame).State;
+	bool matches = recorded.ActiveCamera == state.ActiveCamera && recorded.Toggles == state.Toggles;
+
+	if (!matches)
+	{
+		if (m_mismatches == 0)
+		{
+			m_firstMismatch = m_frame;
+		}
+		m_mismatches++;
+	}
+
+	m_frame++;
+
+	return matches;
+}
+#pragma endregion
\ No newline at end of file
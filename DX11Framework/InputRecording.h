@@ -0,0 +1,145 @@
+#pragma once
+
+// Include{s}
+// Only the standard library and the input system, so recordings can be written and replayed without a window
+#include "InputSystem.h"
+#include <iosfwd>
+
+// Struct to hold the state an update left behind, compared on replay to catch a run drifting from its recording
+struct RecordedFrameState
+{
+	uint32_t ActiveCamera;
+
+	// One bit for each RecordedToggle
+	uint32_t Toggles;
+};
+
+// Bits of RecordedFrameState::Toggles
+enum RecordedToggle : uint32_t
+{
+	RecordedToggle_MainMenu = 1u << 0,
+	RecordedToggle_Fill = 1u << 1,
+	RecordedToggle_NoBackfaceCulling = 1u << 2,
+	RecordedToggle_WaveFilter = 1u << 3,
+	RecordedToggle_WaveFilterX = 1u << 4,
+	RecordedToggle_Pixelate = 1u << 5,
+	RecordedToggle_GoochShading = 1u << 6,
+	RecordedToggle_Lighting = 1u << 7,
+	RecordedToggle_Texture = 1u << 8,
+	RecordedToggle_UI = 1u << 9,
+	RecordedToggle_PerformanceHUD = 1u << 10,
+	RecordedToggle_MonitorWall = 1u << 11,
+	RecordedToggle_Rotation = 1u << 12,
+	RecordedToggle_MouseLook = 1u << 13
+};
+
+// Struct to hold one recorded update
+struct RecordedFrame
+{
+	// The clock reading the simulation loop took, replaying it steps the simulation exactly as it was stepped
+	double ClockTime;
+
+	// The clock reading the input was handled at
+	double InputTime;
+
+	RecordedFrameState State;
+
+	// The frame's events in the recording's event list
+	uint32_t FirstEvent;
+	uint32_t EventCount;
+};
+
+// Every update of a run, with the input events it handled and the time it ran at. Stored as a small binary file,
+// "RLIR", a version, the frame and event counts and then each frame followed by its events, all little endian
+class InputRecording
+{
+public:
+#pragma region Recording Methods
+	// Adds an update to the end of the recording
+	void AddFrame(double clockTime, double inputTime, const std::vector<InputEvent>& events,
+		const RecordedFrameState& state);
+
+	// Removes every frame
+	void Clear();
+#pragma endregion
+
+#pragma region File Methods
+	// Writes the recording
+	// Returns bool - False if the file could not be written
+	bool Write(const std::string& path) const;
+	bool Write(std::ostream& stream) const;
+
+	// Replaces the recording with one read back
+	// Returns bool - False if the file could not be read or is not a recording
+	bool Read(const std::string& path);
+	bool Read(std::istream& stream);
+#pragma endregion
+
+#pragma region Getters
+	// Gets the number of recorded updates
+	// Returns size_t - The frame count
+	size_t GetFrameCount() const { return m_frames.size(); }
+
+	// Gets a recorded update
+	// Returns RecordedFrame - The frame
+	const RecordedFrame& GetFrame(size_t index) const { return m_frames[index]; }
+
+	// Gets the first event of a recorded update, the frame's EventCount follow it
+	// Returns InputEvent* - The events, null if the frame has none
+	const InputEvent* GetEvents(const RecordedFrame& frame) const
+	{
+		return frame.EventCount > 0 ? &m_events[frame.FirstEvent] : nullptr;
+	}
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	std::vector<RecordedFrame> m_frames;
+	std::vector<InputEvent> m_events;
+#pragma endregion
+};
+
+// Feeds a recording back into the input system one update at a time, and counts the updates that ended in a
+// different state than they were recorded in
+class InputReplayer
+{
+public:
+#pragma region Replay Methods
+	// Starts replaying from the first frame, the recording is borrowed and has to outlive the replay
+	void Start(const InputRecording* recording);
+
+	// Hands the next frame's events to the input system in place of anything the window sent
+	// Returns RecordedFrame - The frame being replayed, set the simulation clock to its ClockTime before stepping
+	const RecordedFrame& BeginFrame(InputSystem* input);
+
+	// Compares the state the update left behind with the recording and moves on to the next frame
+	// Returns bool - True if the state matches
+	bool EndFrame(const RecordedFrameState& state);
+#pragma endregion
+
+#pragma region Getters
+	// Checks every frame has been replayed
+	// Returns bool - True when there is nothing left, or no recording
+	bool IsFinished() const { return !m_recording || m_frame >= m_recording->GetFrameCount(); }
+
+	// Gets the number of frames replayed so far
+	// Returns size_t - The frame count
+	size_t GetFrameIndex() const { return m_frame; }
+
+	// Gets the number of replayed frames whose state did not match the recording
+	// Returns size_t - The mismatched frame count
+	size_t GetMismatchCount() const { return m_mismatches; }
+
+	// Gets the first replayed frame whose state did not match the recording
+	// Returns size_t - The frame index, the frame count if every frame matched
+	size_t GetFirstMismatch() const { return m_firstMismatch; }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	const InputRecording* m_recording = nullptr;
+	size_t m_frame = 0;
+	size_t m_mismatches = 0;
+	size_t m_firstMismatch = 0;
+#pragma endregion
+};
@@ -0,0 +1,362 @@
+// Include{s}
+#include "InputSystem.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp> // Using nlohmann.json Library (Not Mine!)
+
+#pragma region Name Tables
+namespace
+{
+	// Struct to hold a name used in the action map and the key code it stands for
+	struct KeyName
+	{
+		const char* Name;
+		uint16_t Key;
+	};
+
+	// The codes are the Win32 virtual key codes, written out so this file does not need the Windows headers.
+	// Letters and digits are their own upper case characters and are handled before this table is searched
+	const KeyName KeyNames[] =
+	{
+		{ "Backspace", 0x08 }, { "Tab", 0x09 }, { "Return", 0x0D }, { "Shift", 0x10 }, { "Control", 0x11 },
+		{ "Alt", 0x12 }, { "Escape", 0x1B }, { "Space", 0x20 }, { "PageUp", 0x21 }, { "PageDown", 0x22 },
+		{ "End", 0x23 }, { "Home", 0x24 }, { "Left", 0x25 }, { "Up", 0x26 }, { "Right", 0x27 }, { "Down", 0x28 },
+		{ "Insert", 0x2D }, { "Delete", 0x2E }
+	};
+
+	constexpr uint16_t Numpad0Key = 0x60;
+	constexpr uint16_t F1Key = 0x70;
+
+	// In the same order as the InputAction enum
+	const char* const ActionNames[Action_Count] =
+	{
+		"MoveForward", "MoveBack", "MoveLeft", "MoveRight", "MoveUp", "MoveDown",
+		"LookUp", "LookDown", "LookLeft", "LookRight",
+		"ResetCamera", "ToggleMouseLook", "ToggleFill", "ToggleBackfaceCulling", "ToggleWaveFilter",
+		"ToggleWaveFilterX", "TogglePixelate", "ToggleGoochShading", "ToggleLighting", "ToggleTexture", "ToggleUI",
+		"TogglePerformanceHUD", "ToggleMonitorWall", "ToggleRotation",
+		"Camera0", "Camera1", "Camera2", "Camera3", "Camera4", "Camera5", "Camera6", "Camera7", "Camera8", "Camera9",
+		"NextCamera", "PreviousCamera", "Back", "MenuLeft", "MenuRight", "MenuSelect"
+	};
+}
+#pragma endregion
+
+#pragma region Queue Methods
+bool InputEventQueue::Push(const InputEvent& event)
+{
+	uint32_t head = m_head.load(std::memory_order_relaxed);
+	uint32_t tail = m_tail.load(std::memory_order_acquire);
+
+	// The indices only ever count up, so the difference is the fill even after they wrap
+	if (head - tail >= Capacity)
+	{
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	m_events[head & (Capacity - 1)] = event;
+
+	// Publish the event only once it is fully written
+	m_head.store(head + 1, std::memory_order_release);
+
+	return true;
+}
+
+bool InputEventQueue::Pop(InputEvent& event)
+{
+	uint32_t tail = m_tail.load(std::memory_order_relaxed);
+	uint32_t head = m_head.load(std::memory_order_acquire);
+
+	if (tail == head)
+	{
+		return false;
+	}
+
+	event = m_events[tail & (Capacity - 1)];
+
+	// Hand the slot back to the producer only once it has been read
+	m_tail.store(tail + 1, std::memory_order_release);
+
+	return true;
+}
+#pragma endregion
+
+#pragma region Event Methods
+void InputSystem::BeginFrame(double now)
+{
+	ResetFrameState();
+
+	InputEvent event;
+	while (m_queue.Pop(event))
+	{
+		m_frameEvents.push_back(event);
+		ApplyEvent(event);
+	}
+
+	MeasureLatency(now);
+}
+
+void InputSystem::BeginReplayFrame(const InputEvent* events, size_t count, double now)
+{
+	ResetFrameState();
+
+	// Live input would change what the replay does, so it is drained and dropped
+	InputEvent event;
+	while (m_queue.Pop(event))
+	{
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		m_frameEvents.push_back(events[i]);
+		ApplyEvent(events[i]);
+	}
+
+	MeasureLatency(now);
+}
+#pragma endregion
+
+#pragma region Action Methods
+bool InputSystem::LoadActionMap(const std::string& path)
+{
+	std::ifstream file(path);
+
+	// Check if the file is open
+	if (!file.is_open())
+	{
+		std::cerr << "Failed to open JSON file." << std::endl;
+		return false;
+	}
+
+	nlohmann::json inputActions;
+	file >> inputActions;
+
+	ClearBindings();
+
+	for (auto& action : inputActions["InputActions"].items())
+	{
+		InputAction inputAction = FindAction(action.key());
+		if (inputAction == Action_Count)
+		{
+			std::cerr << "Unknown input action " << action.key() << std::endl;
+			continue;
+		}
+
+		for (auto& keyName : action.value())
+		{
+			uint16_t key = FindKey(keyName.get<std::string>());
+			if (key == 0)
+			{
+				std::cerr << "Unknown key " << keyName.get<std::string>() << " bound to " << action.key() << std::endl;
+				continue;
+			}
+
+			BindKey(inputAction, key);
+		}
+	}
+
+	return true;
+}
+
+void InputSystem::BindKey(InputAction action, uint16_t key)
+{
+	if (action < Action_Count && key < KeyCount)
+	{
+		m_bindings[action].push_back(key);
+	}
+}
+
+void InputSystem::ClearBindings()
+{
+	for (auto& bindings : m_bindings)
+	{
+		bindings.clear();
+	}
+}
+
+uint16_t InputSystem::FindKey(const std::string& name)
+{
+	// Letters and digits are their own key codes
+	if (name.size() == 1)
+	{
+		char character = name[0];
+		if ((character >= 'A' && character <= 'Z') || (character >= '0' && character <= '9'))
+		{
+			return static_cast<uint16_t>(character);
+		}
+		return 0;
+	}
+
+	// F1 - F12
+	if (name.size() <= 3 && name[0] == 'F')
+	{
+		int number = atoi(name.c_str() + 1);
+		return number >= 1 && number <= 12 ? static_cast<uint16_t>(F1Key + number - 1) : 0;
+	}
+
+	// Numpad0 - Numpad9
+	if (name.size() == 7 && name.compare(0, 6, "Numpad") == 0 && name[6] >= '0' && name[6] <= '9')
+	{
+		return static_cast<uint16_t>(Numpad0Key + name[6] - '0');
+	}
+
+	for (const KeyName& keyName : KeyNames)
+	{
+		if (name == keyName.Name)
+		{
+			return keyName.Key;
+		}
+	}
+
+	return 0;
+}
+
+InputAction InputSystem::FindAction(const std::string& name)
+{
+	for (int action = 0; action < Action_Count; action++)
+	{
+		if (name == ActionNames[action])
+		{
+			return static_cast<InputAction>(action);
+		}
+	}
+
+	return Action_Count;
+}
+#pragma endregion
+
+#pragma region Action Getters
+bool InputSystem::IsActionDown(InputAction action) const
+{
+	for (uint16_t key : m_bindings[action])
+	{
+		// A tap that started and ended inside the frame still moves for one frame
+		if (m_held[key] || m_pressed[key])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool InputSystem::WasActionPressed(InputAction action) const
+{
+	for (uint16_t key : m_bindings[action])
+	{
+		if (m_pressed[key])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool InputSystem::WasActionReleased(InputAction action) const
+{
+	for (uint16_t key : m_bindings[action])
+	{
+		if (m_released[key])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+#pragma endregion
+
+#pragma region Private Methods
+void InputSystem::ResetFrameState()
+{
+	// Presses, releases and motion only last for the frame that drains them
+	memset(m_pressed, 0, sizeof(m_pressed));
+	memset(m_released, 0, sizeof(m_released));
+	m_mouseDeltaX = 0;
+	m_mouseDeltaY = 0;
+	m_wheelDelta = 0;
+	m_frameEvents.clear();
+}
+
+void InputSystem::ApplyEvent(const InputEvent& event)
+{
+	switch (event.Type)
+	{
+	case InputEvent_KeyDown:
+		if (event.Key < KeyCount)
+		{
+			// Held keys repeat, only the first down is a press
+			if (!m_held[event.Key])
+			{
+				m_pressed[event.Key] = 1;
+			}
+			m_held[event.Key] = 1;
+		}
+		break;
+
+	case InputEvent_KeyUp:
+		if (event.Key < KeyCount)
+		{
+			if (m_held[event.Key])
+			{
+				m_released[event.Key] = 1;
+			}
+			m_held[event.Key] = 0;
+		}
+		break;
+
+	case InputEvent_MouseMove:
+		m_mouseX = event.X;
+		m_mouseY = event.Y;
+		break;
+
+	case InputEvent_MouseDelta:
+		m_mouseDeltaX += event.X;
+		m_mouseDeltaY += event.Y;
+		break;
+
+	case InputEvent_MouseWheel:
+		m_wheelDelta += event.X;
+		break;
+
+	case InputEvent_FocusLost:
+		for (uint32_t key = 0; key < KeyCount; key++)
+		{
+			if (m_held[key])
+			{
+				m_released[key] = 1;
+			}
+		}
+		memset(m_held, 0, sizeof(m_held));
+		break;
+	}
+}
+
+void InputSystem::MeasureLatency(double now)
+{
+	double totalLatency = 0.0;
+	double maxLatency = 0.0;
+
+	for (const InputEvent& event : m_frameEvents)
+	{
+		double latency = now - event.Timestamp;
+		if (latency < 0.0)
+		{
+			latency = 0.0;
+		}
+
+		totalLatency += latency;
+		if (latency > maxLatency)
+		{
+			maxLatency = latency;
+		}
+	}
+
+	m_latency.EventCount = static_cast<uint32_t>(m_frameEvents.size());
+	m_latency.Average = m_frameEvents.empty() ? 0.0 : totalLatency / m_frameEvents.size();
+	m_latency.Max = maxLatency;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,270 @@
+#pragma once
+
+// Include{s}
+// Only the standard library and the JSON reader, so event streams can be replayed without a window
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Kinds of event the platform layer hands over
+enum InputEventType : uint8_t
+{
+	InputEvent_KeyDown,
+	InputEvent_KeyUp,
+	InputEvent_MouseMove, // X and Y are the cursor position in the client area
+	InputEvent_MouseDelta, // X and Y are raw relative motion, free of pointer acceleration
+	InputEvent_MouseWheel, // X is the wheel delta, 120 per notch
+	InputEvent_FocusLost // Every key is let go, the key ups go to whatever window took focus
+};
+
+// Struct to hold one input event, stamped when the platform layer received it
+struct InputEvent
+{
+	InputEventType Type;
+	uint16_t Key;
+	int32_t X;
+	int32_t Y;
+	double Timestamp;
+};
+
+// Everything the application responds to. Keys are bound to these in Input Actions.json, the code only asks about
+// actions
+enum InputAction
+{
+	Action_MoveForward,
+	Action_MoveBack,
+	Action_MoveLeft,
+	Action_MoveRight,
+	Action_MoveUp,
+	Action_MoveDown,
+	Action_LookUp,
+	Action_LookDown,
+	Action_LookLeft,
+	Action_LookRight,
+	Action_ResetCamera,
+	Action_ToggleMouseLook,
+	Action_ToggleFill,
+	Action_ToggleBackfaceCulling,
+	Action_ToggleWaveFilter,
+	Action_ToggleWaveFilterX,
+	Action_TogglePixelate,
+	Action_ToggleGoochShading,
+	Action_ToggleLighting,
+	Action_ToggleTexture,
+	Action_ToggleUI,
+	Action_TogglePerformanceHUD,
+	Action_ToggleMonitorWall,
+	Action_ToggleRotation,
+	Action_Camera0,
+	Action_Camera1,
+	Action_Camera2,
+	Action_Camera3,
+	Action_Camera4,
+	Action_Camera5,
+	Action_Camera6,
+	Action_Camera7,
+	Action_Camera8,
+	Action_Camera9,
+	Action_NextCamera,
+	Action_PreviousCamera,
+	Action_Back, // Leaves the scene for the main menu, or quits from the main menu
+	Action_MenuLeft,
+	Action_MenuRight,
+	Action_MenuSelect,
+	Action_Count
+};
+
+// Struct to hold how long the events drained in a frame waited between arriving and being handled
+struct InputLatency
+{
+	uint32_t EventCount;
+	double Average;
+	double Max;
+};
+
+// Single producer, single consumer ring of events. The window procedure pushes and the update pops, neither ever
+// waits on the other
+class InputEventQueue
+{
+public:
+#pragma region Queue Methods
+	// Adds an event, producer side only
+	// Returns bool - False if the queue was full and the event was dropped
+	bool Push(const InputEvent& event);
+
+	// Takes the oldest event, consumer side only
+	// Returns bool - False if the queue was empty
+	bool Pop(InputEvent& event);
+#pragma endregion
+
+#pragma region Getters
+	// Gets the number of events dropped because the queue was full
+	// Returns uint32_t - The dropped event count
+	uint32_t GetDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	// Power of two, so the indices wrap with a mask. Far more than a frame of typing and mouse motion
+	static constexpr uint32_t Capacity = 1024;
+
+	InputEvent m_events[Capacity] = {};
+
+	// Each side owns one index, on separate cache lines so they do not bounce between cores
+	alignas(64) std::atomic<uint32_t> m_head{ 0 };
+	alignas(64) std::atomic<uint32_t> m_tail{ 0 };
+	std::atomic<uint32_t> m_dropped{ 0 };
+#pragma endregion
+};
+
+// Turns the queued events into per-frame key and action state. Presses and releases are latched until the frame that
+// drains them, so a tap shorter than a frame is still seen as a press
+class InputSystem
+{
+public:
+#pragma region Singleton
+	// Only allow one instance of the InputSystem
+	// Singleton Pattern
+	InputSystem(const InputSystem&) = delete;
+	InputSystem& operator=(const InputSystem&) = delete;
+
+	// Get the instance of the InputSystem
+	// Returns InputSystem* - The instance of the InputSystem
+	static InputSystem* GetInstance()
+	{
+		static InputSystem instance;
+		return &instance;
+	}
+#pragma endregion
+
+#pragma region Event Methods
+	// Queues an event from the platform layer
+	// Returns bool - False if the event was dropped
+	bool PushEvent(const InputEvent& event) { return m_queue.Push(event); }
+
+	// Drains the queue into this frame's state, the time is on the same clock as the event timestamps
+	void BeginFrame(double now);
+
+	// Uses the given events as this frame's input instead, anything queued by the platform layer is thrown away
+	void BeginReplayFrame(const InputEvent* events, size_t count, double now);
+#pragma endregion
+
+#pragma region Action Methods
+	// Loads the key bindings for every action, { "InputActions": { "MoveForward": [ "W" ], ... } }
+	// Returns bool - True if the file was opened and read
+	bool LoadActionMap(const std::string& path);
+
+	// Binds a key to an action, on top of any keys already bound to it
+	void BindKey(InputAction action, uint16_t key);
+
+	// Removes every key binding
+	void ClearBindings();
+
+	// Looks up a key by the name used in the action map, letters, digits, F1 - F12, Numpad0 - Numpad9 and the
+	// named keys such as Escape or PageUp
+	// Returns uint16_t - The key code, zero if the name is not known
+	static uint16_t FindKey(const std::string& name);
+
+	// Looks up an action by the name used in the action map
+	// Returns InputAction - The action, Action_Count if the name is not known
+	static InputAction FindAction(const std::string& name);
+#pragma endregion
+
+#pragma region Key Getters
+	// Checks a key is held down at the end of the drained events
+	// Returns bool - True if the key is held
+	bool IsKeyHeld(uint16_t key) const { return key < KeyCount && m_held[key] != 0; }
+
+	// Checks a key went down during the frame, even if it came back up again
+	// Returns bool - True if the key was pressed
+	bool WasKeyPressed(uint16_t key) const { return key < KeyCount && m_pressed[key] != 0; }
+
+	// Checks a key came up during the frame
+	// Returns bool - True if the key was released
+	bool WasKeyReleased(uint16_t key) const { return key < KeyCount && m_released[key] != 0; }
+#pragma endregion
+
+#pragma region Action Getters
+	// Checks any key bound to the action is held, or was tapped during the frame
+	// Returns bool - True if the action is active this frame
+	bool IsActionDown(InputAction action) const;
+
+	// Checks any key bound to the action was pressed during the frame
+	// Returns bool - True if the action was triggered
+	bool WasActionPressed(InputAction action) const;
+
+	// Checks any key bound to the action was released during the frame
+	// Returns bool - True if the action was let go
+	bool WasActionReleased(InputAction action) const;
+#pragma endregion
+
+#pragma region Mouse Getters
+	// Gets the last cursor position in the client area
+	int32_t GetMouseX() const { return m_mouseX; }
+	int32_t GetMouseY() const { return m_mouseY; }
+
+	// Gets the raw mouse motion summed over the frame
+	int32_t GetMouseDeltaX() const { return m_mouseDeltaX; }
+	int32_t GetMouseDeltaY() const { return m_mouseDeltaY; }
+
+	// Gets the wheel motion summed over the frame
+	// Returns int32_t - The wheel delta, 120 per notch and positive away from the user
+	int32_t GetWheelDelta() const { return m_wheelDelta; }
+#pragma endregion
+
+#pragma region Getters
+	// Gets how long the events drained by the last BeginFrame waited
+	// Returns InputLatency - The latencies in seconds
+	const InputLatency& GetLatency() const { return m_latency; }
+
+	// Gets the number of events dropped because the queue was full
+	// Returns uint32_t - The dropped event count
+	uint32_t GetDroppedCount() const { return m_queue.GetDroppedCount(); }
+
+	// Gets the events handled by the last BeginFrame, in the order they arrived
+	// Returns std::vector<InputEvent> - The events
+	const std::vector<InputEvent>& GetFrameEvents() const { return m_frameEvents; }
+#pragma endregion
+
+private:
+#pragma region Constructor
+	// Constructor, nothing is bound until an action map is loaded
+	InputSystem() = default;
+#pragma endregion
+
+#pragma region Private Methods
+	// Clears the state that only lasts a frame
+	void ResetFrameState();
+
+	// Applies one event to the key and mouse state
+	void ApplyEvent(const InputEvent& event);
+
+	// Works out how long this frame's events waited
+	void MeasureLatency(double now);
+#pragma endregion
+
+#pragma region Member Variables
+	static constexpr uint32_t KeyCount = 256;
+
+	InputEventQueue m_queue;
+
+	// Kept between frames so draining does not allocate once it has grown
+	std::vector<InputEvent> m_frameEvents;
+
+	uint8_t m_held[KeyCount] = {};
+	uint8_t m_pressed[KeyCount] = {};
+	uint8_t m_released[KeyCount] = {};
+
+	// Keys bound to each action
+	std::vector<uint16_t> m_bindings[Action_Count];
+
+	int32_t m_mouseX = 0;
+	int32_t m_mouseY = 0;
+	int32_t m_mouseDeltaX = 0;
+	int32_t m_mouseDeltaY = 0;
+	int32_t m_wheelDelta = 0;
+
+	InputLatency m_latency = {};
+#pragma endregion
+};
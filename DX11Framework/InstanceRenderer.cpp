@@ -0,0 +1,225 @@
+// Include{s}
+#include "InstanceRenderer.h"
+#include "Profiler.h"
+#include "CounterRegistry.h"
+
+#pragma region Constructor & Destructor
+// Constructor
+InstanceRenderer::InstanceRenderer(RenderDevice* device, UINT initialCapacity)
+{
+	m_device = device;
+
+	CreateInstanceBuffer(initialCapacity);
+}
+
+// Destructor
+InstanceRenderer::~InstanceRenderer()
+{
+	if (m_instanceBuffer)
+	{
+		m_instanceBuffer->Release();
+		m_instanceBuffer = nullptr;
+	}
+
+	m_batches.clear();
+	m_batchLookup.clear();
+}
+#pragma endregion
+
+#pragma region Batching Methods
+void InstanceRenderer::Begin()
+{
+	// Keep the batches (and their vectors) around, most frames submit the same set of meshes
+	for (auto& batch : m_batches)
+	{
+		batch.Instances.clear();
+		batch.StartInstance = 0;
+	}
+
+	m_instanceCount = 0;
+}
+
+void InstanceRenderer::Submit(const MeshData& mesh, ID3D11ShaderResourceView* texture, ID3D11PixelShader* pixelShader,
+	bool transparent, const XMFLOAT4X4& world)
+{
+	// Nothing to draw for objects without a mesh
+	if (mesh.VertexBuffer == nullptr || mesh.IndexBuffer == nullptr || mesh.IndexCount == 0)
+	{
+		return;
+	}
+
+	InstanceBatchKey key = { mesh.VertexBuffer, mesh.IndexBuffer, mesh.IndexCount, texture, pixelShader, transparent };
+
+	// Find the batch for this key, or start a new one
+	auto it = m_batchLookup.find(key);
+	if (it == m_batchLookup.end())
+	{
+		InstanceBatch batch = {};
+		batch.Key = key;
+		batch.VBStride = mesh.VBStride;
+		batch.VBOffset = mesh.VBOffset;
+
+		it = m_batchLookup.emplace(key, m_batches.size()).first;
+		m_batches.push_back(batch);
+	}
+
+	m_batches[it->second].Instances.push_back({ world });
+	m_instanceCount++;
+}
+
+HRESULT InstanceRenderer::Upload(RenderContext* immediateContext)
+{
+	PROFILE_FUNCTION();
+
+	HRESULT hr = S_OK;
+
+	if (m_instanceCount == 0)
+	{
+		return hr;
+	}
+
+	// Grow the buffer geometrically so large scenes only pay for the resize a handful of times
+	if (m_instanceCount > m_instanceCapacity)
+	{
+		UINT newCapacity = m_instanceCapacity > 0 ? m_instanceCapacity : 1;
+		while (newCapacity < m_instanceCount)
+		{
+			newCapacity *= 2;
+		}
+
+		hr = CreateInstanceBuffer(newCapacity);
+		if (FAILED(hr)) return hr;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
+	hr = immediateContext->Map(m_instanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+	if (FAILED(hr)) return hr;
+
+	// Pack the batches back to back, each one remembers where its instances start
+	auto destination = static_cast<InstanceData*>(mappedSubresource.pData);
+	UINT writtenInstances = 0;
+
+	for (auto& batch : m_batches)
+	{
+		batch.StartInstance = writtenInstances;
+
+		if (batch.Instances.empty())
+		{
+			continue;
+		}
+
+		memcpy(destination + writtenInstances, batch.Instances.data(), sizeof(InstanceData) * batch.Instances.size());
+		writtenInstances += static_cast<UINT>(batch.Instances.size());
+	}
+
+	immediateContext->Unmap(m_instanceBuffer, 0);
+
+	return hr;
+}
+
+void InstanceRenderer::Draw(RenderContext* immediateContext, bool transparentPass) const
+{
+	PROFILE_FUNCTION();
+
+	ID3D11ShaderResourceView* boundTexture = nullptr;
+	ID3D11PixelShader* boundPixelShader = nullptr;
+	bool firstBatch = true;
+
+	UINT drawCalls = 0;
+	UINT filteredStateChanges = 0;
+	double triangles = 0.0;
+
+	for (const auto& batch : m_batches)
+	{
+		if (batch.Instances.empty() || batch.Key.Transparent != transparentPass)
+		{
+			continue;
+		}
+
+		// Only touch the pipeline when the material actually changes between batches
+		if (firstBatch || batch.Key.Texture != boundTexture)
+		{
+			immediateContext->PSSetShaderResources(0, 1, &batch.Key.Texture);
+			boundTexture = batch.Key.Texture;
+		}
+		else
+		{
+			filteredStateChanges++;
+		}
+		if (firstBatch || batch.Key.PixelShader != boundPixelShader)
+		{
+			immediateContext->PSSetShader(batch.Key.PixelShader, nullptr, 0);
+			boundPixelShader = batch.Key.PixelShader;
+		}
+		else
+		{
+			filteredStateChanges++;
+		}
+		firstBatch = false;
+
+		// Slot 0 holds the mesh, slot 1 holds the per-instance world matrices
+		ID3D11Buffer* vertexBuffers[2] = { batch.Key.VertexBuffer, m_instanceBuffer };
+		UINT strides[2] = { batch.VBStride, sizeof(InstanceData) };
+		UINT offsets[2] = { batch.VBOffset, 0 };
+
+		immediateContext->IASetVertexBuffers(0, 2, vertexBuffers, strides, offsets);
+		immediateContext->IASetIndexBuffer(batch.Key.IndexBuffer, DXGI_FORMAT_R16_UINT, 0);
+
+		immediateContext->DrawIndexedInstanced(batch.Key.IndexCount, static_cast<UINT>(batch.Instances.size()), 0, 0,
+			batch.StartInstance);
+
+		drawCalls++;
+		triangles += static_cast<double>(batch.Key.IndexCount / 3) * batch.Instances.size();
+	}
+
+	CounterRegistry* counters = CounterRegistry::GetInstance();
+	counters->Add(Counter_DrawCalls, drawCalls);
+	counters->Add(Counter_StateChangesFiltered, filteredStateChanges);
+	counters->Add(Counter_TrianglesSubmitted, triangles);
+}
+#pragma endregion
+
+#pragma region Getters
+UINT InstanceRenderer::GetActiveBatchCount() const
+{
+	UINT activeBatches = 0;
+
+	for (const auto& batch : m_batches)
+	{
+		if (!batch.Instances.empty())
+		{
+			activeBatches++;
+		}
+	}
+
+	return activeBatches;
+}
+#pragma endregion
+
+#pragma region Private Methods
+HRESULT InstanceRenderer::CreateInstanceBuffer(UINT capacity)
+{
+	if (m_instanceBuffer)
+	{
+		m_instanceBuffer->Release();
+		m_instanceBuffer = nullptr;
+	}
+
+	D3D11_BUFFER_DESC instanceBufferDesc = {};
+	instanceBufferDesc.ByteWidth = sizeof(InstanceData) * capacity;
+	instanceBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	instanceBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	instanceBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	HRESULT hr = m_device->CreateBuffer(&instanceBufferDesc, nullptr, &m_instanceBuffer);
+	if (FAILED(hr))
+	{
+		m_instanceCapacity = 0;
+		return hr;
+	}
+
+	m_instanceCapacity = capacity;
+
+	return hr;
+}
+#pragma endregion
\ No newline at end of file
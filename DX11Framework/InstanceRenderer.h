@@ -0,0 +1,95 @@
+#pragma once
+
+// Include{s}
+#include "RenderContext.h"
+#include <tuple>
+
+// Everything that has to match for two draws to be merged into one DrawIndexedInstanced call
+struct InstanceBatchKey
+{
+	ID3D11Buffer* VertexBuffer;
+	ID3D11Buffer* IndexBuffer;
+	UINT IndexCount;
+	ID3D11ShaderResourceView* Texture;
+	ID3D11PixelShader* PixelShader;
+	bool Transparent;
+
+	bool operator<(const InstanceBatchKey& other) const
+	{
+		return std::tie(VertexBuffer, IndexBuffer, IndexCount, Texture, PixelShader, Transparent) <
+			std::tie(other.VertexBuffer, other.IndexBuffer, other.IndexCount, other.Texture, other.PixelShader,
+				other.Transparent);
+	}
+};
+
+// A group of instances that share a mesh, material and shader
+struct InstanceBatch
+{
+	InstanceBatchKey Key;
+	UINT VBStride;
+	UINT VBOffset;
+	UINT StartInstance;
+	std::vector<InstanceData> Instances;
+};
+
+class InstanceRenderer
+{
+public:
+#pragma region Constructor & Destructor
+	// Constructor creates the per-instance vertex buffer
+	InstanceRenderer(RenderDevice* device, UINT initialCapacity = 1024);
+
+	// Destructor
+	~InstanceRenderer();
+#pragma endregion
+
+#pragma region Batching Methods
+	// Empties the batches from the last frame, the batches and their capacity are kept so the steady state does not allocate
+	void Begin();
+
+	// Adds an instance to the batch that matches its mesh, texture, pixel shader and blend mode
+	void Submit(const MeshData& mesh, ID3D11ShaderResourceView* texture, ID3D11PixelShader* pixelShader,
+		bool transparent, const XMFLOAT4X4& world);
+
+	// Writes every batch into the instance buffer with a single map, growing the buffer if needed
+	HRESULT Upload(RenderContext* immediateContext);
+
+	// Draws every non-empty batch of the opaque or the transparent pass with one DrawIndexedInstanced each
+	void Draw(RenderContext* immediateContext, bool transparentPass) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the batches built this frame (including the empty ones kept from previous frames)
+	// Returns std::vector<InstanceBatch> - The instance batches
+	const std::vector<InstanceBatch>& GetBatches() const { return m_batches; }
+
+	// Gets the number of batches that will issue a draw call this frame
+	// Returns UINT - The non-empty batch count
+	UINT GetActiveBatchCount() const;
+
+	// Gets the number of instances submitted this frame
+	// Returns UINT - The instance count
+	UINT GetInstanceCount() const { return m_instanceCount; }
+
+	// Gets the per-instance vertex buffer Upload writes the batches into
+	// Returns ID3D11Buffer* - The instance buffer
+	ID3D11Buffer* GetInstanceBuffer() const { return m_instanceBuffer; }
+#pragma endregion
+
+private:
+#pragma region Private Methods
+	// (Re)creates the dynamic instance buffer with the given capacity
+	HRESULT CreateInstanceBuffer(UINT capacity);
+#pragma endregion
+
+#pragma region Member Variables
+	RenderDevice* m_device = nullptr;
+	ID3D11Buffer* m_instanceBuffer = nullptr;
+	UINT m_instanceCapacity = 0;
+	UINT m_instanceCount = 0;
+
+	// Batches are looked up by key, the map stores the index into m_batches
+	std::map<InstanceBatchKey, size_t> m_batchLookup;
+	std::vector<InstanceBatch> m_batches;
+#pragma endregion
+};
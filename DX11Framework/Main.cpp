@@ -10,19 +10,284 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 	_In_ int nCmdShow)
 {
 	UNREFERENCED_PARAMETER(hPrevInstance);
-	UNREFERENCED_PARAMETER(lpCmdLine);
+
+	PROFILE_THREAD("Main");
+
+#pragma region Heightmap Conversion
+	// --convert-heightmap <raw> <width> <height> <bits> <tiled> converts a raw heightmap into the tiled format the
+	// terrain streams from and exits, without creating a window or a device. Tiles of 256 samples keep a 16k x 16k
+	// heightmap within the tiles the terrain can address
+	int conversionArgumentCount = 0;
+	LPWSTR* conversionArguments = CommandLineToArgvW(lpCmdLine, &conversionArgumentCount);
+
+	for (int i = 0; conversionArguments && i + 5 < conversionArgumentCount; i++)
+	{
+		if (wcscmp(conversionArguments[i], L"--convert-heightmap") == 0)
+		{
+			std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+			bool converted = TiledHeightmap::ConvertRaw(converter.to_bytes(conversionArguments[i + 1]),
+				static_cast<uint32_t>(_wtoi(conversionArguments[i + 2])),
+				static_cast<uint32_t>(_wtoi(conversionArguments[i + 3])),
+				static_cast<uint32_t>(_wtoi(conversionArguments[i + 4])), 256,
+				converter.to_bytes(conversionArguments[i + 5]));
+
+			LocalFree(conversionArguments);
+			return converted ? 0 : -1;
+		}
+	}
+	LocalFree(conversionArguments);
+#pragma endregion
+
+#pragma region Profile Report
+#ifdef PROFILER_ENABLED
+	// --profile writes everything captured this run as a Chrome trace on exit, with the rolling statistics next to it.
+	// Written from a destructor so benchmark, replay and failed runs that return early are covered too
+	struct ProfileReport
+	{
+		bool Enabled;
+
+		~ProfileReport()
+		{
+			if (Enabled)
+			{
+				Profiler::GetInstance()->WriteChromeTrace("profile_trace.json");
+
+				std::ofstream report("profile_report.txt");
+				Profiler::GetInstance()->Print(report);
+			}
+		}
+	};
+	ProfileReport profileReport = { wcsstr(lpCmdLine, L"--profile") != nullptr };
+#endif
+#pragma endregion
 
 #pragma region Application Initialization
 	// Create the application
 	auto application = std::make_unique<DX11Framework>();
 
-	if (FAILED(application->Initialise(hInstance, nCmdShow)))
+	// --headless runs the frame loop on the null backend, nothing is drawn and no window is opened
+	bool headless = wcsstr(lpCmdLine, L"--headless") != nullptr;
+
+	if (FAILED(headless ? application->InitialiseHeadless() : application->Initialise(hInstance, nCmdShow)))
 	{
 		return -1;
 	}
 #pragma endregion
 
+#pragma region Memory Report
+	// --memory-report loads the scene, runs a single frame, writes the memory statistics and exits
+	if (wcsstr(lpCmdLine, L"--memory-report"))
+	{
+		application->Update();
+		application->Draw();
+
+		// The next update closes the frame, so the per-frame counts cover one full update and draw
+		application->Update();
+
+		MemoryTracker::GetInstance()->WriteJSON("memory_report.json");
+
+		// Print to the console that launched the program, if there is one
+		FILE* console = nullptr;
+		if (AttachConsole(ATTACH_PARENT_PROCESS))
+		{
+			freopen_s(&console, "CONOUT$", "w", stdout);
+		}
+		MemoryTracker::GetInstance()->Print(std::cout);
+
+		return 0;
+	}
+#pragma endregion
+
+#pragma region Benchmark
+	// --benchmark <script> flies the debug camera along the scripted path for a fixed number of frames, writes the
+	// per-frame timings and their percentiles and exits
+	int argumentCount = 0;
+	LPWSTR* arguments = CommandLineToArgvW(lpCmdLine, &argumentCount);
+	std::wstring benchmarkScript;
+	std::wstring recordPath;
+	std::wstring replayPath;
+	UINT viewCount = 0;
+
+	for (int i = 0; arguments && i + 1 < argumentCount; i++)
+	{
+		if (wcscmp(arguments[i], L"--benchmark") == 0)
+		{
+			benchmarkScript = arguments[i + 1];
+		}
+
+		// --fps-limit <rate> caps the frame rate while playing, the main menu and background caps apply regardless
+		if (wcscmp(arguments[i], L"--fps-limit") == 0)
+		{
+			application->SetTargetFrameRate(_wtof(arguments[i + 1]));
+		}
+
+		// --views <count> draws that many cameras at once as a monitor wall, replacing the view count of a benchmark
+		if (wcscmp(arguments[i], L"--views") == 0)
+		{
+			viewCount = static_cast<UINT>(_wtoi(arguments[i + 1]));
+		}
+
+		// --record <file> writes the input, clock readings and state of every update to the file on exit
+		if (wcscmp(arguments[i], L"--record") == 0)
+		{
+			recordPath = arguments[i + 1];
+		}
+
+		// --replay <file> runs a recording again, frame for frame, writes the frame timings and exits
+		if (wcscmp(arguments[i], L"--replay") == 0)
+		{
+			replayPath = arguments[i + 1];
+		}
+	}
+	LocalFree(arguments);
+
+	if (viewCount > 0)
+	{
+		application->SetViewCount(viewCount);
+	}
+
+	std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+
+	// A headless run has no window to take input from, so it always runs a benchmark or a replay
+	if (headless && benchmarkScript.empty() && replayPath.empty())
+	{
+		benchmarkScript = L"JSON Files\\Benchmark Flythrough.json";
+	}
+
+	if (!benchmarkScript.empty())
+	{
+		if (FAILED(application->StartBenchmark(converter.to_bytes(benchmarkScript), viewCount)))
+		{
+			return -1;
+		}
+
+		BenchmarkRecorder recorder;
+		MSG benchmarkMsg = { nullptr };
+
+		for (size_t frame = 0; frame < application->GetBenchmarkScript().Frames; frame++)
+		{
+			// Keep the window responding, but never wait on it
+			while (PeekMessage(&benchmarkMsg, nullptr, 0, 0, PM_REMOVE))
+			{
+				TranslateMessage(&benchmarkMsg);
+				DispatchMessageW(&benchmarkMsg);
+			}
+
+			recorder.BeginFrame();
+			application->Update();
+			recorder.EndUpdate();
+			application->Draw();
+			recorder.EndFrame();
+		}
+
+		recorder.WriteCSV("benchmark_frames.csv");
+		recorder.WriteJSON("benchmark_summary.json", application->GetBenchmarkScript());
+		application->WriteTerrainVisibility("benchmark_terrain.csv");
+
+		// Headless runs report what the null backend counted and fail if any call did not validate
+		const NullRenderContext* nullContext = application->GetNullRenderContext();
+		if (nullContext)
+		{
+			FILE* console = nullptr;
+			if (AttachConsole(ATTACH_PARENT_PROCESS))
+			{
+				freopen_s(&console, "CONOUT$", "w", stdout);
+			}
+			nullContext->Print(std::cout);
+
+			// How much of the terrain survived the per-chunk frustum test along the path, over the frames that had any
+			double visiblePercent = 0.0;
+			size_t terrainSamples = 0;
+			for (const TerrainVisibilitySample& sample : application->GetTerrainVisibility())
+			{
+				if (sample.Stats.TotalChunks > 0)
+				{
+					visiblePercent += 100.0 * sample.Stats.VisibleChunks / sample.Stats.TotalChunks;
+					terrainSamples++;
+				}
+			}
+			if (terrainSamples > 0)
+			{
+				visiblePercent /= terrainSamples;
+			}
+			std::cout << "Terrain Chunks Visible: " << visiblePercent << "% average" << std::endl;
+
+			return nullContext->GetStats().ValidationErrors == 0 ? 0 : 1;
+		}
+
+		return 0;
+	}
+#pragma endregion
+
+#pragma region Replay
+	if (!replayPath.empty())
+	{
+		std::string replayFile = converter.to_bytes(replayPath);
+		if (FAILED(application->StartInputReplay(replayFile)))
+		{
+			return -1;
+		}
+
+		BenchmarkRecorder recorder;
+		MSG replayMsg = { nullptr };
+
+		while (!application->GetInputReplayer().IsFinished())
+		{
+			// Keep the window responding, anything typed is thrown away by the replay
+			while (PeekMessage(&replayMsg, nullptr, 0, 0, PM_REMOVE))
+			{
+				TranslateMessage(&replayMsg);
+				DispatchMessageW(&replayMsg);
+			}
+
+			recorder.BeginFrame();
+			application->Update();
+			recorder.EndUpdate();
+			application->Draw();
+			recorder.EndFrame();
+		}
+
+		// Reported like a benchmark, with the recording's average frame time as the timestep
+		const InputRecording& recording = application->GetInputRecording();
+		BenchmarkScript replayScript = {};
+		replayScript.Name = replayFile;
+		replayScript.Frames = recording.GetFrameCount();
+		replayScript.Views = application->GetViewCount();
+		if (recording.GetFrameCount() > 1)
+		{
+			replayScript.Timestep = static_cast<float>(
+				(recording.GetFrame(recording.GetFrameCount() - 1).ClockTime - recording.GetFrame(0).ClockTime) /
+				(recording.GetFrameCount() - 1));
+		}
+
+		recorder.WriteCSV("replay_frames.csv");
+		recorder.WriteJSON("replay_summary.json", replayScript);
+
+		// A replay that did not end up where the recording did has not run the same workload, so it fails
+		const InputReplayer& replayer = application->GetInputReplayer();
+		FILE* console = nullptr;
+		if (AttachConsole(ATTACH_PARENT_PROCESS))
+		{
+			freopen_s(&console, "CONOUT$", "w", stdout);
+		}
+		std::cout << "Replayed " << replayer.GetFrameIndex() << " frames, " << replayer.GetMismatchCount() <<
+			" did not match the recording";
+		if (replayer.GetMismatchCount() > 0)
+		{
+			std::cout << ", the first at frame " << replayer.GetFirstMismatch();
+		}
+		std::cout << std::endl;
+
+		return replayer.GetMismatchCount() == 0 ? 0 : 1;
+	}
+#pragma endregion
+
 #pragma region Main Message Loop
+	if (!recordPath.empty())
+	{
+		application->StartInputRecording();
+	}
+
 	// Main message loop
 	MSG msg = { nullptr };
 
@@ -35,12 +300,27 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 		}
 		else
 		{
+			// Minimized and covered windows wait here instead of drawing frames nobody sees
+			if (application->WaitIfIdle())
+			{
+				continue;
+			}
+
+			PROFILE_SCOPE("Frame");
+
 			application->Update();
 			application->Draw();
 		}
 	}
 #pragma endregion
 
+#pragma region Recording
+	if (!recordPath.empty() && FAILED(application->StopInputRecording(converter.to_bytes(recordPath))))
+	{
+		return -1;
+	}
+#pragma endregion
+
 	return static_cast<int>(msg.wParam);
 }
 
@@ -0,0 +1,57 @@
+#pragma once
+
+// Include{s}
+// The mapping calls are the only platform code, so anything read through it still builds and runs without Windows
+#include <cstddef>
+#include <string>
+
+// Read only view of a whole file mapped into memory. Pages are only read from disk when they are first touched, so
+// files far larger than the memory can be opened and read a piece at a time
+class MappedFile
+{
+public:
+#pragma region Constructor & Destructor
+	MappedFile() = default;
+
+	// Only one owner of a mapping
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Destructor unmaps the file
+	~MappedFile();
+#pragma endregion
+
+#pragma region File Methods
+	// Maps a file, closing anything mapped before
+	// Returns bool - False if the file could not be opened or is empty
+	bool Open(const std::string& path);
+
+	// Unmaps the file
+	void Close();
+#pragma endregion
+
+#pragma region Getters
+	// Gets the start of the mapping
+	// Returns unsigned char* - The file contents, null when nothing is mapped
+	const unsigned char* GetData() const { return m_data; }
+
+	// Gets the size of the mapping
+	// Returns size_t - The file size in bytes
+	size_t GetSize() const { return m_size; }
+
+	// Checks a file is mapped
+	// Returns bool - True if a file is mapped
+	bool IsOpen() const { return m_data != nullptr; }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+
+	// File and mapping handles on Windows, the descriptor elsewhere
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+	int m_descriptor = -1;
+#pragma endregion
+};
@@ -0,0 +1,222 @@
+// Include{s}
+#include "MemoryTracker.h"
+#include <nlohmann/json.hpp> // Using nlohmann.json Library (Not Mine!)
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+// Names in the same order as the MemoryTag enum
+static const char* const g_memoryTagNames[MemoryTag_Count] =
+{
+	"General", "Meshes", "Textures", "JSON", "Terrain", "Scene", "Rendering"
+};
+
+// Tag of the allocations made on each thread
+static thread_local MemoryTag t_currentTag = MemoryTag_General;
+
+#pragma region Allocation Hooks
+#ifdef MEMORY_TRACKING
+// Every block carries its size and tag in front of it, so delete knows what to release, 16 bytes keeps the block
+// aligned the same as malloc
+struct AllocationHeader
+{
+	size_t Size;
+	MemoryTag Tag;
+};
+
+constexpr size_t AllocationHeaderSize = 16;
+static_assert(sizeof(AllocationHeader) <= AllocationHeaderSize, "The allocation header must fit in front of the block");
+
+void* operator new(size_t size)
+{
+	auto header = static_cast<AllocationHeader*>(malloc(AllocationHeaderSize + size));
+
+	if (header == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	header->Size = size;
+	header->Tag = t_currentTag;
+	MemoryTracker::GetInstance()->RecordAllocation(header->Tag, size);
+
+	return reinterpret_cast<unsigned char*>(header) + AllocationHeaderSize;
+}
+
+void operator delete(void* block) noexcept
+{
+	if (block == nullptr)
+	{
+		return;
+	}
+
+	auto header = reinterpret_cast<AllocationHeader*>(static_cast<unsigned char*>(block) - AllocationHeaderSize);
+	MemoryTracker::GetInstance()->RecordFree(header->Tag, header->Size);
+
+	free(header);
+}
+#endif
+#pragma endregion
+
+#pragma region Tracking Methods
+void MemoryTracker::RecordAllocation(MemoryTag tag, size_t size)
+{
+	TagCounters& counters = m_counters[tag];
+	int64_t bytes = static_cast<int64_t>(size);
+
+	int64_t current = counters.CurrentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	counters.CurrentCount.fetch_add(1, std::memory_order_relaxed);
+	counters.TotalCount.fetch_add(1, std::memory_order_relaxed);
+	counters.TotalBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+	// Raise the peak, another thread may have raised it further in the meantime
+	int64_t peak = counters.PeakBytes.load(std::memory_order_relaxed);
+	while (current > peak && !counters.PeakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+	{
+	}
+}
+
+void MemoryTracker::RecordFree(MemoryTag tag, size_t size)
+{
+	TagCounters& counters = m_counters[tag];
+
+	counters.CurrentBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+	counters.CurrentCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::BeginFrame()
+{
+	for (TagCounters& counters : m_counters)
+	{
+		int64_t totalCount = counters.TotalCount.load(std::memory_order_relaxed);
+		int64_t totalBytes = counters.TotalBytes.load(std::memory_order_relaxed);
+
+		counters.FrameCount = totalCount - counters.FrameStartCount;
+		counters.FrameBytes = totalBytes - counters.FrameStartBytes;
+		counters.FrameStartCount = totalCount;
+		counters.FrameStartBytes = totalBytes;
+	}
+}
+
+MemoryTag MemoryTracker::GetCurrentTag()
+{
+	return t_currentTag;
+}
+
+void MemoryTracker::SetCurrentTag(MemoryTag tag)
+{
+	t_currentTag = tag;
+}
+#pragma endregion
+
+#pragma region Report Methods
+MemoryTagStats MemoryTracker::GetStats(MemoryTag tag) const
+{
+	const TagCounters& counters = m_counters[tag];
+
+	MemoryTagStats stats = {};
+	stats.Name = g_memoryTagNames[tag];
+	stats.CurrentBytes = counters.CurrentBytes.load(std::memory_order_relaxed);
+	stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+	stats.CurrentCount = counters.CurrentCount.load(std::memory_order_relaxed);
+	stats.TotalCount = counters.TotalCount.load(std::memory_order_relaxed);
+	stats.TotalBytes = counters.TotalBytes.load(std::memory_order_relaxed);
+	stats.FrameCount = counters.FrameCount;
+	stats.FrameBytes = counters.FrameBytes;
+
+	return stats;
+}
+
+MemoryTagStats MemoryTracker::GetTotalStats() const
+{
+	MemoryTagStats total = {};
+	total.Name = "Total";
+
+	// The peaks of each tag can happen at different times, so their sum is an upper bound
+	for (uint32_t tag = 0; tag < MemoryTag_Count; tag++)
+	{
+		MemoryTagStats stats = GetStats(static_cast<MemoryTag>(tag));
+		total.CurrentBytes += stats.CurrentBytes;
+		total.PeakBytes += stats.PeakBytes;
+		total.CurrentCount += stats.CurrentCount;
+		total.TotalCount += stats.TotalCount;
+		total.TotalBytes += stats.TotalBytes;
+		total.FrameCount += stats.FrameCount;
+		total.FrameBytes += stats.FrameBytes;
+	}
+
+	return total;
+}
+
+bool MemoryTracker::WriteJSON(const std::string& path) const
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+	{
+		std::cerr << "Failed to open " << path << " for the memory report." << std::endl;
+		return false;
+	}
+
+	auto statsToJSON = [](const MemoryTagStats& stats)
+	{
+		return nlohmann::json{
+			{ "currentBytes", stats.CurrentBytes }, { "peakBytes", stats.PeakBytes },
+			{ "currentCount", stats.CurrentCount }, { "totalCount", stats.TotalCount },
+			{ "totalBytes", stats.TotalBytes }, { "frameCount", stats.FrameCount }, { "frameBytes", stats.FrameBytes }
+		};
+	};
+
+	nlohmann::json report;
+	report["enabled"] = IsEnabled();
+	for (uint32_t tag = 0; tag < MemoryTag_Count; tag++)
+	{
+		MemoryTagStats stats = GetStats(static_cast<MemoryTag>(tag));
+		report["tags"][stats.Name] = statsToJSON(stats);
+	}
+	report["total"] = statsToJSON(GetTotalStats());
+
+	file << report.dump(4) << std::endl;
+
+	return true;
+}
+
+void MemoryTracker::Print(std::ostream& stream) const
+{
+	if (!IsEnabled())
+	{
+		stream << "Memory tracking is off, build in debug or define MEMORY_TRACKING." << std::endl;
+		return;
+	}
+
+	stream << std::left << std::setw(12) << "Tag" << std::right << std::setw(14) << "Current KB" << std::setw(14)
+		<< "Peak KB" << std::setw(12) << "Live" << std::setw(12) << "Total" << std::setw(12) << "Frame" << std::endl;
+
+	auto printRow = [&stream](const MemoryTagStats& stats)
+	{
+		stream << std::left << std::setw(12) << stats.Name << std::right << std::fixed << std::setprecision(1)
+			<< std::setw(14) << stats.CurrentBytes / 1024.0 << std::setw(14) << stats.PeakBytes / 1024.0
+			<< std::setw(12) << stats.CurrentCount << std::setw(12) << stats.TotalCount << std::setw(12)
+			<< stats.FrameCount << std::endl;
+	};
+
+	for (uint32_t tag = 0; tag < MemoryTag_Count; tag++)
+	{
+		printRow(GetStats(static_cast<MemoryTag>(tag)));
+	}
+	printRow(GetTotalStats());
+}
+#pragma endregion
+
+#pragma region Getters
+bool MemoryTracker::IsEnabled()
+{
+#ifdef MEMORY_TRACKING
+	return true;
+#else
+	return false;
+#endif
+}
+#pragma endregion
\ No newline at end of file
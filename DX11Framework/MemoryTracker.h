@@ -0,0 +1,145 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, so the counters build and are tested without D3D or Windows
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// The operator new/delete hooks are compiled in for debug builds, define MEMORY_TRACKING to keep them in release
+#if defined(_DEBUG) && !defined(MEMORY_TRACKING)
+#define MEMORY_TRACKING
+#endif
+
+// Subsystems memory is charged to, allocations made outside a MemoryTagScope count as general
+enum MemoryTag : uint32_t
+{
+	MemoryTag_General,
+	MemoryTag_Meshes,
+	MemoryTag_Textures,
+	MemoryTag_JSON,
+	MemoryTag_Terrain,
+	MemoryTag_Scene,
+	MemoryTag_Rendering,
+	MemoryTag_Count
+};
+
+// Struct to hold a snapshot of one tag's statistics
+struct MemoryTagStats
+{
+	const char* Name;
+	int64_t CurrentBytes;
+	int64_t PeakBytes;
+	int64_t CurrentCount;
+	int64_t TotalCount;
+	int64_t TotalBytes;
+	int64_t FrameCount;
+	int64_t FrameBytes;
+};
+
+class MemoryTracker
+{
+public:
+#pragma region Singleton
+	// Only allow one instance of the MemoryTracker
+	// Singleton Pattern
+	MemoryTracker(const MemoryTracker&) = delete;
+	MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+	// Get the instance of the MemoryTracker, usable from the very first allocation
+	// Returns MemoryTracker* - The instance of the MemoryTracker
+	static MemoryTracker* GetInstance()
+	{
+		static MemoryTracker instance;
+		return &instance;
+	}
+#pragma endregion
+
+#pragma region Tracking Methods
+	// Charges an allocation to a tag, called by the operator new hook
+	void RecordAllocation(MemoryTag tag, size_t size);
+
+	// Releases an allocation from a tag, called by the operator delete hook
+	void RecordFree(MemoryTag tag, size_t size);
+
+	// Closes the frame, the per-frame counts become the allocations made since the last call
+	void BeginFrame();
+
+	// Gets the tag new allocations on this thread are charged to
+	// Returns MemoryTag - The current tag
+	static MemoryTag GetCurrentTag();
+
+	// Sets the tag new allocations on this thread are charged to
+	static void SetCurrentTag(MemoryTag tag);
+#pragma endregion
+
+#pragma region Report Methods
+	// Gets the statistics of one tag
+	// Returns MemoryTagStats - A snapshot of the statistics
+	MemoryTagStats GetStats(MemoryTag tag) const;
+
+	// Gets the statistics of every tag added together
+	// Returns MemoryTagStats - A snapshot of the totals
+	MemoryTagStats GetTotalStats() const;
+
+	// Writes every tag's statistics to a JSON file
+	// Returns bool - False if the file could not be opened
+	bool WriteJSON(const std::string& path) const;
+
+	// Prints every tag's statistics as a table
+	void Print(std::ostream& stream) const;
+#pragma endregion
+
+#pragma region Getters
+	// Checks the operator new/delete hooks are compiled in
+	// Returns bool - True if allocations are being tracked
+	static bool IsEnabled();
+#pragma endregion
+
+private:
+#pragma region Constructor
+	// Default constructor
+	MemoryTracker() = default;
+#pragma endregion
+
+#pragma region Member Variables
+	// Counters of one tag, updated from any thread
+	struct TagCounters
+	{
+		std::atomic<int64_t> CurrentBytes{ 0 };
+		std::atomic<int64_t> PeakBytes{ 0 };
+		std::atomic<int64_t> CurrentCount{ 0 };
+		std::atomic<int64_t> TotalCount{ 0 };
+		std::atomic<int64_t> TotalBytes{ 0 };
+
+		// Totals at the start and end of the last full frame, only touched by the main thread
+		int64_t FrameStartCount = 0;
+		int64_t FrameStartBytes = 0;
+		int64_t FrameCount = 0;
+		int64_t FrameBytes = 0;
+	};
+
+	TagCounters m_counters[MemoryTag_Count];
+#pragma endregion
+};
+
+// Charges every allocation made on this thread to a tag until it goes out of scope
+class MemoryTagScope
+{
+public:
+	// Constructor switches the thread to the new tag
+	explicit MemoryTagScope(MemoryTag tag) : m_previousTag(MemoryTracker::GetCurrentTag())
+	{
+		MemoryTracker::SetCurrentTag(tag);
+	}
+
+	// Destructor restores the tag that was active before
+	~MemoryTagScope() { MemoryTracker::SetCurrentTag(m_previousTag); }
+
+	MemoryTagScope(const MemoryTagScope&) = delete;
+	MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+	MemoryTag m_previousTag;
+};
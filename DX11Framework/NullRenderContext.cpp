@@ -0,0 +1,590 @@
+// Include{s}
+#include "NullRenderContext.h"
+#include <algorithm>
+
+#pragma region Null Resources
+// Placeholder COM object, reference counted like a real one so the usual Release calls clean it up
+template <typename Interface>
+class NullDeviceChild : public Interface
+{
+public:
+	HRESULT STDMETHODCALLTYPE QueryInterface(REFIID, void** object) override
+	{
+		*object = nullptr;
+		return E_NOINTERFACE;
+	}
+
+	ULONG STDMETHODCALLTYPE AddRef() override { return ++m_references; }
+
+	ULONG STDMETHODCALLTYPE Release() override
+	{
+		ULONG references = --m_references;
+		if (references == 0)
+		{
+			delete this;
+		}
+
+		return references;
+	}
+
+	void STDMETHODCALLTYPE GetDevice(ID3D11Device** device) override { *device = nullptr; }
+	HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT*, void*) override { return E_FAIL; }
+	HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) override { return S_OK; }
+	HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override { return S_OK; }
+
+protected:
+	virtual ~NullDeviceChild() = default;
+
+private:
+	std::atomic<ULONG> m_references{ 1 };
+};
+
+// Buffer that only remembers its description, dynamic buffers also own enough memory to be mapped
+class NullBuffer : public NullDeviceChild<ID3D11Buffer>
+{
+public:
+	explicit NullBuffer(const D3D11_BUFFER_DESC& desc) : m_desc(desc)
+	{
+		if (desc.Usage == D3D11_USAGE_DYNAMIC)
+		{
+			m_memory.resize(desc.ByteWidth);
+		}
+	}
+
+	void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* dimension) override
+	{
+		*dimension = D3D11_RESOURCE_DIMENSION_BUFFER;
+	}
+	void STDMETHODCALLTYPE SetEvictionPriority(UINT) override {}
+	UINT STDMETHODCALLTYPE GetEvictionPriority() override { return 0; }
+	void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* desc) override { *desc = m_desc; }
+
+	// Gets the CPU copy written through Map
+	// Returns void* - The memory, null for buffers that are not dynamic
+	void* GetMemory() { return m_memory.empty() ? nullptr : m_memory.data(); }
+
+private:
+	D3D11_BUFFER_DESC m_desc;
+	std::vector<unsigned char> m_memory;
+};
+
+// Texture that only remembers its description, so updates into it can be checked against its size
+class NullTexture2D : public NullDeviceChild<ID3D11Texture2D>
+{
+public:
+	explicit NullTexture2D(const D3D11_TEXTURE2D_DESC& desc) : m_desc(desc) {}
+
+	void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* dimension) override
+	{
+		*dimension = D3D11_RESOURCE_DIMENSION_TEXTURE2D;
+	}
+	void STDMETHODCALLTYPE SetEvictionPriority(UINT) override {}
+	UINT STDMETHODCALLTYPE GetEvictionPriority() override { return 0; }
+	void STDMETHODCALLTYPE GetDesc(D3D11_TEXTURE2D_DESC* desc) override { *desc = m_desc; }
+
+private:
+	D3D11_TEXTURE2D_DESC m_desc;
+};
+
+// Texture view, created textures keep their texture behind it while textures from files have none
+class NullShaderResourceView : public NullDeviceChild<ID3D11ShaderResourceView>
+{
+public:
+	NullShaderResourceView(DXGI_FORMAT format, NullTexture2D* texture) : m_texture(texture)
+	{
+		m_desc = {};
+		m_desc.Format = format;
+		m_desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+		m_desc.Texture2D.MipLevels = 1;
+	}
+
+	void STDMETHODCALLTYPE GetResource(ID3D11Resource** resource) override
+	{
+		*resource = m_texture;
+
+		if (m_texture != nullptr)
+		{
+			m_texture->AddRef();
+		}
+	}
+	void STDMETHODCALLTYPE GetDesc(D3D11_SHADER_RESOURCE_VIEW_DESC* desc) override { *desc = m_desc; }
+
+protected:
+	~NullShaderResourceView() override
+	{
+		if (m_texture != nullptr)
+		{
+			m_texture->Release();
+		}
+	}
+
+private:
+	D3D11_SHADER_RESOURCE_VIEW_DESC m_desc;
+	NullTexture2D* m_texture;
+};
+#pragma endregion
+
+#pragma region NullRenderDevice
+HRESULT NullRenderDevice::CreateBuffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+	ID3D11Buffer** buffer)
+{
+	if (desc == nullptr || buffer == nullptr || desc->ByteWidth == 0)
+	{
+		return E_INVALIDARG;
+	}
+
+	// Immutable buffers can never be written after creation, so they must start with their data
+	if (desc->Usage == D3D11_USAGE_IMMUTABLE && (initialData == nullptr || initialData->pSysMem == nullptr))
+	{
+		return E_INVALIDARG;
+	}
+
+	*buffer = new NullBuffer(*desc);
+	m_resourceCount++;
+
+	return S_OK;
+}
+
+HRESULT NullRenderDevice::CreateTexture(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+	ID3D11ShaderResourceView** texture)
+{
+	if (desc == nullptr || texture == nullptr || desc->Width == 0 || desc->Height == 0)
+	{
+		return E_INVALIDARG;
+	}
+
+	*texture = new NullShaderResourceView(desc->Format, new NullTexture2D(*desc));
+	m_resourceCount++;
+
+	return S_OK;
+}
+
+HRESULT NullRenderDevice::CreateTextureFromFile(const wchar_t* path, ID3D11ShaderResourceView** texture)
+{
+	if (path == nullptr || texture == nullptr)
+	{
+		return E_INVALIDARG;
+	}
+
+	// Missing files still fail so the scene batches the same way it does on D3D11, the contents are never read
+	std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+	if (!std::ifstream(converter.to_bytes(path)).is_open())
+	{
+		return E_FAIL;
+	}
+
+	*texture = new NullShaderResourceView(DXGI_FORMAT_R8G8B8A8_UNORM, nullptr);
+	m_resourceCount++;
+
+	return S_OK;
+}
+
+const void* NullRenderDevice::GetBufferMemory(ID3D11Buffer* buffer)
+{
+	return buffer ? static_cast<NullBuffer*>(buffer)->GetMemory() : nullptr;
+}
+#pragma endregion
+
+#pragma region Input Assembler
+void NullRenderContext::IASetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	CountStateChange(inputLayout == m_inputLayout);
+	m_inputLayout = inputLayout;
+}
+
+void NullRenderContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	CountStateChange(topology == m_topology);
+	m_topology = topology;
+}
+
+void NullRenderContext::IASetVertexBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* vertexBuffers,
+	const UINT* strides, const UINT* offsets)
+{
+	if (vertexBuffers == nullptr || strides == nullptr || offsets == nullptr)
+	{
+		ReportError("IASetVertexBuffers called without buffers, strides or offsets");
+		return;
+	}
+
+	bool redundant = true;
+
+	// Only the slots the framework uses are tracked
+	for (UINT i = 0; i < bufferCount && startSlot + i < VertexBufferSlots; i++)
+	{
+		UINT slot = startSlot + i;
+		redundant &= m_vertexBuffers[slot] == vertexBuffers[i] && m_vertexStrides[slot] == strides[i] &&
+			m_vertexOffsets[slot] == offsets[i];
+
+		if (vertexBuffers[i])
+		{
+			D3D11_BUFFER_DESC desc;
+			vertexBuffers[i]->GetDesc(&desc);
+
+			if (!(desc.BindFlags & D3D11_BIND_VERTEX_BUFFER))
+			{
+				ReportError("IASetVertexBuffers bound a buffer without D3D11_BIND_VERTEX_BUFFER");
+			}
+		}
+
+		m_vertexBuffers[slot] = vertexBuffers[i];
+		m_vertexStrides[slot] = strides[i];
+		m_vertexOffsets[slot] = offsets[i];
+	}
+
+	CountStateChange(redundant);
+}
+
+void NullRenderContext::IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset)
+{
+	CountStateChange(indexBuffer == m_indexBuffer && format == m_indexFormat && offset == m_indexOffset);
+
+	if (indexBuffer)
+	{
+		D3D11_BUFFER_DESC desc;
+		indexBuffer->GetDesc(&desc);
+
+		if (!(desc.BindFlags & D3D11_BIND_INDEX_BUFFER))
+		{
+			ReportError("IASetIndexBuffer bound a buffer without D3D11_BIND_INDEX_BUFFER");
+		}
+		if (format != DXGI_FORMAT_R16_UINT && format != DXGI_FORMAT_R32_UINT)
+		{
+			ReportError("IASetIndexBuffer needs DXGI_FORMAT_R16_UINT or DXGI_FORMAT_R32_UINT");
+		}
+	}
+
+	m_indexBuffer = indexBuffer;
+	m_indexFormat = format;
+	m_indexOffset = offset;
+}
+#pragma endregion
+
+#pragma region Shader Stages
+void NullRenderContext::VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances,
+	UINT classInstanceCount)
+{
+	CountStateChange(vertexShader == m_vertexShader);
+	m_vertexShader = vertexShader;
+}
+
+void NullRenderContext::PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances,
+	UINT classInstanceCount)
+{
+	CountStateChange(pixelShader == m_pixelShader);
+	m_pixelShader = pixelShader;
+}
+
+void NullRenderContext::VSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers)
+{
+	PSSetConstantBuffers(startSlot, bufferCount, constantBuffers);
+}
+
+void NullRenderContext::PSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers)
+{
+	CountStateChange(false);
+
+	for (UINT i = 0; constantBuffers && i < bufferCount; i++)
+	{
+		if (constantBuffers[i] == nullptr)
+		{
+			continue;
+		}
+
+		D3D11_BUFFER_DESC desc;
+		constantBuffers[i]->GetDesc(&desc);
+
+		if (!(desc.BindFlags & D3D11_BIND_CONSTANT_BUFFER) || desc.ByteWidth % 16 != 0)
+		{
+			ReportError("A constant buffer needs D3D11_BIND_CONSTANT_BUFFER and a size that is a multiple of 16");
+		}
+	}
+}
+
+void NullRenderContext::VSSetShaderResources(UINT startSlot, UINT viewCount,
+	ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	CountStateChange(false);
+}
+
+void NullRenderContext::PSSetShaderResources(UINT startSlot, UINT viewCount,
+	ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	// Slot 0 holds the diffuse texture, the only one that changes between draws
+	bool slotZero = startSlot == 0 && viewCount > 0 && shaderResourceViews;
+	CountStateChange(slotZero && shaderResourceViews[0] == m_pixelShaderResource);
+
+	if (slotZero)
+	{
+		m_pixelShaderResource = shaderResourceViews[0];
+	}
+}
+
+void NullRenderContext::VSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers)
+{
+	CountStateChange(false);
+}
+
+void NullRenderContext::PSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers)
+{
+	CountStateChange(false);
+}
+#pragma endregion
+
+#pragma region Rasterizer & Output Merger
+void NullRenderContext::RSSetState(ID3D11RasterizerState* rasterizerState)
+{
+	CountStateChange(rasterizerState == m_rasterizerState);
+	m_rasterizerState = rasterizerState;
+}
+
+void NullRenderContext::RSSetViewports(UINT viewportCount, const D3D11_VIEWPORT* viewports)
+{
+	CountStateChange(false);
+}
+
+void NullRenderContext::OMSetRenderTargets(UINT viewCount, ID3D11RenderTargetView* const* renderTargetViews,
+	ID3D11DepthStencilView* depthStencilView)
+{
+	CountStateChange(false);
+}
+
+void NullRenderContext::OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	CountStateChange(blendState == m_blendState);
+	m_blendState = blendState;
+}
+
+void NullRenderContext::OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef)
+{
+	CountStateChange(depthStencilState == m_depthStencilState);
+	m_depthStencilState = depthStencilState;
+}
+
+void NullRenderContext::ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colour[4])
+{
+}
+
+void NullRenderContext::ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags,
+	FLOAT depth, UINT8 stencil)
+{
+}
+#pragma endregion
+
+#pragma region Resources & Draws
+HRESULT NullRenderContext::Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags,
+	D3D11_MAPPED_SUBRESOURCE* mappedResource)
+{
+	if (resource == nullptr || mappedResource == nullptr)
+	{
+		ReportError("Map called without a resource or a mapped subresource");
+		return E_INVALIDARG;
+	}
+
+	D3D11_RESOURCE_DIMENSION dimension;
+	resource->GetType(&dimension);
+
+	if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER || subresource != 0)
+	{
+		ReportError("Map is only supported on subresource 0 of a buffer");
+		return E_INVALIDARG;
+	}
+
+	if (std::find(m_mappedResources.begin(), m_mappedResources.end(), resource) != m_mappedResources.end())
+	{
+		ReportError("Map called on a buffer that is already mapped");
+		return E_INVALIDARG;
+	}
+
+	// Every resource the null backend sees came from the NullRenderDevice
+	auto buffer = static_cast<NullBuffer*>(static_cast<ID3D11Buffer*>(resource));
+
+	D3D11_BUFFER_DESC desc;
+	buffer->GetDesc(&desc);
+
+	// Only dynamic buffers are written by the frame, so they are the only ones given memory to map
+	if (mapType != D3D11_MAP_WRITE_DISCARD || desc.Usage != D3D11_USAGE_DYNAMIC ||
+		!(desc.CPUAccessFlags & D3D11_CPU_ACCESS_WRITE))
+	{
+		ReportError("Map needs D3D11_MAP_WRITE_DISCARD on a dynamic buffer with D3D11_CPU_ACCESS_WRITE");
+		return E_INVALIDARG;
+	}
+
+	mappedResource->pData = buffer->GetMemory();
+	mappedResource->RowPitch = desc.ByteWidth;
+	mappedResource->DepthPitch = desc.ByteWidth;
+
+	m_mappedResources.push_back(resource);
+	m_stats.Maps++;
+	m_stats.MappedBytes += desc.ByteWidth;
+
+	return S_OK;
+}
+
+void NullRenderContext::Unmap(ID3D11Resource* resource, UINT subresource)
+{
+	auto it = std::find(m_mappedResources.begin(), m_mappedResources.end(), resource);
+
+	if (it == m_mappedResources.end())
+	{
+		ReportError("Unmap called on a buffer that is not mapped");
+		return;
+	}
+
+	m_mappedResources.erase(it);
+}
+
+void NullRenderContext::UpdateSubresource(ID3D11Resource* dstResource, UINT dstSubresource, const D3D11_BOX* dstBox,
+	const void* srcData, UINT srcRowPitch, UINT srcDepthPitch)
+{
+	if (dstResource == nullptr || srcData == nullptr)
+	{
+		ReportError("UpdateSubresource called with a null resource or no data");
+		return;
+	}
+
+	D3D11_RESOURCE_DIMENSION dimension;
+	dstResource->GetType(&dimension);
+
+	if (dimension != D3D11_RESOURCE_DIMENSION_TEXTURE2D || dstSubresource != 0)
+	{
+		ReportError("UpdateSubresource is only supported on subresource 0 of a texture");
+		return;
+	}
+
+	// Every resource the null backend sees came from the NullRenderDevice
+	D3D11_TEXTURE2D_DESC desc;
+	static_cast<ID3D11Texture2D*>(dstResource)->GetDesc(&desc);
+
+	// Immutable textures can never be written and dynamic ones are written through Map
+	if (desc.Usage != D3D11_USAGE_DEFAULT)
+	{
+		ReportError("UpdateSubresource needs a texture with D3D11_USAGE_DEFAULT");
+		return;
+	}
+
+	const D3D11_BOX whole = { 0, 0, 0, desc.Width, desc.Height, 1 };
+	const D3D11_BOX& box = dstBox != nullptr ? *dstBox : whole;
+
+	if (box.left >= box.right || box.top >= box.bottom || box.right > desc.Width || box.bottom > desc.Height)
+	{
+		ReportError("UpdateSubresource box is empty or outside the texture");
+		return;
+	}
+
+	m_stats.Updates++;
+	m_stats.UpdatedBytes += static_cast<UINT64>(srcRowPitch) * (box.bottom - box.top);
+}
+
+void NullRenderContext::DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation)
+{
+	ValidateDraw("DrawIndexed", false, indexCount, startIndexLocation, 1, 0);
+
+	m_stats.DrawCalls++;
+	m_stats.Triangles += indexCount / 3;
+}
+
+void NullRenderContext::DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount,
+	UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation)
+{
+	ValidateDraw("DrawIndexedInstanced", true, indexCountPerInstance, startIndexLocation, instanceCount,
+		startInstanceLocation);
+
+	m_stats.DrawCalls++;
+	m_stats.Triangles += static_cast<UINT64>(indexCountPerInstance / 3) * instanceCount;
+}
+#pragma endregion
+
+#pragma region Report Methods
+void NullRenderContext::Print(std::ostream& stream) const
+{
+	stream << "Draw Calls: " << m_stats.DrawCalls << std::endl;
+	stream << "Triangles: " << m_stats.Triangles << std::endl;
+	stream << "State Changes: " << m_stats.StateChanges << " (" << m_stats.RedundantStateChanges << " redundant)"
+		<< std::endl;
+	stream << "Maps: " << m_stats.Maps << " (" << m_stats.MappedBytes << " bytes)" << std::endl;
+	stream << "Updates: " << m_stats.Updates << " (" << m_stats.UpdatedBytes << " bytes)" << std::endl;
+	stream << "Validation Errors: " << m_stats.ValidationErrors << std::endl;
+
+	for (const std::string& error : m_errors)
+	{
+		stream << "  " << error << std::endl;
+	}
+}
+#pragma endregion
+
+#pragma region Private Methods
+void NullRenderContext::CountStateChange(bool redundant)
+{
+	m_stats.StateChanges++;
+
+	if (redundant)
+	{
+		m_stats.RedundantStateChanges++;
+	}
+}
+
+void NullRenderContext::ReportError(const std::string& message)
+{
+	m_stats.ValidationErrors++;
+
+	if (m_errors.size() < MaxErrorMessages)
+	{
+		m_errors.push_back(message);
+	}
+}
+
+void NullRenderContext::ValidateDraw(const char* call, bool instanced, UINT indexCount, UINT startIndex,
+	UINT instanceCount, UINT startInstance)
+{
+	// Shaders and input layouts are not checked, a headless run never compiles them
+	if (m_topology == D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED)
+	{
+		ReportError(std::string(call) + " without a primitive topology");
+	}
+
+	if (!m_mappedResources.empty())
+	{
+		ReportError(std::string(call) + " while a buffer is still mapped");
+	}
+
+	// Instanced draws can build their vertices from the vertex id, with only the instances in slot 1
+	if (m_vertexBuffers[0] == nullptr && (!instanced || m_vertexBuffers[1] == nullptr))
+	{
+		ReportError(std::string(call) + " without a vertex buffer in slot 0");
+	}
+
+	if (m_indexBuffer == nullptr)
+	{
+		ReportError(std::string(call) + " without an index buffer");
+		return;
+	}
+
+	D3D11_BUFFER_DESC desc;
+	m_indexBuffer->GetDesc(&desc);
+
+	UINT64 indexSize = m_indexFormat == DXGI_FORMAT_R32_UINT ? 4 : 2;
+	if (m_indexOffset + (static_cast<UINT64>(startIndex) + indexCount) * indexSize > desc.ByteWidth)
+	{
+		ReportError(std::string(call) + " reads past the end of the index buffer");
+	}
+
+	// Slot 1 holds the per-instance data of the instanced draws
+	if (instanceCount > 1 || startInstance > 0)
+	{
+		if (m_vertexBuffers[1] == nullptr)
+		{
+			ReportError(std::string(call) + " without an instance buffer in slot 1");
+			return;
+		}
+
+		m_vertexBuffers[1]->GetDesc(&desc);
+
+		if (m_vertexOffsets[1] + (static_cast<UINT64>(startInstance) + instanceCount) * m_vertexStrides[1] >
+			desc.ByteWidth)
+		{
+			ReportError(std::string(call) + " reads past the end of the instance buffer");
+		}
+	}
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+// Include{s}
+#include "RenderContext.h"
+#include <atomic>
+
+// Struct to hold what the null backend was asked to do
+struct NullRenderStats
+{
+	UINT64 DrawCalls;
+	UINT64 Triangles;
+	UINT64 StateChanges;
+	UINT64 RedundantStateChanges;
+	UINT64 Maps;
+	UINT64 MappedBytes;
+	UINT64 Updates;
+	UINT64 UpdatedBytes;
+	UINT64 ValidationErrors;
+};
+
+// Creates placeholder resources that remember their description but own no GPU memory, dynamic buffers get a block
+// of CPU memory so they can still be mapped and written
+class NullRenderDevice : public RenderDevice
+{
+public:
+	HRESULT CreateBuffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+		ID3D11Buffer** buffer) override;
+	HRESULT CreateTexture(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+		ID3D11ShaderResourceView** texture) override;
+	HRESULT CreateTextureFromFile(const wchar_t* path, ID3D11ShaderResourceView** texture) override;
+
+	// Gets the number of resources created
+	// Returns UINT64 - The resource count
+	UINT64 GetResourceCount() const { return m_resourceCount.load(); }
+
+	// Gets the CPU copy of a buffer made by a NullRenderDevice, so what was written through Map can be read back
+	// Returns const void* - The memory, null for buffers that are not dynamic
+	static const void* GetBufferMemory(ID3D11Buffer* buffer);
+
+private:
+	std::atomic<UINT64> m_resourceCount{ 0 };
+};
+
+// Draws nothing. Tracks the bound state, checks every call against it and counts what was asked for. Only works
+// with resources made by the NullRenderDevice
+class NullRenderContext : public RenderContext
+{
+public:
+#pragma region Input Assembler
+	void IASetInputLayout(ID3D11InputLayout* inputLayout) override;
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+	void IASetVertexBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* vertexBuffers, const UINT* strides,
+		const UINT* offsets) override;
+	void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) override;
+#pragma endregion
+
+#pragma region Shader Stages
+	void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances,
+		UINT classInstanceCount) override;
+	void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances,
+		UINT classInstanceCount) override;
+	void VSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers) override;
+	void PSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers) override;
+	void VSSetShaderResources(UINT startSlot, UINT viewCount,
+		ID3D11ShaderResourceView* const* shaderResourceViews) override;
+	void PSSetShaderResources(UINT startSlot, UINT viewCount,
+		ID3D11ShaderResourceView* const* shaderResourceViews) override;
+	void VSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers) override;
+	void PSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers) override;
+#pragma endregion
+
+#pragma region Rasterizer & Output Merger
+	void RSSetState(ID3D11RasterizerState* rasterizerState) override;
+	void RSSetViewports(UINT viewportCount, const D3D11_VIEWPORT* viewports) override;
+	void OMSetRenderTargets(UINT viewCount, ID3D11RenderTargetView* const* renderTargetViews,
+		ID3D11DepthStencilView* depthStencilView) override;
+	void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) override;
+	void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) override;
+	void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colour[4]) override;
+	void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth,
+		UINT8 stencil) override;
+#pragma endregion
+
+#pragma region Resources & Draws
+	HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags,
+		D3D11_MAPPED_SUBRESOURCE* mappedResource) override;
+	void Unmap(ID3D11Resource* resource, UINT subresource) override;
+	void UpdateSubresource(ID3D11Resource* dstResource, UINT dstSubresource, const D3D11_BOX* dstBox,
+		const void* srcData, UINT srcRowPitch, UINT srcDepthPitch) override;
+	void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) override;
+	void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation,
+		INT baseVertexLocation, UINT startInstanceLocation) override;
+#pragma endregion
+
+#pragma region Report Methods
+	// Gets the counts since the context was created or last reset
+	// Returns NullRenderStats - The counts
+	const NullRenderStats& GetStats() const { return m_stats; }
+
+	// Zeroes the counts, the bound state is kept
+	void ResetStats() { m_stats = {}; }
+
+	// Prints the counts and the first validation errors
+	void Print(std::ostream& stream) const;
+#pragma endregion
+
+private:
+#pragma region Private Methods
+	// Counts a state change, redundant if the value was already bound
+	void CountStateChange(bool redundant);
+
+	// Records a validation error, only the first few messages are kept
+	void ReportError(const std::string& message);
+
+	// Checks the bound input assembler state covers a draw of indices and instances
+	void ValidateDraw(const char* call, bool instanced, UINT indexCount, UINT startIndex, UINT instanceCount,
+		UINT startInstance);
+#pragma endregion
+
+#pragma region Member Variables
+	static const UINT VertexBufferSlots = 2;
+	static const size_t MaxErrorMessages = 16;
+
+	ID3D11InputLayout* m_inputLayout = nullptr;
+	D3D11_PRIMITIVE_TOPOLOGY m_topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	ID3D11Buffer* m_vertexBuffers[VertexBufferSlots] = {};
+	UINT m_vertexStrides[VertexBufferSlots] = {};
+	UINT m_vertexOffsets[VertexBufferSlots] = {};
+	ID3D11Buffer* m_indexBuffer = nullptr;
+	DXGI_FORMAT m_indexFormat = DXGI_FORMAT_UNKNOWN;
+	UINT m_indexOffset = 0;
+	ID3D11VertexShader* m_vertexShader = nullptr;
+	ID3D11PixelShader* m_pixelShader = nullptr;
+	ID3D11ShaderResourceView* m_pixelShaderResource = nullptr;
+	ID3D11BlendState* m_blendState = nullptr;
+	ID3D11DepthStencilState* m_depthStencilState = nullptr;
+	ID3D11RasterizerState* m_rasterizerState = nullptr;
+
+	// Buffers mapped and not yet unmapped
+	std::vector<ID3D11Resource*> m_mappedResources;
+
+	NullRenderStats m_stats = {};
+	std::vector<std::string> m_errors;
+#pragma endregion
+};
@@ -1,4 +1,5 @@
 #include "OBJLoader.h"
+#include "Profiler.h"
 
 bool OBJLoader::FindSimilarVertex(const SimpleVertex& vertex, std::map<SimpleVertex, unsigned short>& vertToIndexMap,
 	unsigned short& index)
@@ -62,8 +63,10 @@ void OBJLoader::CreateIndices(const std::vector<XMFLOAT3>& inVertices,
 //WARNING: This code makes a big assumption -- that your models have texture coordinates AND normals which they should have anyway (else you can't do texturing and lighting!)
 //If your .obj file has no lines beginning with "vt" or "vn", then you'll need to change the Export settings in your modelling software so that it exports the texture coordinates
 //and normals. If you still have no "vt" lines, you'll need to do some texture unwrapping, also known as UV unwrapping.
-MeshData OBJLoader::Load(const char* filename, ID3D11Device* _pd3dDevice, bool invertTexCoords)
+MeshData OBJLoader::Load(const char* filename, RenderDevice* _pd3dDevice, bool invertTexCoords)
 {
+	PROFILE_FUNCTION();
+
 	std::string binaryFilename = filename;
 	binaryFilename.append("Binary");
 	std::ifstream binaryInFile;
@@ -253,6 +256,8 @@ MeshData OBJLoader::Load(const char* filename, ID3D11Device* _pd3dDevice, bool i
 		meshData.IndexCount = meshIndices.size();
 		meshData.IndexBuffer = indexBuffer;
 
+		CalculateBounds(finalVerts, numMeshVertices, meshData);
+
 		//This data has now been sent over to the GPU so we can delete this CPU-side stuff
 		delete[] indicesArray;
 		delete[] finalVerts;
@@ -309,9 +314,76 @@ MeshData OBJLoader::Load(const char* filename, ID3D11Device* _pd3dDevice, bool i
 	meshData.IndexCount = numIndices;
 	meshData.IndexBuffer = indexBuffer;
 
+	CalculateBounds(finalVerts, numVertices, meshData);
+
 	//This data has now been sent over to the GPU so we can delete this CPU-side stuff
 	delete[] indices;
 	delete[] finalVerts;
 
 	return meshData;
+}
+
+bool OBJLoader::LoadCPUMesh(const char* filename, CPUMeshData& cpuMesh)
+{
+	PROFILE_FUNCTION();
+
+	std::string binaryFilename = filename;
+	binaryFilename.append("Binary");
+	std::ifstream binaryInFile;
+	binaryInFile.open(binaryFilename, std::ios::in | std::ios::binary);
+
+	if (!binaryInFile.good())
+	{
+		return false;
+	}
+
+	unsigned int numVertices;
+	unsigned int numIndices;
+
+	//Read in array sizes
+	binaryInFile.read((char*)&numVertices, sizeof(unsigned int));
+	binaryInFile.read((char*)&numIndices, sizeof(unsigned int));
+
+	//Only the positions are needed, the normals and texture coordinates are read and thrown away
+	std::vector<SimpleVertex> vertices(numVertices);
+	cpuMesh.Indices.resize(numIndices);
+	binaryInFile.read((char*)vertices.data(), sizeof(SimpleVertex) * numVertices);
+	binaryInFile.read((char*)cpuMesh.Indices.data(), sizeof(unsigned short) * numIndices);
+
+	if (!binaryInFile.good())
+	{
+		cpuMesh.Indices.clear();
+		return false;
+	}
+
+	cpuMesh.Positions.resize(numVertices);
+	for (unsigned int i = 0; i < numVertices; ++i)
+	{
+		cpuMesh.Positions[i] = vertices[i].Pos;
+	}
+
+	return true;
+}
+
+void OBJLoader::CalculateBounds(const SimpleVertex* vertices, unsigned int numVertices, MeshData& meshData)
+{
+	if (numVertices == 0)
+	{
+		meshData.BoundsCenter = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		meshData.BoundsExtents = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		return;
+	}
+
+	XMVECTOR minimum = XMLoadFloat3(&vertices[0].Pos);
+	XMVECTOR maximum = minimum;
+
+	for (unsigned int i = 1; i < numVertices; ++i)
+	{
+		XMVECTOR position = XMLoadFloat3(&vertices[i].Pos);
+		minimum = XMVectorMin(minimum, position);
+		maximum = XMVectorMax(maximum, position);
+	}
+
+	XMStoreFloat3(&meshData.BoundsCenter, XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f));
+	XMStoreFloat3(&meshData.BoundsExtents, XMVectorScale(XMVectorSubtract(maximum, minimum), 0.5f));
 }
\ No newline at end of file
@@ -1,12 +1,13 @@
 #pragma once
 
 // Include{s}
-#include "Structures.h"
+#include "RenderContext.h"
+#include "OcclusionCuller.h"
 
 namespace OBJLoader
 {
 	//The only method you'll need to call
-	MeshData Load(const char* filename, ID3D11Device* _pd3dDevice, bool invertTexCoords = true);
+	MeshData Load(const char* filename, RenderDevice* _pd3dDevice, bool invertTexCoords = true);
 
 	//Helper methods for the above method
 	//Searhes to see if a similar vertex already exists in the buffer -- if true, we re-use that index
@@ -18,4 +19,10 @@ namespace OBJLoader
 		const std::vector<XMFLOAT3>& inNormals, std::vector<unsigned short>& outIndices,
 		std::vector<XMFLOAT3>& outVertices, std::vector<XMFLOAT2>& outTexCoords,
 		std::vector<XMFLOAT3>& outNormals);
+
+	//Reads the positions and indices of a mesh into CPU memory, from the binary file Load writes next to the OBJ
+	bool LoadCPUMesh(const char* filename, CPUMeshData& cpuMesh);
+
+	//Fills in the local-space bounding box of the mesh from its vertex positions
+	void CalculateBounds(const SimpleVertex* vertices, unsigned int numVertices, MeshData& meshData);
 };
@@ -0,0 +1,255 @@
+// Include{s}
+#include "OcclusionCuller.h"
+#include "FrameArena.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX;
+
+#pragma region Constructor
+// Constructor
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+{
+	m_width = (width + 3) & ~3u;
+	m_height = height;
+
+	m_depth.resize(m_width * m_height, 1.0f);
+}
+#pragma endregion
+
+#pragma region Occlusion Methods
+void OcclusionCuller::Clear(FXMMATRIX viewProjection)
+{
+	XMStoreFloat4x4(&m_viewProjection, viewProjection);
+
+	std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+	m_triangleCount = 0;
+}
+
+void OcclusionCuller::RasterizeOccluder(const CPUMeshData& mesh, FXMMATRIX world)
+{
+	XMMATRIX worldViewProjection = world * XMLoadFloat4x4(&m_viewProjection);
+
+	// Project every vertex once, vertices in front of the near plane are flagged with a negative depth
+	// The projected copy only lives for this call, so it comes from the frame arena
+	FrameVector<XMFLOAT3> screenPositions(mesh.Positions.size());
+	for (size_t i = 0; i < mesh.Positions.size(); i++)
+	{
+		const XMFLOAT3& position = mesh.Positions[i];
+		XMFLOAT4 clip;
+		XMStoreFloat4(&clip, XMVector4Transform(XMVectorSet(position.x, position.y, position.z, 1.0f),
+			worldViewProjection));
+
+		if (clip.z < 0.0f || clip.w <= 0.0f)
+		{
+			screenPositions[i] = XMFLOAT3(0.0f, 0.0f, -1.0f);
+			continue;
+		}
+
+		float inverseW = 1.0f / clip.w;
+		screenPositions[i] = XMFLOAT3(
+			(clip.x * inverseW * 0.5f + 0.5f) * m_width,
+			(0.5f - clip.y * inverseW * 0.5f) * m_height,
+			clip.z * inverseW);
+	}
+
+	for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+	{
+		const XMFLOAT3& v0 = screenPositions[mesh.Indices[i]];
+		const XMFLOAT3& v1 = screenPositions[mesh.Indices[i + 1]];
+		const XMFLOAT3& v2 = screenPositions[mesh.Indices[i + 2]];
+
+		// Triangles crossing the near plane are skipped rather than clipped, an occluder may only ever hide less
+		if (v0.z < 0.0f || v1.z < 0.0f || v2.z < 0.0f)
+		{
+			continue;
+		}
+
+		RasterizeTriangle(v0, v1, v2);
+	}
+}
+
+bool OcclusionCuller::IsOccluded(const XMFLOAT3& center, const XMFLOAT3& extents) const
+{
+	XMMATRIX viewProjection = XMLoadFloat4x4(&m_viewProjection);
+
+	float minX = FLT_MAX;
+	float minY = FLT_MAX;
+	float maxX = -FLT_MAX;
+	float maxY = -FLT_MAX;
+	float nearestDepth = FLT_MAX;
+
+	// Screen-space rectangle and nearest depth of the eight corners
+	for (int corner = 0; corner < 8; corner++)
+	{
+		XMVECTOR position = XMVectorSet(
+			center.x + (corner & 1 ? extents.x : -extents.x),
+			center.y + (corner & 2 ? extents.y : -extents.y),
+			center.z + (corner & 4 ? extents.z : -extents.z),
+			1.0f);
+
+		XMFLOAT4 clip;
+		XMStoreFloat4(&clip, XMVector4Transform(position, viewProjection));
+
+		// Boxes that reach the camera can never be hidden
+		if (clip.z < 0.0f || clip.w <= 0.0f)
+		{
+			return false;
+		}
+
+		float inverseW = 1.0f / clip.w;
+		float x = (clip.x * inverseW * 0.5f + 0.5f) * m_width;
+		float y = (0.5f - clip.y * inverseW * 0.5f) * m_height;
+
+		minX = fminf(minX, x);
+		maxX = fmaxf(maxX, x);
+		minY = fminf(minY, y);
+		maxY = fmaxf(maxY, y);
+		nearestDepth = fminf(nearestDepth, clip.z * inverseW);
+	}
+
+	// Every pixel the rectangle touches, not just the ones whose centre it covers
+	// Clamped as floats first, corners close to the camera can project far outside the int range
+	int pixelMinX = static_cast<int>(floorf(fmaxf(minX, 0.0f)));
+	int pixelMinY = static_cast<int>(floorf(fmaxf(minY, 0.0f)));
+	int pixelMaxX = static_cast<int>(ceilf(fminf(maxX, static_cast<float>(m_width)))) - 1;
+	int pixelMaxY = static_cast<int>(ceilf(fminf(maxY, static_cast<float>(m_height)))) - 1;
+
+	// Off screen, leave it to the frustum test
+	if (pixelMinX > pixelMaxX || pixelMinY > pixelMaxY)
+	{
+		return false;
+	}
+
+	const XMVECTOR laneOffsets = XMVectorSet(0.0f, 1.0f, 2.0f, 3.0f);
+	const XMVECTOR rectMinX = XMVectorReplicate(static_cast<float>(pixelMinX));
+	const XMVECTOR rectMaxX = XMVectorReplicate(static_cast<float>(pixelMaxX));
+	const XMVECTOR depth = XMVectorReplicate(nearestDepth);
+
+	for (int y = pixelMinY; y <= pixelMaxY; y++)
+	{
+		const float* row = &m_depth[y * m_width];
+
+		for (int x = pixelMinX & ~3; x <= pixelMaxX; x += 4)
+		{
+			XMVECTOR laneX = XMVectorAdd(XMVectorReplicate(static_cast<float>(x)), laneOffsets);
+			XMVECTOR laneMask = XMVectorAndInt(XMVectorGreaterOrEqual(laneX, rectMinX),
+				XMVectorLessOrEqual(laneX, rectMaxX));
+
+			// Any pixel where the box is in front of the stored occluder depth means it can be seen
+			XMVECTOR stored = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&row[x]));
+			XMVECTOR visible = XMVectorAndInt(XMVectorGreaterOrEqual(stored, depth), laneMask);
+
+			if (!XMComparisonAllTrue(XMVector4EqualIntR(visible, XMVectorFalseInt())))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+#pragma endregion
+
+#pragma region Private Methods
+void OcclusionCuller::RasterizeTriangle(const XMFLOAT3& v0, const XMFLOAT3& v1, const XMFLOAT3& v2)
+{
+	// Occluders are rasterized with both windings, so swap to make the area positive
+	float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+	const XMFLOAT3& a = v0;
+	const XMFLOAT3& b = area < 0.0f ? v2 : v1;
+	const XMFLOAT3& c = area < 0.0f ? v1 : v2;
+	area = fabsf(area);
+
+	// Degenerate
+	if (area < 1e-6f)
+	{
+		return;
+	}
+
+	float minX = fminf(a.x, fminf(b.x, c.x));
+	float maxX = fmaxf(a.x, fmaxf(b.x, c.x));
+	float minY = fminf(a.y, fminf(b.y, c.y));
+	float maxY = fmaxf(a.y, fmaxf(b.y, c.y));
+
+	// Clamp to the buffer, starting on a 4 pixel boundary so the blocks stay aligned with the rows
+	int pixelMinX = static_cast<int>(floorf(fmaxf(minX, 0.0f))) & ~3;
+	int pixelMinY = static_cast<int>(floorf(fmaxf(minY, 0.0f)));
+	int pixelMaxX = static_cast<int>(ceilf(fminf(maxX, static_cast<float>(m_width - 1))));
+	int pixelMaxY = static_cast<int>(ceilf(fminf(maxY, static_cast<float>(m_height - 1))));
+
+	if (pixelMinX > pixelMaxX || pixelMinY > pixelMaxY)
+	{
+		return;
+	}
+
+	m_triangleCount++;
+
+	// Edge functions E(x, y) = A * x + B * y + C, positive on the inside of each edge, sampled at pixel centres
+	const XMFLOAT3* edgeStart[3] = { &a, &b, &c };
+	const XMFLOAT3* edgeEnd[3] = { &b, &c, &a };
+	XMVECTOR edgeA[3];
+	XMVECTOR edgeB[3];
+	XMVECTOR edgeC[3];
+	for (int e = 0; e < 3; e++)
+	{
+		float edgeX = edgeEnd[e]->x - edgeStart[e]->x;
+		float edgeY = edgeEnd[e]->y - edgeStart[e]->y;
+
+		float A = -edgeY;
+		float B = edgeX;
+		float C = edgeY * edgeStart[e]->x - edgeX * edgeStart[e]->y;
+
+		edgeA[e] = XMVectorReplicate(A);
+		edgeB[e] = XMVectorReplicate(B);
+		edgeC[e] = XMVectorReplicate(C);
+	}
+
+	// Depth plane, pushed back by its slope across half a pixel so the stored depth is the farthest the pixel sees
+	float depthX = ((b.z - a.z) * (c.y - a.y) - (c.z - a.z) * (b.y - a.y)) / area;
+	float depthY = ((c.z - a.z) * (b.x - a.x) - (b.z - a.z) * (c.x - a.x)) / area;
+	float depthC = a.z - depthX * a.x - depthY * a.y + 0.5f * (fabsf(depthX) + fabsf(depthY));
+
+	const XMVECTOR depthSlopeX = XMVectorReplicate(depthX);
+	const XMVECTOR depthSlopeY = XMVectorReplicate(depthY);
+	const XMVECTOR depthMax = XMVectorReplicate(fmaxf(a.z, fmaxf(b.z, c.z)));
+	const XMVECTOR laneOffsets = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+
+	for (int y = pixelMinY; y <= pixelMaxY; y++)
+	{
+		float* row = &m_depth[y * m_width];
+		XMVECTOR pixelY = XMVectorReplicate(y + 0.5f);
+
+		XMVECTOR rowEdge[3];
+		for (int e = 0; e < 3; e++)
+		{
+			rowEdge[e] = XMVectorMultiplyAdd(edgeB[e], pixelY, edgeC[e]);
+		}
+		XMVECTOR rowDepth = XMVectorMultiplyAdd(depthSlopeY, pixelY, XMVectorReplicate(depthC));
+
+		for (int x = pixelMinX; x <= pixelMaxX; x += 4)
+		{
+			XMVECTOR pixelX = XMVectorAdd(XMVectorReplicate(static_cast<float>(x)), laneOffsets);
+
+			// Coverage mask of the four pixels
+			XMVECTOR mask = XMVectorGreaterOrEqual(XMVectorMultiplyAdd(edgeA[0], pixelX, rowEdge[0]), XMVectorZero());
+			mask = XMVectorAndInt(mask,
+				XMVectorGreaterOrEqual(XMVectorMultiplyAdd(edgeA[1], pixelX, rowEdge[1]), XMVectorZero()));
+			mask = XMVectorAndInt(mask,
+				XMVectorGreaterOrEqual(XMVectorMultiplyAdd(edgeA[2], pixelX, rowEdge[2]), XMVectorZero()));
+
+			if (XMComparisonAllTrue(XMVector4EqualIntR(mask, XMVectorFalseInt())))
+			{
+				continue;
+			}
+
+			XMVECTOR depth = XMVectorMin(XMVectorMultiplyAdd(depthSlopeX, pixelX, rowDepth), depthMax);
+
+			XMVECTOR stored = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&row[x]));
+			stored = XMVectorSelect(stored, XMVectorMin(stored, depth), mask);
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&row[x]), stored);
+		}
+	}
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+// Include{s}
+// Only the standard library and DirectXMath, so the culler builds and is tested without D3D or Windows
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// Struct to hold a CPU copy of a mesh's positions and indices, used by the software occlusion culler
+struct CPUMeshData
+{
+	std::vector<DirectX::XMFLOAT3> Positions;
+	std::vector<unsigned short> Indices;
+};
+
+class OcclusionCuller
+{
+public:
+#pragma region Constructor
+	// Constructor allocates the depth buffer, the width is rounded up to a multiple of 4 so every row splits into SIMD blocks
+	OcclusionCuller(uint32_t width = 256, uint32_t height = 144);
+#pragma endregion
+
+#pragma region Occlusion Methods
+	// Resets the depth buffer to the far plane and stores the camera used by the following calls
+	void Clear(DirectX::FXMMATRIX viewProjection);
+
+	// Rasterizes an occluder mesh (both windings) into the depth buffer
+	void RasterizeOccluder(const CPUMeshData& mesh, DirectX::FXMMATRIX world);
+
+	// Tests a world-space bounding box against the depth buffer
+	// Returns bool - True if every pixel the box covers is hidden behind an occluder
+	bool IsOccluded(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the width of the depth buffer
+	// Returns uint32_t - The width in pixels
+	uint32_t GetWidth() const { return m_width; }
+
+	// Gets the height of the depth buffer
+	// Returns uint32_t - The height in pixels
+	uint32_t GetHeight() const { return m_height; }
+
+	// Gets the depth buffer, row major with values from 0 (near) to 1 (far)
+	// Returns std::vector<float> - The depth buffer
+	const std::vector<float>& GetDepthBuffer() const { return m_depth; }
+
+	// Gets the number of occluder triangles rasterized since the last clear
+	// Returns uint32_t - The triangle count
+	uint32_t GetTriangleCount() const { return m_triangleCount; }
+#pragma endregion
+
+private:
+#pragma region Private Methods
+	// Rasterizes a screen-space triangle (x, y in pixels, z in 0-1) four pixels at a time under a coverage mask
+	void RasterizeTriangle(const DirectX::XMFLOAT3& v0, const DirectX::XMFLOAT3& v1, const DirectX::XMFLOAT3& v2);
+#pragma endregion
+
+#pragma region Member Variables
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_triangleCount = 0;
+	std::vector<float> m_depth;
+	DirectX::XMFLOAT4X4 m_viewProjection = {};
+#pragma endregion
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+// Include{s}
+#if defined(_WIN32)
+#include <ppl.h>
+#else
+#include <algorithm>
+#include <thread>
+#include <vector>
+#endif
+
+// Runs body(i) for every i in [first, last) across the worker threads and returns once they have all finished. Uses
+// the Concurrency Runtime's thread pool on Windows, elsewhere the indices are dealt out over one thread per core
+template <typename Index, typename Function>
+void ParallelFor(Index first, Index last, const Function& body)
+{
+#if defined(_WIN32)
+	concurrency::parallel_for(first, last, body);
+#else
+	if (last <= first)
+	{
+		return;
+	}
+
+	const Index count = last - first;
+	const Index cores = static_cast<Index>((std::max)(1u, std::thread::hardware_concurrency()));
+	const Index threadCount = (std::min)(count, cores);
+
+	// Thread t takes every threadCount'th index starting at first + t, the calling thread takes the first share
+	auto runShare = [&](Index share)
+	{
+		for (Index i = first + share; i < last; i += threadCount)
+		{
+			body(i);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (Index share = 1; share < threadCount; share++)
+	{
+		threads.emplace_back(runShare, share);
+	}
+
+	runShare(0);
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+#endif
+}
@@ -0,0 +1,133 @@
+// Include{s}
+#include "PerformanceHUD.h"
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+
+#pragma region Constructor & Destructor
+// Destructor
+PerformanceHUD::~PerformanceHUD()
+{
+	if (m_whiteTexture)
+	{
+		m_whiteTexture->Release();
+		m_whiteTexture = nullptr;
+	}
+}
+#pragma endregion
+
+#pragma region Initialization Methods
+HRESULT PerformanceHUD::Initialise(ID3D11Device* device)
+{
+	HRESULT hr = S_OK;
+
+	const UINT whitePixel = 0xFFFFFFFF;
+
+	D3D11_TEXTURE2D_DESC textureDesc = {};
+	textureDesc.Width = 1;
+	textureDesc.Height = 1;
+	textureDesc.MipLevels = 1;
+	textureDesc.ArraySize = 1;
+	textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	textureDesc.SampleDesc.Count = 1;
+	textureDesc.Usage = D3D11_USAGE_IMMUTABLE;
+	textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	D3D11_SUBRESOURCE_DATA textureData = {};
+	textureData.pSysMem = &whitePixel;
+	textureData.SysMemPitch = sizeof(whitePixel);
+
+	ID3D11Texture2D* texture = nullptr;
+	hr = device->CreateTexture2D(&textureDesc, &textureData, &texture);
+	if (FAILED(hr)) return hr;
+
+	hr = device->CreateShaderResourceView(texture, nullptr, &m_whiteTexture);
+	texture->Release();
+
+	return hr;
+}
+#pragma endregion
+
+#pragma region Draw Methods
+void PerformanceHUD::Draw(SpriteBatch* spriteBatch, SpriteFont* spriteFont, XMFLOAT2 position) const
+{
+	if (!m_visible || m_whiteTexture == nullptr)
+	{
+		return;
+	}
+
+	CounterRegistry* counters = CounterRegistry::GetInstance();
+	FrameArena* frameArena = FrameArena::GetInstance();
+	const RollingStats& frameTimes = counters->GetFrameTimes();
+
+	const float lineHeight = spriteFont->GetLineSpacing();
+	const LONG left = static_cast<LONG>(position.x);
+	const LONG top = static_cast<LONG>(position.y);
+	const LONG graphWidth = GraphFrames * GraphBarWidth;
+
+	// Background behind the graph and every line of text below it
+	UINT lineCount = 4 + counters->GetCounterCount() - Counter_BuiltInCount;
+	RECT background = { left - 10, top - 10, left + graphWidth + 10,
+		top + GraphHeight + 20 + static_cast<LONG>(lineHeight * lineCount) };
+	spriteBatch->Draw(m_whiteTexture, background, XMVECTOR(Colors::Black) * 0.6f);
+
+	// Frame time graph, newest frame on the right, scaled so the 30 FPS line is always on screen
+	float maxFrameTime = frameTimes.GetMax();
+	float graphScaleMs = maxFrameTime > GraphMinimumScaleMs ? maxFrameTime : GraphMinimumScaleMs;
+
+	for (UINT age = 0; age < GraphFrames && age < frameTimes.GetCount(); age++)
+	{
+		float frameTime = frameTimes.GetSample(age);
+		LONG barHeight = static_cast<LONG>(frameTime / graphScaleMs * GraphHeight);
+		LONG barRight = left + graphWidth - static_cast<LONG>(age) * GraphBarWidth;
+
+		RECT bar = { barRight - GraphBarWidth + 1, top + GraphHeight - barHeight, barRight, top + GraphHeight };
+		XMVECTOR barColour = frameTime <= 1000.0f / 60.0f ? Colors::Green : frameTime <= 1000.0f / 30.0f ?
+			Colors::Yellow : Colors::Red;
+
+		spriteBatch->Draw(m_whiteTexture, bar, barColour);
+	}
+
+	// Line across the graph at 60 FPS
+	LONG targetLine = top + GraphHeight - static_cast<LONG>(1000.0f / 60.0f / graphScaleMs * GraphHeight);
+	RECT target = { left, targetLine, left + graphWidth, targetLine + 1 };
+	spriteBatch->Draw(m_whiteTexture, target, Colors::White);
+
+	XMFLOAT2 textPosition(position.x, position.y + GraphHeight + 10);
+
+	auto drawLine = [&](const char* text, FXMVECTOR colour)
+	{
+		spriteFont->DrawString(spriteBatch, text, textPosition, colour);
+		textPosition.y += lineHeight;
+	};
+
+	float averageFrameTime = frameTimes.GetAverage();
+	drawLine(frameArena->Format("FPS: %.0f Frame: %.2f ms", averageFrameTime > 0.0f ? 1000.0f / averageFrameTime :
+		0.0f, averageFrameTime), Colors::White);
+	drawLine(frameArena->Format("p50: %.2f p95: %.2f p99: %.2f ms", frameTimes.GetPercentile(50.0f),
+		frameTimes.GetPercentile(95.0f), frameTimes.GetPercentile(99.0f)), Colors::White);
+
+	drawLine(frameArena->Format("Draw Calls: %.0f Filtered State Changes: %.0f Triangles: %.0f",
+		counters->GetCounter(Counter_DrawCalls).LastFrame, counters->GetCounter(Counter_StateChangesFiltered).LastFrame,
+		counters->GetCounter(Counter_TrianglesSubmitted).LastFrame), Colors::White);
+
+	// Heap use is only known when the allocation hooks are compiled in
+	if (MemoryTracker::IsEnabled())
+	{
+		drawLine(frameArena->Format("Constant Buffers: %.1f KB Memory: %.1f MB",
+			counters->GetCounter(Counter_ConstantBufferBytes).LastFrame / 1024.0,
+			counters->GetCounter(Counter_MemoryInUse).LastFrame / (1024.0 * 1024.0)), Colors::White);
+	}
+	else
+	{
+		drawLine(frameArena->Format("Constant Buffers: %.1f KB Memory: Not Tracked",
+			counters->GetCounter(Counter_ConstantBufferBytes).LastFrame / 1024.0), Colors::White);
+	}
+
+	// Anything other subsystems registered goes underneath
+	for (CounterID counter = Counter_BuiltInCount; counter < counters->GetCounterCount(); counter++)
+	{
+		drawLine(frameArena->Format("%s: %.2f", counters->GetCounter(counter).Name.c_str(),
+			counters->GetCounter(counter).LastFrame), Colors::White);
+	}
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+// Include{s}
+#include "Structures.h"
+#include "CounterRegistry.h"
+
+// Overlay of the frame time graph and the counters in the CounterRegistry, drawn with the UI sprite batch and font
+class PerformanceHUD
+{
+public:
+#pragma region Constructor & Destructor
+	// Default constructor
+	PerformanceHUD() = default;
+
+	// Destructor releases the graph texture
+	~PerformanceHUD();
+
+	PerformanceHUD(const PerformanceHUD&) = delete;
+	PerformanceHUD& operator=(const PerformanceHUD&) = delete;
+#pragma endregion
+
+#pragma region Initialization Methods
+	// Creates the white pixel the graph bars and the background are stretched from
+	HRESULT Initialise(ID3D11Device* device);
+#pragma endregion
+
+#pragma region Draw Methods
+	// Draws the overlay with its top left corner at position, the sprite batch must already have begun
+	void Draw(SpriteBatch* spriteBatch, SpriteFont* spriteFont, XMFLOAT2 position) const;
+#pragma endregion
+
+#pragma region Getters & Setters
+	// Checks if the overlay is shown
+	// Returns bool - True if visible
+	bool IsVisible() const { return m_visible; }
+
+	// Shows or hides the overlay
+	void SetVisible(bool visible) { m_visible = visible; }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	ID3D11ShaderResourceView* m_whiteTexture = nullptr;
+	bool m_visible = false;
+
+	// Frames shown in the graph, the size of each bar and the frame time of a full height bar at the least
+	static const UINT GraphFrames = 120;
+	static const LONG GraphBarWidth = 4;
+	static const LONG GraphHeight = 120;
+	static constexpr float GraphMinimumScaleMs = 33.3f;
+#pragma endregion
+};
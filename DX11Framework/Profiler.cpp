@@ -0,0 +1,333 @@
+// Include{s}
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <chrono>
+#endif
+
+#ifdef PROFILER_ENABLED
+// Buffer and scope depth of the calling thread
+static thread_local void* t_threadBuffer = nullptr;
+static thread_local uint32_t t_threadIndex = 0;
+static thread_local uint32_t t_threadDepth = 0;
+
+// Path hash of every open scope on the calling thread by depth, scopes nested deeper than this share the last one
+constexpr uint32_t MaxScopeDepth = 64;
+static thread_local uint64_t t_threadPaths[MaxScopeDepth];
+
+// Destroyed when its thread exits, handing the thread's buffer back to the profiler
+struct ThreadBufferRelease
+{
+	~ThreadBufferRelease()
+	{
+		if (t_threadBuffer)
+		{
+			Profiler::GetInstance()->ReleaseThreadBuffer();
+		}
+	}
+};
+static thread_local ThreadBufferRelease t_threadBufferRelease;
+
+#pragma region Constructor
+// Constructor
+Profiler::Profiler()
+{
+#if defined(_WIN32)
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	m_frequency = frequency.QuadPart;
+#else
+	m_frequency = 1000000000;
+#endif
+	m_startTime = GetTimestamp();
+
+	// Reserved up front so draining never allocates in the middle of a frame
+	m_traceEvents.reserve(MaxTraceEvents);
+}
+#pragma endregion
+
+#pragma region Recording Methods
+void Profiler::Record(const char* name, uint64_t path, int64_t start, int64_t end, uint32_t depth)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	// Only this thread writes, so the slot is filled first and then published with the count
+	uint64_t writeCount = buffer->WriteCount.load(std::memory_order_relaxed);
+	buffer->Events[writeCount % ThreadBuffer::Capacity] = { name, path, start, end, depth };
+	buffer->WriteCount.store(writeCount + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+	GetThreadBuffer()->Name = name;
+}
+
+void Profiler::ReleaseThreadBuffer()
+{
+	std::lock_guard<std::mutex> lock(m_threadMutex);
+	m_freeThreads.push_back(t_threadIndex);
+	t_threadBuffer = nullptr;
+}
+
+void Profiler::BeginFrame()
+{
+	DrainThreads();
+
+	// Scopes that ran this frame add a sample, the rest keep their history untouched
+	for (ScopeHistory& scope : m_scopes)
+	{
+		if (scope.CurrentCalls == 0)
+		{
+			continue;
+		}
+
+		uint32_t slot = scope.Written % ScopeHistory::HistoryLength;
+		scope.FrameMs[slot] = scope.CurrentMs;
+		scope.FrameCalls[slot] = scope.CurrentCalls;
+		scope.Written++;
+
+		scope.CurrentMs = 0.0f;
+		scope.CurrentCalls = 0;
+	}
+}
+
+int64_t Profiler::GetTimestamp()
+{
+#if defined(_WIN32)
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	return counter.QuadPart;
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint32_t& Profiler::GetThreadDepth()
+{
+	return t_threadDepth;
+}
+
+uint64_t Profiler::EnterScope(const char* name)
+{
+	uint32_t depth = t_threadDepth++;
+
+	// FNV-1a over the parent's path, a separator and the name, so the same name under another parent hashes apart
+	uint64_t path = depth > 0 ? t_threadPaths[(std::min)(depth, MaxScopeDepth) - 1] : 14695981039346656037ull;
+	path = (path ^ '/') * 1099511628211ull;
+	for (const char* character = name; *character; character++)
+	{
+		path = (path ^ static_cast<unsigned char>(*character)) * 1099511628211ull;
+	}
+
+	if (depth < MaxScopeDepth)
+	{
+		t_threadPaths[depth] = path;
+	}
+
+	return path;
+}
+#pragma endregion
+
+#pragma region Report Methods
+std::vector<ProfileScopeStats> Profiler::GetScopeStats() const
+{
+	std::vector<ProfileScopeStats> stats;
+	stats.reserve(m_scopes.size());
+
+	float samples[ScopeHistory::HistoryLength];
+
+	for (const ScopeHistory& scope : m_scopes)
+	{
+		uint32_t count = scope.Written < ScopeHistory::HistoryLength ? scope.Written : ScopeHistory::HistoryLength;
+		if (count == 0)
+		{
+			continue;
+		}
+
+		float total = 0.0f;
+		uint32_t calls = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			samples[i] = scope.FrameMs[i];
+			total += scope.FrameMs[i];
+			calls += scope.FrameCalls[i];
+		}
+
+		// The 99th percentile is the sample 99% of the way up the sorted history
+		std::sort(samples, samples + count);
+		uint32_t percentileIndex = (std::min)(count - 1, static_cast<uint32_t>(count * 0.99f));
+
+		ProfileScopeStats scopeStats = {};
+		scopeStats.Name = scope.Name;
+		scopeStats.Depth = scope.Depth;
+		scopeStats.CallsPerFrame = static_cast<float>(calls) / count;
+		scopeStats.MinMs = samples[0];
+		scopeStats.AverageMs = total / count;
+		scopeStats.P99Ms = samples[percentileIndex];
+		stats.push_back(scopeStats);
+	}
+
+	return stats;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path)
+{
+	std::ofstream file(path);
+
+	if (!file.is_open())
+	{
+		std::cerr << "Failed to open " << path << " for the profiler trace." << std::endl;
+		return false;
+	}
+
+	// Pick up anything recorded since the last frame closed, it is added to the statistics when the frame does
+	DrainThreads();
+
+	const double microsecondsPerTick = 1000000.0 / m_frequency;
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	// Oldest first, the ring starts at m_traceStart once it has wrapped
+	for (size_t i = 0; i < m_traceEvents.size(); i++)
+	{
+		const auto& traceEvent = m_traceEvents[(m_traceStart + i) % m_traceEvents.size()];
+		const ProfileEvent& profileEvent = traceEvent.first;
+
+		file << std::fixed << std::setprecision(3) << "{\"name\":\"" << profileEvent.Name
+			<< "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << traceEvent.second
+			<< ",\"ts\":" << (profileEvent.Start - m_startTime) * microsecondsPerTick
+			<< ",\"dur\":" << (profileEvent.End - profileEvent.Start) * microsecondsPerTick << "},\n";
+	}
+
+	// Metadata events name the threads
+	{
+		std::lock_guard<std::mutex> lock(m_threadMutex);
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(m_threads.size()); i++)
+		{
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":\""
+				<< (m_threads[i]->Name ? m_threads[i]->Name : "Thread") << " " << i << "\"}}"
+				<< (i + 1 < m_threads.size() ? ",\n" : "\n");
+		}
+	}
+
+	file << "]}" << std::endl;
+
+	return true;
+}
+
+void Profiler::Print(std::ostream& stream) const
+{
+	stream << std::left << std::setw(48) << "Scope" << std::right << std::setw(10) << "Calls" << std::setw(10)
+		<< "Min ms" << std::setw(10) << "Avg ms" << std::setw(10) << "P99 ms" << std::endl;
+
+	for (const ProfileScopeStats& stats : GetScopeStats())
+	{
+		// Indented by depth so the nesting reads like a tree
+		std::string name = std::string(stats.Depth * 2, ' ') + stats.Name;
+
+		stream << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(10) << stats.CallsPerFrame << std::setw(10) << stats.MinMs << std::setw(10)
+			<< stats.AverageMs << std::setw(10) << stats.P99Ms << std::endl;
+	}
+}
+#pragma endregion
+
+#pragma region Private Methods
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+	if (t_threadBuffer == nullptr)
+	{
+		// Buffers belong to the profiler, so the events of finished loader threads can still be drained
+		std::lock_guard<std::mutex> lock(m_threadMutex);
+
+		if (!m_freeThreads.empty())
+		{
+			t_threadIndex = m_freeThreads.back();
+			m_freeThreads.pop_back();
+		}
+		else
+		{
+			t_threadIndex = static_cast<uint32_t>(m_threads.size());
+			m_threads.push_back(std::make_unique<ThreadBuffer>());
+		}
+
+		t_threadBuffer = m_threads[t_threadIndex].get();
+
+		// Touching the release object makes sure it is constructed, and so destroyed when the thread exits
+		(void)&t_threadBufferRelease;
+	}
+
+	return static_cast<ThreadBuffer*>(t_threadBuffer);
+}
+
+void Profiler::DrainThreads()
+{
+	std::lock_guard<std::mutex> lock(m_threadMutex);
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(m_threads.size()); i++)
+	{
+		DrainThread(*m_threads[i], i);
+	}
+}
+
+void Profiler::DrainThread(ThreadBuffer& buffer, uint32_t threadIndex)
+{
+	uint64_t writeCount = buffer.WriteCount.load(std::memory_order_acquire);
+
+	// A thread that wrapped its whole ring since the last drain has lost its oldest events
+	if (writeCount - buffer.ReadCount > ThreadBuffer::Capacity)
+	{
+		buffer.ReadCount = writeCount - ThreadBuffer::Capacity;
+	}
+
+	const float millisecondsPerTick = 1000.0f / m_frequency;
+
+	for (; buffer.ReadCount < writeCount; buffer.ReadCount++)
+	{
+		const ProfileEvent& profileEvent = buffer.Events[buffer.ReadCount % ThreadBuffer::Capacity];
+
+		ScopeHistory& scope = FindScope(profileEvent);
+		scope.CurrentMs += (profileEvent.End - profileEvent.Start) * millisecondsPerTick;
+		scope.CurrentCalls++;
+
+		if (m_traceEvents.size() < MaxTraceEvents)
+		{
+			m_traceEvents.emplace_back(profileEvent, threadIndex);
+		}
+		else
+		{
+			m_traceEvents[m_traceStart] = std::make_pair(profileEvent, threadIndex);
+			m_traceStart = (m_traceStart + 1) % MaxTraceEvents;
+		}
+	}
+}
+
+Profiler::ScopeHistory& Profiler::FindScope(const ProfileEvent& profileEvent)
+{
+	// The path hashes the names rather than the pointers, so copies of a literal in other translation units match.
+	// The same function called under another parent is kept apart so the table still reads as a tree
+	for (ScopeHistory& scope : m_scopes)
+	{
+		if (scope.Path == profileEvent.Path && scope.Depth == profileEvent.Depth)
+		{
+			return scope;
+		}
+	}
+
+	m_scopes.emplace_back();
+	m_scopes.back().Name = profileEvent.Name;
+	m_scopes.back().Path = profileEvent.Path;
+	m_scopes.back().Depth = profileEvent.Depth;
+
+	return m_scopes.back();
+}
+#pragma endregion
+#endif
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, so the profiled modules build and are tested without D3D or Windows
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Define DISABLE_PROFILER to compile every PROFILE_ macro out, leaving no code or data behind
+#ifndef DISABLE_PROFILER
+#define PROFILER_ENABLED
+#endif
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+#ifdef PROFILER_ENABLED
+// Times the enclosing scope, the name must be a string literal (only the pointer is stored)
+#define PROFILE_SCOPE(name) ProfileScope PROFILER_CONCAT(profileScope, __LINE__)(name)
+
+// Times the enclosing function
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+
+// Names the calling thread in the trace
+#define PROFILE_THREAD(name) Profiler::GetInstance()->SetThreadName(name)
+
+// Closes the frame, call once at the start of every frame
+#define PROFILE_BEGIN_FRAME() Profiler::GetInstance()->BeginFrame()
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_THREAD(name)
+#define PROFILE_BEGIN_FRAME()
+#endif
+
+// Struct to hold one timed scope
+struct ProfileEvent
+{
+	const char* Name;
+	uint64_t Path;
+	int64_t Start;
+	int64_t End;
+	uint32_t Depth;
+};
+
+// Struct to hold the rolling statistics of one scope, times are per frame (every call in the frame added together)
+struct ProfileScopeStats
+{
+	const char* Name;
+	uint32_t Depth;
+	float CallsPerFrame;
+	float MinMs;
+	float AverageMs;
+	float P99Ms;
+};
+
+class Profiler
+{
+public:
+#pragma region Singleton
+	// Only allow one instance of the Profiler
+	// Singleton Pattern
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	// Get the instance of the Profiler
+	// Returns Profiler* - The instance of the Profiler
+	static Profiler* GetInstance()
+	{
+		static Profiler instance;
+		return &instance;
+	}
+#pragma endregion
+
+#pragma region Recording Methods
+	// Records a finished scope into the calling thread's ring buffer, no locks once the thread has its buffer
+	void Record(const char* name, uint64_t path, int64_t start, int64_t end, uint32_t depth);
+
+	// Names the calling thread in the trace
+	void SetThreadName(const char* name);
+
+	// Hands the calling thread's buffer back for the next new thread, called automatically when a thread exits
+	void ReleaseThreadBuffer();
+
+	// Closes the frame, drains every thread's buffer into the trace and adds the frame to the rolling statistics
+	void BeginFrame();
+
+	// Gets the current time
+	// Returns int64_t - The time in performance counter ticks (nanoseconds off Windows)
+	static int64_t GetTimestamp();
+
+	// Gets the nesting depth of the calling thread, incremented by every open scope
+	// Returns uint32_t& - The depth
+	static uint32_t& GetThreadDepth();
+
+	// Opens a scope on the calling thread, one level below the scope already open
+	// Returns uint64_t - A hash of the scope's name and the names of every scope it is nested in
+	static uint64_t EnterScope(const char* name);
+#pragma endregion
+
+#pragma region Report Methods
+	// Gets the rolling min, average and 99th percentile of every scope, in the order they were first seen
+	// Returns std::vector<ProfileScopeStats> - The statistics
+	std::vector<ProfileScopeStats> GetScopeStats() const;
+
+	// Writes the captured events in the Chrome trace event format (open with chrome://tracing or Perfetto)
+	// Returns bool - False if the file could not be opened
+	bool WriteChromeTrace(const std::string& path);
+
+	// Prints the rolling statistics as a table
+	void Print(std::ostream& stream) const;
+#pragma endregion
+
+private:
+#pragma region Private Types
+	// Single producer ring of events, only the owning thread writes and only BeginFrame reads
+	struct ThreadBuffer
+	{
+		static const uint32_t Capacity = 8192;
+
+		ProfileEvent Events[Capacity];
+		std::atomic<uint64_t> WriteCount{ 0 };
+		uint64_t ReadCount = 0;
+		const char* Name = nullptr;
+	};
+
+	// Per-frame totals of one scope over the last HistoryLength frames it ran in
+	struct ScopeHistory
+	{
+		static const uint32_t HistoryLength = 240;
+
+		const char* Name = nullptr;
+		uint64_t Path = 0;
+		uint32_t Depth = 0;
+		float FrameMs[HistoryLength] = {};
+		uint32_t FrameCalls[HistoryLength] = {};
+		uint32_t Written = 0;
+		float CurrentMs = 0.0f;
+		uint32_t CurrentCalls = 0;
+	};
+#pragma endregion
+
+#pragma region Constructor
+	// Constructor reads the timestamp frequency
+	Profiler();
+#pragma endregion
+
+#pragma region Private Methods
+	// Gets the calling thread's buffer, registering it the first time
+	// Returns ThreadBuffer* - The buffer
+	ThreadBuffer* GetThreadBuffer();
+
+	// Copies the events written since the last drain out of every thread's buffer, without closing the frame
+	void DrainThreads();
+
+	// Copies the events written since the last drain out of a thread's buffer
+	void DrainThread(ThreadBuffer& buffer, uint32_t threadIndex);
+
+	// Finds the history of a scope by its path, so a function called from two places is kept as two scopes, adding it
+	// the first time
+	// Returns ScopeHistory& - The history
+	ScopeHistory& FindScope(const ProfileEvent& profileEvent);
+#pragma endregion
+
+#pragma region Member Variables
+	// Buffers of exited threads are reused, so the short-lived loader threads share a handful of them
+	std::mutex m_threadMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+	std::vector<uint32_t> m_freeThreads;
+
+	std::vector<ScopeHistory> m_scopes;
+
+	// Ring of everything drained so far with the thread index, the oldest events are dropped past MaxTraceEvents
+	static const size_t MaxTraceEvents = 1 << 18;
+	std::vector<std::pair<ProfileEvent, uint32_t>> m_traceEvents;
+	size_t m_traceStart = 0;
+
+	int64_t m_frequency = 1;
+	int64_t m_startTime = 0;
+#pragma endregion
+};
+
+// Times a scope from construction to destruction, created by PROFILE_SCOPE
+class ProfileScope
+{
+public:
+	// Constructor starts the timer
+	explicit ProfileScope(const char* name) : m_name(name), m_path(Profiler::EnterScope(name)),
+		m_start(Profiler::GetTimestamp())
+	{
+	}
+
+	// Destructor records the scope
+	~ProfileScope()
+	{
+		uint32_t depth = --Profiler::GetThreadDepth();
+		Profiler::GetInstance()->Record(m_name, m_path, m_start, Profiler::GetTimestamp(), depth);
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	const char* m_name;
+	uint64_t m_path;
+	int64_t m_start;
+};
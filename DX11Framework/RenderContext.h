@@ -0,0 +1,78 @@
+#pragma once
+
+// Include{s}
+#include "Structures.h"
+
+// Resource creation the loaders need, so meshes, textures and terrain can be made by either backend
+class RenderDevice
+{
+public:
+	// Virtual destructor
+	virtual ~RenderDevice() = default;
+
+	// Creates a buffer, same as ID3D11Device::CreateBuffer
+	virtual HRESULT CreateBuffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+		ID3D11Buffer** buffer) = 0;
+
+	// Creates a 2D texture and returns the default view of it
+	virtual HRESULT CreateTexture(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData,
+		ID3D11ShaderResourceView** texture) = 0;
+
+	// Loads a DDS texture
+	virtual HRESULT CreateTextureFromFile(const wchar_t* path, ID3D11ShaderResourceView** texture) = 0;
+};
+
+// Every ID3D11DeviceContext call the frame makes, with the same names and arguments, so the frame loop can run on the
+// D3D11 backend or the null backend
+class RenderContext
+{
+public:
+	// Virtual destructor
+	virtual ~RenderContext() = default;
+
+#pragma region Input Assembler
+	virtual void IASetInputLayout(ID3D11InputLayout* inputLayout) = 0;
+	virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+	virtual void IASetVertexBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* vertexBuffers,
+		const UINT* strides, const UINT* offsets) = 0;
+	virtual void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) = 0;
+#pragma endregion
+
+#pragma region Shader Stages
+	virtual void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances,
+		UINT classInstanceCount) = 0;
+	virtual void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances,
+		UINT classInstanceCount) = 0;
+	virtual void VSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers) = 0;
+	virtual void PSSetConstantBuffers(UINT startSlot, UINT bufferCount, ID3D11Buffer* const* constantBuffers) = 0;
+	virtual void VSSetShaderResources(UINT startSlot, UINT viewCount,
+		ID3D11ShaderResourceView* const* shaderResourceViews) = 0;
+	virtual void PSSetShaderResources(UINT startSlot, UINT viewCount,
+		ID3D11ShaderResourceView* const* shaderResourceViews) = 0;
+	virtual void VSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers) = 0;
+	virtual void PSSetSamplers(UINT startSlot, UINT samplerCount, ID3D11SamplerState* const* samplers) = 0;
+#pragma endregion
+
+#pragma region Rasterizer & Output Merger
+	virtual void RSSetState(ID3D11RasterizerState* rasterizerState) = 0;
+	virtual void RSSetViewports(UINT viewportCount, const D3D11_VIEWPORT* viewports) = 0;
+	virtual void OMSetRenderTargets(UINT viewCount, ID3D11RenderTargetView* const* renderTargetViews,
+		ID3D11DepthStencilView* depthStencilView) = 0;
+	virtual void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) = 0;
+	virtual void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) = 0;
+	virtual void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colour[4]) = 0;
+	virtual void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth,
+		UINT8 stencil) = 0;
+#pragma endregion
+
+#pragma region Resources & Draws
+	virtual HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags,
+		D3D11_MAPPED_SUBRESOURCE* mappedResource) = 0;
+	virtual void Unmap(ID3D11Resource* resource, UINT subresource) = 0;
+	virtual void UpdateSubresource(ID3D11Resource* dstResource, UINT dstSubresource, const D3D11_BOX* dstBox,
+		const void* srcData, UINT srcRowPitch, UINT srcDepthPitch) = 0;
+	virtual void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) = 0;
+	virtual void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation,
+		INT baseVertexLocation, UINT startInstanceLocation) = 0;
+#pragma endregion
+};
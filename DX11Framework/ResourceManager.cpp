@@ -1,8 +1,10 @@
 #include "ResourceManager.h"
 
 #pragma region Load Methods
-ID3D11ShaderResourceView* ResourceManager::LoadTexture(ID3D11Device* _device, const wchar_t* path)
+ID3D11ShaderResourceView* ResourceManager::LoadTexture(RenderDevice* _device, const wchar_t* path)
 {
+	MemoryTagScope textureTag(MemoryTag_Textures);
+
 	// Iterate through the texture paths, if the path is found, return the texture
 	for (int i = 0; i < m_texturePaths.size(); ++i)
 	{
@@ -14,7 +16,7 @@ ID3D11ShaderResourceView* ResourceManager::LoadTexture(ID3D11Device* _device, co
 
 	// Load the texture from the path, if no texture is found
 	ID3D11ShaderResourceView* texture;
-	HRESULT hr = CreateDDSTextureFromFile(_device, path, nullptr, &texture);
+	HRESULT hr = _device->CreateTextureFromFile(path, &texture);
 	if (FAILED(hr)) { return nullptr; }
 
 	m_texturePaths.push_back(path);
@@ -23,8 +25,10 @@ ID3D11ShaderResourceView* ResourceManager::LoadTexture(ID3D11Device* _device, co
 	return texture;
 }
 
-MeshData ResourceManager::LoadMesh(ID3D11Device* _device, const std::string& path)
+MeshData ResourceManager::LoadMesh(RenderDevice* _device, const std::string& path)
 {
+	MemoryTagScope meshTag(MemoryTag_Meshes);
+
 	// Iterate through the mesh paths, if the path is found, return the mesh
 	for (int i = 0; i < m_MeshPaths.size(); ++i)
 	{
@@ -41,15 +45,64 @@ MeshData ResourceManager::LoadMesh(ID3D11Device* _device, const std::string& pat
 
 	return meshData;
 }
+
+const CPUMeshData* ResourceManager::LoadCPUMesh(const std::string& path)
+{
+	MemoryTagScope meshTag(MemoryTag_Meshes);
+
+	// Iterate through the CPU mesh paths, if the path is found, return the mesh
+	for (int i = 0; i < m_CPUMeshPaths.size(); ++i)
+	{
+		if (m_CPUMeshPaths[i] == path)
+		{
+			return m_CPUMeshes[i].get();
+		}
+	}
+
+	// Load the CPU mesh from the path, if no mesh is found
+	auto cpuMesh = std::make_unique<CPUMeshData>();
+	if (!OBJLoader::LoadCPUMesh(path.c_str(), *cpuMesh)) { return nullptr; }
+
+	m_CPUMeshPaths.push_back(path);
+	m_CPUMeshes.push_back(std::move(cpuMesh));
+
+	return m_CPUMeshes.back().get();
+}
 #pragma endregion
 
 #pragma region Destructor
 // Destructor
 ResourceManager::~ResourceManager()
 {
+	// The resource manager owns every cached resource, game objects sharing them must not release them
+	for (auto& texture : m_Textures)
+	{
+		if (texture)
+		{
+			texture->Release();
+			texture = nullptr;
+		}
+	}
+
+	for (auto& mesh : m_Meshes)
+	{
+		if (mesh.VertexBuffer)
+		{
+			mesh.VertexBuffer->Release();
+			mesh.VertexBuffer = nullptr;
+		}
+		if (mesh.IndexBuffer)
+		{
+			mesh.IndexBuffer->Release();
+			mesh.IndexBuffer = nullptr;
+		}
+	}
+
 	m_Textures.clear();
 	m_Meshes.clear();
 	m_texturePaths.clear();
 	m_MeshPaths.clear();
+	m_CPUMeshes.clear();
+	m_CPUMeshPaths.clear();
 }
 #pragma endregion
\ No newline at end of file
@@ -3,6 +3,7 @@
 // Include{s}
 #include "Structures.h"
 #include "OBJLoader.h"
+#include "MemoryTracker.h"
 
 class ResourceManager
 {
@@ -25,10 +26,14 @@ public:
 
 #pragma region LoadMethods
 	// Checks to see if the texture has already been loaded, if not, loads it
-	ID3D11ShaderResourceView* LoadTexture(ID3D11Device* _device, const wchar_t* path);
+	ID3D11ShaderResourceView* LoadTexture(RenderDevice* _device, const wchar_t* path);
 
 	// Checks to see if the mesh has already been loaded, if not, loads it
-	MeshData LoadMesh(ID3D11Device* _device, const std::string& path);
+	MeshData LoadMesh(RenderDevice* _device, const std::string& path);
+
+	// Checks to see if the CPU copy of the mesh has already been loaded, if not, loads it
+	// Returns CPUMeshData* - The cached positions and indices, or nullptr if the mesh could not be read
+	const CPUMeshData* LoadCPUMesh(const std::string& path);
 #pragma endregion
 
 private:
@@ -48,5 +53,9 @@ private:
 	// Vectors to store mesh paths and their corresponding data
 	std::vector<std::string> m_MeshPaths;
 	std::vector<MeshData> m_Meshes;
+
+	// Vectors to store CPU mesh paths and their data (heap allocated so the returned pointers stay valid)
+	std::vector<std::string> m_CPUMeshPaths;
+	std::vector<std::unique_ptr<CPUMeshData>> m_CPUMeshes;
 #pragma endregion
 };
@@ -0,0 +1,743 @@
+// Include{s}
+#include "SceneBVH.h"
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+#include "ParallelFor.h"
+
+using namespace DirectX;
+
+// Build and traversal limits, leaves stop splitting at the depth limit so the traversal stacks can never overflow
+constexpr uint32_t MaxLeafSize = 2;
+constexpr uint32_t MaxDepth = 60;
+constexpr uint32_t StackSize = MaxDepth + 2;
+constexpr int BinCount = 8;
+
+// Multi-frustum queries split into roughly this many subtrees, and only go wide once there is enough work to share
+constexpr uint32_t QueryTaskCount = 32;
+constexpr uint32_t ParallelQueryThreshold = 2048;
+
+// A subtree still to be walked by a multi-frustum query, with the frustums it still has to be tested against and the
+// ones that already see all of it
+struct FrustumQueryEntry
+{
+	uint32_t Node;
+	uint64_t TestMask;
+	uint64_t AcceptMask;
+};
+
+#pragma region Helper Functions
+// Half the surface area of a box, the constant factor does not matter when comparing SAH costs
+static float HalfSurfaceArea(const XMFLOAT3& boundsMin, const XMFLOAT3& boundsMax)
+{
+	float x = boundsMax.x - boundsMin.x;
+	float y = boundsMax.y - boundsMin.y;
+	float z = boundsMax.z - boundsMin.z;
+
+	return x * y + y * z + z * x;
+}
+
+// Grows a box to contain another box
+static void GrowBounds(XMFLOAT3& boundsMin, XMFLOAT3& boundsMax, const XMFLOAT3& otherMin, const XMFLOAT3& otherMax)
+{
+	boundsMin = XMFLOAT3(fminf(boundsMin.x, otherMin.x), fminf(boundsMin.y, otherMin.y), fminf(boundsMin.z, otherMin.z));
+	boundsMax = XMFLOAT3(fmaxf(boundsMax.x, otherMax.x), fmaxf(boundsMax.y, otherMax.y), fmaxf(boundsMax.z, otherMax.z));
+}
+
+// Slab test, tNear is the distance along the ray where it enters the box
+static bool IntersectRayBox(const XMFLOAT3& origin, const XMFLOAT3& inverseDirection, const XMFLOAT3& boundsMin,
+	const XMFLOAT3& boundsMax, float maxDistance, float& tNear)
+{
+	float tx1 = (boundsMin.x - origin.x) * inverseDirection.x;
+	float tx2 = (boundsMax.x - origin.x) * inverseDirection.x;
+	float tMin = fminf(tx1, tx2);
+	float tMax = fmaxf(tx1, tx2);
+
+	float ty1 = (boundsMin.y - origin.y) * inverseDirection.y;
+	float ty2 = (boundsMax.y - origin.y) * inverseDirection.y;
+	tMin = fmaxf(tMin, fminf(ty1, ty2));
+	tMax = fminf(tMax, fmaxf(ty1, ty2));
+
+	float tz1 = (boundsMin.z - origin.z) * inverseDirection.z;
+	float tz2 = (boundsMax.z - origin.z) * inverseDirection.z;
+	tMin = fmaxf(tMin, fminf(tz1, tz2));
+	tMax = fminf(tMax, fmaxf(tz1, tz2));
+
+	// Rays starting inside the box hit it at distance 0
+	tMin = fmaxf(tMin, 0.0f);
+	if (tMax < tMin || tMin > maxDistance)
+	{
+		return false;
+	}
+
+	tNear = tMin;
+	return true;
+}
+
+// Converts min/max corners into the centre/extents form the frustum tests use
+static void ToCenterExtents(const XMFLOAT3& boundsMin, const XMFLOAT3& boundsMax, XMFLOAT3& center, XMFLOAT3& extents)
+{
+	center = XMFLOAT3(0.5f * (boundsMin.x + boundsMax.x), 0.5f * (boundsMin.y + boundsMax.y),
+		0.5f * (boundsMin.z + boundsMax.z));
+	extents = XMFLOAT3(0.5f * (boundsMax.x - boundsMin.x), 0.5f * (boundsMax.y - boundsMin.y),
+		0.5f * (boundsMax.z - boundsMin.z));
+}
+#pragma endregion
+
+#pragma region Build Methods
+void SceneBVH::Build(const std::vector<XMFLOAT3>& centers, const std::vector<XMFLOAT3>& extents)
+{
+	const uint32_t count = static_cast<uint32_t>(centers.size());
+
+	m_primitiveMin.resize(count);
+	m_primitiveMax.resize(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		UpdatePrimitive(i, centers[i], extents[i]);
+	}
+
+	m_primitiveIndices.resize(count);
+	std::iota(m_primitiveIndices.begin(), m_primitiveIndices.end(), 0);
+
+	m_nodes.clear();
+	if (count == 0)
+	{
+		return;
+	}
+
+	// A binary tree over N leaves never needs more than 2N - 1 nodes
+	m_nodes.reserve(2 * count - 1);
+
+	BVHNode root = {};
+	root.LeftFirst = 0;
+	root.Count = count;
+	m_nodes.push_back(root);
+
+	UpdateNodeBounds(0);
+	Subdivide(0, 0);
+}
+
+void SceneBVH::UpdatePrimitive(uint32_t primitive, const XMFLOAT3& center, const XMFLOAT3& extents)
+{
+	m_primitiveMin[primitive] = XMFLOAT3(center.x - extents.x, center.y - extents.y, center.z - extents.z);
+	m_primitiveMax[primitive] = XMFLOAT3(center.x + extents.x, center.y + extents.y, center.z + extents.z);
+}
+
+void SceneBVH::Refit()
+{
+	// Children are always stored after their parent, so walking backwards visits them first
+	for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; i--)
+	{
+		BVHNode& node = m_nodes[i];
+
+		if (node.Count > 0)
+		{
+			UpdateNodeBounds(i);
+			continue;
+		}
+
+		const BVHNode& left = m_nodes[node.LeftFirst];
+		const BVHNode& right = m_nodes[node.LeftFirst + 1];
+
+		node.BoundsMin = left.BoundsMin;
+		node.BoundsMax = left.BoundsMax;
+		GrowBounds(node.BoundsMin, node.BoundsMax, right.BoundsMin, right.BoundsMax);
+	}
+}
+#pragma endregion
+
+#pragma region Query Methods
+void SceneBVH::QueryFrustum(const FrustumCuller& frustum, std::vector<uint32_t>& results) const
+{
+	results.clear();
+
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	uint32_t stack[StackSize];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	XMFLOAT3 center;
+	XMFLOAT3 extents;
+
+	while (stackSize > 0)
+	{
+		uint32_t nodeIndex = stack[--stackSize];
+		const BVHNode& node = m_nodes[nodeIndex];
+
+		ToCenterExtents(node.BoundsMin, node.BoundsMax, center, extents);
+		FrustumTest test = frustum.Classify(center, extents);
+
+		if (test == Frustum_Outside)
+		{
+			continue;
+		}
+
+		// Everything below a node that is fully inside is visible, no need to test it
+		if (test == Frustum_Inside)
+		{
+			CollectSubtree(nodeIndex, results);
+			continue;
+		}
+
+		if (node.Count > 0)
+		{
+			for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; i++)
+			{
+				uint32_t primitive = m_primitiveIndices[i];
+
+				ToCenterExtents(m_primitiveMin[primitive], m_primitiveMax[primitive], center, extents);
+				if (frustum.IsVisible(center, extents))
+				{
+					results.push_back(primitive);
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.LeftFirst + 1;
+		stack[stackSize++] = node.LeftFirst;
+	}
+}
+
+void SceneBVH::QueryFrustums(const FrustumCuller* frustums, uint32_t frustumCount, std::vector<uint64_t>& visibility)
+	const
+{
+	visibility.assign(m_primitiveMin.size(), 0);
+
+	if (m_nodes.empty() || frustumCount == 0)
+	{
+		return;
+	}
+
+	frustumCount = frustumCount < MaxQueryFrustums ? frustumCount : MaxQueryFrustums;
+	const uint64_t allFrustums = frustumCount == 64 ? ~0ull : (1ull << frustumCount) - 1;
+
+	// Small scenes or few frustums are not worth waking the thread pool for
+	if (m_primitiveMin.size() * frustumCount < ParallelQueryThreshold)
+	{
+		QueryFrustumsSubtree(frustums, frustumCount, 0, allFrustums, 0, visibility);
+		return;
+	}
+
+	// Split the top of the tree a level at a time until there are enough subtrees to share out. The subtrees never
+	// hold the same primitive, so the tasks write to separate masks without locking
+	FrustumQueryEntry levels[2][QueryTaskCount * 2];
+	FrustumQueryEntry* tasks = levels[0];
+	FrustumQueryEntry* nextLevel = levels[1];
+	uint32_t taskCount = 1;
+	bool split = true;
+
+	tasks[0] = { 0, allFrustums, 0 };
+
+	while (split && taskCount < QueryTaskCount)
+	{
+		uint32_t nextCount = 0;
+		split = false;
+
+		for (uint32_t i = 0; i < taskCount; i++)
+		{
+			const BVHNode& node = m_nodes[tasks[i].Node];
+
+			if (node.Count > 0)
+			{
+				nextLevel[nextCount++] = tasks[i];
+				continue;
+			}
+
+			nextLevel[nextCount++] = { node.LeftFirst, tasks[i].TestMask, tasks[i].AcceptMask };
+			nextLevel[nextCount++] = { node.LeftFirst + 1, tasks[i].TestMask, tasks[i].AcceptMask };
+			split = true;
+		}
+
+		std::swap(tasks, nextLevel);
+		taskCount = nextCount;
+	}
+
+	ParallelFor(uint32_t(0), taskCount, [&](uint32_t i)
+	{
+		QueryFrustumsSubtree(frustums, frustumCount, tasks[i].Node, tasks[i].TestMask, tasks[i].AcceptMask,
+			visibility);
+	});
+}
+
+
+bool SceneBVH::RayCast(const XMFLOAT3& origin, const XMFLOAT3& direction, float maxDistance, uint32_t& hitPrimitive,
+	float& hitDistance) const
+{
+	if (m_nodes.empty())
+	{
+		return false;
+	}
+
+	// Zero components use a huge (but finite) inverse, so 0 * inverse never produces a NaN
+	XMFLOAT3 inverseDirection(
+		direction.x != 0.0f ? 1.0f / direction.x : FLT_MAX,
+		direction.y != 0.0f ? 1.0f / direction.y : FLT_MAX,
+		direction.z != 0.0f ? 1.0f / direction.z : FLT_MAX);
+
+	bool hit = false;
+	float closestDistance = maxDistance;
+	float tNear = 0.0f;
+
+	uint32_t stack[StackSize];
+	uint32_t stackSize = 0;
+
+	if (IntersectRayBox(origin, inverseDirection, m_nodes[0].BoundsMin, m_nodes[0].BoundsMax, closestDistance, tNear))
+	{
+		stack[stackSize++] = 0;
+	}
+
+	while (stackSize > 0)
+	{
+		const BVHNode& node = m_nodes[stack[--stackSize]];
+
+		// A closer hit may have been found since this node was pushed
+		if (!IntersectRayBox(origin, inverseDirection, node.BoundsMin, node.BoundsMax, closestDistance, tNear))
+		{
+			continue;
+		}
+
+		if (node.Count > 0)
+		{
+			for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; i++)
+			{
+				uint32_t primitive = m_primitiveIndices[i];
+
+				if (IntersectRayBox(origin, inverseDirection, m_primitiveMin[primitive], m_primitiveMax[primitive],
+					closestDistance, tNear) && tNear < closestDistance)
+				{
+					closestDistance = tNear;
+					hitPrimitive = primitive;
+					hit = true;
+				}
+			}
+			continue;
+		}
+
+		// Visit the nearer child first, so later subtrees are more likely to be rejected by the closest hit
+		uint32_t leftIndex = node.LeftFirst;
+		uint32_t rightIndex = node.LeftFirst + 1;
+		float tLeft = 0.0f;
+		float tRight = 0.0f;
+		bool hitLeft = IntersectRayBox(origin, inverseDirection, m_nodes[leftIndex].BoundsMin,
+			m_nodes[leftIndex].BoundsMax, closestDistance, tLeft);
+		bool hitRight = IntersectRayBox(origin, inverseDirection, m_nodes[rightIndex].BoundsMin,
+			m_nodes[rightIndex].BoundsMax, closestDistance, tRight);
+
+		if (hitLeft && hitRight)
+		{
+			stack[stackSize++] = tLeft < tRight ? rightIndex : leftIndex;
+			stack[stackSize++] = tLeft < tRight ? leftIndex : rightIndex;
+		}
+		else if (hitLeft)
+		{
+			stack[stackSize++] = leftIndex;
+		}
+		else if (hitRight)
+		{
+			stack[stackSize++] = rightIndex;
+		}
+	}
+
+	if (hit)
+	{
+		hitDistance = closestDistance;
+	}
+
+	return hit;
+}
+
+void SceneBVH::QuerySphere(const XMFLOAT3& center, float radius, std::vector<uint32_t>& results) const
+{
+	results.clear();
+
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	const float radiusSquared = radius * radius;
+
+	// Squared distance from the sphere centre to the closest point of a box
+	auto overlaps = [&](const XMFLOAT3& boundsMin, const XMFLOAT3& boundsMax)
+	{
+		float dx = center.x - fmaxf(boundsMin.x, fminf(center.x, boundsMax.x));
+		float dy = center.y - fmaxf(boundsMin.y, fminf(center.y, boundsMax.y));
+		float dz = center.z - fmaxf(boundsMin.z, fminf(center.z, boundsMax.z));
+
+		return dx * dx + dy * dy + dz * dz <= radiusSquared;
+	};
+
+	uint32_t stack[StackSize];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const BVHNode& node = m_nodes[stack[--stackSize]];
+
+		if (!overlaps(node.BoundsMin, node.BoundsMax))
+		{
+			continue;
+		}
+
+		if (node.Count > 0)
+		{
+			for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; i++)
+			{
+				uint32_t primitive = m_primitiveIndices[i];
+
+				if (overlaps(m_primitiveMin[primitive], m_primitiveMax[primitive]))
+				{
+					results.push_back(primitive);
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.LeftFirst + 1;
+		stack[stackSize++] = node.LeftFirst;
+	}
+}
+
+void SceneBVH::QueryBox(const XMFLOAT3& center, const XMFLOAT3& extents, std::vector<uint32_t>& results) const
+{
+	results.clear();
+
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	const XMFLOAT3 queryMin(center.x - extents.x, center.y - extents.y, center.z - extents.z);
+	const XMFLOAT3 queryMax(center.x + extents.x, center.y + extents.y, center.z + extents.z);
+
+	auto overlaps = [&](const XMFLOAT3& boundsMin, const XMFLOAT3& boundsMax)
+	{
+		return boundsMin.x <= queryMax.x && boundsMax.x >= queryMin.x &&
+			boundsMin.y <= queryMax.y && boundsMax.y >= queryMin.y &&
+			boundsMin.z <= queryMax.z && boundsMax.z >= queryMin.z;
+	};
+
+	uint32_t stack[StackSize];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const BVHNode& node = m_nodes[stack[--stackSize]];
+
+		if (!overlaps(node.BoundsMin, node.BoundsMax))
+		{
+			continue;
+		}
+
+		if (node.Count > 0)
+		{
+			for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; i++)
+			{
+				uint32_t primitive = m_primitiveIndices[i];
+
+				if (overlaps(m_primitiveMin[primitive], m_primitiveMax[primitive]))
+				{
+					results.push_back(primitive);
+				}
+			}
+			continue;
+		}
+
+		stack[stackSize++] = node.LeftFirst + 1;
+		stack[stackSize++] = node.LeftFirst;
+	}
+}
+#pragma endregion
+
+#pragma region Private Methods
+void SceneBVH::UpdateNodeBounds(uint32_t nodeIndex)
+{
+	BVHNode& node = m_nodes[nodeIndex];
+
+	node.BoundsMin = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+	node.BoundsMax = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; i++)
+	{
+		uint32_t primitive = m_primitiveIndices[i];
+		GrowBounds(node.BoundsMin, node.BoundsMax, m_primitiveMin[primitive], m_primitiveMax[primitive]);
+	}
+}
+
+void SceneBVH::Subdivide(uint32_t nodeIndex, uint32_t depth)
+{
+	// Copy what is needed, pushing the children can move the node array
+	const uint32_t first = m_nodes[nodeIndex].LeftFirst;
+	const uint32_t count = m_nodes[nodeIndex].Count;
+
+	if (count <= MaxLeafSize || depth >= MaxDepth)
+	{
+		return;
+	}
+
+	// Split on primitive centroids, (min + max) is twice the centroid which does not change the ordering
+	auto centroid = [&](uint32_t primitive, int axis)
+	{
+		return (&m_primitiveMin[primitive].x)[axis] + (&m_primitiveMax[primitive].x)[axis];
+	};
+
+	float centroidMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float centroidMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (uint32_t i = first; i < first + count; i++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			centroidMin[axis] = fminf(centroidMin[axis], centroid(m_primitiveIndices[i], axis));
+			centroidMax[axis] = fmaxf(centroidMax[axis], centroid(m_primitiveIndices[i], axis));
+		}
+	}
+
+	// Binned SAH, cost of a split is the primitive count of each side weighted by its surface area
+	int bestAxis = -1;
+	float bestSplit = 0.0f;
+	float bestCost = FLT_MAX;
+
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (centroidMax[axis] <= centroidMin[axis])
+		{
+			continue;
+		}
+
+		XMFLOAT3 binMin[BinCount];
+		XMFLOAT3 binMax[BinCount];
+		uint32_t binPrimitives[BinCount] = {};
+		for (int b = 0; b < BinCount; b++)
+		{
+			binMin[b] = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+			binMax[b] = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		}
+
+		float scale = BinCount / (centroidMax[axis] - centroidMin[axis]);
+		for (uint32_t i = first; i < first + count; i++)
+		{
+			uint32_t primitive = m_primitiveIndices[i];
+			int b = static_cast<int>((centroid(primitive, axis) - centroidMin[axis]) * scale);
+			b = b < BinCount - 1 ? b : BinCount - 1;
+
+			binPrimitives[b]++;
+			GrowBounds(binMin[b], binMax[b], m_primitiveMin[primitive], m_primitiveMax[primitive]);
+		}
+
+		// Sweep from both ends to get the area and count on each side of every bin boundary
+		float leftArea[BinCount - 1];
+		float rightArea[BinCount - 1];
+		uint32_t leftCount[BinCount - 1];
+		uint32_t rightCount[BinCount - 1];
+
+		XMFLOAT3 leftMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		XMFLOAT3 leftMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		XMFLOAT3 rightMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		XMFLOAT3 rightMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		uint32_t leftSum = 0;
+		uint32_t rightSum = 0;
+
+		for (int b = 0; b < BinCount - 1; b++)
+		{
+			leftSum += binPrimitives[b];
+			leftCount[b] = leftSum;
+			if (binPrimitives[b] > 0)
+			{
+				GrowBounds(leftMin, leftMax, binMin[b], binMax[b]);
+			}
+			leftArea[b] = leftSum > 0 ? HalfSurfaceArea(leftMin, leftMax) : 0.0f;
+
+			int r = BinCount - 1 - b;
+			rightSum += binPrimitives[r];
+			rightCount[r - 1] = rightSum;
+			if (binPrimitives[r] > 0)
+			{
+				GrowBounds(rightMin, rightMax, binMin[r], binMax[r]);
+			}
+			rightArea[r - 1] = rightSum > 0 ? HalfSurfaceArea(rightMin, rightMax) : 0.0f;
+		}
+
+		for (int b = 0; b < BinCount - 1; b++)
+		{
+			float cost = leftCount[b] * leftArea[b] + rightCount[b] * rightArea[b];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = centroidMin[axis] + (b + 1) / scale;
+			}
+		}
+	}
+
+	// Keep the node as a leaf when no split is cheaper than testing every primitive in it
+	const BVHNode& node = m_nodes[nodeIndex];
+	float leafCost = count * HalfSurfaceArea(node.BoundsMin, node.BoundsMax);
+	if (bestAxis < 0 || bestCost >= leafCost)
+	{
+		return;
+	}
+
+	// Partition the primitive range in place around the split plane
+	uint32_t i = first;
+	uint32_t j = first + count - 1;
+	while (i <= j)
+	{
+		if (centroid(m_primitiveIndices[i], bestAxis) < bestSplit)
+		{
+			i++;
+		}
+		else
+		{
+			std::swap(m_primitiveIndices[i], m_primitiveIndices[j]);
+			if (j == 0)
+			{
+				break;
+			}
+			j--;
+		}
+	}
+
+	uint32_t leftPrimitives = i - first;
+	if (leftPrimitives == 0 || leftPrimitives == count)
+	{
+		return;
+	}
+
+	uint32_t leftIndex = static_cast<uint32_t>(m_nodes.size());
+
+	BVHNode leftChild = {};
+	leftChild.LeftFirst = first;
+	leftChild.Count = leftPrimitives;
+	m_nodes.push_back(leftChild);
+
+	BVHNode rightChild = {};
+	rightChild.LeftFirst = i;
+	rightChild.Count = count - leftPrimitives;
+	m_nodes.push_back(rightChild);
+
+	m_nodes[nodeIndex].LeftFirst = leftIndex;
+	m_nodes[nodeIndex].Count = 0;
+
+	UpdateNodeBounds(leftIndex);
+	UpdateNodeBounds(leftIndex + 1);
+
+	Subdivide(leftIndex, depth + 1);
+	Subdivide(leftIndex + 1, depth + 1);
+}
+
+void SceneBVH::QueryFrustumsSubtree(const FrustumCuller* frustums, uint32_t frustumCount, uint32_t nodeIndex,
+	uint64_t testMask, uint64_t acceptMask, std::vector<uint64_t>& visibility) const
+{
+	FrustumQueryEntry stack[StackSize];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = { nodeIndex, testMask, acceptMask };
+
+	XMFLOAT3 center;
+	XMFLOAT3 extents;
+
+	while (stackSize > 0)
+	{
+		FrustumQueryEntry entry = stack[--stackSize];
+		const BVHNode& node = m_nodes[entry.Node];
+
+		ToCenterExtents(node.BoundsMin, node.BoundsMax, center, extents);
+
+		// Frustums the node is outside of drop out, and frustums it is fully inside of stop testing
+		for (uint32_t f = 0; f < frustumCount; f++)
+		{
+			uint64_t bit = 1ull << f;
+			if ((entry.TestMask & bit) == 0)
+			{
+				continue;
+			}
+
+			FrustumTest test = frustums[f].Classify(center, extents);
+
+			if (test == Frustum_Outside)
+			{
+				entry.TestMask &= ~bit;
+			}
+			else if (test == Frustum_Inside)
+			{
+				entry.TestMask &= ~bit;
+				entry.AcceptMask |= bit;
+			}
+		}
+
+		if (entry.TestMask == 0)
+		{
+			if (entry.AcceptMask != 0)
+			{
+				MarkSubtree(entry.Node, entry.AcceptMask, visibility);
+			}
+			continue;
+		}
+
+		if (node.Count > 0)
+		{
+			for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; i++)
+			{
+				uint32_t primitive = m_primitiveIndices[i];
+				uint64_t visible = entry.AcceptMask;
+
+				ToCenterExtents(m_primitiveMin[primitive], m_primitiveMax[primitive], center, extents);
+				for (uint32_t f = 0; f < frustumCount; f++)
+				{
+					uint64_t bit = 1ull << f;
+					if ((entry.TestMask & bit) && frustums[f].IsVisible(center, extents))
+					{
+						visible |= bit;
+					}
+				}
+
+				visibility[primitive] |= visible;
+			}
+			continue;
+		}
+
+		stack[stackSize++] = { node.LeftFirst + 1, entry.TestMask, entry.AcceptMask };
+		stack[stackSize++] = { node.LeftFirst, entry.TestMask, entry.AcceptMask };
+	}
+}
+
+void SceneBVH::MarkSubtree(uint32_t nodeIndex, uint64_t mask, std::vector<uint64_t>& visibility) const
+{
+	const BVHNode& node = m_nodes[nodeIndex];
+
+	if (node.Count > 0)
+	{
+		for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; i++)
+		{
+			visibility[m_primitiveIndices[i]] |= mask;
+		}
+		return;
+	}
+
+	MarkSubtree(node.LeftFirst, mask, visibility);
+	MarkSubtree(node.LeftFirst + 1, mask, visibility);
+}
+
+void SceneBVH::CollectSubtree(uint32_t nodeIndex, std::vector<uint32_t>& results) const
+{
+	const BVHNode& node = m_nodes[nodeIndex];
+
+	if (node.Count > 0)
+	{
+		for (uint32_t i = node.LeftFirst; i < node.LeftFirst + node.Count; i++)
+		{
+			results.push_back(m_primitiveIndices[i]);
+		}
+		return;
+	}
+
+	CollectSubtree(node.LeftFirst, results);
+	CollectSubtree(node.LeftFirst + 1, results);
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+// Include{s}
+#include "FrustumCuller.h"
+
+// Most frustums one multi-frustum query can test, one bit each in the visibility masks
+constexpr uint32_t MaxQueryFrustums = 64;
+
+// A node of the hierarchy, two of these fit in a cache line
+// Interior nodes (Count == 0) store the index of their left child, the right child always follows it
+// Leaf nodes store the first entry of their range in the primitive index list
+struct BVHNode
+{
+	DirectX::XMFLOAT3 BoundsMin;
+	uint32_t LeftFirst;
+	DirectX::XMFLOAT3 BoundsMax;
+	uint32_t Count;
+};
+
+class SceneBVH
+{
+public:
+#pragma region Build Methods
+	// Builds the hierarchy over a set of world-space bounding boxes using the surface area heuristic
+	void Build(const std::vector<DirectX::XMFLOAT3>& centers, const std::vector<DirectX::XMFLOAT3>& extents);
+
+	// Replaces the bounding box of a primitive, the hierarchy is not valid again until Refit is called
+	void UpdatePrimitive(uint32_t primitive, const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents);
+
+	// Recomputes the node bounds bottom up without changing the tree topology
+	void Refit();
+#pragma endregion
+
+#pragma region Query Methods
+	// Finds every primitive inside or intersecting the frustum, subtrees fully inside are accepted without further tests
+	void QueryFrustum(const FrustumCuller& frustum, std::vector<uint32_t>& results) const;
+
+	// Finds what every frustum sees in one walk of the tree, bit f of visibility[primitive] is set if frustum f sees
+	// it. Each node is only tested against the frustums still straddling it, and the top subtrees run in parallel
+	void QueryFrustums(const FrustumCuller* frustums, uint32_t frustumCount, std::vector<uint64_t>& visibility) const;
+
+	// Finds the closest primitive whose bounding box is hit by the ray
+	// Returns bool - True if a primitive was hit within maxDistance
+	bool RayCast(const DirectX::XMFLOAT3& origin, const DirectX::XMFLOAT3& direction, float maxDistance,
+		uint32_t& hitPrimitive, float& hitDistance) const;
+
+	// Finds every primitive whose bounding box overlaps the sphere
+	void QuerySphere(const DirectX::XMFLOAT3& center, float radius, std::vector<uint32_t>& results) const;
+
+	// Finds every primitive whose bounding box overlaps the box
+	void QueryBox(const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents,
+		std::vector<uint32_t>& results) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the number of primitives the hierarchy was built over
+	// Returns uint32_t - The primitive count
+	uint32_t GetPrimitiveCount() const { return static_cast<uint32_t>(m_primitiveMin.size()); }
+
+	// Gets the flat node array, the root is node 0
+	// Returns std::vector<BVHNode> - The nodes
+	const std::vector<BVHNode>& GetNodes() const { return m_nodes; }
+#pragma endregion
+
+private:
+#pragma region Private Methods
+	// Recomputes the bounds of a node from the primitives it holds
+	void UpdateNodeBounds(uint32_t nodeIndex);
+
+	// Splits a node along the cheapest binned SAH plane, recursing until splitting no longer pays off
+	void Subdivide(uint32_t nodeIndex, uint32_t depth);
+
+	// Adds every primitive below a node to the results
+	void CollectSubtree(uint32_t nodeIndex, std::vector<uint32_t>& results) const;
+
+	// Walks a subtree for the frustums in testMask, everything below it is already visible to those in acceptMask
+	void QueryFrustumsSubtree(const FrustumCuller* frustums, uint32_t frustumCount, uint32_t nodeIndex,
+		uint64_t testMask, uint64_t acceptMask, std::vector<uint64_t>& visibility) const;
+
+	// Marks every primitive below a node as visible to a set of frustums
+	void MarkSubtree(uint32_t nodeIndex, uint64_t mask, std::vector<uint64_t>& visibility) const;
+#pragma endregion
+
+#pragma region Member Variables
+	std::vector<BVHNode> m_nodes;
+
+	// Leaves index into this list, which is reordered during the build so every leaf is a contiguous range
+	std::vector<uint32_t> m_primitiveIndices;
+
+	// Primitive bounds as min/max corners, in the order they were given to Build
+	std::vector<DirectX::XMFLOAT3> m_primitiveMin;
+	std::vector<DirectX::XMFLOAT3> m_primitiveMax;
+#pragma endregion
+};
@@ -44,8 +44,8 @@ struct VS_Out
 	float2 texCoord : TEXCOORD;
 };
 
-// Vertex shader
-VS_Out VS_main(float3 Position : POSITION, float3 Normal : NORMAL, float2 Texcoord : TEXCOORD)
+// Shared vertex transform, used by both the single draw and the instanced vertex shaders
+VS_Out TransformVertex(float3 Position, float3 Normal, float2 Texcoord, float4x4 world)
 {
 	VS_Out output = (VS_Out)0;
 	float4 Pos4 = float4(Position, 1.0f);
@@ -68,13 +68,13 @@ VS_Out VS_main(float3 Position : POSITION, float3 Normal : NORMAL, float2 Texcoo
 
 	// Transform normal to world space
 	float4 NormW = float4(Normal, 0.0f);
-	output.NormalW = mul(NormW, World);
+	output.NormalW = mul(NormW, world);
 	output.NormalW = normalize(output.NormalW.xyz);
 	output.normal = normalize(Normal);
-	output.PosW = mul(Pos4, World).xyz;
+	output.PosW = mul(Pos4, world).xyz;
 
 	// Transform position to world space
-	float4 viewPos = mul(Pos4, World);
+	float4 viewPos = mul(Pos4, world);
 	viewPos = mul(viewPos, View);
 	output.position = mul(viewPos, Projection);
 
@@ -84,6 +84,22 @@ VS_Out VS_main(float3 Position : POSITION, float3 Normal : NORMAL, float2 Texcoo
 	return output;
 }
 
+// Vertex shader
+VS_Out VS_main(float3 Position : POSITION, float3 Normal : NORMAL, float2 Texcoord : TEXCOORD)
+{
+	return TransformVertex(Position, Normal, Texcoord, World);
+}
+
+// Instanced vertex shader, the world matrix rows come from the per-instance buffer instead of the constant buffer
+VS_Out VS_Instanced(float3 Position : POSITION, float3 Normal : NORMAL, float2 Texcoord : TEXCOORD,
+	float4 InstanceWorld0 : INSTANCEWORLD0, float4 InstanceWorld1 : INSTANCEWORLD1,
+	float4 InstanceWorld2 : INSTANCEWORLD2, float4 InstanceWorld3 : INSTANCEWORLD3)
+{
+	float4x4 instanceWorld = float4x4(InstanceWorld0, InstanceWorld1, InstanceWorld2, InstanceWorld3);
+
+	return TransformVertex(Position, Normal, Texcoord, instanceWorld);
+}
+
 // Pixel shader
 float4 PS_main(VS_Out input, float3 PosW : POSITION0, float3 NormalW : NORMALW) : SV_TARGET
 {
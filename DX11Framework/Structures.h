@@ -57,6 +57,14 @@ struct MeshData
 	UINT VBStride;
 	UINT VBOffset;
 	UINT IndexCount;
+	XMFLOAT3 BoundsCenter;  // Local-space axis aligned bounding box, used for culling
+	XMFLOAT3 BoundsExtents;
+};
+
+// Struct to hold the per-instance data streamed alongside a mesh (kept untransposed, rows are rebuilt in the shader)
+struct InstanceData
+{
+	XMFLOAT4X4 World;
 };
 
 // Struct to hold simple vertex data
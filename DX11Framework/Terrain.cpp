@@ -2,19 +2,40 @@
 
 // Include{s}
 #include "Terrain.h"
+#include "Profiler.h"
+#include "CounterRegistry.h"
 
 #pragma region Constructor & Destructor
 
 // Build the terrain, from the heightmap
-Terrain::Terrain(ID3D11Device* device)
+Terrain::Terrain(RenderDevice* device)
 {
+	PROFILE_FUNCTION();
+
 	LoadHeightmap(513, 513, "Textures\\Heightmap_513x513.raw");
 	BuildHeightMaps(device);
 
-	std::thread buildVBThread(&Terrain::BuildFlatGridVB, this, device);
-	std::thread buildIBThread(&Terrain::BuildFlatGridIB, this, device);
-	buildVBThread.join();
-	buildIBThread.join();
+	// Centre the grid on the origin, the same place the single grid it replaced sat
+	const float originX = -0.5f * m_cellSpacing * (m_HeightmapWidth - 1);
+	const float originZ = -0.5f * m_cellSpacing * (m_HeightmapHeight - 1);
+	m_quadtree.Build(m_heightMapData.data(), m_HeightmapWidth, m_HeightmapHeight, m_cellSpacing, originX, originZ,
+		m_patchResolution);
+
+	m_heightField.Build(m_heightMapData.data(), m_HeightmapWidth, m_HeightmapHeight, m_cellSpacing, originX,
+		originZ);
+	m_heightField.BuildMips(m_heightQueryLevels);
+
+	BuildPatchIB(device);
+	BuildNodeBuffers(device);
+	BuildTileStreaming(device, "Textures\\Heightmap_513x513.raw", "Textures\\Heightmap_513x513.rlth");
+
+	// The patches are flat on the CPU, the vertex shader lifts them onto the heightmap
+	const float minHeight = m_quadtree.GetMinHeight();
+	const float maxHeight = m_quadtree.GetMaxHeight();
+	m_boundsCenter = XMFLOAT3(originX + 0.5f * m_quadtree.GetSizeX(), 0.5f * (minHeight + maxHeight),
+		originZ + 0.5f * m_quadtree.GetSizeZ());
+	m_boundsExtents = XMFLOAT3(0.5f * m_quadtree.GetSizeX(), 0.5f * (maxHeight - minHeight),
+		0.5f * m_quadtree.GetSizeZ());
 
 	XMStoreFloat4x4(&m_matrix, XMMatrixIdentity());
 }
@@ -22,19 +43,46 @@ Terrain::Terrain(ID3D11Device* device)
 // Destructor
 Terrain::~Terrain()
 {
-	if (m_TriFlatGridVB)
+	m_streamer.Stop();
+
+	if (m_tileAtlas)
+	{
+		m_tileAtlas->Release();
+		m_tileAtlas = nullptr;
+	}
+
+	if (m_tileAtlasSRV)
+	{
+		m_tileAtlasSRV->Release();
+		m_tileAtlasSRV = nullptr;
+	}
+
+	if (m_tileTableBuffer)
+	{
+		m_tileTableBuffer->Release();
+		m_tileTableBuffer = nullptr;
+	}
+
+	if (m_patchIB)
+	{
+		m_patchIB->Release();
+		m_patchIB = nullptr;
+	}
+
+	if (m_nodeInstanceBuffer)
 	{
-		m_TriFlatGridVB->Release();
-		m_TriFlatGridVB = nullptr;
+		m_nodeInstanceBuffer->Release();
+		m_nodeInstanceBuffer = nullptr;
 	}
 
-	if (m_TriFlatGridIB)
+	if (m_terrainConstantBuffer)
 	{
-		m_TriFlatGridIB->Release();
-		m_TriFlatGridIB = nullptr;
+		m_terrainConstantBuffer->Release();
+		m_terrainConstantBuffer = nullptr;
 	}
 
-	m_indices.clear();
+	m_selection.clear();
+	m_nodeInstances.clear();
 	m_heightMapData.clear();
 }
 
@@ -43,6 +91,10 @@ Terrain::~Terrain()
 #pragma region Heightmap Methods
 void Terrain::LoadHeightmap(int heightmapWidth, int heightmapHeight, std::string heightmapFileName)
 {
+	PROFILE_FUNCTION();
+
+	MemoryTagScope terrainTag(MemoryTag_Terrain);
+
 	m_HeightmapWidth = heightmapWidth;
 	m_HeightmapHeight = heightmapHeight;
 	m_HeightmapFileName = heightmapFileName;
@@ -60,16 +112,19 @@ void Terrain::LoadHeightmap(int heightmapWidth, int heightmapHeight, std::string
 
 	m_heightMapData.resize(m_HeightmapWidth * m_HeightmapHeight);
 
-	float heightScale = 10.0f;
 	for (unsigned int i = 0; i < m_HeightmapHeight * m_HeightmapWidth; i++)
 	{
 		// Normalise the heightmap data and add it to the vector
-		m_heightMapData[i] = (in[i] / 255.0f) * heightScale;
+		m_heightMapData[i] = (in[i] / 255.0f) * m_heightScale;
 	}
 }
 
-void Terrain::BuildHeightMaps(ID3D11Device* device)
+void Terrain::BuildHeightMaps(RenderDevice* device)
 {
+	PROFILE_FUNCTION();
+
+	MemoryTagScope terrainTag(MemoryTag_Terrain);
+
 	D3D11_TEXTURE2D_DESC texDesc;
 	texDesc.Width = m_HeightmapWidth;
 	texDesc.Height = m_HeightmapHeight;
@@ -88,91 +143,436 @@ void Terrain::BuildHeightMaps(ID3D11Device* device)
 	data.SysMemPitch = m_HeightmapWidth * sizeof(float);
 	data.SysMemSlicePitch = 0;
 
-	ID3D11Texture2D* hmapTex = nullptr;
-	device->CreateTexture2D(&texDesc, &data, &hmapTex);
+	// Create the texture and the shader resource view covering its one mip
+	device->CreateTexture(&texDesc, &data, &m_HeightMapSRV);
+}
+#pragma endregion
+
+#pragma region Patch Methods
+void Terrain::BuildPatchIB(RenderDevice* device)
+{
+	PROFILE_FUNCTION();
+
+	MemoryTagScope terrainTag(MemoryTag_Terrain);
+
+	// Each index is the vertex id the shader turns back into a grid position, so there is no vertex buffer
+	std::vector<unsigned short> indices;
+	TerrainQuadtree::BuildPatchIndices(m_patchResolution, indices, m_partStartIndex, m_partIndexCount);
+
+	// Create the index buffer
+	D3D11_BUFFER_DESC ibd = {};
+	ibd.Usage = D3D11_USAGE_IMMUTABLE;
+	ibd.ByteWidth = sizeof(unsigned short) * indices.size();
+	ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA iinitData = {};
+	iinitData.pSysMem = indices.data();
+	device->CreateBuffer(&ibd, &iinitData, &m_patchIB);
+}
+
+void Terrain::BuildNodeBuffers(RenderDevice* device)
+{
+	PROFILE_FUNCTION();
+
+	MemoryTagScope terrainTag(MemoryTag_Terrain);
+
+	// A selection never holds more entries than the quadtree has nodes, each quadrant drawn stands in for a child
+	// that is not
+	m_nodeInstanceCapacity = m_quadtree.GetTotalNodeCount();
+	m_selection.reserve(m_nodeInstanceCapacity);
+	m_nodeInstances.resize(m_nodeInstanceCapacity);
+
+	D3D11_BUFFER_DESC instanceBufferDesc = {};
+	instanceBufferDesc.ByteWidth = sizeof(XMFLOAT4) * m_nodeInstanceCapacity;
+	instanceBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	instanceBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	instanceBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	device->CreateBuffer(&instanceBufferDesc, nullptr, &m_nodeInstanceBuffer);
+
+	D3D11_BUFFER_DESC constantBufferDesc = {};
+	constantBufferDesc.ByteWidth = sizeof(TerrainConstantBuffer);
+	constantBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+	constantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	constantBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	device->CreateBuffer(&constantBufferDesc, nullptr, &m_terrainConstantBuffer);
+
+	m_terrainCBData.GridInfo = XMFLOAT4(static_cast<float>(m_patchResolution), 1.0f / m_HeightmapWidth,
+		1.0f / m_HeightmapHeight, m_cellSpacing);
+	m_terrainCBData.Origin = XMFLOAT4(m_quadtree.GetOriginX(), m_quadtree.GetOriginZ(), 0.0f, 0.0f);
+}
+
+void Terrain::BuildTileStreaming(RenderDevice* device, const std::string& rawFileName,
+	const std::string& tiledFileName)
+{
+	PROFILE_FUNCTION();
+
+	MemoryTagScope terrainTag(MemoryTag_Terrain);
+
+	m_tilesResidentCounter = CounterRegistry::GetInstance()->Register("Terrain Tiles Resident", CounterKind_Gauge);
+
+	// The tiled copy is made from the raw file the first time and kept next to it
+	if (!m_streamer.Start(tiledFileName, m_tileSlotCount))
+	{
+		if (!TiledHeightmap::ConvertRaw(rawFileName, m_HeightmapWidth, m_HeightmapHeight, 8, m_tileSize,
+			tiledFileName) || !m_streamer.Start(tiledFileName, m_tileSlotCount))
+		{
+			return;
+		}
+	}
+
+	// The tiles have to match the heightmap the quadtree was built from, and fit in the tile table
+	const TiledHeightmap& heightmap = m_streamer.GetHeightmap();
+	if (heightmap.GetWidth() != static_cast<uint32_t>(m_HeightmapWidth) ||
+		heightmap.GetHeight() != static_cast<uint32_t>(m_HeightmapHeight) ||
+		heightmap.GetTilesX() * heightmap.GetTilesZ() > MaxHeightmapTiles)
+	{
+		m_streamer.Stop();
+		return;
+	}
+
+	m_tileSize = heightmap.GetTileSize();
+	const UINT tileSide = m_tileSize + 1;
+	const UINT slotRows = (m_tileSlotCount + m_tileSlotsPerRow - 1) / m_tileSlotsPerRow;
+
+	// The atlas starts empty, tiles are copied into their slots as they page in
+	D3D11_TEXTURE2D_DESC atlasDesc = {};
+	atlasDesc.Width = m_tileSlotsPerRow * tileSide;
+	atlasDesc.Height = slotRows * tileSide;
+	atlasDesc.MipLevels = 1;
+	atlasDesc.ArraySize = 1;
+	atlasDesc.Format = DXGI_FORMAT_R16_UNORM;
+	atlasDesc.SampleDesc.Count = 1;
+	atlasDesc.Usage = D3D11_USAGE_DEFAULT;
+	atlasDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	if (FAILED(device->CreateTexture(&atlasDesc, nullptr, &m_tileAtlasSRV)))
+	{
+		m_streamer.Stop();
+		return;
+	}
+
+	// Tiles are copied into the texture behind the view
+	m_tileAtlasSRV->GetResource(&m_tileAtlas);
+
+	D3D11_BUFFER_DESC tileTableDesc = {};
+	tileTableDesc.ByteWidth = sizeof(TerrainTileTableBuffer);
+	tileTableDesc.Usage = D3D11_USAGE_DYNAMIC;
+	tileTableDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	tileTableDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 
-	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
-	srvDesc.Format = texDesc.Format;
-	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Texture2D.MostDetailedMip = 0;
-	srvDesc.Texture2D.MipLevels = 1;
+	if (m_tileAtlas == nullptr || FAILED(device->CreateBuffer(&tileTableDesc, nullptr, &m_tileTableBuffer)))
+	{
+		m_streamer.Stop();
+		return;
+	}
 
-	// Create the shader resource view
-	device->CreateShaderResourceView(hmapTex, &srvDesc, &m_HeightMapSRV);
+	m_terrainCBData.TileInfo = XMFLOAT4(static_cast<float>(m_tileSize), static_cast<float>(heightmap.GetTilesX()),
+		static_cast<float>(heightmap.GetTilesZ()), static_cast<float>(m_tileSlotsPerRow));
+	m_terrainCBData.AtlasInfo = XMFLOAT4(1.0f / atlasDesc.Width, 1.0f / atlasDesc.Height, m_heightScale, 0.0f);
 
-	hmapTex->Release();
+	m_tileStreaming = true;
+	m_tileTableDirty = true;
 }
 #pragma endregion
 
-#pragma region Grid Methods
-void Terrain::BuildFlatGridVB(ID3D11Device* device)
+#pragma region Streaming Methods
+void Terrain::StreamTiles(RenderContext* immediateContext, const XMFLOAT3& cameraPosition)
 {
-	// Create the vertices for the grid
-	std::vector<SimpleVertex> Vertices(m_NumPatchVertRows * m_NumPatchVertCols);
+	PROFILE_FUNCTION();
+
+	if (!m_tileStreaming)
+	{
+		return;
+	}
 
-	float halfWidth = 0.5f * m_HeightmapWidth;
-	float halfDepth = 0.5f * m_HeightmapHeight;
+	// Tiles are wanted by their distance in heightmap samples from the camera in local space
+	XMFLOAT3 localCamera;
+	XMStoreFloat3(&localCamera, XMVector3TransformCoord(XMLoadFloat3(&cameraPosition),
+		XMMatrixInverse(nullptr, XMLoadFloat4x4(&m_matrix))));
 
-	float patchWidth = m_HeightmapWidth / (m_NumPatchVertCols - 1);
-	float patchDepth = m_HeightmapHeight / (m_NumPatchVertRows - 1);
+	m_streamer.Update((localCamera.x - m_quadtree.GetOriginX()) / m_cellSpacing,
+		(localCamera.z - m_quadtree.GetOriginZ()) / m_cellSpacing, m_tileStreamRadius * m_tileSize);
+	m_streamer.CollectLoaded(m_loadedTiles);
 
-	float du = 1.0f / (m_NumPatchVertCols - 1);
-	float dv = 1.0f / (m_NumPatchVertRows - 1);
+	// Copy each finished tile into its slot of the atlas
+	const UINT tileSide = m_tileSize + 1;
+	for (const HeightmapLoadedTile& tile : m_loadedTiles)
+	{
+		const UINT left = (tile.Request.Slot % m_tileSlotsPerRow) * tileSide;
+		const UINT top = (tile.Request.Slot / m_tileSlotsPerRow) * tileSide;
+		const D3D11_BOX box = { left, top, 0, left + tileSide, top + tileSide, 1 };
+
+		immediateContext->UpdateSubresource(m_tileAtlas, 0, &box, tile.Samples.data(),
+			tileSide * sizeof(uint16_t), 0);
+	}
+
+	const HeightmapTileCache& cache = m_streamer.GetCache();
+	CounterRegistry::GetInstance()->Set(m_tilesResidentCounter, cache.GetResidentCount());
+
+	// An evicted tile's slot keeps its samples until the next tile lands in it, so the table only has to change
+	// when tiles have been uploaded
+	if (!m_loadedTiles.empty())
+	{
+		m_tileTableDirty = true;
+	}
+
+	if (!m_tileTableDirty)
+	{
+		return;
+	}
 
-	for (unsigned int i = 0; i < m_NumPatchVertRows; i++)
+	const TiledHeightmap& heightmap = m_streamer.GetHeightmap();
+	for (uint32_t tileZ = 0; tileZ < heightmap.GetTilesZ(); tileZ++)
 	{
-		float z = i * patchDepth - halfDepth;
-		for (unsigned int j = 0; j < m_NumPatchVertCols; j++)
+		for (uint32_t tileX = 0; tileX < heightmap.GetTilesX(); tileX++)
 		{
-			float x = -halfWidth + j * patchWidth;
+			const uint32_t slot = cache.GetSlot(tileX, tileZ);
+			m_tileTableData.TileSlots[tileZ * heightmap.GetTilesX() + tileX] =
+				slot == HeightmapTileCache::NoSlot ? 0 : slot + 1;
+		}
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
+	if (FAILED(immediateContext->Map(m_tileTableBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource)))
+	{
+		return;
+	}
+	memcpy(mappedSubresource.pData, &m_tileTableData, sizeof(m_tileTableData));
+	immediateContext->Unmap(m_tileTableBuffer, 0);
+
+	m_tileTableDirty = false;
+	CounterRegistry::GetInstance()->Add(Counter_ConstantBufferBytes, sizeof(m_tileTableData));
+}
+#pragma endregion
+
+#pragma region Render Methods
+void Terrain::Select(const XMFLOAT3& cameraPosition, const XMFLOAT4* frustumPlanes, float projectionScale)
+{
+	PROFILE_FUNCTION();
 
-			Vertices[i * m_NumPatchVertCols + j].Pos = XMFLOAT3(x, 0.0f, z);
-			Vertices[i * m_NumPatchVertCols + j].TexC.x = j * du;
-			Vertices[i * m_NumPatchVertCols + j].TexC.y = i * dv;
+	// Selection happens in the terrain's local space, points go back through the inverse and planes through the
+	// transpose of the matrix
+	XMMATRIX world = XMLoadFloat4x4(&m_matrix);
+	XMMATRIX inverseWorld = XMMatrixInverse(nullptr, world);
+	XMMATRIX planeTransform = XMMatrixTranspose(world);
+
+	XMFLOAT3 localCamera;
+	XMStoreFloat3(&localCamera, XMVector3TransformCoord(XMLoadFloat3(&cameraPosition), inverseWorld));
+
+	float localPlanes[6][4];
+	for (int plane = 0; plane < 6; plane++)
+	{
+		XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(localPlanes[plane]),
+			XMPlaneTransform(XMLoadFloat4(&frustumPlanes[plane]), planeTransform));
+	}
+
+	// The ranges follow the view, a monitor wall tile is smaller than the full screen and can use coarser levels
+	m_quadtree.ComputeLodRanges(projectionScale, m_pixelError);
+
+	const float camera[3] = { localCamera.x, localCamera.y, localCamera.z };
+	m_quadtree.Select(camera, localPlanes, m_selection);
+	m_selectionStats = m_quadtree.Summarise(m_selection);
+
+	// Group the nodes by the part drawn, so each part is one instanced draw
+	UINT partCounts[TerrainNodePart_Count] = {};
+	for (const TerrainSelectedNode& node : m_selection)
+	{
+		partCounts[node.Part]++;
+	}
+
+	UINT nextInstance = 0;
+	for (UINT part : { UINT(TerrainNodePart_Whole), UINT(TerrainNodePart_Quadrant0), UINT(TerrainNodePart_Quadrant1),
+		UINT(TerrainNodePart_Quadrant2), UINT(TerrainNodePart_Quadrant3) })
+	{
+		m_partStartInstance[part] = nextInstance;
+		m_partInstanceCount[part] = 0;
+		nextInstance += partCounts[part];
+	}
+
+	for (const TerrainSelectedNode& node : m_selection)
+	{
+		UINT instance = m_partStartInstance[node.Part] + m_partInstanceCount[node.Part]++;
+		m_nodeInstances[instance] = XMFLOAT4(node.X, node.Z, node.Size, static_cast<float>(node.Level));
+	}
+
+	// Fill in the morph ranges for the vertex shader
+	const UINT lodLevels = m_quadtree.GetLodLevels();
+	for (UINT level = 0; level < lodLevels; level++)
+	{
+		float morphStart = 0.0f;
+		float morphEnd = 0.0f;
+		m_quadtree.GetMorphRange(level, morphStart, morphEnd);
+
+		// Nothing is coarser than the last level, so it never morphs
+		const bool lastLevel = level + 1 == lodLevels;
+		m_terrainCBData.MorphConstants[level] = XMFLOAT4(morphStart, lastLevel ? 0.0f : 1.0f / (morphEnd - morphStart),
+			0.0f, 0.0f);
+	}
+
+	m_terrainCBData.CameraPosition = XMFLOAT4(localCamera.x, localCamera.y, localCamera.z, 1.0f);
+}
+
+void Terrain::Draw(RenderContext* immediateContext)
+{
+	PROFILE_FUNCTION();
+
+	if (m_selection.empty() || m_nodeInstanceBuffer == nullptr || m_terrainConstantBuffer == nullptr)
+	{
+		return;
+	}
+
+	// Upload the nodes and the morph ranges
+	D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
+	if (FAILED(immediateContext->Map(m_nodeInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource)))
+	{
+		return;
+	}
+	memcpy(mappedSubresource.pData, m_nodeInstances.data(), sizeof(XMFLOAT4) * m_selection.size());
+	immediateContext->Unmap(m_nodeInstanceBuffer, 0);
+
+	if (FAILED(immediateContext->Map(m_terrainConstantBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource)))
+	{
+		return;
+	}
+	memcpy(mappedSubresource.pData, &m_terrainCBData, sizeof(m_terrainCBData));
+	immediateContext->Unmap(m_terrainConstantBuffer, 0);
+
+	immediateContext->VSSetConstantBuffers(1, 1, &m_terrainConstantBuffer);
+
+	// Without streaming the table stays unbound, reads as empty and every height comes from the resident heightmap
+	if (m_tileStreaming)
+	{
+		immediateContext->VSSetConstantBuffers(2, 1, &m_tileTableBuffer);
+		immediateContext->VSSetShaderResources(1, 1, &m_tileAtlasSRV);
+	}
+
+	// Slot 0 is left empty as the patch comes from the vertex ids, slot 1 holds the nodes
+	ID3D11Buffer* vertexBuffers[2] = { nullptr, m_nodeInstanceBuffer };
+	UINT strides[2] = { 0, sizeof(XMFLOAT4) };
+	UINT offsets[2] = { 0, 0 };
+
+	immediateContext->IASetVertexBuffers(0, 2, vertexBuffers, strides, offsets);
+	immediateContext->IASetIndexBuffer(m_patchIB, DXGI_FORMAT_R16_UINT, 0);
+
+	UINT drawCalls = 0;
+	for (UINT part = 0; part < TerrainNodePart_Count; part++)
+	{
+		if (m_partInstanceCount[part] == 0)
+		{
+			continue;
 		}
+
+		immediateContext->DrawIndexedInstanced(m_partIndexCount[part], m_partInstanceCount[part],
+			m_partStartIndex[part], 0, m_partStartInstance[part]);
+		drawCalls++;
 	}
 
-	// Create the vertex buffer
-	D3D11_BUFFER_DESC vbd = {};
-	vbd.Usage = D3D11_USAGE_IMMUTABLE;
-	vbd.ByteWidth = sizeof(SimpleVertex) * Vertices.size();
-	vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	CounterRegistry* counters = CounterRegistry::GetInstance();
+	counters->Add(Counter_DrawCalls, drawCalls);
+	counters->Add(Counter_ConstantBufferBytes, sizeof(m_terrainCBData));
+	counters->Add(Counter_TrianglesSubmitted, static_cast<double>(m_selectionStats.Triangles));
+}
+#pragma endregion
+
+#pragma region Query Methods
+float Terrain::GetHeight(float x, float z, UINT level) const
+{
+	XMMATRIX world = XMLoadFloat4x4(&m_matrix);
+
+	XMFLOAT3 localPosition;
+	XMStoreFloat3(&localPosition, XMVector3TransformCoord(XMVectorSet(x, 0.0f, z, 1.0f),
+		XMMatrixInverse(nullptr, world)));
+
+	// Lift the local point onto the ground and take it back to world space
+	const float height = m_heightField.GetHeight(localPosition.x, localPosition.z, level);
+
+	return XMVectorGetY(XMVector3TransformCoord(XMVectorSet(localPosition.x, height, localPosition.z, 1.0f), world));
+}
+
+XMFLOAT3 Terrain::GetNormal(float x, float z, UINT level) const
+{
+	XMMATRIX inverseWorld = XMMatrixInverse(nullptr, XMLoadFloat4x4(&m_matrix));
+
+	XMFLOAT3 localPosition;
+	XMStoreFloat3(&localPosition, XMVector3TransformCoord(XMVectorSet(x, 0.0f, z, 1.0f), inverseWorld));
+
+	XMFLOAT3 normal;
+	m_heightField.GetNormal(localPosition.x, localPosition.z, &normal.x, level);
 
-	D3D11_SUBRESOURCE_DATA vinitData = {};
-	vinitData.pSysMem = Vertices.data();
-	device->CreateBuffer(&vbd, &vinitData, &m_TriFlatGridVB);
+	// Normals go through the inverse transpose, so they stay at right angles to the ground under uneven scales
+	XMStoreFloat3(&normal, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&normal),
+		XMMatrixTranspose(inverseWorld))));
+	return normal;
 }
 
-void Terrain::BuildFlatGridIB(ID3D11Device* device)
+void Terrain::GetHeights(const XMFLOAT3* positions, UINT count, float* heights, UINT level) const
 {
-	// Create the indices for the grid
-	for (unsigned int i = 0; i < m_NumPatchVertRows - 1; i++)
+	PROFILE_FUNCTION();
+
+	XMMATRIX world = XMLoadFloat4x4(&m_matrix);
+	XMMATRIX inverseWorld = XMMatrixInverse(nullptr, world);
+
+	// Work through the points a block at a time, so the height field sees them four at a time without the query
+	// allocating
+	const UINT blockSize = 256;
+	float localX[blockSize];
+	float localZ[blockSize];
+
+	for (UINT first = 0; first < count; first += blockSize)
 	{
-		for (unsigned int j = 0; j < m_NumPatchVertCols - 1; j++)
+		const UINT blockCount = (std::min)(blockSize, count - first);
+
+		for (UINT i = 0; i < blockCount; i++)
 		{
-			int topleft = i * m_NumPatchVertCols + j;
-			int topright = i * m_NumPatchVertCols + (j + 1);
-			int bottomleft = (i + 1) * m_NumPatchVertCols + j;
-			int bottomright = (i + 1) * m_NumPatchVertCols + (j + 1);
-
-			m_indices.push_back(topright);
-			m_indices.push_back(bottomleft);
-			m_indices.push_back(bottomright);
-
-			m_indices.push_back(topleft);
-			m_indices.push_back(bottomleft);
-			m_indices.push_back(topright);
+			XMFLOAT3 localPosition;
+			XMStoreFloat3(&localPosition, XMVector3TransformCoord(XMVectorSet(positions[first + i].x, 0.0f,
+				positions[first + i].z, 1.0f), inverseWorld));
+			localX[i] = localPosition.x;
+			localZ[i] = localPosition.z;
+		}
+
+		m_heightField.GetHeights(localX, localZ, blockCount, heights + first, level);
+
+		for (UINT i = 0; i < blockCount; i++)
+		{
+			heights[first + i] = XMVectorGetY(XMVector3TransformCoord(XMVectorSet(localX[i], heights[first + i],
+				localZ[i], 1.0f), world));
 		}
 	}
+}
 
-	// Create the index buffer
-	D3D11_BUFFER_DESC ibd = {};
-	ibd.Usage = D3D11_USAGE_IMMUTABLE;
-	ibd.ByteWidth = sizeof(unsigned int) * m_indices.size();
-	ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+void Terrain::GetNormals(const XMFLOAT3* positions, UINT count, XMFLOAT3* normals, UINT level) const
+{
+	PROFILE_FUNCTION();
 
-	D3D11_SUBRESOURCE_DATA iinitData = {};
-	iinitData.pSysMem = &m_indices[0];
-	device->CreateBuffer(&ibd, &iinitData, &m_TriFlatGridIB);
+	XMMATRIX inverseWorld = XMMatrixInverse(nullptr, XMLoadFloat4x4(&m_matrix));
+	XMMATRIX normalMatrix = XMMatrixTranspose(inverseWorld);
+
+	const UINT blockSize = 256;
+	float localX[blockSize];
+	float localZ[blockSize];
+
+	for (UINT first = 0; first < count; first += blockSize)
+	{
+		const UINT blockCount = (std::min)(blockSize, count - first);
+
+		for (UINT i = 0; i < blockCount; i++)
+		{
+			XMFLOAT3 localPosition;
+			XMStoreFloat3(&localPosition, XMVector3TransformCoord(XMVectorSet(positions[first + i].x, 0.0f,
+				positions[first + i].z, 1.0f), inverseWorld));
+			localX[i] = localPosition.x;
+			localZ[i] = localPosition.z;
+		}
+
+		// XMFLOAT3 is three packed floats, the same x, y, z triples the height field writes
+		m_heightField.GetNormals(localX, localZ, blockCount, &normals[first].x, level);
+
+		for (UINT i = 0; i < blockCount; i++)
+		{
+			XMStoreFloat3(&normals[first + i],
+				XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&normals[first + i]), normalMatrix)));
+		}
+	}
 }
 #pragma endregion
\ No newline at end of file
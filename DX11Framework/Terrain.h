@@ -1,14 +1,59 @@
 #pragma once
 // Broken and Unfinished Terrain Class (Bonus Points for Trying?)
 // Include{s}
-#include "Structures.h"
+#include "RenderContext.h"
+#include "MemoryTracker.h"
+#include "TerrainQuadtree.h"
+#include "TerrainHeightField.h"
+#include "CounterRegistry.h"
+#include "HeightmapStreamer.h"
+
+// The most heightmap tiles the tile table in the vertex shader can address
+const UINT MaxHeightmapTiles = 4096;
+
+// Struct to hold the terrain's own constant buffer, bound to b1 next to the shared one
+struct TerrainConstantBuffer
+{
+	// x is where a level starts morphing and y is one over the length of the morph, y is 0 for the coarsest level
+	XMFLOAT4 MorphConstants[MaxTerrainLodLevels];
+
+	// The camera in the terrain's local space, w is unused
+	XMFLOAT4 CameraPosition;
+
+	// x is the patch resolution, y and z are one over the heightmap width and height, w is the cell spacing
+	XMFLOAT4 GridInfo;
+
+	// xy is the local position of the first heightmap sample, zw is unused
+	XMFLOAT4 Origin;
+
+	// x is the samples along the side of a tile, y and z are the tiles across and down, w is the slots in a row of
+	// the atlas
+	XMFLOAT4 TileInfo;
+
+	// x and y are one over the atlas width and height, z is the height scale, w is unused
+	XMFLOAT4 AtlasInfo;
+};
+
+// Struct to hold the atlas slot of every heightmap tile, bound to b2. Each entry is the slot plus one, 0 while the
+// tile is not resident, the shader reads them four to a uint4
+struct TerrainTileTableBuffer
+{
+	UINT TileSlots[MaxHeightmapTiles];
+};
+
+// Struct to hold what the terrain drew for the first view of one benchmark frame
+struct TerrainVisibilitySample
+{
+	XMFLOAT3 CameraPosition;
+	TerrainSelectionStats Stats;
+};
 
 class Terrain
 {
 public:
 #pragma region Constructor & Destructor
 	// Constructor calls other methods to build the terrain
-	Terrain(ID3D11Device* device);
+	Terrain(RenderDevice* device);
 
 	~Terrain();
 #pragma endregion
@@ -18,31 +63,138 @@ public:
 	void LoadHeightmap(int heightmapWidth, int heightmapHeight, std::string heightmapFileName);
 
 	// Builds the heightmaps
-	void BuildHeightMaps(ID3D11Device* device);
+	void BuildHeightMaps(RenderDevice* device);
+
+	// Builds the index buffer of the patch every node is drawn with, the whole patch first and then each quadrant on
+	// its own. There is no vertex buffer, the vertex shader works the grid position out from the index
+	void BuildPatchIB(RenderDevice* device);
+
+	// Builds the per node buffers and the terrain constant buffer
+	void BuildNodeBuffers(RenderDevice* device);
+
+	// Opens the tiled copy of the heightmap, converting the raw file the first time, and builds the tile atlas and
+	// tile table. The terrain falls back to the resident heightmap if there are too many tiles to address
+	void BuildTileStreaming(RenderDevice* device, const std::string& rawFileName, const std::string& tiledFileName);
+#pragma endregion
+
+#pragma region Streaming Methods
+	// Pages in the tiles around a world-space camera, uploads the ones that have finished into the atlas and
+	// refreshes the tile table. Called once a frame before any view is drawn
+	void StreamTiles(RenderContext* immediateContext, const XMFLOAT3& cameraPosition);
+#pragma endregion
 
-	// Builds the vertex buffer for a flat grid
-	void BuildFlatGridVB(ID3D11Device* device);
+#pragma region Render Methods
+	// Picks the nodes to draw for a camera. The position and the six frustum planes are in world space, and
+	// projectionScale is half the viewport height times the projection's y scale
+	void Select(const XMFLOAT3& cameraPosition, const XMFLOAT4* frustumPlanes, float projectionScale);
 
-	// Builds the index buffer for a flat grid
-	void BuildFlatGridIB(ID3D11Device* device);
+	// Draws the selected nodes with one instanced draw for whole nodes and one for each quadrant. The heightmap
+	// shaders, texture and sampler have to be bound already, the tile atlas and table are bound here
+	void Draw(RenderContext* immediateContext);
+#pragma endregion
+
+#pragma region Query Methods
+	// Gets the height of the ground under a world-space point, as the heightmap shader places it. Level 0 is full
+	// detail and each level up halves it. The terrain can be moved, scaled and turned about y but not tilted
+	// Returns float - The world-space height
+	float GetHeight(float x, float z, UINT level = 0) const;
+
+	// Gets the unit normal of the ground under a world-space point
+	// Returns XMFLOAT3 - The world-space normal
+	XMFLOAT3 GetNormal(float x, float z, UINT level = 0) const;
+
+	// Gets the ground heights under count world-space points, their y is ignored
+	void GetHeights(const XMFLOAT3* positions, UINT count, float* heights, UINT level = 0) const;
+
+	// Gets the unit normals of the ground under count world-space points, their y is ignored
+	void GetNormals(const XMFLOAT3* positions, UINT count, XMFLOAT3* normals, UINT level = 0) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the centre of the local-space bounding box of the grid, including the heightmap displacement
+	// Returns XMFLOAT3 - The bounding box centre
+	const XMFLOAT3& GetBoundsCenter() const { return m_boundsCenter; }
+
+	// Gets the half size of the local-space bounding box of the grid
+	// Returns XMFLOAT3 - The bounding box extents
+	const XMFLOAT3& GetBoundsExtents() const { return m_boundsExtents; }
+
+	// Gets the node quadtree
+	// Returns TerrainQuadtree - The quadtree
+	const TerrainQuadtree& GetQuadtree() const { return m_quadtree; }
+
+	// Gets the CPU copy of the heights the queries sample
+	// Returns TerrainHeightField - The height field
+	const TerrainHeightField& GetHeightField() const { return m_heightField; }
+
+	// Gets the counts of the last selection
+	// Returns TerrainSelectionStats - The node and triangle counts
+	const TerrainSelectionStats& GetSelectionStats() const { return m_selectionStats; }
+
+	// Gets the streamer paging the heightmap tiles in
+	// Returns HeightmapStreamer - The streamer
+	const HeightmapStreamer& GetStreamer() const { return m_streamer; }
 #pragma endregion
 
 #pragma region Public Member Variables
-	ID3D11Buffer* m_TriFlatGridVB;
-	ID3D11Buffer* m_TriFlatGridIB;
-	std::vector<unsigned int> m_indices;
+	ID3D11Buffer* m_patchIB = nullptr;
 	XMFLOAT4X4 m_matrix;
 	ID3D11ShaderResourceView* m_HeightMapSRV;
 #pragma endregion
 
 private:
 #pragma region Private Member Variables
-	int m_cellSpacing = 1;
-	int m_NumPatchVertCols = 400;
-	int m_NumPatchVertRows = 400;
+	float m_cellSpacing = 1.0f;
 	std::vector<float> m_heightMapData;
 	int m_HeightmapWidth;
 	int m_HeightmapHeight;
 	std::string m_HeightmapFileName;
+	float m_heightScale = 10.0f;
+	XMFLOAT3 m_boundsCenter = { 0, 0, 0 };
+	XMFLOAT3 m_boundsExtents = { 0, 0, 0 };
+
+	// Cells along the side of a patch, and how many pixels a level's height error may cover before the next level
+	// in is used
+	UINT m_patchResolution = 32;
+	float m_pixelError = 2.0f;
+
+	TerrainQuadtree m_quadtree;
+
+	// The heights for CPU queries, and how many levels of coarser heights are kept for rough ones
+	TerrainHeightField m_heightField;
+	UINT m_heightQueryLevels = 5;
+
+	// Where each part's indices start in the patch index buffer, and how many there are
+	UINT m_partStartIndex[TerrainNodePart_Count] = {};
+	UINT m_partIndexCount[TerrainNodePart_Count] = {};
+
+	// The last selection, and each node as (x, z, size, level) grouped by the part drawn
+	std::vector<TerrainSelectedNode> m_selection;
+	std::vector<XMFLOAT4> m_nodeInstances;
+	UINT m_partStartInstance[TerrainNodePart_Count] = {};
+	UINT m_partInstanceCount[TerrainNodePart_Count] = {};
+	TerrainSelectionStats m_selectionStats = {};
+
+	ID3D11Buffer* m_nodeInstanceBuffer = nullptr;
+	UINT m_nodeInstanceCapacity = 0;
+	ID3D11Buffer* m_terrainConstantBuffer = nullptr;
+	TerrainConstantBuffer m_terrainCBData = {};
+
+	// Tiles are paged into slots of an atlas, the table says which slot each tile is in. The radius covers the
+	// tiles a slot count of 16 can always hold around the camera
+	HeightmapStreamer m_streamer;
+	UINT m_tileSize = 128;
+	UINT m_tileSlotCount = 16;
+	UINT m_tileSlotsPerRow = 4;
+	float m_tileStreamRadius = 1.5f;
+	bool m_tileStreaming = false;
+	bool m_tileTableDirty = false;
+	std::vector<HeightmapLoadedTile> m_loadedTiles;
+	TerrainTileTableBuffer m_tileTableData = {};
+
+	ID3D11ShaderResourceView* m_tileAtlasSRV = nullptr;
+	ID3D11Resource* m_tileAtlas = nullptr;
+	ID3D11Buffer* m_tileTableBuffer = nullptr;
+	CounterID m_tilesResidentCounter = 0;
 #pragma endregion
 };
@@ -0,0 +1,357 @@
+// Include{s}
+#include "TerrainHeightField.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#pragma region Filter Helpers
+namespace
+{
+	// Gets a sample of a level, with the coordinates clamped to it
+	float GetClampedSample(const float* samples, uint32_t width, uint32_t height, int64_t x, int64_t z)
+	{
+		x = (std::max)(int64_t(0), (std::min)(x, int64_t(width) - 1));
+		z = (std::max)(int64_t(0), (std::min)(z, int64_t(height) - 1));
+
+		return samples[z * width + x];
+	}
+
+	// Turns the slopes along x and z into a unit normal
+	void NormalFromSlopes(float slopeX, float slopeZ, float normal[3])
+	{
+		const float inverseLength = 1.0f / sqrtf(slopeX * slopeX + 1.0f + slopeZ * slopeZ);
+
+		normal[0] = -slopeX * inverseLength;
+		normal[1] = inverseLength;
+		normal[2] = -slopeZ * inverseLength;
+	}
+}
+#pragma endregion
+
+#pragma region Build Methods
+void TerrainHeightField::Build(const float* heights, uint32_t width, uint32_t height, float cellSpacing,
+	float originX, float originZ)
+{
+	m_originX = originX;
+	m_originZ = originZ;
+	m_cellSpacing = cellSpacing;
+
+	// A cell needs 2 samples each way
+	const bool valid = heights != nullptr && width >= 2 && height >= 2 && cellSpacing > 0.0f;
+
+	m_samples[0] = valid ? heights : nullptr;
+	m_widths[0] = valid ? width : 0;
+	m_heights[0] = valid ? height : 0;
+	m_levelCount = valid ? 1 : 0;
+
+	for (uint32_t level = 1; level < MaxHeightFieldLevels; level++)
+	{
+		m_samples[level] = nullptr;
+		m_mipSamples[level].clear();
+	}
+}
+
+void TerrainHeightField::BuildMips(uint32_t levelCount)
+{
+	if (!IsBuilt())
+	{
+		return;
+	}
+
+	static const float TentWeights[3] = { 0.25f, 0.5f, 0.25f };
+
+	levelCount = (std::min)(levelCount, MaxHeightFieldLevels);
+	m_levelCount = 1;
+
+	for (uint32_t level = 1; level < levelCount; level++)
+	{
+		const float* below = m_samples[level - 1];
+		const uint32_t belowWidth = m_widths[level - 1];
+		const uint32_t belowHeight = m_heights[level - 1];
+
+		if (belowWidth < 3 || belowHeight < 3)
+		{
+			break;
+		}
+
+		const uint32_t width = (belowWidth + 1) / 2;
+		const uint32_t height = (belowHeight + 1) / 2;
+		std::vector<float>& samples = m_mipSamples[level];
+		samples.resize(static_cast<size_t>(width) * height);
+
+		for (uint32_t z = 0; z < height; z++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				float sum = 0.0f;
+
+				for (int64_t offsetZ = -1; offsetZ <= 1; offsetZ++)
+				{
+					for (int64_t offsetX = -1; offsetX <= 1; offsetX++)
+					{
+						sum += TentWeights[offsetZ + 1] * TentWeights[offsetX + 1] * GetClampedSample(below,
+							belowWidth, belowHeight, int64_t(x) * 2 + offsetX, int64_t(z) * 2 + offsetZ);
+					}
+				}
+
+				samples[static_cast<size_t>(z) * width + x] = sum;
+			}
+		}
+
+		m_samples[level] = samples.data();
+		m_widths[level] = width;
+		m_heights[level] = height;
+		m_levelCount = level + 1;
+	}
+}
+#pragma endregion
+
+#pragma region Query Methods
+float TerrainHeightField::GetHeight(float x, float z, uint32_t level) const
+{
+	if (!IsBuilt())
+	{
+		return 0.0f;
+	}
+
+	level = (std::min)(level, m_levelCount - 1);
+
+	float fractionX = 0.0f;
+	float fractionZ = 0.0f;
+	const float* cell = m_samples[level] + FindCell(level, x, z, fractionX, fractionZ);
+	const uint32_t width = m_widths[level];
+
+	// The same blend the sampler does between the four samples around the position
+	const float top = cell[0] + (cell[1] - cell[0]) * fractionX;
+	const float bottom = cell[width] + (cell[width + 1] - cell[width]) * fractionX;
+
+	return top + (bottom - top) * fractionZ;
+}
+
+void TerrainHeightField::GetNormal(float x, float z, float normal[3], uint32_t level) const
+{
+	if (!IsBuilt())
+	{
+		normal[0] = 0.0f;
+		normal[1] = 1.0f;
+		normal[2] = 0.0f;
+		return;
+	}
+
+	level = (std::min)(level, m_levelCount - 1);
+
+	float fractionX = 0.0f;
+	float fractionZ = 0.0f;
+	const float* cell = m_samples[level] + FindCell(level, x, z, fractionX, fractionZ);
+	const uint32_t width = m_widths[level];
+	const float cellsPerUnit = 1.0f / (m_cellSpacing * float(1u << level));
+
+	// The slopes of the bilinear surface, each blended across the other axis
+	const float slopeTop = cell[1] - cell[0];
+	const float slopeBottom = cell[width + 1] - cell[width];
+	const float slopeLeft = cell[width] - cell[0];
+	const float slopeRight = cell[width + 1] - cell[1];
+
+	NormalFromSlopes((slopeTop + (slopeBottom - slopeTop) * fractionZ) * cellsPerUnit,
+		(slopeLeft + (slopeRight - slopeLeft) * fractionX) * cellsPerUnit, normal);
+}
+
+void TerrainHeightField::GetHeights(const float* x, const float* z, uint32_t count, float* heights,
+	uint32_t level) const
+{
+	if (!IsBuilt())
+	{
+		std::fill(heights, heights + count, 0.0f);
+		return;
+	}
+
+	level = (std::min)(level, m_levelCount - 1);
+
+	uint32_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+	const float* samples = m_samples[level];
+	const uint32_t width = m_widths[level];
+	const __m128 cellsPerUnit = _mm_set1_ps(1.0f / (m_cellSpacing * float(1u << level)));
+	const __m128 originX = _mm_set1_ps(m_originX);
+	const __m128 originZ = _mm_set1_ps(m_originZ);
+	const __m128 lastX = _mm_set1_ps(float(width - 1));
+	const __m128 lastZ = _mm_set1_ps(float(m_heights[level] - 1));
+	const __m128 lastCellX = _mm_set1_ps(float(width - 2));
+	const __m128 lastCellZ = _mm_set1_ps(float(m_heights[level] - 2));
+	const __m128 zero = _mm_setzero_ps();
+
+	// 4 positions per iteration, only fetching the samples is done a lane at a time
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 gridX = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(x + i), originX), cellsPerUnit),
+			zero), lastX);
+		const __m128 gridZ = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(z + i), originZ), cellsPerUnit),
+			zero), lastZ);
+
+		// The grid position is never negative, so truncating is the floor
+		const __m128i cellX = _mm_cvttps_epi32(_mm_min_ps(gridX, lastCellX));
+		const __m128i cellZ = _mm_cvttps_epi32(_mm_min_ps(gridZ, lastCellZ));
+		const __m128 fractionX = _mm_sub_ps(gridX, _mm_cvtepi32_ps(cellX));
+		const __m128 fractionZ = _mm_sub_ps(gridZ, _mm_cvtepi32_ps(cellZ));
+
+		alignas(16) int32_t cellsX[4];
+		alignas(16) int32_t cellsZ[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(cellsX), cellX);
+		_mm_store_si128(reinterpret_cast<__m128i*>(cellsZ), cellZ);
+
+		alignas(16) float corners[4][4];
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			const float* cell = samples + static_cast<size_t>(cellsZ[lane]) * width + cellsX[lane];
+			corners[0][lane] = cell[0];
+			corners[1][lane] = cell[1];
+			corners[2][lane] = cell[width];
+			corners[3][lane] = cell[width + 1];
+		}
+
+		const __m128 topLeft = _mm_load_ps(corners[0]);
+		const __m128 bottomLeft = _mm_load_ps(corners[2]);
+		const __m128 top = _mm_add_ps(topLeft, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(corners[1]), topLeft), fractionX));
+		const __m128 bottom = _mm_add_ps(bottomLeft,
+			_mm_mul_ps(_mm_sub_ps(_mm_load_ps(corners[3]), bottomLeft), fractionX));
+
+		_mm_storeu_ps(heights + i, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), fractionZ)));
+	}
+#endif
+
+	// The positions left over
+	for (; i < count; i++)
+	{
+		heights[i] = GetHeight(x[i], z[i], level);
+	}
+}
+
+void TerrainHeightField::GetNormals(const float* x, const float* z, uint32_t count, float* normals,
+	uint32_t level) const
+{
+	if (!IsBuilt())
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			GetNormal(x[i], z[i], normals + i * 3, level);
+		}
+		return;
+	}
+
+	level = (std::min)(level, m_levelCount - 1);
+
+	uint32_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+	const float* samples = m_samples[level];
+	const uint32_t width = m_widths[level];
+	const __m128 cellsPerUnit = _mm_set1_ps(1.0f / (m_cellSpacing * float(1u << level)));
+	const __m128 originX = _mm_set1_ps(m_originX);
+	const __m128 originZ = _mm_set1_ps(m_originZ);
+	const __m128 lastX = _mm_set1_ps(float(width - 1));
+	const __m128 lastZ = _mm_set1_ps(float(m_heights[level] - 1));
+	const __m128 lastCellX = _mm_set1_ps(float(width - 2));
+	const __m128 lastCellZ = _mm_set1_ps(float(m_heights[level] - 2));
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	// 4 positions per iteration, the same cell search as GetHeights
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 gridX = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(x + i), originX), cellsPerUnit),
+			zero), lastX);
+		const __m128 gridZ = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(z + i), originZ), cellsPerUnit),
+			zero), lastZ);
+
+		const __m128i cellX = _mm_cvttps_epi32(_mm_min_ps(gridX, lastCellX));
+		const __m128i cellZ = _mm_cvttps_epi32(_mm_min_ps(gridZ, lastCellZ));
+		const __m128 fractionX = _mm_sub_ps(gridX, _mm_cvtepi32_ps(cellX));
+		const __m128 fractionZ = _mm_sub_ps(gridZ, _mm_cvtepi32_ps(cellZ));
+
+		alignas(16) int32_t cellsX[4];
+		alignas(16) int32_t cellsZ[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(cellsX), cellX);
+		_mm_store_si128(reinterpret_cast<__m128i*>(cellsZ), cellZ);
+
+		alignas(16) float corners[4][4];
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			const float* cell = samples + static_cast<size_t>(cellsZ[lane]) * width + cellsX[lane];
+			corners[0][lane] = cell[0];
+			corners[1][lane] = cell[1];
+			corners[2][lane] = cell[width];
+			corners[3][lane] = cell[width + 1];
+		}
+
+		const __m128 topLeft = _mm_load_ps(corners[0]);
+		const __m128 topRight = _mm_load_ps(corners[1]);
+		const __m128 bottomLeft = _mm_load_ps(corners[2]);
+		const __m128 bottomRight = _mm_load_ps(corners[3]);
+
+		const __m128 slopeTop = _mm_sub_ps(topRight, topLeft);
+		const __m128 slopeBottom = _mm_sub_ps(bottomRight, bottomLeft);
+		const __m128 slopeLeft = _mm_sub_ps(bottomLeft, topLeft);
+		const __m128 slopeRight = _mm_sub_ps(bottomRight, topRight);
+
+		const __m128 slopeX = _mm_mul_ps(_mm_add_ps(slopeTop, _mm_mul_ps(_mm_sub_ps(slopeBottom, slopeTop), fractionZ)),
+			cellsPerUnit);
+		const __m128 slopeZ = _mm_mul_ps(_mm_add_ps(slopeLeft, _mm_mul_ps(_mm_sub_ps(slopeRight, slopeLeft), fractionX)),
+			cellsPerUnit);
+
+		const __m128 inverseLength = _mm_div_ps(one,
+			_mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(slopeX, slopeX), one), _mm_mul_ps(slopeZ, slopeZ))));
+
+		alignas(16) float normalX[4];
+		alignas(16) float normalY[4];
+		alignas(16) float normalZ[4];
+		_mm_store_ps(normalX, _mm_mul_ps(_mm_sub_ps(zero, slopeX), inverseLength));
+		_mm_store_ps(normalY, inverseLength);
+		_mm_store_ps(normalZ, _mm_mul_ps(_mm_sub_ps(zero, slopeZ), inverseLength));
+
+		// Back to x, y, z triples
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			normals[(i + lane) * 3 + 0] = normalX[lane];
+			normals[(i + lane) * 3 + 1] = normalY[lane];
+			normals[(i + lane) * 3 + 2] = normalZ[lane];
+		}
+	}
+#endif
+
+	// The positions left over
+	for (; i < count; i++)
+	{
+		GetNormal(x[i], z[i], normals + i * 3, level);
+	}
+}
+#pragma endregion
+
+#pragma region Private Methods
+uint32_t TerrainHeightField::FindCell(uint32_t level, float x, float z, float& fractionX, float& fractionZ) const
+{
+	const uint32_t width = m_widths[level];
+	const uint32_t height = m_heights[level];
+	const float cellsPerUnit = 1.0f / (m_cellSpacing * float(1u << level));
+
+	// Sample i of a level sits on sample i * 2^level of the level 0 grid
+	float gridX = (x - m_originX) * cellsPerUnit;
+	float gridZ = (z - m_originZ) * cellsPerUnit;
+
+	// NaN fails every comparison, so it has to be caught before the cast. It goes to the lowest edge, the same as
+	// the SIMD batches where max hands back its second operand
+	gridX = gridX >= 0.0f ? (std::min)(gridX, float(width - 1)) : 0.0f;
+	gridZ = gridZ >= 0.0f ? (std::min)(gridZ, float(height - 1)) : 0.0f;
+
+	// The last row and column of samples are only the far side of the cells before them
+	const uint32_t cellX = static_cast<uint32_t>((std::min)(gridX, float(width - 2)));
+	const uint32_t cellZ = static_cast<uint32_t>((std::min)(gridZ, float(height - 2)));
+
+	fractionX = gridX - float(cellX);
+	fractionZ = gridZ - float(cellZ);
+
+	return cellZ * width + cellX;
+}
+#pragma endregion
\ No newline at end of file
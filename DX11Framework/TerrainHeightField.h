@@ -0,0 +1,77 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, so queries can be run and checked against the shader without a device
+#include <cstdint>
+#include <vector>
+
+// Most levels a height field can have, level 0 being the samples themselves
+constexpr uint32_t MaxHeightFieldLevels = 8;
+
+// CPU side copy of how the heightmap shader samples the terrain, for cameras that follow the ground, placing objects
+// and collision. Heights are filtered bilinearly between the samples the same way the shader's sampler does with
+// texel centres on the samples, and normals are the slope of that same surface. Coarser levels halve the samples
+// each time, for queries that only need the rough shape of the ground
+class TerrainHeightField
+{
+public:
+#pragma region Build Methods
+	// Points the field at a row major grid of samples spaced cellSpacing apart, starting at (originX, originZ). The
+	// samples are not copied, so they have to outlive the field and be built again if they change
+	void Build(const float* heights, uint32_t width, uint32_t height, float cellSpacing, float originX,
+		float originZ);
+
+	// Builds the coarser levels, each from the one below with a [1 2 1] tent filter so sample i sits on sample 2i of
+	// the level below. Stops early once a level would be less than 2 samples a side
+	void BuildMips(uint32_t levelCount);
+#pragma endregion
+
+#pragma region Query Methods
+	// Gets the height at a local position. Positions off the grid take the height of its nearest edge
+	// Returns float - The height
+	float GetHeight(float x, float z, uint32_t level = 0) const;
+
+	// Gets the unit normal at a local position, from the slope of the filtered surface
+	void GetNormal(float x, float z, float normal[3], uint32_t level = 0) const;
+
+	// Gets the heights of count positions, four at a time where SIMD is available
+	void GetHeights(const float* x, const float* z, uint32_t count, float* heights, uint32_t level = 0) const;
+
+	// Gets the unit normals of count positions as x, y, z triples, four at a time where SIMD is available
+	void GetNormals(const float* x, const float* z, uint32_t count, float* normals, uint32_t level = 0) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the number of levels built, 1 until BuildMips is called
+	// Returns uint32_t - The level count
+	uint32_t GetLevelCount() const { return m_levelCount; }
+
+	// Gets the samples across and down a level
+	uint32_t GetLevelWidth(uint32_t level) const { return m_widths[level]; }
+	uint32_t GetLevelHeight(uint32_t level) const { return m_heights[level]; }
+
+	// Checks if the field has been built
+	// Returns bool - True if there are samples to query
+	bool IsBuilt() const { return m_samples[0] != nullptr; }
+#pragma endregion
+
+private:
+#pragma region Private Methods
+	// Finds the cell a local position falls in and how far across it the position is, clamped to the grid
+	// Returns uint32_t - The index of the cell's first sample
+	uint32_t FindCell(uint32_t level, float x, float z, float& fractionX, float& fractionZ) const;
+#pragma endregion
+
+#pragma region Member Variables
+	float m_cellSpacing = 1.0f;
+	float m_originX = 0.0f;
+	float m_originZ = 0.0f;
+	uint32_t m_levelCount = 0;
+
+	// Level 0 points at the samples it was built from, the levels above point into their own storage
+	const float* m_samples[MaxHeightFieldLevels] = {};
+	uint32_t m_widths[MaxHeightFieldLevels] = {};
+	uint32_t m_heights[MaxHeightFieldLevels] = {};
+	std::vector<float> m_mipSamples[MaxHeightFieldLevels];
+#pragma endregion
+};
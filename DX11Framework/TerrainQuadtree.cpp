@@ -0,0 +1,468 @@
+// Include{s}
+#include "TerrainQuadtree.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#pragma region Reduction Helpers
+namespace
+{
+	// Every frustum plane, one bit each
+	const uint32_t AllPlanes = 0x3F;
+
+	// Widens a range of samples into minHeight and maxHeight
+	void ReduceMinMax(const float* samples, uint32_t count, float& minHeight, float& maxHeight)
+	{
+		uint32_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+		// 4 samples per iteration, folded into one lane at the end
+		if (count >= 4)
+		{
+			__m128 minimum = _mm_loadu_ps(samples);
+			__m128 maximum = minimum;
+
+			for (i = 4; i + 4 <= count; i += 4)
+			{
+				const __m128 values = _mm_loadu_ps(samples + i);
+				minimum = _mm_min_ps(minimum, values);
+				maximum = _mm_max_ps(maximum, values);
+			}
+
+			minimum = _mm_min_ps(minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+			minimum = _mm_min_ss(minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+			maximum = _mm_max_ps(maximum, _mm_shuffle_ps(maximum, maximum, _MM_SHUFFLE(1, 0, 3, 2)));
+			maximum = _mm_max_ss(maximum, _mm_shuffle_ps(maximum, maximum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			minHeight = (std::min)(minHeight, _mm_cvtss_f32(minimum));
+			maxHeight = (std::max)(maxHeight, _mm_cvtss_f32(maximum));
+		}
+#endif
+
+		// The samples left over
+		for (; i < count; i++)
+		{
+			minHeight = (std::min)(minHeight, samples[i]);
+			maxHeight = (std::max)(maxHeight, samples[i]);
+		}
+	}
+}
+#pragma endregion
+
+#pragma region Build Methods
+void TerrainQuadtree::Build(const float* heights, uint32_t width, uint32_t height, float cellSpacing, float originX,
+	float originZ, uint32_t patchResolution)
+{
+	m_width = width;
+	m_height = height;
+	m_cellSpacing = cellSpacing;
+	m_originX = originX;
+	m_originZ = originZ;
+	m_patchResolution = patchResolution;
+
+	const uint32_t cellsX = width > 1 ? width - 1 : 1;
+	const uint32_t cellsZ = height > 1 ? height - 1 : 1;
+
+	// Add levels until one node covers the whole grid
+	m_lodLevels = 0;
+	uint32_t nodesX = (cellsX + patchResolution - 1) / patchResolution;
+	uint32_t nodesZ = (cellsZ + patchResolution - 1) / patchResolution;
+
+	while (m_lodLevels < MaxTerrainLodLevels)
+	{
+		m_nodesX[m_lodLevels] = nodesX;
+		m_nodesZ[m_lodLevels] = nodesZ;
+		m_lodLevels++;
+
+		if (nodesX == 1 && nodesZ == 1)
+		{
+			break;
+		}
+
+		nodesX = (nodesX + 1) / 2;
+		nodesZ = (nodesZ + 1) / 2;
+	}
+
+	// The finest nodes take their bounds from the samples under them, including the shared edge
+	m_nodeMinHeights[0].assign(m_nodesX[0] * m_nodesZ[0], 0.0f);
+	m_nodeMaxHeights[0].assign(m_nodesX[0] * m_nodesZ[0], 0.0f);
+
+	for (uint32_t nodeZ = 0; nodeZ < m_nodesZ[0]; nodeZ++)
+	{
+		for (uint32_t nodeX = 0; nodeX < m_nodesX[0]; nodeX++)
+		{
+			const uint32_t startX = nodeX * patchResolution;
+			const uint32_t startZ = nodeZ * patchResolution;
+			const uint32_t endX = (std::min)(startX + patchResolution, width - 1);
+			const uint32_t endZ = (std::min)(startZ + patchResolution, height - 1);
+
+			float minHeight = heights[startZ * width + startX];
+			float maxHeight = minHeight;
+
+			for (uint32_t z = startZ; z <= endZ; z++)
+			{
+				ReduceMinMax(&heights[z * width + startX], endX - startX + 1, minHeight, maxHeight);
+			}
+
+			m_nodeMinHeights[0][nodeZ * m_nodesX[0] + nodeX] = minHeight;
+			m_nodeMaxHeights[0][nodeZ * m_nodesX[0] + nodeX] = maxHeight;
+		}
+	}
+
+	// Every coarser node spans the children it has
+	for (uint32_t level = 1; level < m_lodLevels; level++)
+	{
+		m_nodeMinHeights[level].assign(m_nodesX[level] * m_nodesZ[level], 0.0f);
+		m_nodeMaxHeights[level].assign(m_nodesX[level] * m_nodesZ[level], 0.0f);
+
+		for (uint32_t nodeZ = 0; nodeZ < m_nodesZ[level]; nodeZ++)
+		{
+			for (uint32_t nodeX = 0; nodeX < m_nodesX[level]; nodeX++)
+			{
+				float minHeight = m_nodeMinHeights[level - 1][(nodeZ * 2) * m_nodesX[level - 1] + nodeX * 2];
+				float maxHeight = m_nodeMaxHeights[level - 1][(nodeZ * 2) * m_nodesX[level - 1] + nodeX * 2];
+
+				for (uint32_t child = 1; child < 4; child++)
+				{
+					const uint32_t childX = nodeX * 2 + (child & 1);
+					const uint32_t childZ = nodeZ * 2 + (child >> 1);
+
+					if (childX < m_nodesX[level - 1] && childZ < m_nodesZ[level - 1])
+					{
+						const uint32_t childIndex = childZ * m_nodesX[level - 1] + childX;
+						minHeight = (std::min)(minHeight, m_nodeMinHeights[level - 1][childIndex]);
+						maxHeight = (std::max)(maxHeight, m_nodeMaxHeights[level - 1][childIndex]);
+					}
+				}
+
+				m_nodeMinHeights[level][nodeZ * m_nodesX[level] + nodeX] = minHeight;
+				m_nodeMaxHeights[level][nodeZ * m_nodesX[level] + nodeX] = maxHeight;
+			}
+		}
+	}
+
+	m_minHeight = m_nodeMinHeights[m_lodLevels - 1][0];
+	m_maxHeight = m_nodeMaxHeights[m_lodLevels - 1][0];
+	for (size_t node = 1; node < m_nodeMinHeights[m_lodLevels - 1].size(); node++)
+	{
+		m_minHeight = (std::min)(m_minHeight, m_nodeMinHeights[m_lodLevels - 1][node]);
+		m_maxHeight = (std::max)(m_maxHeight, m_nodeMaxHeights[m_lodLevels - 1][node]);
+	}
+
+	for (uint32_t level = 0; level < m_lodLevels; level++)
+	{
+		m_levelErrors[level] = MeasureLevelError(heights, level);
+	}
+
+	// Until the view is known, each level reaches twice as far as its nodes are wide
+	for (uint32_t level = 0; level < m_lodLevels; level++)
+	{
+		m_lodRanges[level] = 2.0f * cellSpacing * (patchResolution << level);
+	}
+}
+
+void TerrainQuadtree::BuildPatchIndices(uint32_t patchResolution, std::vector<uint16_t>& indices,
+	uint32_t partStartIndex[TerrainNodePart_Count], uint32_t partIndexCount[TerrainNodePart_Count])
+{
+	const uint32_t vertsPerSide = patchResolution + 1;
+	const uint32_t halfResolution = patchResolution / 2;
+	indices.clear();
+	indices.reserve(6 * patchResolution * patchResolution);
+
+	for (uint32_t part = 0; part < TerrainNodePart_Whole; part++)
+	{
+		const uint32_t firstColumn = (part & 1) * halfResolution;
+		const uint32_t firstRow = (part >> 1) * halfResolution;
+
+		partStartIndex[part] = static_cast<uint32_t>(indices.size());
+
+		// Two triangles a cell, wound the same way as the rest of the scene
+		for (uint32_t i = firstRow; i < firstRow + halfResolution; i++)
+		{
+			for (uint32_t j = firstColumn; j < firstColumn + halfResolution; j++)
+			{
+				const uint16_t topleft = static_cast<uint16_t>(i * vertsPerSide + j);
+				const uint16_t topright = static_cast<uint16_t>(i * vertsPerSide + (j + 1));
+				const uint16_t bottomleft = static_cast<uint16_t>((i + 1) * vertsPerSide + j);
+				const uint16_t bottomright = static_cast<uint16_t>((i + 1) * vertsPerSide + (j + 1));
+
+				indices.push_back(topright);
+				indices.push_back(bottomleft);
+				indices.push_back(bottomright);
+
+				indices.push_back(topleft);
+				indices.push_back(bottomleft);
+				indices.push_back(topright);
+			}
+		}
+
+		partIndexCount[part] = static_cast<uint32_t>(indices.size()) - partStartIndex[part];
+	}
+
+	partStartIndex[TerrainNodePart_Whole] = 0;
+	partIndexCount[TerrainNodePart_Whole] = static_cast<uint32_t>(indices.size());
+}
+#pragma endregion
+
+#pragma region Selection Methods
+void TerrainQuadtree::ComputeLodRanges(float projectionScale, float pixelError)
+{
+	// The finest level reaches at least two of its nodes out, so its morph is spread over a node or more
+	float range = 2.0f * m_cellSpacing * m_patchResolution;
+
+	for (uint32_t level = 0; level + 1 < m_lodLevels; level++)
+	{
+		// The next level takes over once its error is no more than pixelError pixels on screen
+		const float errorDistance = m_levelErrors[level + 1] * projectionScale / pixelError;
+
+		range = (std::max)(range, errorDistance);
+		m_lodRanges[level] = range;
+		range *= 2.0f;
+	}
+
+	// Nothing is coarser than the last level, so it covers everything left
+	if (m_lodLevels > 0)
+	{
+		m_lodRanges[m_lodLevels - 1] = 1e30f;
+	}
+}
+
+void TerrainQuadtree::Select(const float cameraPosition[3], const float (*frustumPlanes)[4],
+	std::vector<TerrainSelectedNode>& selection) const
+{
+	selection.clear();
+
+	if (m_lodLevels == 0)
+	{
+		return;
+	}
+
+	const uint32_t rootLevel = m_lodLevels - 1;
+	for (uint32_t nodeZ = 0; nodeZ < m_nodesZ[rootLevel]; nodeZ++)
+	{
+		for (uint32_t nodeX = 0; nodeX < m_nodesX[rootLevel]; nodeX++)
+		{
+			SelectNode(rootLevel, nodeX, nodeZ, cameraPosition, frustumPlanes, AllPlanes, selection);
+		}
+	}
+}
+
+TerrainSelectionStats TerrainQuadtree::Summarise(const std::vector<TerrainSelectedNode>& selection) const
+{
+	TerrainSelectionStats stats = {};
+	stats.TotalChunks = GetChunkCount();
+
+	const uint64_t wholeTriangles = 2ull * m_patchResolution * m_patchResolution;
+	const float chunkSize = m_cellSpacing * m_patchResolution;
+
+	for (const TerrainSelectedNode& node : selection)
+	{
+		stats.Nodes++;
+		stats.Triangles += node.Part == TerrainNodePart_Whole ? wholeTriangles : wholeTriangles / 4;
+		stats.NodesPerLevel[node.Level]++;
+
+		// The chunks the drawn area covers, clamped to the grid as nodes of the coarser levels can hang over its edge
+		const uint32_t firstX = static_cast<uint32_t>(lroundf((node.X - m_originX) / chunkSize));
+		const uint32_t firstZ = static_cast<uint32_t>(lroundf((node.Z - m_originZ) / chunkSize));
+		const uint32_t span = node.Part == TerrainNodePart_Whole ? 1u << node.Level : 1u << (node.Level - 1);
+		const uint32_t startX = firstX + (node.Part == TerrainNodePart_Whole ? 0 : (node.Part & 1) * span);
+		const uint32_t startZ = firstZ + (node.Part == TerrainNodePart_Whole ? 0 : (node.Part >> 1) * span);
+		const uint32_t endX = (std::min)(startX + span, m_nodesX[0]);
+		const uint32_t endZ = (std::min)(startZ + span, m_nodesZ[0]);
+
+		if (startX < endX && startZ < endZ)
+		{
+			stats.VisibleChunks += (endX - startX) * (endZ - startZ);
+		}
+	}
+
+	return stats;
+}
+#pragma endregion
+
+#pragma region Getters
+void TerrainQuadtree::GetMorphRange(uint32_t level, float& start, float& end) const
+{
+	const float previousRange = level > 0 ? m_lodRanges[level - 1] : 0.0f;
+
+	end = m_lodRanges[level];
+	start = previousRange + (end - previousRange) * MorphStartRatio;
+}
+
+uint32_t TerrainQuadtree::GetTotalNodeCount() const
+{
+	uint32_t nodeCount = 0;
+
+	for (uint32_t level = 0; level < m_lodLevels; level++)
+	{
+		nodeCount += m_nodesX[level] * m_nodesZ[level];
+	}
+
+	return nodeCount;
+}
+#pragma endregion
+
+#pragma region Private Methods
+bool TerrainQuadtree::SelectNode(uint32_t level, uint32_t nodeX, uint32_t nodeZ, const float cameraPosition[3],
+	const float (*frustumPlanes)[4], uint32_t planeMask, std::vector<TerrainSelectedNode>& selection) const
+{
+	// Nothing to draw, and nothing the parent needs to draw either
+	if (frustumPlanes && planeMask != 0 && !IsInFrustum(level, nodeX, nodeZ, frustumPlanes, planeMask))
+	{
+		return true;
+	}
+
+	if (!IsInRange(level, nodeX, nodeZ, cameraPosition, m_lodRanges[level]))
+	{
+		return false;
+	}
+
+	const float size = m_cellSpacing * (m_patchResolution << level);
+	TerrainSelectedNode node = { m_originX + nodeX * size, m_originZ + nodeZ * size, size, level,
+		TerrainNodePart_Whole };
+
+	// The finest level, or far enough that no child is close enough to need the extra detail
+	if (level == 0 || !IsInRange(level, nodeX, nodeZ, cameraPosition, m_lodRanges[level - 1]))
+	{
+		selection.push_back(node);
+		return true;
+	}
+
+	// Children out of their own range are covered by this node's quadrant over them
+	uint32_t uncovered = 0;
+	for (uint32_t child = 0; child < 4; child++)
+	{
+		const uint32_t childX = nodeX * 2 + (child & 1);
+		const uint32_t childZ = nodeZ * 2 + (child >> 1);
+
+		if (childX < m_nodesX[level - 1] && childZ < m_nodesZ[level - 1] &&
+			!SelectNode(level - 1, childX, childZ, cameraPosition, frustumPlanes, planeMask, selection))
+		{
+			uncovered |= 1u << child;
+		}
+	}
+
+	if (uncovered == 0xF)
+	{
+		selection.push_back(node);
+		return true;
+	}
+
+	for (uint32_t child = 0; child < 4; child++)
+	{
+		if (uncovered & (1u << child))
+		{
+			node.Part = static_cast<TerrainNodePart>(child);
+			selection.push_back(node);
+		}
+	}
+
+	return true;
+}
+
+bool TerrainQuadtree::IsInRange(uint32_t level, uint32_t nodeX, uint32_t nodeZ, const float cameraPosition[3],
+	float range) const
+{
+	const float size = m_cellSpacing * (m_patchResolution << level);
+	const uint32_t node = nodeZ * m_nodesX[level] + nodeX;
+
+	const float boxMin[3] = { m_originX + nodeX * size, m_nodeMinHeights[level][node], m_originZ + nodeZ * size };
+	const float boxMax[3] = { boxMin[0] + size, m_nodeMaxHeights[level][node], boxMin[2] + size };
+
+	// Distance from the camera to the nearest point of the box
+	float distanceSquared = 0.0f;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		const float nearest = (std::max)(boxMin[axis], (std::min)(cameraPosition[axis], boxMax[axis]));
+		const float offset = cameraPosition[axis] - nearest;
+		distanceSquared += offset * offset;
+	}
+
+	return distanceSquared <= range * range;
+}
+
+bool TerrainQuadtree::IsInFrustum(uint32_t level, uint32_t nodeX, uint32_t nodeZ, const float (*frustumPlanes)[4],
+	uint32_t& planeMask) const
+{
+	const float size = m_cellSpacing * (m_patchResolution << level);
+	const uint32_t node = nodeZ * m_nodesX[level] + nodeX;
+	const float minHeight = m_nodeMinHeights[level][node];
+	const float maxHeight = m_nodeMaxHeights[level][node];
+
+	const float center[3] = { m_originX + (nodeX + 0.5f) * size, 0.5f * (minHeight + maxHeight),
+		m_originZ + (nodeZ + 0.5f) * size };
+	const float extents[3] = { 0.5f * size, 0.5f * (maxHeight - minHeight), 0.5f * size };
+
+	for (int plane = 0; plane < 6; plane++)
+	{
+		if ((planeMask & (1u << plane)) == 0)
+		{
+			continue;
+		}
+
+		const float* p = frustumPlanes[plane];
+
+		// Outside if even the corner furthest along the plane normal is behind it
+		const float distance = p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3];
+		const float radius = fabsf(p[0]) * extents[0] + fabsf(p[1]) * extents[1] + fabsf(p[2]) * extents[2];
+
+		if (distance + radius < 0.0f)
+		{
+			return false;
+		}
+
+		// Inside if even the nearest corner is in front, nothing under this node can cross the plane
+		if (distance - radius >= 0.0f)
+		{
+			planeMask &= ~(1u << plane);
+		}
+	}
+
+	return true;
+}
+
+float TerrainQuadtree::GetSample(const float* heights, int64_t x, int64_t z) const
+{
+	x = (std::max)(int64_t(0), (std::min)(x, int64_t(m_width) - 1));
+	z = (std::max)(int64_t(0), (std::min)(z, int64_t(m_height) - 1));
+
+	return heights[z * m_width + x];
+}
+
+float TerrainQuadtree::MeasureLevelError(const float* heights, uint32_t level) const
+{
+	if (level == 0)
+	{
+		return 0.0f;
+	}
+
+	// A level's vertices land on every step-th sample, anything between is blended from the four around it
+	const int64_t step = int64_t(1) << level;
+	const float inverseStep = 1.0f / step;
+	float maxError = 0.0f;
+
+	for (int64_t z = 0; z < m_height; z++)
+	{
+		const int64_t z0 = (z / step) * step;
+		const float tz = (z - z0) * inverseStep;
+
+		for (int64_t x = 0; x < m_width; x++)
+		{
+			const int64_t x0 = (x / step) * step;
+			const float tx = (x - x0) * inverseStep;
+
+			const float top = GetSample(heights, x0, z0) + (GetSample(heights, x0 + step, z0) -
+				GetSample(heights, x0, z0)) * tx;
+			const float bottom = GetSample(heights, x0, z0 + step) + (GetSample(heights, x0 + step, z0 + step) -
+				GetSample(heights, x0, z0 + step)) * tx;
+			const float approximation = top + (bottom - top) * tz;
+
+			maxError = (std::max)(maxError, fabsf(heights[z * m_width + x] - approximation));
+		}
+	}
+
+	return maxError;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,176 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, so node selection can be run and checked without a device
+#include <cstdint>
+#include <vector>
+
+// Most levels of detail a terrain can have, the shader holds a morph range for each
+constexpr uint32_t MaxTerrainLodLevels = 8;
+
+// Which part of a node a selection draws. Quadrants are numbered x first, so quadrant 1 is the +x half of the -z side
+enum TerrainNodePart : uint32_t
+{
+	TerrainNodePart_Quadrant0,
+	TerrainNodePart_Quadrant1,
+	TerrainNodePart_Quadrant2,
+	TerrainNodePart_Quadrant3,
+	TerrainNodePart_Whole,
+	TerrainNodePart_Count
+};
+
+// Struct to hold one node picked to be drawn, in the terrain's local space
+struct TerrainSelectedNode
+{
+	float X;
+	float Z;
+	float Size;
+	uint32_t Level;
+	TerrainNodePart Part;
+};
+
+// Struct to hold what a selection came to
+struct TerrainSelectionStats
+{
+	uint32_t Nodes;
+	uint64_t Triangles;
+	uint32_t NodesPerLevel[MaxTerrainLodLevels];
+
+	// Finest level chunks under the drawn nodes, out of every chunk of the grid
+	uint32_t VisibleChunks;
+	uint32_t TotalChunks;
+};
+
+// Chunked level of detail for a height grid, continuous distance-based LOD (CDLOD). The grid is split into a
+// quadtree of square nodes that are all drawn with the same patch of cells, so a node one level up covers four
+// times the ground at half the density. Each level is used out to a fixed distance from the camera, and inside the
+// last part of that range the vertices slide onto the next level's grid, so there are no cracks or pops between
+// levels
+class TerrainQuadtree
+{
+public:
+#pragma region Build Methods
+	// Works out the height bounds of every node and how far each level can be off the true surface. The heights are
+	// a row major grid of samples spaced cellSpacing apart, starting at (originX, originZ). A grid of 2^n + 1
+	// samples a side fills the nodes exactly. The bounds form a min/max pyramid, the finest level reduced from the
+	// samples four at a time and every level above from the one below
+	void Build(const float* heights, uint32_t width, uint32_t height, float cellSpacing, float originX,
+		float originZ, uint32_t patchResolution);
+
+	// Lays out the triangle list every node is drawn with. Each index is a vertex id on the patch's grid of
+	// patchResolution + 1 vertices a side, row by row, which the vertex shader turns back into a grid position. The
+	// quadrants are laid out back to back, so the whole patch draws all of them
+	static void BuildPatchIndices(uint32_t patchResolution, std::vector<uint16_t>& indices,
+		uint32_t partStartIndex[TerrainNodePart_Count], uint32_t partIndexCount[TerrainNodePart_Count]);
+#pragma endregion
+
+#pragma region Selection Methods
+	// Sets how far out each level is used, from the screen-space error allowed. projectionScale is how many pixels a
+	// unit long edge covers one unit from the camera, half the viewport height times the projection's y scale. Each
+	// level is used from where its height error shrinks to pixelError pixels, and a level always reaches at least
+	// twice as far as the one before so the morph has room
+	void ComputeLodRanges(float projectionScale, float pixelError);
+
+	// Picks the nodes to draw for a camera, both in the terrain's local space. The planes are optional, six of them
+	// as (normal, distance) with the inside positive. Nodes outside any of them are skipped, and the children of a
+	// node wholly inside a plane are not tested against it again
+	void Select(const float cameraPosition[3], const float (*frustumPlanes)[4],
+		std::vector<TerrainSelectedNode>& selection) const;
+
+	// Counts the nodes, triangles and finest level chunks of a selection
+	// Returns TerrainSelectionStats - The counts
+	TerrainSelectionStats Summarise(const std::vector<TerrainSelectedNode>& selection) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the number of levels, level 0 is the finest
+	// Returns uint32_t - The level count
+	uint32_t GetLodLevels() const { return m_lodLevels; }
+
+	// Gets the number of cells along the side of every node's patch
+	// Returns uint32_t - The patch resolution
+	uint32_t GetPatchResolution() const { return m_patchResolution; }
+
+	// Gets how far from the camera a level is used
+	// Returns float - The range in local units
+	float GetLodRange(uint32_t level) const { return m_lodRanges[level]; }
+
+	// Gets the distances a level's vertices start and finish sliding onto the next level's grid
+	void GetMorphRange(uint32_t level, float& start, float& end) const;
+
+	// Gets the most a level's surface is off the full resolution heights
+	// Returns float - The height error in local units
+	float GetLevelError(uint32_t level) const { return m_levelErrors[level]; }
+
+	// Gets the number of nodes in the finest level
+	// Returns uint32_t - The chunk count
+	uint32_t GetChunkCount() const { return m_nodesX[0] * m_nodesZ[0]; }
+
+	// Gets the number of nodes in every level together, the most a selection can hold
+	// Returns uint32_t - The node count
+	uint32_t GetTotalNodeCount() const;
+
+	// Gets the lowest and highest sample of the whole grid
+	float GetMinHeight() const { return m_minHeight; }
+	float GetMaxHeight() const { return m_maxHeight; }
+
+	// Gets the corner of the grid with the lowest coordinates
+	float GetOriginX() const { return m_originX; }
+	float GetOriginZ() const { return m_originZ; }
+
+	// Gets the size of the grid along x and z
+	float GetSizeX() const { return m_cellSpacing * (m_width - 1); }
+	float GetSizeZ() const { return m_cellSpacing * (m_height - 1); }
+#pragma endregion
+
+private:
+#pragma region Private Methods
+	// Selects a node or the parts of it whose children are not close enough to be drawn themselves
+	// Returns bool - False if the node is out of its level's range, and its parent has to draw the area instead
+	bool SelectNode(uint32_t level, uint32_t nodeX, uint32_t nodeZ, const float cameraPosition[3],
+		const float (*frustumPlanes)[4], uint32_t planeMask, std::vector<TerrainSelectedNode>& selection) const;
+
+	// Checks a node's box reaches within a distance of the camera
+	// Returns bool - True if the box is in range
+	bool IsInRange(uint32_t level, uint32_t nodeX, uint32_t nodeZ, const float cameraPosition[3],
+		float range) const;
+
+	// Checks a node's box against the planes set in planeMask, and clears the bits of the planes it is wholly inside
+	// Returns bool - True if any of the box is inside
+	bool IsInFrustum(uint32_t level, uint32_t nodeX, uint32_t nodeZ, const float (*frustumPlanes)[4],
+		uint32_t& planeMask) const;
+
+	// Gets the height of a sample, clamped to the grid
+	// Returns float - The height
+	float GetSample(const float* heights, int64_t x, int64_t z) const;
+
+	// Works out how far a level's grid, every 2^level samples, is off the full resolution heights
+	// Returns float - The largest difference
+	float MeasureLevelError(const float* heights, uint32_t level) const;
+#pragma endregion
+
+#pragma region Member Variables
+	uint32_t m_width = 0;
+	uint32_t m_height = 0;
+	float m_cellSpacing = 1.0f;
+	float m_originX = 0.0f;
+	float m_originZ = 0.0f;
+	float m_minHeight = 0.0f;
+	float m_maxHeight = 0.0f;
+
+	uint32_t m_patchResolution = 32;
+	uint32_t m_lodLevels = 0;
+
+	// Nodes along each side of every level, and the lowest and highest sample under each node
+	uint32_t m_nodesX[MaxTerrainLodLevels] = {};
+	uint32_t m_nodesZ[MaxTerrainLodLevels] = {};
+	std::vector<float> m_nodeMinHeights[MaxTerrainLodLevels];
+	std::vector<float> m_nodeMaxHeights[MaxTerrainLodLevels];
+
+	float m_levelErrors[MaxTerrainLodLevels] = {};
+	float m_lodRanges[MaxTerrainLodLevels] = {};
+
+	// How far into each level's range the vertices start sliding onto the next level's grid
+	static constexpr float MorphStartRatio = 0.66f;
+#pragma endregion
+};
@@ -0,0 +1,186 @@
+// Include{s}
+#include "TiledHeightmap.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#pragma region Stream Helpers
+namespace
+{
+	const char FileMagic[4] = { 'R', 'L', 'T', 'H' };
+	const uint32_t FileVersion = 1;
+
+	// The tiles start on a 64 byte boundary after the header
+	const size_t TileDataOffset = 64;
+
+	// Fields are written one at a time so the file has no padding, the byte order is the machine's, little endian
+	// on everything this builds for
+	template <typename T>
+	void WriteValue(std::ostream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	T ReadValue(const unsigned char* data, size_t offset)
+	{
+		T value;
+		memcpy(&value, data + offset, sizeof(T));
+		return value;
+	}
+}
+#pragma endregion
+
+#pragma region Conversion Methods
+bool TiledHeightmap::ConvertRaw(const std::string& rawPath, uint32_t width, uint32_t height, uint32_t bitsPerSample,
+	uint32_t tileSize, const std::string& tiledPath)
+{
+	if (width < 2 || height < 2 || tileSize == 0 || (bitsPerSample != 8 && bitsPerSample != 16))
+	{
+		return false;
+	}
+
+	std::ifstream raw(rawPath, std::ios::binary);
+	std::ofstream tiled(tiledPath, std::ios::binary);
+
+	// Check if the files are open
+	if (!raw.is_open() || !tiled.is_open())
+	{
+		return false;
+	}
+
+	const uint32_t tilesX = (width - 1 + tileSize - 1) / tileSize;
+	const uint32_t tilesZ = (height - 1 + tileSize - 1) / tileSize;
+	const uint32_t tileSide = tileSize + 1;
+	const size_t bytesPerSample = bitsPerSample / 8;
+
+	tiled.write(FileMagic, sizeof(FileMagic));
+	WriteValue(tiled, FileVersion);
+	WriteValue(tiled, width);
+	WriteValue(tiled, height);
+	WriteValue(tiled, tileSize);
+	WriteValue(tiled, tilesX);
+	WriteValue(tiled, tilesZ);
+
+	const std::vector<char> padding(TileDataOffset - static_cast<size_t>(tiled.tellp()), 0);
+	tiled.write(padding.data(), padding.size());
+
+	// One band of rows for a row of tiles, widened to 16 bits
+	std::vector<unsigned char> rawRow(width * bytesPerSample);
+	std::vector<uint16_t> band(static_cast<size_t>(tileSide) * width);
+	std::vector<uint16_t> tile(static_cast<size_t>(tileSide) * tileSide);
+
+	for (uint32_t tileZ = 0; tileZ < tilesZ; tileZ++)
+	{
+		for (uint32_t row = 0; row < tileSide; row++)
+		{
+			// Rows past the bottom edge repeat the last one
+			const uint32_t z = (std::min)(tileZ * tileSize + row, height - 1);
+
+			raw.seekg(static_cast<std::streamoff>(z) * width * bytesPerSample);
+			if (!raw.read(reinterpret_cast<char*>(rawRow.data()), rawRow.size()))
+			{
+				return false;
+			}
+
+			for (uint32_t x = 0; x < width; x++)
+			{
+				// 8-bit samples are spread over the whole 16-bit range, 255 becomes 65535
+				band[static_cast<size_t>(row) * width + x] = bitsPerSample == 8 ? static_cast<uint16_t>(rawRow[x] * 257) :
+					static_cast<uint16_t>(rawRow[x * 2] | (rawRow[x * 2 + 1] << 8));
+			}
+		}
+
+		for (uint32_t tileX = 0; tileX < tilesX; tileX++)
+		{
+			for (uint32_t row = 0; row < tileSide; row++)
+			{
+				for (uint32_t column = 0; column < tileSide; column++)
+				{
+					// Columns past the right edge repeat the last one
+					const uint32_t x = (std::min)(tileX * tileSize + column, width - 1);
+					tile[static_cast<size_t>(row) * tileSide + column] = band[static_cast<size_t>(row) * width + x];
+				}
+			}
+
+			tiled.write(reinterpret_cast<const char*>(tile.data()), tile.size() * sizeof(uint16_t));
+		}
+	}
+
+	return static_cast<bool>(tiled);
+}
+#pragma endregion
+
+#pragma region File Methods
+bool TiledHeightmap::Open(const std::string& path)
+{
+	Close();
+
+	if (!m_file.Open(path))
+	{
+		return false;
+	}
+
+	const unsigned char* data = m_file.GetData();
+
+	if (m_file.GetSize() < TileDataOffset || memcmp(data, FileMagic, sizeof(FileMagic)) != 0 ||
+		ReadValue<uint32_t>(data, 4) != FileVersion)
+	{
+		m_file.Close();
+		return false;
+	}
+
+	m_width = ReadValue<uint32_t>(data, 8);
+	m_height = ReadValue<uint32_t>(data, 12);
+	m_tileSize = ReadValue<uint32_t>(data, 16);
+	m_tilesX = ReadValue<uint32_t>(data, 20);
+	m_tilesZ = ReadValue<uint32_t>(data, 24);
+
+	// The header has to agree with what is actually in the file
+	const uint64_t tileBytes = static_cast<uint64_t>(GetTileSampleCount()) * sizeof(uint16_t);
+	if (m_tileSize == 0 || m_width < 2 || m_height < 2 || m_tilesX != (m_width - 2) / m_tileSize + 1 ||
+		m_tilesZ != (m_height - 2) / m_tileSize + 1 ||
+		m_file.GetSize() < TileDataOffset + tileBytes * m_tilesX * m_tilesZ)
+	{
+		Close();
+		return false;
+	}
+
+	m_tiles = reinterpret_cast<const uint16_t*>(data + TileDataOffset);
+
+	return true;
+}
+
+void TiledHeightmap::Close()
+{
+	m_file.Close();
+	m_tiles = nullptr;
+	m_width = 0;
+	m_height = 0;
+	m_tileSize = 0;
+	m_tilesX = 0;
+	m_tilesZ = 0;
+}
+#pragma endregion
+
+#pragma region Sample Methods
+const uint16_t* TiledHeightmap::GetTile(uint32_t tileX, uint32_t tileZ) const
+{
+	return m_tiles + (static_cast<size_t>(tileZ) * m_tilesX + tileX) * GetTileSampleCount();
+}
+
+float TiledHeightmap::GetSample(int64_t x, int64_t z) const
+{
+	x = (std::max)(int64_t(0), (std::min)(x, int64_t(m_width) - 1));
+	z = (std::max)(int64_t(0), (std::min)(z, int64_t(m_height) - 1));
+
+	// The last sample of the heightmap is only in the tile before it
+	const uint32_t tileX = (std::min)(static_cast<uint32_t>(x / m_tileSize), m_tilesX - 1);
+	const uint32_t tileZ = (std::min)(static_cast<uint32_t>(z / m_tileSize), m_tilesZ - 1);
+	const uint32_t column = static_cast<uint32_t>(x) - tileX * m_tileSize;
+	const uint32_t row = static_cast<uint32_t>(z) - tileZ * m_tileSize;
+
+	return GetTile(tileX, tileZ)[row * (m_tileSize + 1) + column] / 65535.0f;
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+// Include{s}
+// Only the standard library and the file mapping, so heightmaps can be converted and read without a device
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+
+// Heightmap split into square tiles of 16-bit samples, read straight out of a mapped file so only the tiles in use
+// are ever paged in. Stored as "RLTH", a version, the sample and tile counts and then every tile, rows of tiles from
+// the lowest z up. A tile holds TileSize + 1 samples a side, the last row and column repeat the first of the next
+// tile, so each tile can be filtered on its own without seams
+class TiledHeightmap
+{
+public:
+#pragma region Conversion Methods
+	// Converts a row major .raw heightmap of 8 or 16-bit samples, 16-bit ones little endian, into a tiled file.
+	// The raw file is read a band of tiles at a time, so heightmaps larger than the memory can be converted
+	// Returns bool - False if the raw file is too short or either file could not be opened
+	static bool ConvertRaw(const std::string& rawPath, uint32_t width, uint32_t height, uint32_t bitsPerSample,
+		uint32_t tileSize, const std::string& tiledPath);
+#pragma endregion
+
+#pragma region File Methods
+	// Maps a tiled heightmap
+	// Returns bool - False if the file could not be opened or is not a complete tiled heightmap
+	bool Open(const std::string& path);
+
+	// Unmaps the heightmap
+	void Close();
+#pragma endregion
+
+#pragma region Sample Methods
+	// Gets a tile's samples, reading them pages in that part of the file if it is not in memory already
+	// Returns uint16_t* - The (TileSize + 1) squared samples, row major
+	const uint16_t* GetTile(uint32_t tileX, uint32_t tileZ) const;
+
+	// Gets one sample, clamped to the heightmap
+	// Returns float - The sample from 0 to 1
+	float GetSample(int64_t x, int64_t z) const;
+#pragma endregion
+
+#pragma region Getters
+	// Gets the size of the heightmap in samples
+	uint32_t GetWidth() const { return m_width; }
+	uint32_t GetHeight() const { return m_height; }
+
+	// Gets the number of sample steps along the side of a tile
+	// Returns uint32_t - The tile size
+	uint32_t GetTileSize() const { return m_tileSize; }
+
+	// Gets the number of tiles along x and z
+	uint32_t GetTilesX() const { return m_tilesX; }
+	uint32_t GetTilesZ() const { return m_tilesZ; }
+
+	// Gets the number of samples a tile holds
+	// Returns uint32_t - The samples along a side, squared
+	uint32_t GetTileSampleCount() const { return (m_tileSize + 1) * (m_tileSize + 1); }
+
+	// Checks a heightmap is mapped
+	// Returns bool - True if a heightmap is mapped
+	bool IsOpen() const { return m_file.IsOpen(); }
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	MappedFile m_file;
+	const uint16_t* m_tiles = nullptr;
+
+	uint32_t m_width = 0;
+	uint32_t m_height = 0;
+	uint32_t m_tileSize = 0;
+	uint32_t m_tilesX = 0;
+	uint32_t m_tilesZ = 0;
+#pragma endregion
+};
@@ -0,0 +1,387 @@
+// Include{s}
+#include "TransformStore.h"
+#include "ParallelFor.h"
+#include "Profiler.h"
+#include <algorithm>
+
+using namespace DirectX;
+
+// Below this many transforms to rebuild the cost of waking the worker threads outweighs the work
+constexpr uint32_t ParallelThreshold = 2048;
+
+#pragma region Helper Functions
+// Gathers values into a new order, order[i] is the old index of the value that ends up at i
+template <typename T>
+static void Permute(std::vector<T>& values, const std::vector<uint32_t>& order)
+{
+	std::vector<T> sorted;
+	sorted.reserve(order.size());
+
+	for (uint32_t oldIndex : order)
+	{
+		sorted.push_back(values[oldIndex]);
+	}
+
+	values.swap(sorted);
+}
+#pragma endregion
+
+#pragma region Handle Methods
+uint32_t TransformStore::Allocate(const XMFLOAT3& position, const XMFLOAT3& rotation, const XMFLOAT3& scale)
+{
+	uint32_t handle;
+
+	if (!m_freeHandles.empty())
+	{
+		handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+	}
+	else
+	{
+		handle = static_cast<uint32_t>(m_handleToIndex.size());
+		m_handleToIndex.push_back(InvalidTransform);
+	}
+
+	// A new root at the end of the arrays keeps the depth first order valid
+	uint32_t index = static_cast<uint32_t>(m_positions.size());
+	m_handleToIndex[handle] = index;
+
+	m_positions.push_back(position);
+	m_rotations.push_back(rotation);
+	m_scales.push_back(scale);
+	m_worldMatrices.emplace_back();
+	m_worldMatricesTransposed.emplace_back();
+	m_parents.push_back(InvalidTransform);
+	m_subtreeSizes.push_back(1);
+	m_indexToHandle.push_back(handle);
+	m_dirty.push_back(0);
+
+	// Build the matrices straight away, so the transform is valid before the first update
+	ComputeWorldMatrix(index);
+
+	return handle;
+}
+
+void TransformStore::Free(uint32_t handle)
+{
+	uint32_t index = m_handleToIndex[handle];
+
+	// A freed transform must not be rebuilt by a pending update
+	ClearDirty(handle);
+
+	// Children keep their local transform, which now places them relative to the world
+	MarkChildrenDirty(index, true);
+
+	// The slot is dropped when the order is rebuilt
+	m_indexToHandle[index] = InvalidTransform;
+	m_handleToIndex[handle] = InvalidTransform;
+	m_freeHandles.push_back(handle);
+	m_hierarchyChanged = true;
+}
+
+bool TransformStore::SetParent(uint32_t handle, uint32_t parentHandle)
+{
+	uint32_t index = m_handleToIndex[handle];
+	uint32_t parentIndex = parentHandle == InvalidTransform ? InvalidTransform : m_handleToIndex[parentHandle];
+
+	// Walk up from the new parent, meeting the transform on the way would make a cycle
+	for (uint32_t ancestor = parentIndex; ancestor != InvalidTransform; ancestor = m_parents[ancestor])
+	{
+		if (ancestor == index)
+		{
+			return false;
+		}
+	}
+
+	if (m_parents[index] == parentIndex)
+	{
+		return true;
+	}
+
+	m_parents[index] = parentIndex;
+	m_hierarchyChanged = true;
+	MarkDirty(handle);
+
+	return true;
+}
+#pragma endregion
+
+#pragma region Update Methods
+uint32_t TransformStore::UpdateDirtyTransforms()
+{
+	PROFILE_FUNCTION();
+
+	if (m_hierarchyChanged)
+	{
+		RebuildOrder();
+	}
+
+	if (m_dirtyHandles.empty())
+	{
+		return 0;
+	}
+
+	// Sorted dirty indices collapse into disjoint subtrees, a dirty node inside an earlier dirty subtree is covered by it
+	m_dirtyRoots.clear();
+	for (uint32_t handle : m_dirtyHandles)
+	{
+		m_dirtyRoots.push_back(m_handleToIndex[handle]);
+	}
+	std::sort(m_dirtyRoots.begin(), m_dirtyRoots.end());
+
+	uint32_t rangeEnd = 0;
+	uint32_t updateCount = 0;
+	auto root = m_dirtyRoots.begin();
+	for (uint32_t index : m_dirtyRoots)
+	{
+		if (index < rangeEnd)
+		{
+			continue;
+		}
+
+		*root++ = index;
+		rangeEnd = index + m_subtreeSizes[index];
+		updateCount += m_subtreeSizes[index];
+	}
+	m_dirtyRoots.erase(root, m_dirtyRoots.end());
+
+	// Parents come first inside a subtree, so each one is a single forward pass
+	auto updateSubtree = [this](uint32_t subtreeRoot)
+	{
+		for (uint32_t i = subtreeRoot; i < subtreeRoot + m_subtreeSizes[subtreeRoot]; i++)
+		{
+			ComputeWorldMatrix(i);
+		}
+	};
+
+	if (updateCount < ParallelThreshold || m_dirtyRoots.size() < 2)
+	{
+		for (uint32_t subtreeRoot : m_dirtyRoots)
+		{
+			updateSubtree(subtreeRoot);
+		}
+	}
+	else
+	{
+		// The subtrees never overlap, so they can run without locking
+		ParallelFor(size_t(0), m_dirtyRoots.size(), [&](size_t i)
+		{
+			updateSubtree(m_dirtyRoots[i]);
+		});
+	}
+
+	for (uint32_t handle : m_dirtyHandles)
+	{
+		m_dirty[m_handleToIndex[handle]] = 0;
+	}
+	m_dirtyHandles.clear();
+
+	return updateCount;
+}
+#pragma endregion
+
+#pragma region Setters
+void TransformStore::SetPosition(uint32_t handle, const XMFLOAT3& position)
+{
+	m_positions[m_handleToIndex[handle]] = position;
+	MarkDirty(handle);
+}
+
+void TransformStore::SetRotation(uint32_t handle, const XMFLOAT3& rotation)
+{
+	m_rotations[m_handleToIndex[handle]] = rotation;
+	MarkDirty(handle);
+}
+
+void TransformStore::SetScale(uint32_t handle, const XMFLOAT3& scale)
+{
+	m_scales[m_handleToIndex[handle]] = scale;
+	MarkDirty(handle);
+}
+
+void TransformStore::SetWorldMatrix(uint32_t handle, FXMMATRIX worldMatrix)
+{
+	uint32_t index = m_handleToIndex[handle];
+
+	XMStoreFloat4x4(&m_worldMatrices[index], worldMatrix);
+	XMStoreFloat4x4(&m_worldMatricesTransposed[index], XMMatrixTranspose(worldMatrix));
+
+	// A local change made before the override would otherwise be rebuilt over it on the next update
+	ClearDirty(handle);
+
+	// The children have to follow the new matrix
+	MarkChildrenDirty(index, false);
+}
+#pragma endregion
+
+#pragma region Getters
+uint32_t TransformStore::GetParent(uint32_t handle) const
+{
+	uint32_t parentIndex = m_parents[m_handleToIndex[handle]];
+
+	return parentIndex == InvalidTransform ? InvalidTransform : m_indexToHandle[parentIndex];
+}
+#pragma endregion
+
+#pragma region Private Methods
+void TransformStore::MarkDirty(uint32_t handle)
+{
+	uint32_t index = m_handleToIndex[handle];
+
+	if (!m_dirty[index])
+	{
+		m_dirty[index] = 1;
+		m_dirtyHandles.push_back(handle);
+	}
+}
+
+void TransformStore::ClearDirty(uint32_t handle)
+{
+	uint32_t index = m_handleToIndex[handle];
+
+	if (m_dirty[index])
+	{
+		m_dirtyHandles.erase(std::find(m_dirtyHandles.begin(), m_dirtyHandles.end(), handle));
+		m_dirty[index] = 0;
+	}
+}
+
+void TransformStore::MarkChildrenDirty(uint32_t index, bool detach)
+{
+	// The subtree range is only trustworthy while the order is up to date, otherwise search everything
+	uint32_t first = m_hierarchyChanged ? 0 : index + 1;
+	uint32_t last = m_hierarchyChanged ? static_cast<uint32_t>(m_parents.size()) : index + m_subtreeSizes[index];
+
+	for (uint32_t i = first; i < last; i++)
+	{
+		if (m_parents[i] == index && m_indexToHandle[i] != InvalidTransform)
+		{
+			if (detach)
+			{
+				m_parents[i] = InvalidTransform;
+			}
+
+			MarkDirty(m_indexToHandle[i]);
+		}
+	}
+}
+
+void TransformStore::RebuildOrder()
+{
+	const uint32_t count = static_cast<uint32_t>(m_positions.size());
+
+	// Children of every node, in their current order
+	std::vector<std::vector<uint32_t>> children(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (m_indexToHandle[i] != InvalidTransform && m_parents[i] != InvalidTransform)
+		{
+			children[m_parents[i]].push_back(i);
+		}
+	}
+
+	// Depth first walk from every live root
+	std::vector<uint32_t> order;
+	order.reserve(count);
+	std::vector<uint32_t> stack;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (m_indexToHandle[i] == InvalidTransform || m_parents[i] != InvalidTransform)
+		{
+			continue;
+		}
+
+		stack.push_back(i);
+		while (!stack.empty())
+		{
+			uint32_t node = stack.back();
+			stack.pop_back();
+			order.push_back(node);
+
+			// Pushed in reverse so the children come out in their original order
+			for (auto child = children[node].rbegin(); child != children[node].rend(); ++child)
+			{
+				stack.push_back(*child);
+			}
+		}
+	}
+
+	std::vector<uint32_t> newIndex(count, InvalidTransform);
+	for (uint32_t i = 0; i < static_cast<uint32_t>(order.size()); i++)
+	{
+		newIndex[order[i]] = i;
+	}
+
+	Permute(m_positions, order);
+	Permute(m_rotations, order);
+	Permute(m_scales, order);
+	Permute(m_worldMatrices, order);
+	Permute(m_worldMatricesTransposed, order);
+	Permute(m_parents, order);
+	Permute(m_indexToHandle, order);
+	Permute(m_dirty, order);
+
+	const uint32_t liveCount = static_cast<uint32_t>(order.size());
+	m_subtreeSizes.assign(liveCount, 1);
+
+	for (uint32_t i = 0; i < liveCount; i++)
+	{
+		if (m_parents[i] != InvalidTransform)
+		{
+			m_parents[i] = newIndex[m_parents[i]];
+		}
+
+		m_handleToIndex[m_indexToHandle[i]] = i;
+	}
+
+	// Children come after their parents, so walking backwards adds every subtree into its parent once it is complete
+	for (uint32_t i = liveCount; i-- > 0;)
+	{
+		if (m_parents[i] != InvalidTransform)
+		{
+			m_subtreeSizes[m_parents[i]] += m_subtreeSizes[i];
+		}
+	}
+
+	m_hierarchyChanged = false;
+}
+
+void TransformStore::ComputeWorldMatrix(uint32_t index)
+{
+	const XMFLOAT3& position = m_positions[index];
+	const XMFLOAT3& scale = m_scales[index];
+
+	// All three angles go through one vector sin/cos
+	XMVECTOR sines;
+	XMVECTOR cosines;
+	XMVectorSinCos(&sines, &cosines, XMLoadFloat3(&m_rotations[index]));
+
+	XMFLOAT3 sine;
+	XMFLOAT3 cosine;
+	XMStoreFloat3(&sine, sines);
+	XMStoreFloat3(&cosine, cosines);
+
+	// Scaling * RotationX * RotationY * RotationZ * Translation, multiplied out by hand
+	XMMATRIX world;
+	world.r[0] = XMVectorScale(XMVectorSet(cosine.y * cosine.z, cosine.y * sine.z, -sine.y, 0.0f), scale.x);
+	world.r[1] = XMVectorScale(XMVectorSet(
+		sine.x * sine.y * cosine.z - cosine.x * sine.z,
+		sine.x * sine.y * sine.z + cosine.x * cosine.z,
+		sine.x * cosine.y, 0.0f), scale.y);
+	world.r[2] = XMVectorScale(XMVectorSet(
+		cosine.x * sine.y * cosine.z + sine.x * sine.z,
+		cosine.x * sine.y * sine.z - sine.x * cosine.z,
+		cosine.x * cosine.y, 0.0f), scale.z);
+	world.r[3] = XMVectorSet(position.x, position.y, position.z, 1.0f);
+
+	// Children are placed relative to their parent, which is always up to date by the time they are reached
+	if (m_parents[index] != InvalidTransform)
+	{
+		world = world * XMLoadFloat4x4(&m_worldMatrices[m_parents[index]]);
+	}
+
+	XMStoreFloat4x4(&m_worldMatrices[index], world);
+	XMStoreFloat4x4(&m_worldMatricesTransposed[index], XMMatrixTranspose(world));
+}
+#pragma endregion
\ No newline at end of file
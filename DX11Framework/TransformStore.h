@@ -0,0 +1,148 @@
+#pragma once
+
+// Include{s}
+// Only the standard library and DirectXMath, so the store builds and is tested without D3D or Windows
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// Handle (and parent) value meaning "no transform"
+constexpr uint32_t InvalidTransform = 0xFFFFFFFF;
+
+class TransformStore
+{
+public:
+#pragma region Singleton
+	// Only allow one instance of the TransformStore
+	// Singleton Pattern
+	TransformStore(const TransformStore&) = delete;
+	TransformStore& operator=(const TransformStore&) = delete;
+
+	// Get the instance of the TransformStore
+	// Returns TransformStore* - The instance of the TransformStore
+	static TransformStore* GetInstance()
+	{
+		static TransformStore instance;
+		return &instance;
+	}
+#pragma endregion
+
+#pragma region Handle Methods
+	// Adds a root transform to the store, its world matrix is valid straight away
+	// Returns uint32_t - The handle used to access the transform
+	uint32_t Allocate(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& rotation,
+		const DirectX::XMFLOAT3& scale);
+
+	// Returns a transform to the store so its handle can be reused, its children become roots
+	void Free(uint32_t handle);
+
+	// Attaches a transform to a parent (or detaches it with InvalidTransform), its position, rotation and scale become
+	// relative to the parent
+	// Returns bool - False if the parent is the transform itself or one of its descendants
+	bool SetParent(uint32_t handle, uint32_t parentHandle);
+#pragma endregion
+
+#pragma region Update Methods
+	// Re-sorts the hierarchy if it changed, then rebuilds the world matrices of every dirty subtree in one pass
+	// Returns uint32_t - The number of world matrices rebuilt
+	uint32_t UpdateDirtyTransforms();
+#pragma endregion
+
+#pragma region Setters
+	// Sets the local position of a transform and marks it dirty
+	void SetPosition(uint32_t handle, const DirectX::XMFLOAT3& position);
+
+	// Sets the local rotation (radians about X, then Y, then Z) of a transform and marks it dirty
+	void SetRotation(uint32_t handle, const DirectX::XMFLOAT3& rotation);
+
+	// Sets the local scale of a transform and marks it dirty
+	void SetScale(uint32_t handle, const DirectX::XMFLOAT3& scale);
+
+	// Overrides the world matrix of a transform directly, it stays until the position, rotation or scale change
+	void SetWorldMatrix(uint32_t handle, DirectX::FXMMATRIX worldMatrix);
+#pragma endregion
+
+#pragma region Getters
+	// Gets the local position of a transform
+	// Returns XMFLOAT3 - The position
+	const DirectX::XMFLOAT3& GetPosition(uint32_t handle) const { return m_positions[m_handleToIndex[handle]]; }
+
+	// Gets the local rotation of a transform
+	// Returns XMFLOAT3 - The rotation
+	const DirectX::XMFLOAT3& GetRotation(uint32_t handle) const { return m_rotations[m_handleToIndex[handle]]; }
+
+	// Gets the local scale of a transform
+	// Returns XMFLOAT3 - The scale
+	const DirectX::XMFLOAT3& GetScale(uint32_t handle) const { return m_scales[m_handleToIndex[handle]]; }
+
+	// Gets the parent of a transform
+	// Returns uint32_t - The parent handle, InvalidTransform for roots
+	uint32_t GetParent(uint32_t handle) const;
+
+	// Gets the cached world matrix of a transform (untransposed)
+	// Returns XMFLOAT4X4 - The world matrix as of the last update
+	const DirectX::XMFLOAT4X4& GetWorldMatrix(uint32_t handle) const
+	{
+		return m_worldMatrices[m_handleToIndex[handle]];
+	}
+
+	// Gets the cached world matrix of a transform, already transposed for the constant buffer
+	// Returns XMFLOAT4X4 - The transposed world matrix as of the last update
+	const DirectX::XMFLOAT4X4& GetWorldMatrixTransposed(uint32_t handle) const
+	{
+		return m_worldMatricesTransposed[m_handleToIndex[handle]];
+	}
+
+	// Gets the number of transforms waiting for an update
+	// Returns uint32_t - The dirty transform count
+	uint32_t GetDirtyCount() const { return static_cast<uint32_t>(m_dirtyHandles.size()); }
+#pragma endregion
+
+private:
+#pragma region Constructor
+	// Default constructor
+	TransformStore() = default;
+#pragma endregion
+
+#pragma region Private Methods
+	// Adds a transform to the dirty list, once
+	void MarkDirty(uint32_t handle);
+
+	// Takes a transform off the dirty list, if it is on it
+	void ClearDirty(uint32_t handle);
+
+	// Marks the direct children of a node dirty, optionally turning them into roots
+	void MarkChildrenDirty(uint32_t index, bool detach);
+
+	// Re-sorts the arrays depth first, dropping freed slots and recomputing the subtree sizes
+	void RebuildOrder();
+
+	// Builds the world and transposed world matrices of one node from its local transform and its parent
+	void ComputeWorldMatrix(uint32_t index);
+#pragma endregion
+
+#pragma region Member Variables
+	// Each component lives in its own array, sorted depth first so parents always come before their children
+	// and every subtree is one contiguous range
+	std::vector<DirectX::XMFLOAT3> m_positions;
+	std::vector<DirectX::XMFLOAT3> m_rotations;
+	std::vector<DirectX::XMFLOAT3> m_scales;
+	std::vector<DirectX::XMFLOAT4X4> m_worldMatrices;
+	std::vector<DirectX::XMFLOAT4X4> m_worldMatricesTransposed;
+	std::vector<uint32_t> m_parents;
+	std::vector<uint32_t> m_subtreeSizes;
+	std::vector<uint32_t> m_indexToHandle;
+	std::vector<uint8_t> m_dirty;
+
+	// Handles stay the same when the arrays are re-sorted, this table maps them to the current index
+	std::vector<uint32_t> m_handleToIndex;
+	std::vector<uint32_t> m_freeHandles;
+
+	// Handles changed since the last update, and the subtree roots built from them
+	std::vector<uint32_t> m_dirtyHandles;
+	std::vector<uint32_t> m_dirtyRoots;
+
+	// Set when parents change or transforms are freed, the order is rebuilt on the next update
+	bool m_hierarchyChanged = false;
+#pragma endregion
+};
@@ -0,0 +1,90 @@
+// Include{s}
+#include "TestFramework.h"
+#include "Benchmark.h"
+#include "SceneBVH.h"
+#include <random>
+
+using namespace DirectX;
+
+// Headless run of a benchmark script, for machines with no window or GPU. The camera flies the scripted path at the
+// script's fixed timestep over a field of boxes, the update evaluates the path and builds the frustum the way the
+// debug camera does and the draw is the BVH query that picks what would be drawn. The per-frame timings and their
+// percentiles are written like the app's --benchmark run: BenchmarkFlythrough [--smoke] [script]
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const int scriptArgument = smoke ? 2 : 1;
+	const std::string scriptPath = argc > scriptArgument ? argv[scriptArgument] : DEFAULT_BENCHMARK_SCRIPT;
+
+	BenchmarkScript script;
+	if (!LoadBenchmarkScript(scriptPath, script))
+	{
+		return 1;
+	}
+	const size_t frames = smoke ? (std::min)(script.Frames, size_t(20)) : script.Frames;
+
+	// A 40 x 40 unit field of boxes around the origin, the area the scene and its flythrough cover
+	std::mt19937 random(37);
+	std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> size(0.1f, 1.0f);
+	std::vector<XMFLOAT3> centers(smoke ? 1000 : 100000);
+	std::vector<XMFLOAT3> extents(centers.size());
+	for (size_t i = 0; i < centers.size(); i++)
+	{
+		centers[i].x = position(random);
+		centers[i].y = position(random) * 0.25f;
+		centers[i].z = position(random);
+		extents[i] = XMFLOAT3(size(random), size(random), size(random));
+	}
+
+	SceneBVH bvh;
+	bvh.Build(centers, extents);
+
+	BenchmarkRecorder recorder;
+	FrustumCuller frustum;
+	std::vector<uint32_t> visible;
+	size_t totalVisible = 0;
+	const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 100.0f);
+
+	for (size_t frame = 0; frame < frames; frame++)
+	{
+		recorder.BeginFrame();
+
+		XMFLOAT3 pathPosition;
+		XMFLOAT3 pathRotation;
+		script.Path.Evaluate(frame * script.Timestep, pathPosition, pathRotation);
+
+		XMMATRIX rotation = XMMatrixRotationRollPitchYaw(pathRotation.x, pathRotation.y, pathRotation.z);
+		XMVECTOR eye = XMLoadFloat3(&pathPosition);
+		XMVECTOR target = eye + XMVector3TransformCoord(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), rotation);
+		XMVECTOR up = XMVector3TransformCoord(XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f), rotation);
+		frustum.ExtractPlanes(XMMatrixMultiply(XMMatrixLookAtLH(eye, target, up), projection));
+
+		recorder.EndUpdate();
+
+		bvh.QueryFrustum(frustum, visible);
+		totalVisible += visible.size();
+
+		recorder.EndFrame();
+	}
+
+	if (!recorder.WriteCSV("benchmark_frames.csv") || !recorder.WriteJSON("benchmark_summary.json", script))
+	{
+		return 1;
+	}
+
+	const BenchmarkSummary summary = recorder.GetFrameSummary();
+	printf("%s, %zu frames over %zu boxes\n", script.Name.c_str(), frames, centers.size());
+	printf("%10s %10s %10s %10s %10s %10s\n", "Min ms", "Avg ms", "P50 ms", "P95 ms", "P99 ms", "Max ms");
+	printf("%10.4f %10.4f %10.4f %10.4f %10.4f %10.4f\n", summary.Min, summary.Average, summary.P50, summary.P95,
+		summary.P99, summary.Max);
+
+	// A path that never sees the field is timing nothing
+	if (totalVisible == 0)
+	{
+		printf("The camera path never saw a box\n");
+		return 1;
+	}
+
+	return 0;
+}
\ No newline at end of file
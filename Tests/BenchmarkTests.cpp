@@ -0,0 +1,254 @@
+// Include{s}
+#include "TestFramework.h"
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace DirectX;
+
+#pragma region Helper Functions
+// Writes a vector as { x, y, z }
+static nlohmann::json VectorToJSON(const XMFLOAT3& vector)
+{
+	return nlohmann::json{ { "x", vector.x }, { "y", vector.y }, { "z", vector.z } };
+}
+
+// Builds a keyframe array for CameraPath::LoadFromJSON
+static nlohmann::json CreateKeyframes(const std::vector<BenchmarkKeyframe>& keyframes)
+{
+	nlohmann::json array = nlohmann::json::array();
+	for (const BenchmarkKeyframe& keyframe : keyframes)
+	{
+		array.push_back({ { "time", keyframe.Time }, { "position", VectorToJSON(keyframe.Position) },
+			{ "rotation", VectorToJSON(keyframe.Rotation) } });
+	}
+
+	return array;
+}
+
+// Uneven times and a path that doubles back, so a segment or weight mix up shows
+static std::vector<BenchmarkKeyframe> CreateTestKeyframes()
+{
+	return {
+		{ 0.0f, XMFLOAT3(0.0f, 1.0f, -14.0f), XMFLOAT3(0.0f, 0.0f, 0.0f) },
+		{ 1.5f, XMFLOAT3(12.0f, 4.0f, -8.0f), XMFLOAT3(0.2f, -0.8f, 0.0f) },
+		{ 4.0f, XMFLOAT3(14.0f, 6.0f, 10.0f), XMFLOAT3(0.3f, -2.2f, 0.1f) },
+		{ 5.0f, XMFLOAT3(-10.0f, 5.0f, 12.0f), XMFLOAT3(0.25f, 2.5f, 0.0f) },
+		{ 9.0f, XMFLOAT3(-3.0f, 2.0f, -6.0f), XMFLOAT3(-0.1f, 0.4f, -0.2f) }
+	};
+}
+
+// Written out from the Catmull-Rom definition, one component at a time
+static float ReferenceCatmullRom(float p0, float p1, float p2, float p3, float t)
+{
+	return 0.5f * (2.0f * p1 + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t * t +
+		(3.0f * p1 - p0 - 3.0f * p2 + p3) * t * t * t);
+}
+
+// Reads a whole file
+static std::string ReadFile(const std::string& path)
+{
+	std::ifstream file(path);
+	std::stringstream contents;
+	contents << file.rdbuf();
+
+	return contents.str();
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(SummaryUsesTheNearestRank)
+{
+	// 1 to 100 out of order
+	std::vector<double> timings;
+	for (int i = 0; i < 100; i++)
+	{
+		timings.push_back(1.0 + (i * 37) % 100);
+	}
+
+	BenchmarkSummary summary = BenchmarkRecorder::Summarise(timings);
+	CHECK_EQUAL(1.0, summary.Min);
+	CHECK_NEAR(50.5, summary.Average, 1e-9);
+	CHECK_EQUAL(50.0, summary.P50);
+	CHECK_EQUAL(95.0, summary.P95);
+	CHECK_EQUAL(99.0, summary.P99);
+	CHECK_EQUAL(100.0, summary.Max);
+
+	// Ten frames, P95 and P99 both land on the slowest
+	summary = BenchmarkRecorder::Summarise({ 4.0, 1.0, 9.0, 3.0, 7.0, 2.0, 10.0, 5.0, 8.0, 6.0 });
+	CHECK_EQUAL(5.0, summary.P50);
+	CHECK_EQUAL(10.0, summary.P95);
+	CHECK_EQUAL(10.0, summary.P99);
+
+	summary = BenchmarkRecorder::Summarise({ 3.5 });
+	CHECK(summary.Min == 3.5 && summary.P50 == 3.5 && summary.P99 == 3.5 && summary.Max == 3.5);
+
+	summary = BenchmarkRecorder::Summarise({});
+	CHECK(summary.Min == 0.0 && summary.Average == 0.0 && summary.P95 == 0.0 && summary.Max == 0.0);
+}
+
+TEST_CASE(PathPassesThroughEveryKeyframe)
+{
+	CameraPath path;
+	const std::vector<BenchmarkKeyframe> keyframes = CreateTestKeyframes();
+	CHECK(path.LoadFromJSON(CreateKeyframes(keyframes)));
+	CHECK_EQUAL(keyframes.size(), path.GetKeyframes().size());
+	CHECK_EQUAL(9.0f, path.GetDuration());
+
+	for (const BenchmarkKeyframe& keyframe : keyframes)
+	{
+		XMFLOAT3 position;
+		XMFLOAT3 rotation;
+		path.Evaluate(keyframe.Time, position, rotation);
+
+		CHECK_NEAR(keyframe.Position.x, position.x, 1e-4f);
+		CHECK_NEAR(keyframe.Position.y, position.y, 1e-4f);
+		CHECK_NEAR(keyframe.Position.z, position.z, 1e-4f);
+		CHECK_NEAR(keyframe.Rotation.y, rotation.y, 1e-5f);
+	}
+
+	// Held at the end points outside the path
+	XMFLOAT3 position;
+	XMFLOAT3 rotation;
+	path.Evaluate(-3.0f, position, rotation);
+	CHECK(position.x == 0.0f && position.z == -14.0f);
+	path.Evaluate(100.0f, position, rotation);
+	CHECK(position.x == -3.0f && position.z == -6.0f && rotation.z == -0.2f);
+}
+
+TEST_CASE(PathMatchesTheCatmullRomFormula)
+{
+	CameraPath path;
+	const std::vector<BenchmarkKeyframe> keyframes = CreateTestKeyframes();
+	CHECK(path.LoadFromJSON(CreateKeyframes(keyframes)));
+
+	const size_t last = keyframes.size() - 1;
+	for (size_t segment = 0; segment < last; segment++)
+	{
+		// The end keyframes stand in for the neighbours the first and last segments do not have
+		const BenchmarkKeyframe& before = keyframes[segment > 0 ? segment - 1 : 0];
+		const BenchmarkKeyframe& from = keyframes[segment];
+		const BenchmarkKeyframe& to = keyframes[segment + 1];
+		const BenchmarkKeyframe& after = keyframes[segment + 2 <= last ? segment + 2 : last];
+
+		for (int step = 1; step < 8; step++)
+		{
+			float t = step / 8.0f;
+			XMFLOAT3 position;
+			XMFLOAT3 rotation;
+			path.Evaluate(from.Time + t * (to.Time - from.Time), position, rotation);
+
+			CHECK_NEAR(ReferenceCatmullRom(before.Position.x, from.Position.x, to.Position.x, after.Position.x, t),
+				position.x, 1e-3f);
+			CHECK_NEAR(ReferenceCatmullRom(before.Position.y, from.Position.y, to.Position.y, after.Position.y, t),
+				position.y, 1e-3f);
+			CHECK_NEAR(ReferenceCatmullRom(before.Position.z, from.Position.z, to.Position.z, after.Position.z, t),
+				position.z, 1e-3f);
+			CHECK_NEAR(ReferenceCatmullRom(before.Rotation.y, from.Rotation.y, to.Rotation.y, after.Rotation.y, t),
+				rotation.y, 1e-4f);
+		}
+	}
+
+	// Evenly spaced keyframes on a line give a path moving along it at a constant speed
+	CHECK(path.LoadFromJSON(CreateKeyframes({
+		{ 0.0f, XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3() }, { 1.0f, XMFLOAT3(2.0f, 0.0f, 0.0f), XMFLOAT3() },
+		{ 2.0f, XMFLOAT3(4.0f, 0.0f, 0.0f), XMFLOAT3() }, { 3.0f, XMFLOAT3(6.0f, 0.0f, 0.0f), XMFLOAT3() } })));
+	XMFLOAT3 position;
+	XMFLOAT3 rotation;
+	path.Evaluate(1.25f, position, rotation);
+	CHECK_NEAR(2.5f, position.x, 1e-5f);
+}
+
+TEST_CASE(KeyframesMustBeInOrder)
+{
+	CameraPath path;
+	CHECK(!path.LoadFromJSON(nlohmann::json::array()));
+	CHECK(!path.LoadFromJSON(nlohmann::json::object()));
+
+	std::vector<BenchmarkKeyframe> keyframes = CreateTestKeyframes();
+	keyframes[2].Time = keyframes[1].Time;
+	CHECK(!path.LoadFromJSON(CreateKeyframes(keyframes)));
+	CHECK(path.GetKeyframes().empty());
+	CHECK_EQUAL(0.0f, path.GetDuration());
+
+	// A single keyframe is a camera that stays still
+	CHECK(path.LoadFromJSON(CreateKeyframes({ keyframes[3] })));
+	XMFLOAT3 position;
+	XMFLOAT3 rotation;
+	path.Evaluate(2.0f, position, rotation);
+	CHECK(position.x == -10.0f && rotation.y == 2.5f);
+}
+
+TEST_CASE(ScriptsNeedFramesATimestepAndKeyframes)
+{
+	const std::string path = "BenchmarkTests_script.json";
+	BenchmarkScript script;
+
+	std::ofstream(path) << nlohmann::json{ { "name", "Test" }, { "frames", 30 }, { "timestep", 0.5 },
+		{ "keyframes", CreateKeyframes(CreateTestKeyframes()) } }.dump();
+	CHECK(LoadBenchmarkScript(path, script));
+	CHECK(script.Name == "Test");
+	CHECK_EQUAL(size_t(30), script.Frames);
+	CHECK_EQUAL(0.5f, script.Timestep);
+	CHECK_EQUAL(1u, script.Views);
+	CHECK_EQUAL(size_t(5), script.Path.GetKeyframes().size());
+
+	std::ofstream(path) << nlohmann::json{ { "frames", 0 }, { "keyframes", CreateKeyframes(CreateTestKeyframes()) } }
+		.dump();
+	CHECK(!LoadBenchmarkScript(path, script));
+
+	std::ofstream(path) << "{ \"frames\": ";
+	CHECK(!LoadBenchmarkScript(path, script));
+
+	std::remove(path.c_str());
+	CHECK(!LoadBenchmarkScript(path, script));
+}
+
+TEST_CASE(RecorderWritesEveryFrameAndTheSummaries)
+{
+	BenchmarkRecorder recorder;
+	for (int i = 1; i <= 20; i++)
+	{
+		recorder.AddFrame(i * 0.5, 1.0);
+	}
+
+	// A frame timed for real still splits into update and draw
+	recorder.BeginFrame();
+	recorder.EndUpdate();
+	recorder.EndFrame();
+
+	const BenchmarkFrame& timed = recorder.GetFrames().back();
+	CHECK_EQUAL(size_t(20), timed.Frame);
+	CHECK(timed.UpdateMs >= 0.0 && timed.DrawMs >= 0.0);
+	CHECK_NEAR(timed.UpdateMs + timed.DrawMs, timed.FrameMs, 1e-9);
+
+	const std::string csvPath = "BenchmarkTests_frames.csv";
+	CHECK(recorder.WriteCSV(csvPath));
+	std::string csv = ReadFile(csvPath);
+	std::remove(csvPath.c_str());
+	CHECK_EQUAL(size_t(22), static_cast<size_t>(std::count(csv.begin(), csv.end(), '\n')));
+	CHECK(csv.find("frame,update_ms,draw_ms,frame_ms\n0,0.5000,1.0000,1.5000\n") == 0);
+
+	BenchmarkScript script;
+	script.Name = "Recorder";
+	script.Frames = 21;
+	script.Timestep = 0.25f;
+	script.Views = 4;
+
+	const std::string jsonPath = "BenchmarkTests_summary.json";
+	CHECK(recorder.WriteJSON(jsonPath, script));
+	nlohmann::json report = nlohmann::json::parse(ReadFile(jsonPath), nullptr, false);
+	std::remove(jsonPath.c_str());
+	CHECK(!report.is_discarded());
+	CHECK(report.value("name", "") == "Recorder");
+	CHECK_EQUAL(21, report.value("frames", 0));
+	CHECK_EQUAL(4, report.value("views", 0));
+	CHECK_EQUAL(10.0, report["updateMs"].value("max", 0.0));
+	CHECK_EQUAL(1.0, report["drawMs"].value("p50", 0.0));
+
+	// The timed frame is the quickest, so the median moves up one
+	CHECK_EQUAL(6.0, report["frameMs"].value("p50", 0.0));
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Include{s}
+#include "TestFramework.h"
+#include "Camera.h"
+
+using namespace DirectX;
+
+// Moves a camera the way a frame of debug flying does, one setter per step. An eager camera rebuilds after every
+// setter, which is what each setter used to do, a lazy one only rebuilds when the matrices are next read
+static void MoveCamera(Camera& camera, int frame, int setters, bool eager)
+{
+	for (int setter = 0; setter < setters; setter++)
+	{
+		if (setter % 2 == 0)
+		{
+			camera.AddToPosition(0.01f, 0.0f, 0.02f);
+		}
+		else
+		{
+			camera.AddToRotation(0.0f, 0.001f * static_cast<float>(frame % 7), 0.0f);
+		}
+
+		if (eager)
+		{
+			camera.GetForwardVector();
+			camera.GetShaderMatrices();
+		}
+	}
+}
+
+// Times frames of 1, 4 and 16 setters on every scene camera, each followed by the reads a frame makes of the
+// shader matrices and frustum planes, rebuilding after every setter against rebuilding once on the first read
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const int setterCounts[] = { 1, 4, 16 };
+	const int frames = smoke ? 20 : 20000;
+	const int cameraCount = 10;
+
+	// Culling, the views and the terrain each read the matrices again after the moves
+	const int readsPerFrame = 3;
+
+	printf("%10s %12s %12s %10s\n", "Setters", "Eager ms", "Lazy ms", "Speedup");
+
+	for (int setters : setterCounts)
+	{
+		std::vector<Camera> eagerCameras(cameraCount);
+		std::vector<Camera> lazyCameras(cameraCount);
+		float checksum[2] = { 0.0f, 0.0f };
+
+		// Times every frame on one set of cameras
+		auto timeFrames = [&](std::vector<Camera>& cameras, bool eager, float& sum)
+		{
+			BenchmarkTimer timer;
+			for (int frame = 0; frame < frames; frame++)
+			{
+				for (Camera& camera : cameras)
+				{
+					MoveCamera(camera, frame, setters, eager);
+
+					for (int read = 0; read < readsPerFrame; read++)
+					{
+						sum += camera.GetFrustumPlanes()[4].w;
+						XMFLOAT4X4 viewProjection;
+						XMStoreFloat4x4(&viewProjection, camera.GetShaderMatrices().ViewProjection);
+						sum += viewProjection._44;
+					}
+				}
+			}
+
+			return timer.GetElapsedMilliseconds() / frames;
+		};
+
+		double eagerMs = timeFrames(eagerCameras, true, checksum[0]);
+		double lazyMs = timeFrames(lazyCameras, false, checksum[1]);
+
+		printf("%10d %12.4f %12.4f %9.2fx\n", setters, eagerMs, lazyMs, eagerMs / lazyMs);
+
+		// Both ways have to end up at the same matrices
+		XMFLOAT4X4 eagerMatrix;
+		XMFLOAT4X4 lazyMatrix;
+		XMStoreFloat4x4(&eagerMatrix, eagerCameras.back().GetShaderMatrices().View);
+		XMStoreFloat4x4(&lazyMatrix, lazyCameras.back().GetShaderMatrices().View);
+		if (memcmp(&eagerMatrix, &lazyMatrix, sizeof(eagerMatrix)) != 0 || checksum[0] != checksum[1])
+		{
+			printf("The eager and lazy cameras disagree\n");
+			return 1;
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
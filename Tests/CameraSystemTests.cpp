@@ -0,0 +1,136 @@
+// Include{s}
+#include "TestFramework.h"
+#include "CameraSystem.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+
+#pragma region Helper Functions
+// Builds a camera entry at a position, the hotkey and label are only written when given
+static nlohmann::json MakeCamera(float x, float y, float z, int hotkey, const char* label)
+{
+	nlohmann::json camera;
+	camera["Position"] = { { "x", x }, { "y", y }, { "z", z } };
+	camera["Rotation"] = { { "x", 0.0f }, { "y", x * 0.01f }, { "z", 0.0f } };
+	camera["ProjectionValues"] = { { "fov", 90.0f }, { "near", 0.01f }, { "far", 1000.0f } };
+
+	if (hotkey >= 0)
+	{
+		camera["Hotkey"] = hotkey;
+	}
+	if (label)
+	{
+		camera["Label"] = label;
+	}
+
+	return camera;
+}
+
+// Writes a scene whose camera names sort differently to their hotkeys, and loads it
+// Returns bool - True if the file was loaded
+static bool LoadScene(CameraSystem& cameras)
+{
+	nlohmann::json scene;
+	nlohmann::json& entries = scene["SceneCameraVariables"];
+	entries["DebugCamera"] = MakeCamera(0.0f, 1.0f, -14.0f, 0, "Debug Camera");
+	entries["Alpha"] = MakeCamera(30.0f, 2.0f, 0.0f, 3, "Third");
+	entries["Beta"] = MakeCamera(10.0f, 2.0f, 0.0f, 1, "First");
+	entries["Delta"] = MakeCamera(20.0f, 2.0f, 0.0f, 2, nullptr);
+	entries["Gamma"] = MakeCamera(40.0f, 2.0f, 0.0f, -1, "Unbound");
+
+	const std::string path = "CameraSystemTests_scene.json";
+	{
+		std::ofstream file(path);
+		file << scene.dump(2);
+	}
+
+	const bool loaded = cameras.LoadFromJSON(path, 16.0f / 9.0f);
+	std::remove(path.c_str());
+
+	return loaded;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(CamerasAreInHotkeyOrderAfterLoading)
+{
+	CameraSystem cameras;
+	CHECK(LoadScene(cameras));
+	CHECK_EQUAL(5u, cameras.GetCameraCount());
+
+	// The debug camera is always first, then the number keys in order, unbound cameras last
+	CHECK(strcmp(cameras.GetLabel(0), "Debug Camera") == 0);
+	CHECK(strcmp(cameras.GetLabel(1), "First") == 0);
+	CHECK(strcmp(cameras.GetLabel(2), "Delta") == 0);
+	CHECK(strcmp(cameras.GetLabel(3), "Third") == 0);
+	CHECK(strcmp(cameras.GetLabel(4), "Unbound") == 0);
+	CHECK_EQUAL(10.0f, cameras.GetCamera(1).GetPosition().x);
+	CHECK_EQUAL(20.0f, cameras.GetCamera(2).GetPosition().x);
+	CHECK_EQUAL(30.0f, cameras.GetCamera(3).GetPosition().x);
+
+	CHECK_EQUAL(0, cameras.FindByHotkey(0));
+	CHECK_EQUAL(2, cameras.FindByHotkey(2));
+	CHECK_EQUAL(-1, cameras.FindByHotkey(4));
+	CHECK_EQUAL(-1, cameras.FindByHotkey(-2));
+
+	CHECK(cameras.ActivateHotkey(3));
+	CHECK_EQUAL(3u, cameras.GetActiveIndex());
+	CHECK(!cameras.ActivateHotkey(7));
+	CHECK_EQUAL(3u, cameras.GetActiveIndex());
+}
+
+TEST_CASE(MissingFilesKeepTheDebugCamera)
+{
+	CameraSystem cameras;
+	CHECK(!cameras.LoadFromJSON("CameraSystemTests_missing.json", 1.0f));
+	CHECK_EQUAL(1u, cameras.GetCameraCount());
+	CHECK(cameras.IsDebugCameraActive());
+}
+
+TEST_CASE(CycleActiveWrapsAtEitherEnd)
+{
+	CameraSystem cameras;
+	CHECK(LoadScene(cameras));
+
+	cameras.CycleActive(-1);
+	CHECK_EQUAL(4u, cameras.GetActiveIndex());
+	cameras.CycleActive(1);
+	CHECK_EQUAL(0u, cameras.GetActiveIndex());
+	cameras.CycleActive(2);
+	CHECK_EQUAL(2u, cameras.GetActiveIndex());
+
+	// Steps longer than the list go round more than once
+	cameras.CycleActive(11);
+	CHECK_EQUAL(3u, cameras.GetActiveIndex());
+	cameras.CycleActive(-13);
+	CHECK_EQUAL(0u, cameras.GetActiveIndex());
+}
+
+TEST_CASE(SetActiveCopiesTheFixedCameraOnce)
+{
+	CameraSystem cameras;
+	CHECK(LoadScene(cameras));
+
+	cameras.SetActive(2);
+	CHECK_EQUAL(20.0f, cameras.GetDebugCamera().GetPosition().x);
+	CHECK_NEAR(0.2f, cameras.GetDebugCamera().GetRotation().y, 1e-6f);
+	CHECK(!cameras.IsDebugCameraActive());
+
+	// Selecting the same camera again does not copy over what the debug camera did since
+	cameras.GetDebugCamera().SetPosition(5.0f, 6.0f, 7.0f);
+	cameras.SetActive(2);
+	CHECK_EQUAL(5.0f, cameras.GetDebugCamera().GetPosition().x);
+
+	// Going back to the debug camera leaves it where it is, ready to fly off from
+	cameras.SetActive(0);
+	CHECK(cameras.IsDebugCameraActive());
+	CHECK_EQUAL(5.0f, cameras.GetDebugCamera().GetPosition().x);
+	CHECK_EQUAL(7.0f, cameras.GetDebugCamera().GetPosition().z);
+
+	// Out of range does nothing
+	cameras.SetActive(5);
+	CHECK(cameras.IsDebugCameraActive());
+
+	// The fixed camera itself never moved
+	CHECK_EQUAL(20.0f, cameras.GetCamera(2).GetPosition().x);
+}
+#pragma endregion
\ No newline at end of file
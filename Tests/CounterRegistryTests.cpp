@@ -0,0 +1,199 @@
+// Include{s}
+#include "TestFramework.h"
+#include "CounterRegistry.h"
+
+#pragma region Helper Functions
+// Fills a window with first, first + 1, ... in the order given by stride, so the samples do not arrive sorted
+static void AddSequence(RollingStats& stats, uint32_t count, float first, uint32_t stride)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		stats.Add(first + static_cast<float>(i * stride % count));
+	}
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(EmptyWindowReturnsZero)
+{
+	RollingStats stats(8);
+	uint32_t bins[4] = { 9, 9, 9, 9 };
+	stats.GetHistogram(0.0f, 1.0f, bins, 4);
+
+	CHECK_EQUAL(0u, stats.GetCount());
+	CHECK_EQUAL(0.0f, stats.GetMin());
+	CHECK_EQUAL(0.0f, stats.GetMax());
+	CHECK_EQUAL(0.0f, stats.GetAverage());
+	CHECK_EQUAL(0.0f, stats.GetPercentile(50.0f));
+	CHECK_EQUAL(0.0f, stats.GetSample(0));
+	CHECK_EQUAL(0u, bins[0] + bins[1] + bins[2] + bins[3]);
+
+	// A window of nothing still holds one sample
+	CHECK_EQUAL(1u, RollingStats(0).GetWindowSize());
+}
+
+TEST_CASE(PercentilesUseTheNearestRank)
+{
+	// 1 to 100, shuffled by a stride that shares no factor with the count
+	RollingStats stats(100);
+	AddSequence(stats, 100, 1.0f, 37);
+
+	CHECK_EQUAL(100u, stats.GetCount());
+	CHECK_EQUAL(1.0f, stats.GetPercentile(0.0f));
+	CHECK_EQUAL(1.0f, stats.GetPercentile(1.0f));
+	CHECK_EQUAL(50.0f, stats.GetPercentile(50.0f));
+	CHECK_EQUAL(51.0f, stats.GetPercentile(50.5f));
+	CHECK_EQUAL(90.0f, stats.GetPercentile(90.0f));
+	CHECK_EQUAL(99.0f, stats.GetPercentile(99.0f));
+	CHECK_EQUAL(100.0f, stats.GetPercentile(100.0f));
+
+	// Out of range percentiles are clamped
+	CHECK_EQUAL(1.0f, stats.GetPercentile(-10.0f));
+	CHECK_EQUAL(100.0f, stats.GetPercentile(250.0f));
+
+	CHECK_EQUAL(1.0f, stats.GetMin());
+	CHECK_EQUAL(100.0f, stats.GetMax());
+	CHECK_NEAR(50.5f, stats.GetAverage(), 1e-5f);
+
+	// Five samples, the 20% steps each land on one
+	RollingStats small(5);
+	AddSequence(small, 5, 10.0f, 2);
+	CHECK_EQUAL(10.0f, small.GetPercentile(20.0f));
+	CHECK_EQUAL(11.0f, small.GetPercentile(20.1f));
+	CHECK_EQUAL(12.0f, small.GetPercentile(50.0f));
+	CHECK_EQUAL(14.0f, small.GetPercentile(95.0f));
+}
+
+TEST_CASE(NewSamplesInvalidateTheSortedCopy)
+{
+	RollingStats stats(4);
+	stats.Add(1.0f);
+	stats.Add(2.0f);
+	CHECK_EQUAL(2.0f, stats.GetPercentile(100.0f));
+
+	// The sorted copy from the last query must not be reused
+	stats.Add(10.0f);
+	CHECK_EQUAL(10.0f, stats.GetPercentile(100.0f));
+	CHECK_EQUAL(2.0f, stats.GetPercentile(50.0f));
+
+	stats.Clear();
+	CHECK_EQUAL(0u, stats.GetCount());
+	CHECK_EQUAL(0.0f, stats.GetPercentile(100.0f));
+	stats.Add(5.0f);
+	CHECK_EQUAL(5.0f, stats.GetPercentile(0.0f));
+	CHECK_EQUAL(5.0f, stats.GetSample(0));
+}
+
+TEST_CASE(WindowWrapsAroundKeepingTheNewest)
+{
+	RollingStats stats(4);
+	for (int i = 1; i <= 6; i++)
+	{
+		stats.Add(static_cast<float>(i));
+	}
+
+	// 1 and 2 have been overwritten, the rest are read back newest first
+	CHECK_EQUAL(4u, stats.GetCount());
+	CHECK_EQUAL(6.0f, stats.GetSample(0));
+	CHECK_EQUAL(5.0f, stats.GetSample(1));
+	CHECK_EQUAL(4.0f, stats.GetSample(2));
+	CHECK_EQUAL(3.0f, stats.GetSample(3));
+	CHECK_EQUAL(0.0f, stats.GetSample(4));
+
+	CHECK_EQUAL(3.0f, stats.GetMin());
+	CHECK_EQUAL(6.0f, stats.GetMax());
+	CHECK_NEAR(4.5f, stats.GetAverage(), 1e-6f);
+	CHECK_EQUAL(4.0f, stats.GetPercentile(50.0f));
+
+	// Many times round the window only the last four are left
+	for (int i = 7; i <= 1003; i++)
+	{
+		stats.Add(static_cast<float>(i));
+	}
+	CHECK_EQUAL(1003.0f, stats.GetSample(0));
+	CHECK_EQUAL(1000.0f, stats.GetSample(3));
+	CHECK_EQUAL(1000.0f, stats.GetMin());
+	CHECK_EQUAL(1003.0f, stats.GetPercentile(100.0f));
+	CHECK_NEAR(1001.5f, stats.GetAverage(), 1e-3f);
+}
+
+TEST_CASE(HistogramCountsEveryBin)
+{
+	// 0 to 9 into five bins of two
+	RollingStats stats(10);
+	AddSequence(stats, 10, 0.0f, 3);
+
+	uint32_t bins[5] = {};
+	stats.GetHistogram(0.0f, 10.0f, bins, 5);
+	for (uint32_t bin : bins)
+	{
+		CHECK_EQUAL(2u, bin);
+	}
+
+	// Samples outside the range go in the end bins
+	stats.GetHistogram(3.0f, 7.0f, bins, 2);
+	CHECK_EQUAL(5u, bins[0]);
+	CHECK_EQUAL(5u, bins[1]);
+
+	// An empty range puts everything in the first bin, and no bins is left alone
+	stats.GetHistogram(4.0f, 4.0f, bins, 3);
+	CHECK_EQUAL(10u, bins[0]);
+	CHECK_EQUAL(0u, bins[1] + bins[2]);
+	bins[0] = 42;
+	stats.GetHistogram(0.0f, 10.0f, bins, 0);
+	CHECK_EQUAL(42u, bins[0]);
+}
+
+TEST_CASE(HistogramOnlyCountsTheWindow)
+{
+	RollingStats stats(4);
+	for (int i = 0; i < 10; i++)
+	{
+		stats.Add(i < 6 ? 0.5f : 3.5f);
+	}
+
+	// The six early samples have all been pushed out
+	uint32_t bins[4] = {};
+	stats.GetHistogram(0.0f, 4.0f, bins, 4);
+	CHECK_EQUAL(0u, bins[0]);
+	CHECK_EQUAL(0u, bins[1] + bins[2]);
+	CHECK_EQUAL(4u, bins[3]);
+}
+
+TEST_CASE(CountersCloseIntoTheirHistories)
+{
+	CounterRegistry* registry = CounterRegistry::GetInstance();
+	CHECK(registry->GetCounterCount() >= static_cast<uint32_t>(Counter_BuiltInCount));
+	CHECK(registry->GetCounter(Counter_DrawCalls).Name == "Draw Calls");
+
+	CounterID perFrame = registry->Register("Test Per Frame");
+	CounterID gauge = registry->Register("Test Gauge", CounterKind_Gauge);
+	CHECK_EQUAL(perFrame, registry->Register("Test Per Frame"));
+	CHECK(perFrame != gauge);
+
+	registry->BeginFrame();
+	registry->Add(perFrame, 2.0);
+	registry->Add(perFrame, 3.0);
+	registry->Set(gauge, 7.0);
+	registry->BeginFrame();
+
+	// The per frame counter starts again from zero, the gauge keeps its value
+	CHECK_EQUAL(5.0, registry->GetCounter(perFrame).LastFrame);
+	CHECK_EQUAL(0.0, registry->GetCounter(perFrame).Current);
+	CHECK_EQUAL(7.0, registry->GetCounter(gauge).Current);
+
+	registry->BeginFrame();
+	CHECK_EQUAL(0.0, registry->GetCounter(perFrame).LastFrame);
+	CHECK_EQUAL(7.0, registry->GetCounter(gauge).LastFrame);
+
+	const RollingStats& history = registry->GetCounter(perFrame).History;
+	CHECK_EQUAL(3u, history.GetCount());
+	CHECK_EQUAL(0.0f, history.GetSample(0));
+	CHECK_EQUAL(5.0f, history.GetSample(1));
+	CHECK_EQUAL(7.0f, registry->GetCounter(gauge).History.GetSample(0));
+
+	// Every BeginFrame after the first times a frame
+	CHECK(registry->GetFrameTimes().GetCount() >= 2u);
+	CHECK(registry->GetFrameTimes().GetMin() >= 0.0f);
+}
+#pragma endregion
@@ -0,0 +1,108 @@
+// Include{s}
+#include "TestFramework.h"
+#include "EntityRegistry.h"
+#include "TransformStore.h"
+#include <algorithm>
+#include <memory>
+#include <random>
+
+// Struct laid out like a scene object before the registry, hot transform data next to a name, paths and a device
+struct LegacyObject
+{
+	virtual ~LegacyObject() = default;
+	virtual void SetPosition(float x, float y, float z) { Position = XMFLOAT3(x, y, z); }
+
+	std::string Name;
+	const char* MeshPath;
+	const wchar_t* TexturePath;
+	void* Device;
+	XMFLOAT3 Position;
+	XMFLOAT4X4 World;
+	MeshData Mesh;
+	ID3D11ShaderResourceView* Texture;
+	bool Transparent;
+};
+
+// Times one pass over 100k entities reading each one's world matrix and mesh, the way the draw loop does, through
+// the registry's archetype arrays and through separately allocated objects reached by pointer
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const UINT count = smoke ? 1000 : 100000;
+	const int passes = smoke ? 2 : 100;
+
+	EntityRegistry* registry = EntityRegistry::GetInstance();
+	TransformStore* store = TransformStore::GetInstance();
+
+	// The legacy objects are allocated between other heap blocks and shuffled, as a scene that grew over time
+	std::mt19937 random(4);
+	std::vector<std::unique_ptr<LegacyObject>> objects;
+	std::vector<std::unique_ptr<char[]>> padding;
+	std::vector<Entity> entities;
+	for (UINT i = 0; i < count; i++)
+	{
+		XMFLOAT3 position(static_cast<float>(i), 0.0f, 0.0f);
+
+		objects.push_back(std::make_unique<LegacyObject>());
+		objects.back()->Name = "Object " + std::to_string(i);
+		objects.back()->Position = position;
+		XMStoreFloat4x4(&objects.back()->World, XMMatrixTranslation(position.x, 0.0f, 0.0f));
+		objects.back()->Mesh.IndexCount = 36;
+		padding.push_back(std::make_unique<char[]>(64 + random() % 512));
+
+		Entity entity = registry->Create(Component_Transform | Component_Render | Component_SceneGraph, i,
+			objects.back()->Name);
+		registry->GetTransform(entity) = store->Allocate(position, XMFLOAT3(0.0f, 0.0f, 0.0f),
+			XMFLOAT3(1.0f, 1.0f, 1.0f));
+		registry->GetRender(entity).Mesh.IndexCount = 36;
+		entities.push_back(entity);
+	}
+	std::shuffle(objects.begin(), objects.end(), random);
+
+	// Archetype arrays, each entity's transform handle leads into the store's packed matrices
+	double registrySum = 0.0;
+	BenchmarkTimer registryTimer;
+	for (int pass = 0; pass < passes; pass++)
+	{
+		registry->ForEach(Component_Transform | Component_Render, [&](const EntityArchetype& archetype)
+		{
+			const std::vector<UINT>& transforms = archetype.GetTransforms();
+			const std::vector<RenderComponent>& renders = archetype.GetRenders();
+
+			for (UINT row = 0; row < archetype.GetCount(); row++)
+			{
+				registrySum += store->GetWorldMatrixTransposed(transforms[row])._14 + renders[row].Mesh.IndexCount;
+			}
+		});
+	}
+	double registryMs = registryTimer.GetElapsedMilliseconds() / passes;
+
+	double legacySum = 0.0;
+	BenchmarkTimer legacyTimer;
+	for (int pass = 0; pass < passes; pass++)
+	{
+		for (const std::unique_ptr<LegacyObject>& object : objects)
+		{
+			legacySum += object->World._41 + object->Mesh.IndexCount;
+		}
+	}
+	double legacyMs = legacyTimer.GetElapsedMilliseconds() / passes;
+
+	printf("%10s %14s %14s\n", "Entities", "Registry ms", "Pointers ms");
+	printf("%10u %14.4f %14.4f\n", count, registryMs, legacyMs);
+
+	// Both walks see the same matrices, only in another order
+	if (fabs(registrySum - legacySum) > 1e-6 * fabs(legacySum))
+	{
+		printf("The registry and the objects disagree\n");
+		return 1;
+	}
+
+	for (Entity entity : entities)
+	{
+		store->Free(registry->GetTransform(entity));
+		registry->Destroy(entity);
+	}
+
+	return 0;
+}
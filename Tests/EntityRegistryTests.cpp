@@ -0,0 +1,229 @@
+// Include{s}
+#include "TestFramework.h"
+#include "EntityRegistry.h"
+#include "TransformStore.h"
+#include <random>
+
+#pragma region Helper Functions
+// Counts the entities ForEach walks for a set of components
+static UINT CountWithComponents(UINT components)
+{
+	UINT count = 0;
+	EntityRegistry::GetInstance()->ForEach(components, [&](const EntityArchetype& archetype)
+	{
+		CHECK(archetype.HasComponents(components));
+		CHECK_EQUAL(archetype.GetCount(), static_cast<UINT>(archetype.GetEntities().size()));
+		count += archetype.GetCount();
+	});
+
+	return count;
+}
+
+// Destroys every entity of a test, the registry is a singleton so each test leaves it empty
+static void DestroyAll(const std::vector<Entity>& entities)
+{
+	for (Entity entity : entities)
+	{
+		EntityRegistry::GetInstance()->Destroy(entity);
+	}
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(CreateStartsWithZeroedComponents)
+{
+	EntityRegistry* registry = EntityRegistry::GetInstance();
+	Entity entity = registry->Create(Component_Transform | Component_Render | Component_Occluder, 7, "Crate");
+
+	CHECK(registry->IsAlive(entity));
+	CHECK_EQUAL(UINT(Component_Transform | Component_Render | Component_Occluder), registry->GetComponents(entity));
+	CHECK_EQUAL(InvalidTransform, registry->GetTransform(entity));
+	CHECK(registry->GetRender(entity).Mesh.VertexBuffer == nullptr);
+	CHECK(!registry->GetRender(entity).Transparent);
+	CHECK(registry->GetOccluder(entity) == nullptr);
+	CHECK_EQUAL(7, registry->GetID(entity));
+	CHECK(registry->GetName(entity) == "Crate");
+	CHECK_EQUAL(1u, registry->GetEntityCount());
+
+	DestroyAll({ entity });
+	CHECK_EQUAL(0u, registry->GetEntityCount());
+}
+
+TEST_CASE(DestroyedHandlesStayDeadWhenTheSlotIsReused)
+{
+	EntityRegistry* registry = EntityRegistry::GetInstance();
+	Entity first = registry->Create(Component_Transform, 1, "First");
+	Entity second = registry->Create(Component_Transform, 2, "Second");
+
+	registry->Destroy(first);
+	CHECK(!registry->IsAlive(first));
+	CHECK(registry->IsAlive(second));
+
+	// The slot comes back with the next generation, the old handle still points at it but is not alive
+	Entity reused = registry->Create(Component_Render, 3, "Reused");
+	CHECK_EQUAL(first & EntitySlotMask, reused & EntitySlotMask);
+	CHECK_EQUAL((first >> EntitySlotBits) + 1, reused >> EntitySlotBits);
+	CHECK(first != reused);
+	CHECK(!registry->IsAlive(first));
+	CHECK(registry->IsAlive(reused));
+	CHECK_EQUAL(3, registry->GetID(reused));
+
+	// Destroying a dead handle again leaves the entity now in the slot alone
+	registry->Destroy(first);
+	CHECK(registry->IsAlive(reused));
+	CHECK(!registry->IsAlive(InvalidEntity));
+	CHECK(!registry->IsAlive(0x00FFFFFE));
+
+	DestroyAll({ second, reused });
+}
+
+TEST_CASE(ArchetypeMovesKeepSharedComponents)
+{
+	EntityRegistry* registry = EntityRegistry::GetInstance();
+	std::vector<Entity> entities;
+	for (int i = 0; i < 10; i++)
+	{
+		entities.push_back(registry->Create(Component_Transform | Component_Render, i, "Entity"));
+		registry->GetTransform(entities.back()) = 100 + i;
+		registry->GetRender(entities.back()).Mesh.IndexCount = 1000 + i;
+	}
+	CHECK_EQUAL(10u, CountWithComponents(Component_Transform | Component_Render));
+
+	// Moving entity 2 out swaps the last row into its hole, both have to be found where they went
+	const CPUMeshData mesh;
+	registry->AddComponents(entities[2], Component_Occluder);
+	registry->GetOccluder(entities[2]) = &mesh;
+	CHECK_EQUAL(UINT(Component_Transform | Component_Render | Component_Occluder),
+		registry->GetComponents(entities[2]));
+	CHECK_EQUAL(10u, CountWithComponents(Component_Transform | Component_Render));
+	CHECK_EQUAL(1u, CountWithComponents(Component_Occluder));
+
+	for (int i = 0; i < 10; i++)
+	{
+		CHECK_EQUAL(UINT(100 + i), registry->GetTransform(entities[i]));
+		CHECK_EQUAL(UINT(1000 + i), registry->GetRender(entities[i]).Mesh.IndexCount);
+	}
+	CHECK(registry->GetOccluder(entities[2]) == &mesh);
+
+	// Dropping the render component keeps the transform and the occluder
+	registry->RemoveComponents(entities[2], Component_Render);
+	CHECK_EQUAL(UINT(Component_Transform | Component_Occluder), registry->GetComponents(entities[2]));
+	CHECK_EQUAL(102u, registry->GetTransform(entities[2]));
+	CHECK(registry->GetOccluder(entities[2]) == &mesh);
+	CHECK_EQUAL(9u, CountWithComponents(Component_Render));
+
+	// Adding back what it already has is not a move
+	registry->AddComponents(entities[2], Component_Transform);
+	CHECK_EQUAL(UINT(Component_Transform | Component_Occluder), registry->GetComponents(entities[2]));
+
+	// A component it lost comes back zeroed
+	registry->AddComponents(entities[2], Component_Render);
+	CHECK_EQUAL(0u, registry->GetRender(entities[2]).Mesh.IndexCount);
+	CHECK_EQUAL(10u, CountWithComponents(Component_Transform | Component_Render));
+
+	DestroyAll(entities);
+}
+
+TEST_CASE(RandomOperationsMatchAShadowCopy)
+{
+	EntityRegistry* registry = EntityRegistry::GetInstance();
+	std::mt19937 random(12);
+	const UINT componentSets[] = { Component_Transform, Component_Transform | Component_Render, Component_Render,
+		Component_Transform | Component_Render | Component_Occluder, Component_Transform | Component_SceneGraph };
+
+	// What every live entity should hold, kept next to the registry and compared after each round
+	struct Expected
+	{
+		Entity Handle;
+		UINT Components;
+		UINT Transform;
+		int ID;
+	};
+	std::vector<Expected> alive;
+	std::vector<Entity> dead;
+	int nextID = 0;
+
+	for (int round = 0; round < 20; round++)
+	{
+		for (int operation = 0; operation < 500; operation++)
+		{
+			int choice = random() % 4;
+			if (choice == 0 || alive.empty())
+			{
+				UINT components = componentSets[random() % 5];
+				Entity entity = registry->Create(components, nextID, std::to_string(nextID));
+				Expected expected = { entity, components, 0, nextID++ };
+				if (components & Component_Transform)
+				{
+					expected.Transform = random();
+					registry->GetTransform(expected.Handle) = expected.Transform;
+				}
+				alive.push_back(expected);
+				continue;
+			}
+
+			size_t pick = random() % alive.size();
+			Expected& expected = alive[pick];
+			if (choice == 1)
+			{
+				registry->Destroy(expected.Handle);
+				dead.push_back(expected.Handle);
+				alive[pick] = alive.back();
+				alive.pop_back();
+			}
+			else
+			{
+				// Moves between archetypes, the transform survives unless it was removed
+				UINT flag = 1u << (random() % 4);
+				if (choice == 2)
+				{
+					registry->AddComponents(expected.Handle, flag);
+					if (!(expected.Components & Component_Transform) && flag == Component_Transform)
+					{
+						expected.Transform = InvalidTransform;
+					}
+					expected.Components |= flag;
+				}
+				else if (expected.Components != flag)
+				{
+					registry->RemoveComponents(expected.Handle, flag);
+					expected.Components &= ~flag;
+				}
+			}
+		}
+
+		CHECK_EQUAL(static_cast<UINT>(alive.size()), registry->GetEntityCount());
+		for (const Expected& expected : alive)
+		{
+			CHECK(registry->IsAlive(expected.Handle));
+			CHECK_EQUAL(expected.Components, registry->GetComponents(expected.Handle));
+			CHECK_EQUAL(expected.ID, registry->GetID(expected.Handle));
+			CHECK(registry->GetName(expected.Handle) == std::to_string(expected.ID));
+			if (expected.Components & Component_Transform)
+			{
+				CHECK_EQUAL(expected.Transform, registry->GetTransform(expected.Handle));
+			}
+		}
+
+		// Only this round's, a slot reused more times than the generation bits can count makes an old handle match
+		for (Entity entity : dead)
+		{
+			CHECK(!registry->IsAlive(entity));
+		}
+		dead.clear();
+
+		UINT transforms = 0;
+		for (const Expected& expected : alive)
+		{
+			transforms += expected.Components & Component_Transform ? 1 : 0;
+		}
+		CHECK_EQUAL(transforms, CountWithComponents(Component_Transform));
+	}
+
+	for (const Expected& expected : alive)
+	{
+		registry->Destroy(expected.Handle);
+	}
+	CHECK_EQUAL(0u, registry->GetEntityCount());
+}
+#pragma endregion
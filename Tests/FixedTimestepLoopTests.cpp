@@ -0,0 +1,174 @@
+// Include{s}
+#include "TestFramework.h"
+#include "FixedTimestepLoop.h"
+#include <random>
+
+#pragma region Helper Functions
+// A power of two step, so whole steps and halves of one add up exactly
+static const double Timestep = 1.0 / 64.0;
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(FirstFrameOnlyStartsTheClock)
+{
+	FakeClock clock(5.0);
+	FixedTimestepLoop loop(&clock, Timestep);
+
+	CHECK_EQUAL(0u, loop.BeginFrame());
+	CHECK_EQUAL(0.0f, loop.GetAlpha());
+	CHECK_EQUAL(0.0, loop.GetFrameTime());
+	CHECK_EQUAL(5.0, loop.GetClockTime());
+
+	// The time before the first frame is never simulated
+	clock.Advance(Timestep);
+	CHECK_EQUAL(1u, loop.BeginFrame());
+	CHECK_EQUAL(Timestep, loop.GetFrameTime());
+}
+
+TEST_CASE(AccumulatorCarriesTheRemainder)
+{
+	FakeClock clock;
+	FixedTimestepLoop loop(&clock, Timestep);
+	loop.BeginFrame();
+
+	// One and a half steps, then half a step finishes the second
+	clock.Advance(Timestep * 1.5);
+	CHECK_EQUAL(1u, loop.BeginFrame());
+	CHECK_EQUAL(0.5f, loop.GetAlpha());
+	clock.Advance(Timestep * 0.5);
+	CHECK_EQUAL(1u, loop.BeginFrame());
+	CHECK_EQUAL(0.0f, loop.GetAlpha());
+
+	// Frames shorter than a step build up until one is due
+	for (int frame = 0; frame < 3; frame++)
+	{
+		clock.Advance(Timestep * 0.25);
+		CHECK_EQUAL(0u, loop.BeginFrame());
+		CHECK_EQUAL(0.25f * (frame + 1), loop.GetAlpha());
+	}
+	clock.Advance(Timestep * 0.25);
+	CHECK_EQUAL(1u, loop.BeginFrame());
+
+	// Random frame times, every second of real time is simulated or waiting in the accumulator
+	std::mt19937 random(8);
+	std::uniform_real_distribution<double> frameTime(0.001, 0.05);
+	double elapsed = 0.0;
+	uint32_t steps = 0;
+	for (int frame = 0; frame < 1000; frame++)
+	{
+		double time = frameTime(random);
+		clock.Advance(time);
+		elapsed += time;
+		steps += loop.BeginFrame();
+
+		CHECK(loop.GetAlpha() >= 0.0f && loop.GetAlpha() < 1.0f);
+	}
+	CHECK_NEAR(elapsed, steps * Timestep + loop.GetAlpha() * Timestep, 1e-6);
+	CHECK_EQUAL(0.0, loop.GetDroppedTime());
+}
+
+TEST_CASE(StepsAreClampedAfterASlowFrame)
+{
+	FakeClock clock;
+	FixedTimestepLoop loop(&clock, Timestep, 4);
+	loop.BeginFrame();
+
+	// 12.5 steps due, only 4 are run and the 8 whole steps past the limit are dropped
+	clock.Advance(Timestep * 12.5);
+	CHECK_EQUAL(4u, loop.BeginFrame());
+	CHECK_NEAR(Timestep * 8.0, loop.GetDroppedTime(), 1e-12);
+
+	// The fraction is kept, so the blend does not jump
+	CHECK_NEAR(0.5f, loop.GetAlpha(), 1e-6f);
+
+	// A stall only counts as the longest frame, which is still more than the limit
+	clock.Advance(10.0);
+	CHECK_EQUAL(4u, loop.BeginFrame());
+	CHECK_EQUAL(0.25, loop.GetFrameTime());
+	CHECK_NEAR(Timestep * 8.0 + (0.25 - Timestep * 4.0), loop.GetDroppedTime(), 1e-12);
+	CHECK_NEAR(0.5f, loop.GetAlpha(), 1e-6f);
+
+	// Back to normal frames straight after
+	clock.Advance(Timestep * 0.5);
+	CHECK_EQUAL(1u, loop.BeginFrame());
+	CHECK_NEAR(0.0f, loop.GetAlpha(), 1e-6f);
+}
+
+TEST_CASE(ResetAndSetClockStartAgain)
+{
+	FakeClock clock;
+	FakeClock replayClock(100.0);
+	FixedTimestepLoop loop(&clock, Timestep);
+	loop.BeginFrame();
+	clock.Advance(Timestep * 2.75);
+	CHECK_EQUAL(2u, loop.BeginFrame());
+
+	loop.Reset();
+	clock.Advance(1.0);
+	CHECK_EQUAL(0u, loop.BeginFrame());
+	CHECK_EQUAL(0.0f, loop.GetAlpha());
+
+	// A replay sets its clock to each recorded reading and gets the same steps back
+	loop.SetClock(&replayClock);
+	CHECK_EQUAL(0u, loop.BeginFrame());
+	replayClock.SetSeconds(100.0 + Timestep * 3.0);
+	CHECK_EQUAL(3u, loop.BeginFrame());
+	CHECK_EQUAL(100.0 + Timestep * 3.0, loop.GetClockTime());
+
+	// A timestep of zero falls back to 60 Hz
+	FixedTimestepLoop fallback(&clock, 0.0, 0);
+	CHECK_EQUAL(1.0 / 60.0, fallback.GetTimestep());
+}
+
+TEST_CASE(LimiterKeepsItsSlotsEndToEnd)
+{
+	FakeClock clock;
+	FrameLimiter limiter(&clock, 50.0);
+	CHECK_NEAR(50.0, limiter.GetTargetRate(), 1e-9);
+
+	// The first slot starts on the first Wait
+	CHECK_NEAR(0.02, limiter.Wait(), 1e-12);
+	CHECK_NEAR(0.02, clock.GetSeconds(), 1e-12);
+
+	// A frame that took 5 ms only waits out the rest of its slot
+	clock.Advance(0.005);
+	CHECK_NEAR(0.015, limiter.Wait(), 1e-12);
+	CHECK_NEAR(0.04, clock.GetSeconds(), 1e-12);
+
+	// Running 10 ms over is made up by the next frame, the slots do not move
+	clock.Advance(0.03);
+	CHECK_EQUAL(0.0, limiter.Wait());
+	CHECK_NEAR(0.01, limiter.Wait(), 1e-12);
+	CHECK_NEAR(0.08, clock.GetSeconds(), 1e-12);
+
+	// More than a whole slot behind, the slots start again from now
+	clock.Advance(0.1);
+	CHECK_EQUAL(0.0, limiter.Wait());
+	CHECK_NEAR(0.02, limiter.Wait(), 1e-12);
+	CHECK_NEAR(0.2, clock.GetSeconds(), 1e-12);
+}
+
+TEST_CASE(LimiterRateChanges)
+{
+	FakeClock clock;
+	FrameLimiter limiter(&clock);
+	CHECK_EQUAL(0.0, limiter.GetTargetRate());
+	CHECK_EQUAL(0.0, limiter.Wait());
+	CHECK_EQUAL(0.0, clock.GetSeconds());
+
+	limiter.SetTargetRate(100.0);
+	limiter.Wait();
+	clock.Advance(0.004);
+
+	// Setting the same rate every frame keeps the slots, a new rate starts them again
+	limiter.SetTargetRate(100.0);
+	CHECK_NEAR(0.006, limiter.Wait(), 1e-12);
+	clock.Advance(0.004);
+	limiter.SetTargetRate(25.0);
+	CHECK_NEAR(0.04, limiter.Wait(), 1e-12);
+
+	limiter.SetTargetRate(-5.0);
+	CHECK_EQUAL(0.0, limiter.GetTargetRate());
+	CHECK_EQUAL(0.0, limiter.Wait());
+}
+#pragma endregion
\ No newline at end of file
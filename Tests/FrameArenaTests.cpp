@@ -0,0 +1,96 @@
+// Include{s}
+#include "TestFramework.h"
+#include "FrameArena.h"
+
+#pragma region Helper Functions
+// Checks a pointer sits on an alignment
+static bool IsAligned(const void* pointer, size_t alignment)
+{
+	return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(AllocationsKeepTheirAlignment)
+{
+	FrameArena* arena = FrameArena::GetInstance();
+	arena->BeginFrame();
+
+	const size_t alignments[] = { 1, 2, 4, 8, 16, 32, 64, 256 };
+	for (int i = 0; i < 64; i++)
+	{
+		size_t alignment = alignments[i % 8];
+		void* block = arena->Allocate(1 + i * 3, alignment);
+		CHECK(block != nullptr);
+		CHECK(IsAligned(block, alignment));
+	}
+	CHECK_EQUAL(0u, arena->GetOverflowCount());
+}
+
+TEST_CASE(OverflowBlocksKeepTheirAlignment)
+{
+	FrameArena* arena = FrameArena::GetInstance();
+	arena->BeginFrame();
+
+	// Each of these is bigger than the whole buffer, so they all come from the heap
+	const size_t alignments[] = { 8, 16, 64, 256, 4096 };
+	for (size_t alignment : alignments)
+	{
+		void* block = arena->Allocate(arena->GetCapacity() + 3, alignment);
+		CHECK(block != nullptr);
+		CHECK(IsAligned(block, alignment));
+
+		// The whole block is usable
+		memset(block, 0xAB, arena->GetCapacity() + 3);
+	}
+	CHECK_EQUAL(5u, arena->GetOverflowCount());
+
+	// A zero byte overflow still hands back a distinct block
+	arena->Allocate(arena->GetCapacity() * 2, 32);
+	CHECK(arena->Allocate(0, 64) != nullptr);
+}
+
+TEST_CASE(BufferGrowsToFitThePeak)
+{
+	FrameArena* arena = FrameArena::GetInstance();
+	arena->BeginFrame();
+	arena->BeginFrame();
+	const size_t capacity = arena->GetCapacity();
+
+	// Overflowing this frame makes the same buffer big enough when it comes round two frames later
+	for (int i = 0; i < 4; i++)
+	{
+		arena->Allocate(capacity / 2, 16);
+	}
+	CHECK(arena->GetOverflowCount() > 0);
+
+	arena->BeginFrame();
+	arena->BeginFrame();
+	CHECK(arena->GetCapacity() >= capacity * 2);
+	CHECK_EQUAL(0u, arena->GetOverflowCount());
+	CHECK_EQUAL(size_t(0), arena->GetUsedBytes());
+
+	for (int i = 0; i < 4; i++)
+	{
+		arena->Allocate(capacity / 2, 16);
+	}
+	CHECK_EQUAL(0u, arena->GetOverflowCount());
+}
+
+TEST_CASE(ContainersAndFormatUseTheArena)
+{
+	FrameArena* arena = FrameArena::GetInstance();
+	arena->BeginFrame();
+
+	FrameVector<double> values(1000, 2.0);
+	CHECK(IsAligned(values.data(), alignof(double)));
+	CHECK(arena->GetUsedBytes() >= 1000 * sizeof(double));
+
+	const char* text = arena->Format("%d frames at %.1f ms", 60, 16.7);
+	CHECK(strcmp(text, "60 frames at 16.7 ms") == 0);
+
+	FrameString name("Occluder ");
+	name += text;
+	CHECK(name == "Occluder 60 frames at 16.7 ms");
+}
+#pragma endregion
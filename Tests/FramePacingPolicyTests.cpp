@@ -0,0 +1,89 @@
+// Include{s}
+#include "TestFramework.h"
+#include "FramePacingPolicy.h"
+
+#pragma region Helper Functions
+// Makes the state of a visible window outside a benchmark, on the menu or playing
+static FramePacingState MakeState(bool mainMenu, bool focused)
+{
+	FramePacingState state = {};
+	state.MainMenu = mainMenu;
+	state.Focused = focused;
+
+	return state;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(BenchmarkRunsAreUncapped)
+{
+	FramePacingPolicy policy;
+	policy.SetActiveRate(60.0);
+
+	// Whatever else the window is doing, a benchmark draws every frame as fast as it can
+	FramePacingState state = { true, true, false, true, true };
+	const FramePacingDecision decision = policy.Decide(state);
+	CHECK(decision.Render);
+	CHECK(decision.Poll);
+	CHECK_EQUAL(0.0, decision.TargetRate);
+}
+
+TEST_CASE(MinimizedWindowsDoNotPoll)
+{
+	FramePacingPolicy policy;
+	FramePacingState state = MakeState(false, true);
+	state.Minimized = true;
+	state.Occluded = true;
+
+	const FramePacingDecision decision = policy.Decide(state);
+	CHECK(!decision.Render);
+	CHECK(!decision.Poll);
+}
+
+TEST_CASE(OccludedWindowsPollAtFourHertz)
+{
+	FramePacingPolicy policy;
+	FramePacingState state = MakeState(false, true);
+	state.Occluded = true;
+
+	const FramePacingDecision decision = policy.Decide(state);
+	CHECK(!decision.Render);
+	CHECK(decision.Poll);
+	CHECK_EQUAL(4.0, decision.TargetRate);
+}
+
+TEST_CASE(MenuAndBackgroundTakeTheLowerCap)
+{
+	FramePacingPolicy policy;
+
+	// Uncapped play, the menu and background caps apply on their own
+	CHECK_EQUAL(0.0, policy.Decide(MakeState(false, true)).TargetRate);
+	CHECK_EQUAL(30.0, policy.Decide(MakeState(true, true)).TargetRate);
+	CHECK_EQUAL(15.0, policy.Decide(MakeState(false, false)).TargetRate);
+	CHECK_EQUAL(15.0, policy.Decide(MakeState(true, false)).TargetRate);
+
+	// A play cap under the menu's keeps the menu at it, the background still goes lower
+	policy.SetActiveRate(20.0);
+	CHECK_EQUAL(20.0, policy.Decide(MakeState(false, true)).TargetRate);
+	CHECK_EQUAL(20.0, policy.Decide(MakeState(true, true)).TargetRate);
+	CHECK_EQUAL(15.0, policy.Decide(MakeState(true, false)).TargetRate);
+
+	// A play cap over both is only held while playing
+	policy.SetActiveRate(144.0);
+	CHECK_EQUAL(144.0, policy.Decide(MakeState(false, true)).TargetRate);
+	CHECK_EQUAL(30.0, policy.Decide(MakeState(true, true)).TargetRate);
+	CHECK_EQUAL(15.0, policy.Decide(MakeState(false, false)).TargetRate);
+
+	// A zero menu or background rate does not limit
+	FramePacingRates rates = policy.GetRates();
+	rates.MainMenu = 0.0;
+	rates.Background = 0.0;
+	policy.SetRates(rates);
+	CHECK_EQUAL(144.0, policy.Decide(MakeState(true, false)).TargetRate);
+
+	// Every visible, non-benchmark frame is drawn
+	const FramePacingDecision decision = policy.Decide(MakeState(true, false));
+	CHECK(decision.Render);
+	CHECK(decision.Poll);
+}
+#pragma endregion
\ No newline at end of file
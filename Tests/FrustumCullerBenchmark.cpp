@@ -0,0 +1,103 @@
+// Include{s}
+#include "TestFramework.h"
+#include "FrustumCuller.h"
+#include <random>
+
+using namespace DirectX;
+
+// Times culling 1k, 100k and 1M random boxes with Cull on each of its paths, against testing the boxes one at a
+// time with IsVisible the way the scene did before the culler kept its boxes as a structure of arrays
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const uint32_t counts[] = { 1000, 100000, 1000000 };
+	const uint32_t countCount = smoke ? 1 : 3;
+
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 1.0f),
+		XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV2, 16.0f / 9.0f, 0.1f, 500.0f);
+
+	FrustumCuller culler;
+	culler.ExtractPlanes(XMMatrixMultiply(view, projection));
+
+	FrustumCuller::SetAVXEnabled(true);
+	const bool avxSupported = FrustumCuller::IsAVXEnabled();
+
+	printf("%10s %14s %14s %14s %10s\n", "Objects", "IsVisible ms", "Cull SSE ms", "Cull AVX ms", "Visible");
+
+	for (uint32_t c = 0; c < countCount; c++)
+	{
+		const uint32_t count = counts[c];
+		const int repeats = smoke ? 2 : static_cast<int>(20000000 / count) + 1;
+
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+		std::uniform_real_distribution<float> size(0.5f, 5.0f);
+
+		std::vector<XMFLOAT3> centers(count);
+		std::vector<XMFLOAT3> extents(count);
+		culler.Clear();
+		for (uint32_t i = 0; i < count; i++)
+		{
+			centers[i] = XMFLOAT3(position(random), position(random), position(random));
+			extents[i] = XMFLOAT3(size(random), size(random), size(random));
+			culler.AddBounds(centers[i], extents[i]);
+		}
+
+		std::vector<uint32_t> visible;
+		visible.reserve(count);
+
+		// One box at a time, as an array of structures
+		BenchmarkTimer scalarTimer;
+		for (int r = 0; r < repeats; r++)
+		{
+			visible.clear();
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (culler.IsVisible(centers[i], extents[i]))
+				{
+					visible.push_back(i);
+				}
+			}
+		}
+		double scalarMs = scalarTimer.GetElapsedMilliseconds() / repeats;
+		const size_t expectedVisible = visible.size();
+
+		FrustumCuller::SetAVXEnabled(false);
+		BenchmarkTimer sseTimer;
+		for (int r = 0; r < repeats; r++)
+		{
+			culler.Cull(visible);
+		}
+		double sseMs = sseTimer.GetElapsedMilliseconds() / repeats;
+		bool matches = visible.size() == expectedVisible;
+
+		double avxMs = 0.0;
+		if (avxSupported)
+		{
+			FrustumCuller::SetAVXEnabled(true);
+			BenchmarkTimer avxTimer;
+			for (int r = 0; r < repeats; r++)
+			{
+				culler.Cull(visible);
+			}
+			avxMs = avxTimer.GetElapsedMilliseconds() / repeats;
+			matches = matches && visible.size() == expectedVisible;
+		}
+
+		if (!matches)
+		{
+			printf("Cull and IsVisible disagree on %u objects\n", count);
+			return 1;
+		}
+
+		printf("%10u %14.4f %14.4f %14.4f %10zu\n", count, scalarMs, sseMs, avxMs, expectedVisible);
+	}
+
+	if (!avxSupported)
+	{
+		printf("AVX is not supported here, the AVX column is empty\n");
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+// Include{s}
+#include "TestFramework.h"
+#include "FrustumCuller.h"
+#include <random>
+
+using namespace DirectX;
+
+#pragma region Helper Functions
+// Builds a culler for a camera at the origin looking down +Z, with a 90 degree square view from 1 to 100 units
+static FrustumCuller CreateCuller()
+{
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 1.0f),
+		XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV2, 1.0f, 1.0f, 100.0f);
+
+	FrustumCuller culler;
+	culler.ExtractPlanes(XMMatrixMultiply(view, projection));
+
+	return culler;
+}
+
+// Fills the culler with boxes scattered around the camera, about half of them in view
+static void AddRandomBounds(FrustumCuller& culler, uint32_t count, unsigned seed, std::vector<XMFLOAT3>& centers,
+	std::vector<XMFLOAT3>& extents)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+	std::uniform_real_distribution<float> size(0.1f, 10.0f);
+
+	culler.Clear();
+	centers.resize(count);
+	extents.resize(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		centers[i].x = position(random);
+		centers[i].y = position(random);
+		centers[i].z = position(random);
+		extents[i].x = size(random);
+		extents[i].y = size(random);
+		extents[i].z = size(random);
+
+		culler.AddBounds(centers[i], extents[i]);
+	}
+}
+
+// Tests every box one at a time, the reference Cull has to agree with
+static std::vector<uint32_t> CullOneByOne(const FrustumCuller& culler, const std::vector<XMFLOAT3>& centers,
+	const std::vector<XMFLOAT3>& extents)
+{
+	std::vector<uint32_t> visible;
+	for (uint32_t i = 0; i < centers.size(); i++)
+	{
+		if (culler.IsVisible(centers[i], extents[i]))
+		{
+			visible.push_back(i);
+		}
+	}
+
+	return visible;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(ExtractPlanesBoundTheView)
+{
+	FrustumCuller culler = CreateCuller();
+	const XMFLOAT3 point(0.0f, 0.0f, 0.0f);
+
+	CHECK(culler.IsVisible(XMFLOAT3(0.0f, 0.0f, 50.0f), point));
+	CHECK(culler.IsVisible(XMFLOAT3(45.0f, -45.0f, 50.0f), point));
+	CHECK(!culler.IsVisible(XMFLOAT3(0.0f, 0.0f, -5.0f), point));
+	CHECK(!culler.IsVisible(XMFLOAT3(0.0f, 0.0f, 0.5f), point));
+	CHECK(!culler.IsVisible(XMFLOAT3(0.0f, 0.0f, 101.0f), point));
+	CHECK(!culler.IsVisible(XMFLOAT3(55.0f, 0.0f, 50.0f), point));
+	CHECK(!culler.IsVisible(XMFLOAT3(0.0f, 55.0f, 50.0f), point));
+
+	// Planes come out normalised, so distances are in world units
+	for (int p = 0; p < 6; p++)
+	{
+		const XMFLOAT4& plane = culler.GetPlanes()[p];
+		CHECK_NEAR(1.0, plane.x * plane.x + plane.y * plane.y + plane.z * plane.z, 1e-5);
+	}
+	CHECK_NEAR(-1.0, culler.GetPlanes()[4].w, 1e-4);
+	CHECK_NEAR(100.0, culler.GetPlanes()[5].w, 1e-2);
+}
+
+TEST_CASE(ClassifySeparatesStraddlingBoxes)
+{
+	FrustumCuller culler = CreateCuller();
+
+	CHECK_EQUAL(Frustum_Inside, culler.Classify(XMFLOAT3(0.0f, 0.0f, 50.0f), XMFLOAT3(5.0f, 5.0f, 5.0f)));
+	CHECK_EQUAL(Frustum_Intersecting, culler.Classify(XMFLOAT3(50.0f, 0.0f, 50.0f), XMFLOAT3(5.0f, 5.0f, 5.0f)));
+	CHECK_EQUAL(Frustum_Intersecting, culler.Classify(XMFLOAT3(0.0f, 0.0f, 100.0f), XMFLOAT3(5.0f, 5.0f, 5.0f)));
+	CHECK_EQUAL(Frustum_Outside, culler.Classify(XMFLOAT3(0.0f, 0.0f, -20.0f), XMFLOAT3(5.0f, 5.0f, 5.0f)));
+	CHECK_EQUAL(Frustum_Outside, culler.Classify(XMFLOAT3(80.0f, 0.0f, 50.0f), XMFLOAT3(5.0f, 5.0f, 5.0f)));
+}
+
+TEST_CASE(CullMatchesPerObjectTests)
+{
+	FrustumCuller culler = CreateCuller();
+	std::vector<XMFLOAT3> centers;
+	std::vector<XMFLOAT3> extents;
+	std::vector<uint32_t> visible;
+
+	// Counts that leave every possible tail after the groups of 8 and 4
+	const uint32_t counts[] = { 0, 1, 3, 4, 7, 8, 13, 1000, 4099 };
+	for (uint32_t count : counts)
+	{
+		AddRandomBounds(culler, count, count + 7, centers, extents);
+		std::vector<uint32_t> expected = CullOneByOne(culler, centers, extents);
+
+		CHECK_EQUAL(count, culler.GetBoundsCount());
+		CHECK_EQUAL(static_cast<uint32_t>(expected.size()), culler.Cull(visible));
+		CHECK(expected == visible);
+	}
+}
+
+TEST_CASE(CullPathsAgree)
+{
+	FrustumCuller culler = CreateCuller();
+	std::vector<XMFLOAT3> centers;
+	std::vector<XMFLOAT3> extents;
+	AddRandomBounds(culler, 10007, 99, centers, extents);
+
+	const bool avxDefault = FrustumCuller::IsAVXEnabled();
+	std::vector<uint32_t> wide;
+	std::vector<uint32_t> narrow;
+
+	// Off is always honoured, on only sticks on CPUs with AVX
+	FrustumCuller::SetAVXEnabled(true);
+	culler.Cull(wide);
+	FrustumCuller::SetAVXEnabled(false);
+	CHECK(!FrustumCuller::IsAVXEnabled());
+	culler.Cull(narrow);
+	FrustumCuller::SetAVXEnabled(avxDefault);
+
+	CHECK(wide == narrow);
+	CHECK(!wide.empty() && wide.size() < 10007);
+}
+
+TEST_CASE(TransformBoundsEnclosesRotatedBox)
+{
+	XMFLOAT3 center;
+	XMFLOAT3 extents;
+
+	// A unit cube turned 45 degrees about Y reaches sqrt(2) along X and Z
+	XMMATRIX world = XMMatrixRotationY(XM_PIDIV4) * XMMatrixTranslation(10.0f, 20.0f, 30.0f);
+	FrustumCuller::TransformBounds(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f), world, center, extents);
+
+	CHECK_NEAR(10.0, center.x, 1e-5);
+	CHECK_NEAR(20.0, center.y, 1e-5);
+	CHECK_NEAR(30.0, center.z, 1e-5);
+	CHECK_NEAR(std::sqrt(2.0), extents.x, 1e-5);
+	CHECK_NEAR(1.0, extents.y, 1e-5);
+	CHECK_NEAR(std::sqrt(2.0), extents.z, 1e-5);
+
+	// Scaling grows the extents and moves an off-centre box
+	world = XMMatrixScaling(2.0f, 3.0f, 4.0f);
+	FrustumCuller::TransformBounds(XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT3(1.0f, 1.0f, 1.0f), world, center, extents);
+
+	CHECK_NEAR(2.0, center.x, 1e-5);
+	CHECK_NEAR(3.0, center.y, 1e-5);
+	CHECK_NEAR(4.0, extents.z, 1e-5);
+}
+#pragma endregion
\ No newline at end of file
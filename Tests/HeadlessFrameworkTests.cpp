@@ -0,0 +1,49 @@
+// Include{s}
+#include "TestFramework.h"
+#include "DX11Framework.h"
+
+#pragma region Helper Functions
+// Runs benchmark frames the way Main.cpp does for --headless, without a window to pump
+static void RunFrames(DX11Framework& application, size_t frameCount)
+{
+	for (size_t frame = 0; frame < frameCount; frame++)
+	{
+		application.Update();
+		application.Draw();
+	}
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(HeadlessStartsAndShutsDown)
+{
+	// Nothing is compiled or drawn, so everything the destructor releases may still be null
+	DX11Framework* application = new DX11Framework();
+	CHECK(SUCCEEDED(application->InitialiseHeadless()));
+	CHECK(application->GetNullRenderContext() != nullptr);
+	delete application;
+}
+
+TEST_CASE(HeadlessFramesHaveNoValidationErrors)
+{
+	DX11Framework* application = new DX11Framework();
+	CHECK(SUCCEEDED(application->InitialiseHeadless()));
+	CHECK(SUCCEEDED(application->StartBenchmark("JSON Files\\Benchmark Flythrough.json")));
+
+	RunFrames(*application, 8);
+
+	// Every call went through the null backend and validated
+	const NullRenderContext* context = application->GetNullRenderContext();
+	CHECK(context != nullptr);
+	if (context)
+	{
+		const NullRenderStats& stats = context->GetStats();
+		CHECK(stats.DrawCalls > 0);
+		CHECK(stats.Triangles > 0);
+		CHECK_EQUAL(UINT64(0), stats.ValidationErrors);
+	}
+	CHECK_EQUAL(size_t(8), application->GetTerrainVisibility().size());
+
+	delete application;
+}
+#pragma endregion
\ No newline at end of file
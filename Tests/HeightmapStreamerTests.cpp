@@ -0,0 +1,98 @@
+// Include{s}
+#include "TestFramework.h"
+#include "HeightmapStreamer.h"
+#include <fstream>
+
+#pragma region Helper Functions
+// Writes a 65 sample square .raw heightmap and converts it into 16 tiles of 16 steps
+// Returns bool - True if the tiled file was written
+static bool WriteTiledHeightmap(const std::string& rawPath, const std::string& tiledPath)
+{
+	{
+		std::ofstream file(rawPath, std::ios::binary);
+		for (uint32_t sample = 0; sample < 65 * 65; sample++)
+		{
+			const uint16_t value = static_cast<uint16_t>(sample * 13);
+			file.put(static_cast<char>(value & 0xFF));
+			file.put(static_cast<char>(value >> 8));
+		}
+	}
+
+	return TiledHeightmap::ConvertRaw(rawPath, 65, 65, 16, 16, tiledPath);
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(WaitForIdleFinishesEveryQueuedTile)
+{
+	const std::string rawPath = "HeightmapStreamerTests.raw";
+	const std::string tiledPath = "HeightmapStreamerTests.tiled";
+	CHECK(WriteTiledHeightmap(rawPath, tiledPath));
+
+	HeightmapStreamer streamer;
+	CHECK(streamer.Start(tiledPath, 16));
+	streamer.SetMaxRequestsPerUpdate(16);
+
+	// A radius over the whole heightmap queues all of it at once
+	streamer.Update(32.0f, 32.0f, 100.0f);
+	streamer.WaitForIdle();
+
+	std::vector<HeightmapLoadedTile> loaded;
+	streamer.CollectLoaded(loaded);
+	CHECK_EQUAL(size_t(16), loaded.size());
+	CHECK_EQUAL(16u, streamer.GetCache().GetResidentCount());
+	CHECK_EQUAL(0u, streamer.GetCache().GetPendingCount());
+
+	// Each tile holds what the heightmap has there, and is in the slot it was asked for
+	const TiledHeightmap& heightmap = streamer.GetHeightmap();
+	for (const HeightmapLoadedTile& tile : loaded)
+	{
+		const uint16_t* samples = heightmap.GetTile(tile.Request.TileX, tile.Request.TileZ);
+		CHECK(tile.Samples == std::vector<uint16_t>(samples, samples + heightmap.GetTileSampleCount()));
+		CHECK_EQUAL(tile.Request.Slot, streamer.GetCache().GetSlot(tile.Request.TileX, tile.Request.TileZ));
+	}
+
+	// Nothing more is wanted, so there is nothing to wait for
+	streamer.Update(32.0f, 32.0f, 100.0f);
+	streamer.WaitForIdle();
+	streamer.CollectLoaded(loaded);
+	CHECK(loaded.empty());
+
+	streamer.Stop();
+	std::remove(rawPath.c_str());
+	std::remove(tiledPath.c_str());
+}
+
+TEST_CASE(RequestsAreSpreadOverUpdates)
+{
+	const std::string rawPath = "HeightmapStreamerTestsSpread.raw";
+	const std::string tiledPath = "HeightmapStreamerTestsSpread.tiled";
+	CHECK(WriteTiledHeightmap(rawPath, tiledPath));
+
+	HeightmapStreamer streamer;
+	CHECK(streamer.Start(tiledPath, 16));
+	streamer.SetMaxRequestsPerUpdate(5);
+
+	// 16 tiles at 5 an update takes four updates
+	std::vector<HeightmapLoadedTile> loaded;
+	size_t loadedCount = 0;
+	for (int update = 0; update < 4; update++)
+	{
+		streamer.Update(32.0f, 32.0f, 100.0f);
+		streamer.WaitForIdle();
+		streamer.CollectLoaded(loaded);
+		CHECK_EQUAL(update < 3 ? size_t(5) : size_t(1), loaded.size());
+		loadedCount += loaded.size();
+	}
+	CHECK_EQUAL(size_t(16), loadedCount);
+	CHECK_EQUAL(16u, streamer.GetCache().GetResidentCount());
+
+	// Stopping with nothing queued, and again once stopped, is fine
+	streamer.Stop();
+	streamer.Stop();
+	CHECK(!streamer.GetHeightmap().IsOpen());
+
+	std::remove(rawPath.c_str());
+	std::remove(tiledPath.c_str());
+}
+#pragma endregion
\ No newline at end of file
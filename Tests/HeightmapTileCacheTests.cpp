@@ -0,0 +1,123 @@
+// Include{s}
+#include "TestFramework.h"
+#include "HeightmapTileCache.h"
+
+#pragma region Helper Functions
+// Updates the cache around a camera, in tiles, and marks every tile it hands out as paged in straight away
+// Returns std::vector<HeightmapTileRequest> - The tiles handed out
+static std::vector<HeightmapTileRequest> UpdateAndLoad(HeightmapTileCache& cache, float cameraTileX,
+	float cameraTileZ, float radiusTiles)
+{
+	std::vector<HeightmapTileRequest> requests;
+	cache.Update(cameraTileX, cameraTileZ, radiusTiles, 64, requests);
+
+	for (const HeightmapTileRequest& request : requests)
+	{
+		cache.MarkResident(request);
+	}
+
+	return requests;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(EvictsTheLeastRecentlyWantedTile)
+{
+	// A row of tiles and a radius that only reaches the tile under the camera
+	HeightmapTileCache cache;
+	cache.Initialise(8, 1, 3);
+
+	UpdateAndLoad(cache, 0.5f, 0.5f, 0.4f);
+	UpdateAndLoad(cache, 2.5f, 0.5f, 0.4f);
+	UpdateAndLoad(cache, 4.5f, 0.5f, 0.4f);
+	CHECK_EQUAL(3u, cache.GetResidentCount());
+	CHECK_EQUAL(0u, static_cast<uint32_t>(cache.GetEvictionCount()));
+	const uint32_t firstSlot = cache.GetSlot(0, 0);
+	const uint32_t fourthSlot = cache.GetSlot(4, 0);
+
+	// Every slot is full, the tile wanted longest ago makes room
+	std::vector<HeightmapTileRequest> requests = UpdateAndLoad(cache, 6.5f, 0.5f, 0.4f);
+	CHECK_EQUAL(size_t(1), requests.size());
+	CHECK(!requests.empty() && requests[0].TileX == 6 && requests[0].Slot == firstSlot);
+	CHECK_EQUAL(HeightmapTileCache::NoSlot, cache.GetSlot(0, 0));
+	CHECK_EQUAL(firstSlot, cache.GetSlot(6, 0));
+	CHECK_EQUAL(1u, static_cast<uint32_t>(cache.GetEvictionCount()));
+
+	// Going back to a resident tile hands nothing out, but makes it the most recently wanted
+	CHECK(UpdateAndLoad(cache, 2.5f, 0.5f, 0.4f).empty());
+
+	// So the tile at 4 is now the oldest, not the one at 2
+	requests = UpdateAndLoad(cache, 7.5f, 0.5f, 0.4f);
+	CHECK(!requests.empty() && requests[0].Slot == fourthSlot);
+	CHECK_EQUAL(HeightmapTileCache::NoSlot, cache.GetSlot(4, 0));
+	CHECK(cache.GetSlot(2, 0) != HeightmapTileCache::NoSlot);
+	CHECK(cache.GetSlot(6, 0) != HeightmapTileCache::NoSlot);
+	CHECK_EQUAL(3u, cache.GetResidentCount());
+	CHECK_EQUAL(2u, static_cast<uint32_t>(cache.GetEvictionCount()));
+}
+
+TEST_CASE(WantedTilesAreNeverEvicted)
+{
+	// More tiles are wanted around the middle of the grid than there are slots
+	HeightmapTileCache cache;
+	cache.Initialise(4, 4, 4);
+
+	std::vector<HeightmapTileRequest> requests = UpdateAndLoad(cache, 2.0f, 2.0f, 1.0f);
+	CHECK_EQUAL(size_t(4), requests.size());
+
+	// The camera is on the corner of the four middle tiles, they are the nearest and get the slots
+	uint32_t slots[4];
+	for (uint32_t tile = 0; tile < 4; tile++)
+	{
+		slots[tile] = cache.GetSlot(1 + tile % 2, 1 + tile / 2);
+		CHECK(slots[tile] != HeightmapTileCache::NoSlot);
+	}
+
+	// Still wanted, so the tiles further out cannot push them out
+	for (int update = 0; update < 3; update++)
+	{
+		CHECK(UpdateAndLoad(cache, 2.0f, 2.0f, 1.0f).empty());
+	}
+	for (uint32_t tile = 0; tile < 4; tile++)
+	{
+		CHECK_EQUAL(slots[tile], cache.GetSlot(1 + tile % 2, 1 + tile / 2));
+	}
+	CHECK_EQUAL(0u, static_cast<uint32_t>(cache.GetEvictionCount()));
+}
+
+TEST_CASE(PendingTilesAreNeverEvicted)
+{
+	HeightmapTileCache cache;
+	cache.Initialise(8, 1, 2);
+
+	// Both slots are handed out but not paged in yet
+	std::vector<HeightmapTileRequest> pending;
+	cache.Update(0.5f, 0.5f, 1.0f, 8, pending);
+	CHECK_EQUAL(size_t(2), pending.size());
+	CHECK_EQUAL(2u, cache.GetPendingCount());
+	CHECK_EQUAL(HeightmapTileCache::NoSlot, cache.GetSlot(0, 0));
+
+	// The camera moving away cannot take a slot that is still being filled
+	std::vector<HeightmapTileRequest> requests;
+	cache.Update(6.5f, 0.5f, 0.4f, 8, requests);
+	CHECK(requests.empty());
+
+	// Once paged in they are resident, and no longer wanted so they can go
+	for (const HeightmapTileRequest& request : pending)
+	{
+		cache.MarkResident(request);
+	}
+	CHECK_EQUAL(2u, cache.GetResidentCount());
+	CHECK_EQUAL(0u, cache.GetPendingCount());
+
+	requests = UpdateAndLoad(cache, 6.5f, 0.5f, 0.4f);
+	CHECK_EQUAL(size_t(1), requests.size());
+	CHECK_EQUAL(1u, static_cast<uint32_t>(cache.GetEvictionCount()));
+
+	// Marking a request whose slot has moved on to another tile changes nothing
+	cache.MarkResident(pending[0]);
+	cache.MarkResident(pending[1]);
+	CHECK_EQUAL(2u, cache.GetResidentCount());
+	CHECK_EQUAL(0u, cache.GetPendingCount());
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,268 @@
+// Include{s}
+#include "TestFramework.h"
+#include "InputRecording.h"
+#include "FixedTimestepLoop.h"
+#include <cstdio>
+#include <random>
+#include <sstream>
+
+#pragma region Helper Functions
+// Stand in for the app's update, toggles and camera switches from actions and a position moved every fixed step
+struct TestSimulation
+{
+	RecordedFrameState State = { 0, 0 };
+	double Position = 0.0;
+	uint32_t IgnoreCameraFrom = UINT32_MAX;
+
+	// Runs one update, the frame index is only used to make a simulation drift on purpose
+	void Update(const InputSystem* input, uint32_t steps, double timestep, uint32_t frame)
+	{
+		if (input->WasActionPressed(Action_ToggleFill))
+		{
+			State.Toggles ^= RecordedToggle_Fill;
+		}
+		if (input->WasActionPressed(Action_ToggleUI))
+		{
+			State.Toggles ^= RecordedToggle_UI;
+		}
+		for (uint32_t camera = 0; camera < 10 && frame < IgnoreCameraFrom; camera++)
+		{
+			if (input->WasActionPressed(static_cast<InputAction>(Action_Camera0 + camera)))
+			{
+				State.ActiveCamera = camera;
+			}
+		}
+
+		for (uint32_t step = 0; step < steps; step++)
+		{
+			Position += input->IsActionDown(Action_MoveForward) ? timestep : 0.0;
+		}
+	}
+};
+
+// Binds the keys the test simulation reads
+static InputSystem* BindTestKeys()
+{
+	InputSystem* input = InputSystem::GetInstance();
+	input->ClearBindings();
+	input->BindKey(Action_ToggleFill, 0x72);
+	input->BindKey(Action_ToggleUI, 0x74);
+	input->BindKey(Action_MoveForward, 'W');
+	for (uint16_t camera = 0; camera < 10; camera++)
+	{
+		input->BindKey(static_cast<InputAction>(Action_Camera0 + camera), 0x60 + camera);
+	}
+
+	// Nothing held or queued from another test
+	input->PushEvent({ InputEvent_FocusLost, 0, 0, 0, 0.0 });
+	input->BeginFrame(0.0);
+	input->BeginFrame(0.0);
+
+	return input;
+}
+
+// Struct to hold what a recorded run did, to compare the replay against
+struct RecordedRun
+{
+	InputRecording Recording;
+	std::vector<uint32_t> Steps;
+	std::vector<double> Positions;
+};
+
+// Plays a live run of frames with uneven frame times and scripted key presses, recording every update
+static RecordedRun RecordRun(uint32_t frames, unsigned seed)
+{
+	InputSystem* input = BindTestKeys();
+	FakeClock clock(10.0);
+	FixedTimestepLoop loop(&clock, 1.0 / 120.0);
+	TestSimulation simulation;
+	RecordedRun run;
+
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<double> frameTime(0.004, 0.03);
+	for (uint32_t frame = 0; frame < frames; frame++)
+	{
+		clock.Advance(frameTime(random));
+		const double now = clock.GetSeconds();
+
+		if (frame % 7 == 0)
+		{
+			input->PushEvent({ InputEvent_KeyDown, 0x72, 0, 0, now - 0.003 });
+			input->PushEvent({ InputEvent_KeyUp, 0x72, 0, 0, now - 0.001 });
+		}
+		if (frame % 11 == 0)
+		{
+			input->PushEvent({ InputEvent_KeyDown, static_cast<uint16_t>(0x60 + frame % 10), 0, 0, now - 0.002 });
+		}
+		if (frame % 11 == 1)
+		{
+			input->PushEvent({ InputEvent_KeyUp, static_cast<uint16_t>(0x60 + (frame - 1) % 10), 0, 0, now });
+		}
+		if (frame % 40 == 5 || frame % 40 == 25)
+		{
+			input->PushEvent({ frame % 40 == 5 ? InputEvent_KeyDown : InputEvent_KeyUp, 'W', 0, 0, now - 0.001 });
+		}
+		input->PushEvent({ InputEvent_MouseDelta, 0, static_cast<int32_t>(frame), -1, now - 0.004 });
+
+		const uint32_t steps = loop.BeginFrame();
+		input->BeginFrame(now);
+		simulation.Update(input, steps, loop.GetTimestep(), frame);
+
+		run.Recording.AddFrame(loop.GetClockTime(), now, input->GetFrameEvents(), simulation.State);
+		run.Steps.push_back(steps);
+		run.Positions.push_back(simulation.Position);
+	}
+
+	return run;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(ReplayRunsTheSameUpdatesAsTheRecording)
+{
+	RecordedRun run = RecordRun(600, 3);
+
+	// Through the file format, as a replay from disk would be
+	std::stringstream file;
+	CHECK(run.Recording.Write(file));
+	InputRecording recording;
+	CHECK(recording.Read(file));
+	CHECK_EQUAL(size_t(600), recording.GetFrameCount());
+
+	InputSystem* input = BindTestKeys();
+	FakeClock replayClock;
+	FixedTimestepLoop loop(&replayClock, 1.0 / 120.0);
+	TestSimulation simulation;
+	InputReplayer replayer;
+	replayer.Start(&recording);
+
+	uint32_t stepMismatches = 0;
+	uint32_t positionMismatches = 0;
+	while (!replayer.IsFinished())
+	{
+		const uint32_t frame = static_cast<uint32_t>(replayer.GetFrameIndex());
+
+		// The app sets the simulation clock to the recorded reading before stepping
+		replayClock.SetSeconds(replayer.BeginFrame(input).ClockTime);
+		const uint32_t steps = loop.BeginFrame();
+		simulation.Update(input, steps, loop.GetTimestep(), frame);
+		CHECK(replayer.EndFrame(simulation.State));
+
+		stepMismatches += steps != run.Steps[frame] ? 1 : 0;
+		positionMismatches += simulation.Position != run.Positions[frame] ? 1 : 0;
+	}
+
+	CHECK_EQUAL(size_t(600), replayer.GetFrameIndex());
+	CHECK_EQUAL(size_t(0), replayer.GetMismatchCount());
+	CHECK_EQUAL(size_t(600), replayer.GetFirstMismatch());
+	CHECK_EQUAL(0u, stepMismatches);
+	CHECK_EQUAL(0u, positionMismatches);
+
+	// The run did toggle, switch cameras and move, or there was nothing to get wrong
+	CHECK(simulation.Position > 0.0);
+	CHECK(recording.GetFrame(0).State.Toggles != recording.GetFrame(7).State.Toggles);
+	CHECK(recording.GetFrame(599).State.ActiveCamera != 0);
+}
+
+TEST_CASE(DriftIsCountedFromTheFirstDifferentFrame)
+{
+	RecordedRun run = RecordRun(300, 4);
+	InputSystem* input = BindTestKeys();
+
+	// Stops switching cameras from frame 100, the first switch after that is frame 110
+	TestSimulation simulation;
+	simulation.IgnoreCameraFrom = 100;
+	InputReplayer replayer;
+	replayer.Start(&run.Recording);
+	while (!replayer.IsFinished())
+	{
+		const uint32_t frame = static_cast<uint32_t>(replayer.GetFrameIndex());
+		replayer.BeginFrame(input);
+		simulation.Update(input, 0, 0.0, frame);
+		replayer.EndFrame(simulation.State);
+	}
+
+	CHECK_EQUAL(size_t(110), replayer.GetFirstMismatch());
+	CHECK(replayer.GetMismatchCount() > 0);
+	CHECK(replayer.GetMismatchCount() <= 190);
+
+	// Starting again clears the counts
+	replayer.Start(&run.Recording);
+	CHECK_EQUAL(size_t(0), replayer.GetMismatchCount());
+	CHECK_EQUAL(size_t(0), replayer.GetFrameIndex());
+
+	// No recording, or an empty one, has nothing to replay
+	InputRecording empty;
+	replayer.Start(nullptr);
+	CHECK(replayer.IsFinished());
+	replayer.Start(&empty);
+	CHECK(replayer.IsFinished());
+}
+
+TEST_CASE(FileRoundTripKeepsEveryFrameAndEvent)
+{
+	RecordedRun run = RecordRun(120, 5);
+	const std::string path = "InputRecordingTests.rlir";
+	CHECK(run.Recording.Write(path));
+
+	InputRecording recording;
+	CHECK(recording.Read(path));
+	std::remove(path.c_str());
+	CHECK_EQUAL(run.Recording.GetFrameCount(), recording.GetFrameCount());
+
+	for (size_t i = 0; i < recording.GetFrameCount(); i++)
+	{
+		const RecordedFrame& written = run.Recording.GetFrame(i);
+		const RecordedFrame& read = recording.GetFrame(i);
+
+		// The clock reading is exact, the input time and timestamps are kept as float offsets from it
+		CHECK_EQUAL(written.ClockTime, read.ClockTime);
+		CHECK_NEAR(written.InputTime, read.InputTime, 1e-6);
+		CHECK_EQUAL(written.State.ActiveCamera, read.State.ActiveCamera);
+		CHECK_EQUAL(written.State.Toggles, read.State.Toggles);
+		CHECK_EQUAL(written.EventCount, read.EventCount);
+
+		const InputEvent* writtenEvents = run.Recording.GetEvents(written);
+		const InputEvent* readEvents = recording.GetEvents(read);
+		for (uint32_t e = 0; e < read.EventCount; e++)
+		{
+			CHECK(writtenEvents[e].Type == readEvents[e].Type);
+			CHECK_EQUAL(writtenEvents[e].Key, readEvents[e].Key);
+			CHECK_EQUAL(writtenEvents[e].X, readEvents[e].X);
+			CHECK_EQUAL(writtenEvents[e].Y, readEvents[e].Y);
+			CHECK_NEAR(writtenEvents[e].Timestamp, readEvents[e].Timestamp, 1e-6);
+		}
+	}
+
+	// The file has gone
+	CHECK(!recording.Read(path));
+}
+
+TEST_CASE(DamagedFilesAreRejected)
+{
+	RecordedRun run = RecordRun(50, 6);
+	std::stringstream stream;
+	CHECK(run.Recording.Write(stream));
+	const std::string file = stream.str();
+
+	// Cut short, with another magic, another version and an event count the frames do not add up to
+	std::string damaged[4] = { file.substr(0, file.size() - 3), file, file, file };
+	damaged[1][0] = 'X';
+	damaged[2][4] = 2;
+	damaged[3][12]++;
+
+	for (const std::string& contents : damaged)
+	{
+		InputRecording recording;
+		std::stringstream damagedStream(contents);
+		CHECK(!recording.Read(damagedStream));
+		CHECK_EQUAL(size_t(0), recording.GetFrameCount());
+	}
+
+	// The file it was damaged from still reads
+	InputRecording recording;
+	std::stringstream intact(file);
+	CHECK(recording.Read(intact));
+	CHECK_EQUAL(size_t(50), recording.GetFrameCount());
+}
+#pragma endregion
\ No newline at end of file
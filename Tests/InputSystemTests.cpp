@@ -0,0 +1,228 @@
+// Include{s}
+#include "TestFramework.h"
+#include "InputSystem.h"
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#pragma region Helper Functions
+// Leaves the singleton with nothing bound, held or queued, as if the app had just started
+static InputSystem* ResetInput()
+{
+	InputSystem* input = InputSystem::GetInstance();
+	input->ClearBindings();
+	input->PushEvent({ InputEvent_FocusLost, 0, 0, 0, 0.0 });
+	input->BeginFrame(0.0);
+	input->BeginFrame(0.0);
+
+	return input;
+}
+
+// Builds a key event
+static InputEvent KeyEvent(InputEventType type, uint16_t key, double timestamp)
+{
+	return { type, key, 0, 0, timestamp };
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(KeyAndActionNamesResolve)
+{
+	CHECK_EQUAL(uint16_t('W'), InputSystem::FindKey("W"));
+	CHECK_EQUAL(uint16_t('7'), InputSystem::FindKey("7"));
+	CHECK_EQUAL(uint16_t(0x70), InputSystem::FindKey("F1"));
+	CHECK_EQUAL(uint16_t(0x79), InputSystem::FindKey("F10"));
+	CHECK_EQUAL(uint16_t(0x67), InputSystem::FindKey("Numpad7"));
+	CHECK_EQUAL(uint16_t(0x21), InputSystem::FindKey("PageUp"));
+	CHECK_EQUAL(uint16_t(0x1B), InputSystem::FindKey("Escape"));
+
+	// Lower case, out of range and made up names are not keys
+	CHECK_EQUAL(uint16_t(0), InputSystem::FindKey("w"));
+	CHECK_EQUAL(uint16_t(0), InputSystem::FindKey("F13"));
+	CHECK_EQUAL(uint16_t(0), InputSystem::FindKey("Fx"));
+	CHECK_EQUAL(uint16_t(0), InputSystem::FindKey("NumpadX"));
+	CHECK_EQUAL(uint16_t(0), InputSystem::FindKey("Hyper"));
+
+	CHECK_EQUAL(Action_MoveForward, InputSystem::FindAction("MoveForward"));
+	CHECK_EQUAL(Action_MenuSelect, InputSystem::FindAction("MenuSelect"));
+	CHECK_EQUAL(Action_Count, InputSystem::FindAction("Jump"));
+}
+
+TEST_CASE(ActionMapResolvesQueuedEvents)
+{
+	InputSystem* input = ResetInput();
+
+	// Two keys on one action, a key shared by two actions and names that are skipped
+	const std::string path = "InputSystemTests_actions.json";
+	std::ofstream(path) << R"({ "InputActions": {
+		"MoveForward": [ "W", "Up" ], "MenuSelect": [ "Return" ], "Back": [ "Escape", "Return" ],
+		"Jump": [ "Space" ], "MoveBack": [ "NotAKey", "S" ] } })";
+	CHECK(input->LoadActionMap(path));
+	std::remove(path.c_str());
+	CHECK(!input->LoadActionMap(path));
+
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, InputSystem::FindKey("Up"), 1.0));
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, InputSystem::FindKey("Return"), 1.0));
+	input->BeginFrame(1.0);
+	CHECK(input->WasActionPressed(Action_MoveForward));
+	CHECK(input->IsActionDown(Action_MoveForward));
+	CHECK(input->WasActionPressed(Action_MenuSelect));
+	CHECK(input->WasActionPressed(Action_Back));
+	CHECK(!input->IsActionDown(Action_MoveBack));
+
+	// The other key on the action keeps it down when the first comes up
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, 'W', 1.1));
+	input->PushEvent(KeyEvent(InputEvent_KeyUp, InputSystem::FindKey("Up"), 1.1));
+	input->BeginFrame(1.1);
+	CHECK(input->IsActionDown(Action_MoveForward));
+	CHECK(input->WasActionPressed(Action_MoveForward));
+	CHECK(input->WasActionReleased(Action_MoveForward));
+	CHECK(!input->WasActionPressed(Action_MenuSelect));
+	CHECK(input->IsActionDown(Action_MenuSelect));
+
+	// The unknown key was skipped, the known one after it was still bound
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, 'S', 1.2));
+	input->BeginFrame(1.2);
+	CHECK(input->IsActionDown(Action_MoveBack));
+
+	// Losing focus lets go of everything that was held
+	input->PushEvent({ InputEvent_FocusLost, 0, 0, 0, 1.3 });
+	input->BeginFrame(1.3);
+	CHECK(input->WasActionReleased(Action_MoveForward));
+	CHECK(input->WasActionReleased(Action_Back));
+	CHECK(!input->IsActionDown(Action_MoveForward));
+	CHECK(!input->IsKeyHeld('S'));
+
+	ResetInput();
+}
+
+TEST_CASE(TapsAndRepeatsWithinAFrame)
+{
+	InputSystem* input = ResetInput();
+	input->BindKey(Action_ToggleUI, 0x74);
+
+	// Down and up before the frame drains them, the action still sees one press
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, 0x74, 2.0));
+	input->PushEvent(KeyEvent(InputEvent_KeyUp, 0x74, 2.01));
+	input->BeginFrame(2.02);
+	CHECK(input->WasActionPressed(Action_ToggleUI));
+	CHECK(input->IsActionDown(Action_ToggleUI));
+	CHECK(input->WasActionReleased(Action_ToggleUI));
+	CHECK(!input->IsKeyHeld(0x74));
+	input->BeginFrame(2.03);
+	CHECK(!input->IsActionDown(Action_ToggleUI));
+
+	// Auto repeat sends more downs, only the first is a press
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, 0x74, 3.0));
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, 0x74, 3.0));
+	input->BeginFrame(3.0);
+	CHECK(input->WasKeyPressed(0x74));
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, 0x74, 3.1));
+	input->BeginFrame(3.1);
+	CHECK(!input->WasActionPressed(Action_ToggleUI));
+	CHECK(input->IsActionDown(Action_ToggleUI));
+
+	// A key up with no key down before it is not a release
+	input->PushEvent(KeyEvent(InputEvent_KeyUp, 'Z', 3.2));
+	input->BeginFrame(3.2);
+	CHECK(!input->WasKeyReleased('Z'));
+
+	ResetInput();
+}
+
+TEST_CASE(MouseMotionAndLatencyCoverTheFrame)
+{
+	InputSystem* input = ResetInput();
+
+	input->PushEvent({ InputEvent_MouseMove, 0, 10, 20, 5.0 });
+	input->PushEvent({ InputEvent_MouseDelta, 0, 3, -4, 5.0 });
+	input->PushEvent({ InputEvent_MouseDelta, 0, 2, 1, 5.01 });
+	input->PushEvent({ InputEvent_MouseWheel, 0, 120, 0, 5.02 });
+	input->PushEvent({ InputEvent_MouseWheel, 0, -240, 0, 5.03 });
+	input->PushEvent({ InputEvent_MouseMove, 0, 15, 25, 5.04 });
+	input->BeginFrame(5.05);
+
+	CHECK_EQUAL(15, input->GetMouseX());
+	CHECK_EQUAL(25, input->GetMouseY());
+	CHECK_EQUAL(5, input->GetMouseDeltaX());
+	CHECK_EQUAL(-3, input->GetMouseDeltaY());
+	CHECK_EQUAL(-120, input->GetWheelDelta());
+	CHECK_EQUAL(size_t(6), input->GetFrameEvents().size());
+	CHECK(input->GetFrameEvents()[3].Type == InputEvent_MouseWheel);
+
+	CHECK_EQUAL(6u, input->GetLatency().EventCount);
+	CHECK_NEAR(0.05, input->GetLatency().Max, 1e-9);
+	CHECK_NEAR(0.2 / 6.0, input->GetLatency().Average, 1e-9);
+
+	// Motion lasts a frame, the cursor position stays
+	input->BeginFrame(5.1);
+	CHECK_EQUAL(0, input->GetMouseDeltaX());
+	CHECK_EQUAL(0, input->GetWheelDelta());
+	CHECK_EQUAL(15, input->GetMouseX());
+	CHECK_EQUAL(0u, input->GetLatency().EventCount);
+}
+
+TEST_CASE(QueueFromAnotherThreadLosesNothing)
+{
+	InputSystem* input = ResetInput();
+	const int eventCount = 200000;
+
+	// The window procedure is the only producer, the update the only consumer
+	std::thread producer([&]()
+	{
+		for (int i = 0; i < eventCount; i++)
+		{
+			while (!input->PushEvent({ InputEvent_MouseDelta, 0, 1, i % 2 ? 1 : -1, 0.0 }))
+			{
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	long totalX = 0;
+	long totalY = 0;
+	while (totalX < eventCount)
+	{
+		input->BeginFrame(0.0);
+		totalX += input->GetMouseDeltaX();
+		totalY += input->GetMouseDeltaY();
+	}
+	producer.join();
+
+	CHECK_EQUAL(long(eventCount), totalX);
+	CHECK_EQUAL(0l, totalY);
+
+	// A full queue drops what does not fit and counts it
+	const uint32_t droppedBefore = input->GetDroppedCount();
+	for (int i = 0; i < 1100; i++)
+	{
+		input->PushEvent({ InputEvent_MouseWheel, 0, 1, 0, 0.0 });
+	}
+	input->BeginFrame(0.0);
+	CHECK_EQUAL(1024, input->GetWheelDelta());
+	CHECK_EQUAL(76u, input->GetDroppedCount() - droppedBefore);
+}
+
+TEST_CASE(ReplayFramesReplaceLiveInput)
+{
+	InputSystem* input = ResetInput();
+	input->BindKey(Action_MoveLeft, 'A');
+
+	// Typed during the replay, thrown away
+	input->PushEvent(KeyEvent(InputEvent_KeyDown, 'D', 6.0));
+
+	const InputEvent recorded[] = { KeyEvent(InputEvent_KeyDown, 'A', 1.0), { InputEvent_MouseDelta, 0, 7, 0, 1.0 } };
+	input->BeginReplayFrame(recorded, 2, 1.5);
+	CHECK(input->WasActionPressed(Action_MoveLeft));
+	CHECK(!input->IsKeyHeld('D'));
+	CHECK_EQUAL(7, input->GetMouseDeltaX());
+	CHECK_EQUAL(size_t(2), input->GetFrameEvents().size());
+
+	// The live queue is empty afterwards, the next frame has nothing new
+	input->BeginFrame(7.0);
+	CHECK(input->GetFrameEvents().empty());
+	CHECK(input->IsActionDown(Action_MoveLeft));
+
+	ResetInput();
+}
+#pragma endregion
\ No newline at end of file
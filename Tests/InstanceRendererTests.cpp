@@ -0,0 +1,274 @@
+// Include{s}
+#include "TestFramework.h"
+#include "InstanceRenderer.h"
+#include "NullRenderContext.h"
+
+#pragma region Helper Functions
+// Creates a mesh made of null buffers, with a vertex buffer big enough for the draws to validate
+static MeshData CreateMesh(NullRenderDevice& device, UINT indexCount)
+{
+	std::vector<unsigned short> indices(indexCount, 0);
+	std::vector<SimpleVertex> vertices(3);
+
+	D3D11_BUFFER_DESC vertexDesc = {};
+	vertexDesc.ByteWidth = static_cast<UINT>(sizeof(SimpleVertex) * vertices.size());
+	vertexDesc.Usage = D3D11_USAGE_DEFAULT;
+	vertexDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+	D3D11_SUBRESOURCE_DATA vertexData = { vertices.data() };
+
+	D3D11_BUFFER_DESC indexDesc = {};
+	indexDesc.ByteWidth = static_cast<UINT>(sizeof(unsigned short) * indices.size());
+	indexDesc.Usage = D3D11_USAGE_DEFAULT;
+	indexDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+	D3D11_SUBRESOURCE_DATA indexData = { indices.data() };
+
+	MeshData mesh = {};
+	device.CreateBuffer(&vertexDesc, &vertexData, &mesh.VertexBuffer);
+	device.CreateBuffer(&indexDesc, &indexData, &mesh.IndexBuffer);
+	mesh.VBStride = sizeof(SimpleVertex);
+	mesh.IndexCount = indexCount;
+
+	return mesh;
+}
+
+// Creates a null texture for the batches to be keyed on
+static ID3D11ShaderResourceView* CreateTexture(NullRenderDevice& device)
+{
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = 4;
+	desc.Height = 4;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	ID3D11ShaderResourceView* texture = nullptr;
+	device.CreateTexture(&desc, nullptr, &texture);
+
+	return texture;
+}
+
+// Builds a world matrix whose translation row identifies the instance
+static XMFLOAT4X4 MakeWorld(float id)
+{
+	XMFLOAT4X4 world;
+	XMStoreFloat4x4(&world, XMMatrixScaling(id, 2.0f, 3.0f) * XMMatrixTranslation(id, -id, id * 10.0f));
+
+	return world;
+}
+
+// Checks two matrices hold the same rows
+static bool SameMatrix(const XMFLOAT4X4& a, const XMFLOAT4X4& b)
+{
+	return memcmp(&a, &b, sizeof(XMFLOAT4X4)) == 0;
+}
+
+// Releases the buffers of a test mesh
+static void ReleaseMesh(MeshData& mesh)
+{
+	mesh.VertexBuffer->Release();
+	mesh.IndexBuffer->Release();
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(SubmitGroupsByMeshAndMaterial)
+{
+	NullRenderDevice device;
+	MeshData cube = CreateMesh(device, 36);
+	MeshData plane = CreateMesh(device, 6);
+	ID3D11ShaderResourceView* brick = CreateTexture(device);
+	ID3D11ShaderResourceView* grass = CreateTexture(device);
+	ID3D11PixelShader* pixelShader = reinterpret_cast<ID3D11PixelShader*>(0x1000);
+
+	InstanceRenderer renderer(&device, 16);
+	renderer.Begin();
+	renderer.Submit(cube, brick, pixelShader, false, MakeWorld(1.0f));
+	renderer.Submit(plane, grass, pixelShader, false, MakeWorld(2.0f));
+	renderer.Submit(cube, brick, pixelShader, false, MakeWorld(3.0f));
+	renderer.Submit(cube, grass, pixelShader, false, MakeWorld(4.0f));
+	renderer.Submit(cube, brick, pixelShader, true, MakeWorld(5.0f));
+	renderer.Submit(cube, brick, pixelShader, false, MakeWorld(6.0f));
+
+	// Meshes without buffers have nothing to draw and are dropped
+	renderer.Submit(MeshData{}, brick, pixelShader, false, MakeWorld(7.0f));
+
+	const std::vector<InstanceBatch>& batches = renderer.GetBatches();
+	CHECK_EQUAL(4u, batches.size());
+	CHECK_EQUAL(4u, renderer.GetActiveBatchCount());
+	CHECK_EQUAL(6u, renderer.GetInstanceCount());
+
+	// Batches are kept in the order their first instance was submitted
+	CHECK(batches[0].Key.VertexBuffer == cube.VertexBuffer && batches[0].Key.Texture == brick);
+	CHECK(!batches[0].Key.Transparent);
+	CHECK_EQUAL(36u, batches[0].Key.IndexCount);
+	CHECK_EQUAL(3u, batches[0].Instances.size());
+
+	CHECK(batches[1].Key.VertexBuffer == plane.VertexBuffer && batches[1].Key.IndexBuffer == plane.IndexBuffer);
+	CHECK_EQUAL(1u, batches[1].Instances.size());
+
+	CHECK(batches[2].Key.VertexBuffer == cube.VertexBuffer && batches[2].Key.Texture == grass);
+	CHECK_EQUAL(1u, batches[2].Instances.size());
+
+	CHECK(batches[3].Key.Transparent);
+	CHECK_EQUAL(1u, batches[3].Instances.size());
+
+	for (const InstanceBatch& batch : batches)
+	{
+		CHECK(batch.Key.PixelShader == pixelShader);
+		CHECK_EQUAL(UINT(sizeof(SimpleVertex)), batch.VBStride);
+	}
+
+	// Instances keep their submission order within a batch
+	CHECK(SameMatrix(MakeWorld(1.0f), batches[0].Instances[0].World));
+	CHECK(SameMatrix(MakeWorld(3.0f), batches[0].Instances[1].World));
+	CHECK(SameMatrix(MakeWorld(6.0f), batches[0].Instances[2].World));
+
+	brick->Release();
+	grass->Release();
+	ReleaseMesh(cube);
+	ReleaseMesh(plane);
+}
+
+TEST_CASE(UploadPacksBatchesIntoInstanceBuffer)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+	MeshData cube = CreateMesh(device, 36);
+	MeshData plane = CreateMesh(device, 6);
+
+	InstanceRenderer renderer(&device, 16);
+	renderer.Begin();
+	for (int i = 0; i < 8; i++)
+	{
+		renderer.Submit(i % 3 == 0 ? plane : cube, nullptr, nullptr, false, MakeWorld(static_cast<float>(i)));
+	}
+
+	CHECK_EQUAL(S_OK, renderer.Upload(&context));
+	CHECK_EQUAL(1u, context.GetStats().Maps);
+	CHECK_EQUAL(0u, context.GetStats().ValidationErrors);
+
+	// Each batch starts where the one before it ended, and its rows are the matrices it was given
+	auto instances = static_cast<const InstanceData*>(NullRenderDevice::GetBufferMemory(renderer.GetInstanceBuffer()));
+	CHECK(instances != nullptr);
+
+	UINT expectedStart = 0;
+	for (const InstanceBatch& batch : renderer.GetBatches())
+	{
+		CHECK_EQUAL(expectedStart, batch.StartInstance);
+
+		for (size_t i = 0; instances && i < batch.Instances.size(); i++)
+		{
+			const XMFLOAT4X4& uploaded = instances[batch.StartInstance + i].World;
+			CHECK(SameMatrix(batch.Instances[i].World, uploaded));
+
+			// The translation row identifies the instance, planes were every third submission
+			int id = static_cast<int>(uploaded._41);
+			CHECK_EQUAL(batch.Key.VertexBuffer == plane.VertexBuffer, id % 3 == 0);
+		}
+
+		expectedStart += static_cast<UINT>(batch.Instances.size());
+	}
+	CHECK_EQUAL(8u, expectedStart);
+
+	ReleaseMesh(cube);
+	ReleaseMesh(plane);
+}
+
+TEST_CASE(UploadGrowsInstanceBuffer)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+	MeshData cube = CreateMesh(device, 36);
+
+	InstanceRenderer renderer(&device, 2);
+	renderer.Begin();
+	for (int i = 0; i < 5; i++)
+	{
+		renderer.Submit(cube, nullptr, nullptr, false, MakeWorld(static_cast<float>(i)));
+	}
+	CHECK_EQUAL(S_OK, renderer.Upload(&context));
+
+	// Capacity doubles until the instances fit, 2 -> 8
+	D3D11_BUFFER_DESC desc;
+	renderer.GetInstanceBuffer()->GetDesc(&desc);
+	CHECK_EQUAL(UINT(8 * sizeof(InstanceData)), desc.ByteWidth);
+
+	auto instances = static_cast<const InstanceData*>(NullRenderDevice::GetBufferMemory(renderer.GetInstanceBuffer()));
+	for (int i = 0; instances && i < 5; i++)
+	{
+		CHECK(SameMatrix(MakeWorld(static_cast<float>(i)), instances[i].World));
+	}
+
+	ReleaseMesh(cube);
+}
+
+TEST_CASE(BeginKeepsBatchesForTheNextFrame)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+	MeshData cube = CreateMesh(device, 36);
+	MeshData plane = CreateMesh(device, 6);
+
+	InstanceRenderer renderer(&device, 16);
+	renderer.Begin();
+	renderer.Submit(cube, nullptr, nullptr, false, MakeWorld(1.0f));
+	renderer.Submit(plane, nullptr, nullptr, false, MakeWorld(2.0f));
+	renderer.Upload(&context);
+
+	// The next frame only draws planes, the cube batch stays around empty
+	renderer.Begin();
+	CHECK_EQUAL(0u, renderer.GetInstanceCount());
+	CHECK_EQUAL(0u, renderer.GetActiveBatchCount());
+
+	renderer.Submit(plane, nullptr, nullptr, false, MakeWorld(3.0f));
+	renderer.Submit(plane, nullptr, nullptr, false, MakeWorld(4.0f));
+	renderer.Upload(&context);
+
+	const std::vector<InstanceBatch>& batches = renderer.GetBatches();
+	CHECK_EQUAL(2u, batches.size());
+	CHECK_EQUAL(1u, renderer.GetActiveBatchCount());
+	CHECK_EQUAL(0u, batches[0].Instances.size());
+	CHECK_EQUAL(2u, batches[1].Instances.size());
+	CHECK_EQUAL(0u, batches[1].StartInstance);
+
+	auto instances = static_cast<const InstanceData*>(NullRenderDevice::GetBufferMemory(renderer.GetInstanceBuffer()));
+	CHECK(instances && SameMatrix(MakeWorld(3.0f), instances[0].World));
+	CHECK(instances && SameMatrix(MakeWorld(4.0f), instances[1].World));
+
+	ReleaseMesh(cube);
+	ReleaseMesh(plane);
+}
+
+TEST_CASE(DrawIssuesOneCallPerBatchOfThePass)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+	MeshData cube = CreateMesh(device, 3);
+	MeshData plane = CreateMesh(device, 6);
+
+	InstanceRenderer renderer(&device, 16);
+	renderer.Begin();
+	renderer.Submit(cube, nullptr, nullptr, false, MakeWorld(1.0f));
+	renderer.Submit(cube, nullptr, nullptr, false, MakeWorld(2.0f));
+	renderer.Submit(plane, nullptr, nullptr, false, MakeWorld(3.0f));
+	renderer.Submit(plane, nullptr, nullptr, true, MakeWorld(4.0f));
+	renderer.Upload(&context);
+
+	context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	context.ResetStats();
+
+	renderer.Draw(&context, false);
+	CHECK_EQUAL(2u, context.GetStats().DrawCalls);
+	CHECK_EQUAL(2u * 1u + 1u * 2u, context.GetStats().Triangles);
+
+	renderer.Draw(&context, true);
+	CHECK_EQUAL(3u, context.GetStats().DrawCalls);
+	CHECK_EQUAL(0u, context.GetStats().ValidationErrors);
+
+	ReleaseMesh(cube);
+	ReleaseMesh(plane);
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,151 @@
+// Include{s}
+#include "TestFramework.h"
+#include "MemoryTracker.h"
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#pragma region Helper Functions
+// Allocates through the operator new hook under a tag. Called directly so the compiler cannot leave a pair out
+static void* AllocateTagged(MemoryTag tag, size_t size)
+{
+	MemoryTagScope scope(tag);
+	return ::operator new(size);
+}
+
+// Gets the counters of the tag the tests use, nothing else in the test charges to it
+static MemoryTagStats GetTerrainStats()
+{
+	return MemoryTracker::GetInstance()->GetStats(MemoryTag_Terrain);
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(TrackingIsOnForTheTests)
+{
+	CHECK(MemoryTracker::IsEnabled());
+	CHECK_EQUAL(MemoryTag_General, MemoryTracker::GetCurrentTag());
+}
+
+TEST_CASE(AllocationsChargeTheirSizeWithoutTheHeader)
+{
+	const MemoryTagStats before = GetTerrainStats();
+
+	// Each block has a 16 byte header in front of it, which is not charged and does not move the block off the
+	// alignment malloc gives
+	void* blocks[3] = { AllocateTagged(MemoryTag_Terrain, 100), AllocateTagged(MemoryTag_Terrain, 200),
+		AllocateTagged(MemoryTag_Terrain, 1) };
+	for (void* block : blocks)
+	{
+		CHECK(reinterpret_cast<uintptr_t>(block) % 16 == 0);
+	}
+
+	MemoryTagStats stats = GetTerrainStats();
+	CHECK_EQUAL(before.CurrentBytes + 301, stats.CurrentBytes);
+	CHECK_EQUAL(before.CurrentCount + 3, stats.CurrentCount);
+	CHECK_EQUAL(before.TotalBytes + 301, stats.TotalBytes);
+	CHECK_EQUAL(before.TotalCount + 3, stats.TotalCount);
+	CHECK(stats.PeakBytes >= before.CurrentBytes + 301);
+
+	// The header remembers the size and tag, so a free gives back exactly what was charged
+	for (void* block : blocks)
+	{
+		::operator delete(block);
+	}
+
+	stats = GetTerrainStats();
+	CHECK_EQUAL(before.CurrentBytes, stats.CurrentBytes);
+	CHECK_EQUAL(before.CurrentCount, stats.CurrentCount);
+	CHECK_EQUAL(before.TotalBytes + 301, stats.TotalBytes);
+	CHECK(stats.PeakBytes >= before.CurrentBytes + 301);
+}
+
+TEST_CASE(FreesAreChargedToTheTagTheBlockWasMadeUnder)
+{
+	const MemoryTagStats before = GetTerrainStats();
+	void* block = AllocateTagged(MemoryTag_Terrain, 64);
+
+	// Freed under another tag, the header still sends it back to Terrain
+	{
+		MemoryTagScope scope(MemoryTag_Meshes);
+		::operator delete(block);
+	}
+	CHECK_EQUAL(before.CurrentBytes, GetTerrainStats().CurrentBytes);
+
+	// A tag only applies to the thread that set it, the worker's block is general
+	MemoryTracker* tracker = MemoryTracker::GetInstance();
+	const int64_t terrainBefore = GetTerrainStats().TotalBytes;
+	const int64_t generalBefore = tracker->GetStats(MemoryTag_General).TotalBytes;
+	{
+		MemoryTagScope scope(MemoryTag_Terrain);
+		std::thread worker([]()
+		{
+			::operator delete(::operator new(12345));
+		});
+		worker.join();
+	}
+	CHECK(GetTerrainStats().TotalBytes - terrainBefore < 12345);
+	CHECK(tracker->GetStats(MemoryTag_General).TotalBytes - generalBefore >= 12345);
+}
+
+TEST_CASE(BeginFrameRollsTheFrameCountersOver)
+{
+	MemoryTracker* tracker = MemoryTracker::GetInstance();
+	tracker->BeginFrame();
+
+	void* first = AllocateTagged(MemoryTag_Terrain, 1000);
+	void* second = AllocateTagged(MemoryTag_Terrain, 24);
+	::operator delete(second);
+
+	// The frame just closed made two blocks, freeing one does not take it off the frame's count
+	tracker->BeginFrame();
+	CHECK_EQUAL(int64_t(2), GetTerrainStats().FrameCount);
+	CHECK_EQUAL(int64_t(1024), GetTerrainStats().FrameBytes);
+
+	// A frame with nothing allocated
+	::operator delete(first);
+	tracker->BeginFrame();
+	CHECK_EQUAL(int64_t(0), GetTerrainStats().FrameCount);
+	CHECK_EQUAL(int64_t(0), GetTerrainStats().FrameBytes);
+
+	// The totals add up every tag
+	const MemoryTagStats total = tracker->GetTotalStats();
+	int64_t totalBytes = 0;
+	for (uint32_t tag = 0; tag < MemoryTag_Count; tag++)
+	{
+		totalBytes += tracker->GetStats(static_cast<MemoryTag>(tag)).TotalBytes;
+	}
+	CHECK_EQUAL(totalBytes, total.TotalBytes);
+	CHECK(strcmp(total.Name, "Total") == 0);
+}
+
+TEST_CASE(WriteJSONHoldsEveryTag)
+{
+	MemoryTracker* tracker = MemoryTracker::GetInstance();
+	void* block = AllocateTagged(MemoryTag_Terrain, 4096);
+	tracker->BeginFrame();
+
+	const std::string path = "MemoryTrackerTests_report.json";
+	CHECK(tracker->WriteJSON(path));
+	const MemoryTagStats stats = GetTerrainStats();
+	::operator delete(block);
+
+	std::ifstream file(path);
+	nlohmann::json report = nlohmann::json::parse(file, nullptr, false);
+	file.close();
+	std::remove(path.c_str());
+
+	CHECK(!report.is_discarded());
+	CHECK(report.value("enabled", false));
+	CHECK_EQUAL(size_t(MemoryTag_Count), report["tags"].size());
+
+	// Written before the block was freed, so the report still holds it
+	const nlohmann::json& terrain = report["tags"]["Terrain"];
+	CHECK_EQUAL(stats.CurrentBytes, terrain.value("currentBytes", int64_t(-1)));
+	CHECK_EQUAL(stats.TotalBytes, terrain.value("totalBytes", int64_t(-1)));
+	CHECK_EQUAL(stats.FrameBytes, terrain.value("frameBytes", int64_t(-1)));
+	CHECK(terrain.value("currentBytes", int64_t(0)) >= 4096);
+	CHECK(report["total"].value("totalBytes", int64_t(0)) >= stats.TotalBytes);
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,364 @@
+// Include{s}
+#include "TestFramework.h"
+#include "NullRenderContext.h"
+#include "TerrainQuadtree.h"
+#include <algorithm>
+#include <sstream>
+
+#pragma region Helper Functions
+// Creates a null buffer, data is only given when the usage needs it
+static ID3D11Buffer* CreateBuffer(NullRenderDevice& device, UINT byteWidth, D3D11_USAGE usage, UINT bindFlags)
+{
+	std::vector<unsigned char> data(byteWidth, 0);
+	D3D11_SUBRESOURCE_DATA initialData = { data.data() };
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = byteWidth;
+	desc.Usage = usage;
+	desc.BindFlags = bindFlags;
+	desc.CPUAccessFlags = usage == D3D11_USAGE_DYNAMIC ? D3D11_CPU_ACCESS_WRITE : 0;
+
+	ID3D11Buffer* buffer = nullptr;
+	CHECK(SUCCEEDED(device.CreateBuffer(&desc, &initialData, &buffer)));
+
+	return buffer;
+}
+
+// Binds what an indexed draw needs, a triangle list over the vertex and 16 bit index buffers
+static void BindMesh(NullRenderContext& context, ID3D11Buffer* vertexBuffer, ID3D11Buffer* indexBuffer)
+{
+	UINT stride = 32;
+	UINT offset = 0;
+	context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	context.IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
+	context.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(DeviceRejectsBuffersD3D11Would)
+{
+	NullRenderDevice device;
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = 64;
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+	ID3D11Buffer* buffer = nullptr;
+	CHECK(FAILED(device.CreateBuffer(&desc, nullptr, &buffer)));
+	desc.ByteWidth = 0;
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	CHECK(FAILED(device.CreateBuffer(&desc, nullptr, &buffer)));
+	CHECK(buffer == nullptr);
+	CHECK_EQUAL(UINT64(0), device.GetResourceCount());
+
+	// Only dynamic buffers get memory to map
+	ID3D11Buffer* dynamicBuffer = CreateBuffer(device, 64, D3D11_USAGE_DYNAMIC, D3D11_BIND_VERTEX_BUFFER);
+	ID3D11Buffer* defaultBuffer = CreateBuffer(device, 64, D3D11_USAGE_DEFAULT, D3D11_BIND_VERTEX_BUFFER);
+	CHECK(NullRenderDevice::GetBufferMemory(dynamicBuffer) != nullptr);
+	CHECK(NullRenderDevice::GetBufferMemory(defaultBuffer) == nullptr);
+	CHECK_EQUAL(UINT64(2), device.GetResourceCount());
+
+	D3D11_BUFFER_DESC created;
+	dynamicBuffer->GetDesc(&created);
+	CHECK_EQUAL(64u, created.ByteWidth);
+	CHECK(created.Usage == D3D11_USAGE_DYNAMIC);
+
+	// Reference counted like the real thing
+	CHECK_EQUAL(2ul, static_cast<unsigned long>(dynamicBuffer->AddRef()));
+	CHECK_EQUAL(1ul, static_cast<unsigned long>(dynamicBuffer->Release()));
+	CHECK_EQUAL(0ul, static_cast<unsigned long>(dynamicBuffer->Release()));
+	defaultBuffer->Release();
+}
+
+TEST_CASE(RedundantStateChangesAreCounted)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+	ID3D11Buffer* vertexBuffer = CreateBuffer(device, 96, D3D11_USAGE_DEFAULT, D3D11_BIND_VERTEX_BUFFER);
+	ID3D11Buffer* indexBuffer = CreateBuffer(device, 6, D3D11_USAGE_DEFAULT, D3D11_BIND_INDEX_BUFFER);
+
+	BindMesh(context, vertexBuffer, indexBuffer);
+	CHECK_EQUAL(UINT64(3), context.GetStats().StateChanges);
+	CHECK_EQUAL(UINT64(0), context.GetStats().RedundantStateChanges);
+
+	// The same bindings again change nothing
+	BindMesh(context, vertexBuffer, indexBuffer);
+	CHECK_EQUAL(UINT64(6), context.GetStats().StateChanges);
+	CHECK_EQUAL(UINT64(3), context.GetStats().RedundantStateChanges);
+
+	context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+	CHECK_EQUAL(UINT64(3), context.GetStats().RedundantStateChanges);
+
+	context.ResetStats();
+	CHECK_EQUAL(UINT64(0), context.GetStats().StateChanges);
+
+	// Resetting the counts keeps the bindings
+	context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+	CHECK_EQUAL(UINT64(1), context.GetStats().RedundantStateChanges);
+	CHECK_EQUAL(UINT64(0), context.GetStats().ValidationErrors);
+
+	vertexBuffer->Release();
+	indexBuffer->Release();
+}
+
+TEST_CASE(DrawsAreCheckedAgainstTheBoundState)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+	ID3D11Buffer* vertexBuffer = CreateBuffer(device, 96, D3D11_USAGE_DEFAULT, D3D11_BIND_VERTEX_BUFFER);
+	ID3D11Buffer* indexBuffer = CreateBuffer(device, 12, D3D11_USAGE_DEFAULT, D3D11_BIND_INDEX_BUFFER);
+	ID3D11Buffer* instanceBuffer = CreateBuffer(device, 64 * 4, D3D11_USAGE_DYNAMIC, D3D11_BIND_VERTEX_BUFFER);
+
+	// Nothing bound, no topology, vertex buffer or index buffer
+	context.DrawIndexed(3, 0, 0);
+	CHECK_EQUAL(UINT64(3), context.GetStats().ValidationErrors);
+	CHECK_EQUAL(UINT64(1), context.GetStats().DrawCalls);
+	context.ResetStats();
+
+	// Six 16 bit indices fit, a seventh reads past the end
+	BindMesh(context, vertexBuffer, indexBuffer);
+	context.DrawIndexed(6, 0, 0);
+	CHECK_EQUAL(UINT64(0), context.GetStats().ValidationErrors);
+	CHECK_EQUAL(UINT64(2), context.GetStats().Triangles);
+	context.DrawIndexed(3, 4, 0);
+	CHECK_EQUAL(UINT64(1), context.GetStats().ValidationErrors);
+
+	// Four instances of 64 bytes fit in the instance buffer, starting at the second reads past it
+	context.ResetStats();
+	UINT stride = 64;
+	UINT offset = 0;
+	context.DrawIndexedInstanced(6, 4, 0, 0, 0);
+	CHECK_EQUAL(UINT64(1), context.GetStats().ValidationErrors);
+	context.IASetVertexBuffers(1, 1, &instanceBuffer, &stride, &offset);
+	context.DrawIndexedInstanced(6, 4, 0, 0, 0);
+	CHECK_EQUAL(UINT64(1), context.GetStats().ValidationErrors);
+	CHECK_EQUAL(UINT64(2 * 2 * 4), context.GetStats().Triangles);
+	context.DrawIndexedInstanced(6, 4, 0, 0, 1);
+	CHECK_EQUAL(UINT64(2), context.GetStats().ValidationErrors);
+
+	// Index buffers need an index format and the bind flag
+	context.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R8G8B8A8_UNORM, 0);
+	context.IASetIndexBuffer(vertexBuffer, DXGI_FORMAT_R16_UINT, 0);
+	CHECK_EQUAL(UINT64(4), context.GetStats().ValidationErrors);
+
+	std::stringstream report;
+	context.Print(report);
+	CHECK(report.str().find("Validation Errors: 4") != std::string::npos);
+	CHECK(report.str().find("reads past the end of the instance buffer") != std::string::npos);
+
+	vertexBuffer->Release();
+	indexBuffer->Release();
+	instanceBuffer->Release();
+}
+
+TEST_CASE(InstancedDrawsMayBuildVerticesFromTheVertexId)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+	ID3D11Buffer* indexBuffer = CreateBuffer(device, 12, D3D11_USAGE_DEFAULT, D3D11_BIND_INDEX_BUFFER);
+	ID3D11Buffer* instanceBuffer = CreateBuffer(device, 16 * 4, D3D11_USAGE_DYNAMIC, D3D11_BIND_VERTEX_BUFFER);
+
+	// Only the instances in slot 1, the way the terrain draws its patches
+	UINT stride = 16;
+	UINT offset = 0;
+	context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	context.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+	context.IASetVertexBuffers(1, 1, &instanceBuffer, &stride, &offset);
+	context.DrawIndexedInstanced(6, 4, 0, 0, 0);
+	CHECK_EQUAL(UINT64(0), context.GetStats().ValidationErrors);
+	CHECK_EQUAL(UINT64(2 * 4), context.GetStats().Triangles);
+
+	// The same draw without instancing has nothing to read its vertices from
+	context.DrawIndexed(6, 0, 0);
+	CHECK_EQUAL(UINT64(1), context.GetStats().ValidationErrors);
+
+	std::stringstream report;
+	context.Print(report);
+	CHECK(report.str().find("DrawIndexed without a vertex buffer in slot 0") != std::string::npos);
+
+	// Nor does an instanced draw with neither slot bound
+	NullRenderContext emptyContext;
+	emptyContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	emptyContext.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+	emptyContext.DrawIndexedInstanced(6, 1, 0, 0, 0);
+	CHECK_EQUAL(UINT64(1), emptyContext.GetStats().ValidationErrors);
+
+	indexBuffer->Release();
+	instanceBuffer->Release();
+}
+
+TEST_CASE(PatchIndicesAreVertexIdsOnThePatchGrid)
+{
+	const uint32_t resolution = 32;
+	const uint32_t vertsPerSide = resolution + 1;
+	const uint32_t halfResolution = resolution / 2;
+	std::vector<uint16_t> indices;
+	uint32_t partStart[TerrainNodePart_Count];
+	uint32_t partCount[TerrainNodePart_Count];
+	TerrainQuadtree::BuildPatchIndices(resolution, indices, partStart, partCount);
+
+	// Two triangles a cell, each quadrant a quarter of them and the whole patch all of them
+	CHECK_EQUAL(size_t(6 * resolution * resolution), indices.size());
+	for (uint32_t part = 0; part < TerrainNodePart_Whole; part++)
+	{
+		CHECK_EQUAL(part * 6 * halfResolution * halfResolution, partStart[part]);
+		CHECK_EQUAL(6 * halfResolution * halfResolution, partCount[part]);
+	}
+	CHECK_EQUAL(0u, partStart[TerrainNodePart_Whole]);
+	CHECK_EQUAL(static_cast<uint32_t>(indices.size()), partCount[TerrainNodePart_Whole]);
+
+	// Turned back into grid positions the way HeightmapSampler.hlsl does, every triangle is half a cell of its own
+	// quadrant, wound the same way, and every cell is covered exactly twice
+	std::vector<int> cellTriangles(resolution * resolution, 0);
+	for (uint32_t part = 0; part < TerrainNodePart_Whole; part++)
+	{
+		const uint32_t firstColumn = (part & 1) * halfResolution;
+		const uint32_t firstRow = (part >> 1) * halfResolution;
+
+		for (uint32_t triangle = 0; triangle < partCount[part] / 3; triangle++)
+		{
+			int x[3];
+			int z[3];
+			for (uint32_t corner = 0; corner < 3; corner++)
+			{
+				const uint16_t vertexId = indices[partStart[part] + triangle * 3 + corner];
+				CHECK(vertexId < vertsPerSide * vertsPerSide);
+				x[corner] = vertexId % vertsPerSide;
+				z[corner] = vertexId / vertsPerSide;
+			}
+
+			const int cellX = (std::min)({ x[0], x[1], x[2] });
+			const int cellZ = (std::min)({ z[0], z[1], z[2] });
+			CHECK((std::max)({ x[0], x[1], x[2] }) == cellX + 1 && (std::max)({ z[0], z[1], z[2] }) == cellZ + 1);
+			CHECK(cellX >= static_cast<int>(firstColumn) && cellX < static_cast<int>(firstColumn + halfResolution));
+			CHECK(cellZ >= static_cast<int>(firstRow) && cellZ < static_cast<int>(firstRow + halfResolution));
+			CHECK((x[1] - x[0]) * (z[2] - z[0]) - (z[1] - z[0]) * (x[2] - x[0]) < 0);
+
+			cellTriangles[cellZ * resolution + cellX]++;
+		}
+	}
+	for (int count : cellTriangles)
+	{
+		CHECK_EQUAL(2, count);
+	}
+
+	// Drawn from a 16 bit index buffer with only the node instances bound, as Terrain::Draw does
+	NullRenderDevice device;
+	NullRenderContext context;
+	D3D11_BUFFER_DESC desc = {};
+	desc.ByteWidth = static_cast<UINT>(sizeof(uint16_t) * indices.size());
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+	D3D11_SUBRESOURCE_DATA initialData = { indices.data() };
+	ID3D11Buffer* indexBuffer = nullptr;
+	CHECK(SUCCEEDED(device.CreateBuffer(&desc, &initialData, &indexBuffer)));
+	ID3D11Buffer* instanceBuffer = CreateBuffer(device, 16 * 8, D3D11_USAGE_DYNAMIC, D3D11_BIND_VERTEX_BUFFER);
+
+	UINT stride = 16;
+	UINT offset = 0;
+	context.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	context.IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+	context.IASetVertexBuffers(1, 1, &instanceBuffer, &stride, &offset);
+	for (uint32_t part = 0; part < TerrainNodePart_Count; part++)
+	{
+		context.DrawIndexedInstanced(partCount[part], 2, partStart[part], 0, part);
+	}
+	CHECK_EQUAL(UINT64(0), context.GetStats().ValidationErrors);
+
+	// The largest patch 16 bit indices can address still reaches its last vertex without wrapping
+	TerrainQuadtree::BuildPatchIndices(254, indices, partStart, partCount);
+	CHECK_EQUAL(uint16_t(255 * 255 - 1), *std::max_element(indices.begin(), indices.end()));
+
+	indexBuffer->Release();
+	instanceBuffer->Release();
+}
+
+TEST_CASE(MappedWritesReachTheBuffer)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+	ID3D11Buffer* dynamicBuffer = CreateBuffer(device, 16, D3D11_USAGE_DYNAMIC, D3D11_BIND_CONSTANT_BUFFER);
+	ID3D11Buffer* defaultBuffer = CreateBuffer(device, 16, D3D11_USAGE_DEFAULT, D3D11_BIND_CONSTANT_BUFFER);
+
+	D3D11_MAPPED_SUBRESOURCE mapped = {};
+	CHECK(SUCCEEDED(context.Map(dynamicBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)));
+	CHECK(mapped.pData == NullRenderDevice::GetBufferMemory(dynamicBuffer));
+	const float values[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+	memcpy(mapped.pData, values, sizeof(values));
+
+	// Mapping twice and drawing while mapped are both errors
+	CHECK(FAILED(context.Map(dynamicBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)));
+	context.DrawIndexed(0, 0, 0);
+	CHECK(context.GetStats().ValidationErrors >= 2);
+	context.ResetStats();
+
+	context.Unmap(dynamicBuffer, 0);
+	CHECK(memcmp(NullRenderDevice::GetBufferMemory(dynamicBuffer), values, sizeof(values)) == 0);
+	CHECK_EQUAL(UINT64(0), context.GetStats().ValidationErrors);
+
+	// Only dynamic buffers are written through Map, and only with a discard
+	CHECK(FAILED(context.Map(defaultBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)));
+	CHECK(FAILED(context.Map(dynamicBuffer, 0, D3D11_MAP_WRITE, 0, &mapped)));
+	context.Unmap(defaultBuffer, 0);
+	CHECK_EQUAL(UINT64(3), context.GetStats().ValidationErrors);
+	CHECK_EQUAL(UINT64(0), context.GetStats().Maps);
+
+	// Constant buffers have to be a multiple of 16 bytes
+	ID3D11Buffer* oddBuffer = CreateBuffer(device, 20, D3D11_USAGE_DYNAMIC, D3D11_BIND_CONSTANT_BUFFER);
+	context.VSSetConstantBuffers(0, 1, &dynamicBuffer);
+	CHECK_EQUAL(UINT64(3), context.GetStats().ValidationErrors);
+	context.PSSetConstantBuffers(0, 1, &oddBuffer);
+	CHECK_EQUAL(UINT64(4), context.GetStats().ValidationErrors);
+
+	dynamicBuffer->Release();
+	defaultBuffer->Release();
+	oddBuffer->Release();
+}
+
+TEST_CASE(TextureUpdatesStayInsideTheTexture)
+{
+	NullRenderDevice device;
+	NullRenderContext context;
+
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width = 8;
+	desc.Height = 4;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	desc.SampleDesc.Count = 1;
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	ID3D11ShaderResourceView* view = nullptr;
+	CHECK(SUCCEEDED(device.CreateTexture(&desc, nullptr, &view)));
+	ID3D11Resource* texture = nullptr;
+	view->GetResource(&texture);
+	CHECK(texture != nullptr);
+
+	std::vector<unsigned char> pixels(8 * 4 * 4, 0);
+	context.UpdateSubresource(texture, 0, nullptr, pixels.data(), 8 * 4, 0);
+	CHECK_EQUAL(UINT64(1), context.GetStats().Updates);
+	CHECK_EQUAL(UINT64(8 * 4 * 4), context.GetStats().UpdatedBytes);
+
+	// Two rows in the middle, then a box that runs off the bottom
+	D3D11_BOX rows = { 0, 1, 0, 8, 3, 1 };
+	context.UpdateSubresource(texture, 0, &rows, pixels.data(), 8 * 4, 0);
+	CHECK_EQUAL(UINT64(8 * 4 * 6), context.GetStats().UpdatedBytes);
+	D3D11_BOX outside = { 0, 2, 0, 8, 5, 1 };
+	context.UpdateSubresource(texture, 0, &outside, pixels.data(), 8 * 4, 0);
+	CHECK_EQUAL(UINT64(2), context.GetStats().Updates);
+	CHECK_EQUAL(UINT64(1), context.GetStats().ValidationErrors);
+
+	// Buffers are written through Map instead
+	ID3D11Buffer* buffer = CreateBuffer(device, 16, D3D11_USAGE_DEFAULT, D3D11_BIND_CONSTANT_BUFFER);
+	context.UpdateSubresource(buffer, 0, nullptr, pixels.data(), 16, 0);
+	CHECK_EQUAL(UINT64(2), context.GetStats().ValidationErrors);
+
+	buffer->Release();
+	texture->Release();
+	view->Release();
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Include{s}
+#include "TestFramework.h"
+#include "OcclusionCuller.h"
+#include "FrameArena.h"
+#include <random>
+
+using namespace DirectX;
+
+// Times rasterizing a field of box occluders into the depth buffer and testing boxes against it, at the app's
+// 256 x 144 and at twice and four times that, with how many of the tested boxes came out hidden
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const uint32_t scales[] = { 1, 2, 4 };
+	const uint32_t scaleCount = smoke ? 1 : 3;
+	const int repeats = smoke ? 2 : 50;
+	const int occluderCount = 64;
+	const int boxCount = 10000;
+
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 2.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 2.0f, 1.0f, 1.0f),
+		XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 500.0f);
+	XMMATRIX viewProjection = XMMatrixMultiply(view, projection);
+
+	// Unit cube, twelve triangles
+	CPUMeshData cube;
+	for (int corner = 0; corner < 8; corner++)
+	{
+		cube.Positions.push_back(XMFLOAT3(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f,
+			corner & 4 ? 1.0f : -1.0f));
+	}
+	cube.Indices = { 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3,
+		7, 1, 7, 5 };
+
+	// Buildings in front of the camera and small props scattered among and behind them
+	std::mt19937 random(77);
+	std::uniform_real_distribution<float> spread(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> depth(10.0f, 200.0f);
+	std::uniform_real_distribution<float> size(0.2f, 2.0f);
+
+	std::vector<XMMATRIX> occluders;
+	for (int i = 0; i < occluderCount; i++)
+	{
+		float x = spread(random);
+		float z = depth(random);
+		occluders.push_back(XMMatrixScaling(4.0f, 8.0f, 4.0f) * XMMatrixTranslation(x, 8.0f, z));
+	}
+
+	std::vector<XMFLOAT3> centers(boxCount);
+	std::vector<XMFLOAT3> extents(boxCount);
+	for (int i = 0; i < boxCount; i++)
+	{
+		centers[i].x = spread(random);
+		centers[i].y = 1.0f;
+		centers[i].z = depth(random);
+		extents[i].x = size(random);
+		extents[i].y = size(random);
+		extents[i].z = size(random);
+	}
+
+	printf("%12s %14s %14s %10s %10s\n", "Buffer", "Rasterize ms", "Test ms", "Triangles", "Hidden");
+
+	for (uint32_t s = 0; s < scaleCount; s++)
+	{
+		OcclusionCuller culler(256 * scales[s], 144 * scales[s]);
+
+		BenchmarkTimer rasterizeTimer;
+		for (int r = 0; r < repeats; r++)
+		{
+			FrameArena::GetInstance()->BeginFrame();
+			culler.Clear(viewProjection);
+			for (const XMMATRIX& world : occluders)
+			{
+				culler.RasterizeOccluder(cube, world);
+			}
+		}
+		double rasterizeMs = rasterizeTimer.GetElapsedMilliseconds() / repeats;
+
+		int hidden = 0;
+		BenchmarkTimer testTimer;
+		for (int r = 0; r < repeats; r++)
+		{
+			hidden = 0;
+			for (int i = 0; i < boxCount; i++)
+			{
+				hidden += culler.IsOccluded(centers[i], extents[i]) ? 1 : 0;
+			}
+		}
+		double testMs = testTimer.GetElapsedMilliseconds() / repeats;
+
+		printf("%7ux%-4u %14.4f %14.4f %10u %10d\n", culler.GetWidth(), culler.GetHeight(), rasterizeMs, testMs,
+			culler.GetTriangleCount(), hidden);
+
+		if (hidden == 0 || hidden == boxCount)
+		{
+			printf("Every box came out the same, the benchmark scene is broken\n");
+			return 1;
+		}
+	}
+
+	return 0;
+}
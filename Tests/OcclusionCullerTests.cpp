@@ -0,0 +1,328 @@
+// Include{s}
+#include "TestFramework.h"
+#include "OcclusionCuller.h"
+#include "FrameArena.h"
+#include <cfloat>
+#include <random>
+
+using namespace DirectX;
+
+#pragma region Helper Functions
+// Camera at the origin looking down +Z, 16:9 with a 60 degree view from 0.5 to 200 units
+static XMMATRIX CreateViewProjection()
+{
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 1.0f),
+		XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PI / 3.0f, 16.0f / 9.0f, 0.5f, 200.0f);
+
+	return XMMatrixMultiply(view, projection);
+}
+
+// Builds a unit quad in the XY plane, facing -Z, as two triangles
+static CPUMeshData CreateQuad()
+{
+	CPUMeshData quad;
+	quad.Positions = { XMFLOAT3(-1.0f, -1.0f, 0.0f), XMFLOAT3(-1.0f, 1.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 0.0f),
+		XMFLOAT3(1.0f, -1.0f, 0.0f) };
+	quad.Indices = { 0, 1, 2, 0, 2, 3 };
+
+	return quad;
+}
+
+// Builds a unit cube, twelve triangles
+static CPUMeshData CreateCube()
+{
+	CPUMeshData cube;
+	for (int corner = 0; corner < 8; corner++)
+	{
+		cube.Positions.push_back(XMFLOAT3(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f,
+			corner & 4 ? 1.0f : -1.0f));
+	}
+	cube.Indices = { 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3,
+		7, 1, 7, 5 };
+
+	return cube;
+}
+
+// Scalar reference rasterizer, one pixel at a time in double precision with the same rules as the culler: pixel
+// centres inside every edge of either winding are covered, and keep the nearest of the conservative depths
+class ReferenceRasterizer
+{
+public:
+	ReferenceRasterizer(uint32_t width, uint32_t height, FXMMATRIX viewProjection)
+		: m_width(width), m_height(height), m_depth(width * height, 1.0)
+	{
+		XMStoreFloat4x4(&m_viewProjection, viewProjection);
+	}
+
+	void RasterizeOccluder(const CPUMeshData& mesh, FXMMATRIX world)
+	{
+		XMFLOAT4X4 worldViewProjection;
+		XMStoreFloat4x4(&worldViewProjection, world * XMLoadFloat4x4(&m_viewProjection));
+
+		std::vector<XMFLOAT3> screen(mesh.Positions.size());
+		std::vector<bool> behind(mesh.Positions.size());
+		for (size_t i = 0; i < mesh.Positions.size(); i++)
+		{
+			const XMFLOAT3& position = mesh.Positions[i];
+			XMFLOAT4 clip;
+			XMStoreFloat4(&clip, XMVector4Transform(XMVectorSet(position.x, position.y, position.z, 1.0f),
+				XMLoadFloat4x4(&worldViewProjection)));
+
+			behind[i] = clip.z < 0.0f || clip.w <= 0.0f;
+			screen[i] = XMFLOAT3((clip.x / clip.w * 0.5f + 0.5f) * m_width, (0.5f - clip.y / clip.w * 0.5f) * m_height,
+				clip.z / clip.w);
+		}
+
+		for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+		{
+			if (!behind[mesh.Indices[i]] && !behind[mesh.Indices[i + 1]] && !behind[mesh.Indices[i + 2]])
+			{
+				RasterizeTriangle(screen[mesh.Indices[i]], screen[mesh.Indices[i + 1]], screen[mesh.Indices[i + 2]]);
+			}
+		}
+	}
+
+	const std::vector<double>& GetDepthBuffer() const { return m_depth; }
+
+private:
+	void RasterizeTriangle(const XMFLOAT3& a, const XMFLOAT3& b, const XMFLOAT3& c)
+	{
+		double area = (double(b.x) - a.x) * (double(c.y) - a.y) - (double(c.x) - a.x) * (double(b.y) - a.y);
+		if (fabs(area) < 1e-6)
+		{
+			return;
+		}
+
+		double depthX = ((double(b.z) - a.z) * (double(c.y) - a.y) - (double(c.z) - a.z) * (double(b.y) - a.y)) / area;
+		double depthY = ((double(c.z) - a.z) * (double(b.x) - a.x) - (double(b.z) - a.z) * (double(c.x) - a.x)) / area;
+		double slack = 0.5 * (fabs(depthX) + fabs(depthY));
+		double maxDepth = fmax(a.z, fmax(b.z, c.z));
+
+		const XMFLOAT3* corners[3] = { &a, &b, &c };
+		for (uint32_t y = 0; y < m_height; y++)
+		{
+			for (uint32_t x = 0; x < m_width; x++)
+			{
+				double pixelX = x + 0.5;
+				double pixelY = y + 0.5;
+
+				// Inside when every edge function has the same sign as the area
+				bool inside = true;
+				for (int e = 0; e < 3; e++)
+				{
+					const XMFLOAT3& start = *corners[e];
+					const XMFLOAT3& end = *corners[(e + 1) % 3];
+					double edge = (double(end.x) - start.x) * (pixelY - start.y) -
+						(double(end.y) - start.y) * (pixelX - start.x);
+					inside = inside && (area > 0.0 ? edge >= 0.0 : edge <= 0.0);
+				}
+
+				if (inside)
+				{
+					double depth = a.z + depthX * (pixelX - a.x) + depthY * (pixelY - a.y) + slack;
+					double& stored = m_depth[y * m_width + x];
+					stored = fmin(stored, fmin(depth, maxDepth));
+				}
+			}
+		}
+	}
+
+	uint32_t m_width;
+	uint32_t m_height;
+	std::vector<double> m_depth;
+	XMFLOAT4X4 m_viewProjection;
+};
+
+// Counts pixels the culler and the reference disagree on, pixels covered by only one of them are allowed where an
+// edge passes right through the pixel centre, so only a sliver of them may differ
+static uint32_t CountDepthMismatches(const OcclusionCuller& culler, const ReferenceRasterizer& reference,
+	uint32_t& coveredPixels)
+{
+	const std::vector<float>& depth = culler.GetDepthBuffer();
+	const std::vector<double>& expected = reference.GetDepthBuffer();
+
+	uint32_t mismatches = 0;
+	coveredPixels = 0;
+	for (size_t i = 0; i < depth.size(); i++)
+	{
+		coveredPixels += expected[i] < 1.0 ? 1 : 0;
+		mismatches += fabs(depth[i] - expected[i]) > 1e-4 ? 1 : 0;
+	}
+
+	return mismatches;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(WidthRoundsUpToWholeBlocks)
+{
+	OcclusionCuller culler(250, 10);
+	CHECK_EQUAL(252u, culler.GetWidth());
+	CHECK_EQUAL(10u, culler.GetHeight());
+	CHECK_EQUAL(size_t(252 * 10), culler.GetDepthBuffer().size());
+}
+
+TEST_CASE(DepthBufferMatchesReference)
+{
+	const XMMATRIX viewProjection = CreateViewProjection();
+	const CPUMeshData cube = CreateCube();
+	const CPUMeshData quad = CreateQuad();
+
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> distance(2.0f, 80.0f);
+	std::uniform_real_distribution<float> angle(0.0f, XM_2PI);
+	std::uniform_real_distribution<float> size(0.5f, 8.0f);
+
+	for (int scene = 0; scene < 8; scene++)
+	{
+		OcclusionCuller culler(128, 72);
+		ReferenceRasterizer reference(culler.GetWidth(), culler.GetHeight(), viewProjection);
+		culler.Clear(viewProjection);
+
+		// A mix of turned cubes and quads, some in front of each other and some partly off screen
+		for (int occluder = 0; occluder < 12; occluder++)
+		{
+			XMMATRIX world = XMMatrixScaling(size(random), size(random), size(random));
+			world = world * XMMatrixRotationRollPitchYaw(angle(random), angle(random), angle(random));
+			float x = position(random);
+			float y = position(random);
+			world = world * XMMatrixTranslation(x, y, distance(random));
+
+			const CPUMeshData& mesh = occluder % 2 ? cube : quad;
+			culler.RasterizeOccluder(mesh, world);
+			reference.RasterizeOccluder(mesh, world);
+			FrameArena::GetInstance()->BeginFrame();
+		}
+
+		uint32_t coveredPixels = 0;
+		uint32_t mismatches = CountDepthMismatches(culler, reference, coveredPixels);
+		CHECK(coveredPixels > 0);
+		CHECK(mismatches * 100 <= coveredPixels);
+	}
+}
+
+TEST_CASE(TrianglesBehindTheCameraAreSkipped)
+{
+	OcclusionCuller culler(64, 36);
+	culler.Clear(CreateViewProjection());
+
+	// The quad straddles the camera, so both triangles have a vertex behind the near plane
+	culler.RasterizeOccluder(CreateQuad(), XMMatrixScaling(10.0f, 10.0f, 10.0f) * XMMatrixRotationX(XM_PIDIV2));
+
+	CHECK_EQUAL(0u, culler.GetTriangleCount());
+	for (float depth : culler.GetDepthBuffer())
+	{
+		CHECK_EQUAL(1.0f, depth);
+	}
+
+	// Clear resets the buffer and the count
+	culler.RasterizeOccluder(CreateQuad(), XMMatrixScaling(2.0f, 2.0f, 1.0f) * XMMatrixTranslation(0.0f, 0.0f, 10.0f));
+	CHECK_EQUAL(2u, culler.GetTriangleCount());
+	culler.Clear(CreateViewProjection());
+	CHECK_EQUAL(0u, culler.GetTriangleCount());
+	CHECK_EQUAL(1.0f, culler.GetDepthBuffer()[36 / 2 * 64 + 32]);
+}
+
+TEST_CASE(WallHidesOnlyWhatIsFullyBehindIt)
+{
+	OcclusionCuller culler(128, 72);
+	culler.Clear(CreateViewProjection());
+
+	// A 20 x 20 wall ten units away
+	XMMATRIX wall = XMMatrixScaling(10.0f, 10.0f, 1.0f) * XMMatrixTranslation(0.0f, 0.0f, 10.0f);
+	culler.RasterizeOccluder(CreateQuad(), wall);
+	const XMFLOAT3 unit(1.0f, 1.0f, 1.0f);
+
+	CHECK(culler.IsOccluded(XMFLOAT3(0.0f, 0.0f, 30.0f), unit));
+	CHECK(culler.IsOccluded(XMFLOAT3(4.0f, -4.0f, 50.0f), unit));
+
+	// In front of the wall, poking out past its edge, touching the camera, and off screen
+	CHECK(!culler.IsOccluded(XMFLOAT3(0.0f, 0.0f, 5.0f), unit));
+	CHECK(!culler.IsOccluded(XMFLOAT3(11.0f, 0.0f, 12.0f), unit));
+	CHECK(!culler.IsOccluded(XMFLOAT3(30.0f, 0.0f, 30.0f), unit));
+	CHECK(!culler.IsOccluded(XMFLOAT3(0.0f, 0.0f, 0.0f), unit));
+	CHECK(!culler.IsOccluded(XMFLOAT3(500.0f, 0.0f, 30.0f), unit));
+
+	// A box that passes through the wall is partly in front of it
+	CHECK(!culler.IsOccluded(XMFLOAT3(0.0f, 0.0f, 10.0f), unit));
+}
+
+TEST_CASE(IsOccludedMatchesReferenceDepth)
+{
+	const XMMATRIX viewProjection = CreateViewProjection();
+	OcclusionCuller culler(128, 72);
+	culler.Clear(viewProjection);
+	for (int i = 0; i < 6; i++)
+	{
+		float x = i * 6.0f - 15.0f;
+		culler.RasterizeOccluder(CreateCube(), XMMatrixScaling(3.0f, 6.0f, 1.0f) * XMMatrixTranslation(x, 0.0f, 15.0f));
+	}
+
+	const std::vector<float>& depth = culler.GetDepthBuffer();
+	std::mt19937 random(9);
+	std::uniform_real_distribution<float> position(-25.0f, 25.0f);
+	std::uniform_real_distribution<float> distance(1.0f, 60.0f);
+	std::uniform_real_distribution<float> size(0.1f, 3.0f);
+	int occluded = 0;
+
+	for (int box = 0; box < 2000; box++)
+	{
+		XMFLOAT3 center;
+		center.x = position(random);
+		center.y = position(random);
+		center.z = distance(random);
+		XMFLOAT3 extents;
+		extents.x = size(random);
+		extents.y = size(random);
+		extents.z = size(random);
+
+		// Screen rectangle and nearest depth of the corners, one pixel at a time against the stored depths
+		float minX = FLT_MAX;
+		float minY = FLT_MAX;
+		float maxX = -FLT_MAX;
+		float maxY = -FLT_MAX;
+		float nearest = FLT_MAX;
+		bool expected = true;
+		for (int corner = 0; corner < 8 && expected; corner++)
+		{
+			XMVECTOR position = XMVectorSet(
+				center.x + (corner & 1 ? extents.x : -extents.x),
+				center.y + (corner & 2 ? extents.y : -extents.y),
+				center.z + (corner & 4 ? extents.z : -extents.z),
+				1.0f);
+			XMFLOAT4 clip;
+			XMStoreFloat4(&clip, XMVector4Transform(position, viewProjection));
+
+			expected = clip.z >= 0.0f && clip.w > 0.0f;
+			float x = (clip.x / clip.w * 0.5f + 0.5f) * culler.GetWidth();
+			float y = (0.5f - clip.y / clip.w * 0.5f) * culler.GetHeight();
+			minX = fminf(minX, x);
+			maxX = fmaxf(maxX, x);
+			minY = fminf(minY, y);
+			maxY = fmaxf(maxY, y);
+			nearest = fminf(nearest, clip.z / clip.w);
+		}
+
+		int pixelMinX = static_cast<int>(floorf(fmaxf(minX, 0.0f)));
+		int pixelMinY = static_cast<int>(floorf(fmaxf(minY, 0.0f)));
+		int pixelMaxX = static_cast<int>(ceilf(fminf(maxX, static_cast<float>(culler.GetWidth())))) - 1;
+		int pixelMaxY = static_cast<int>(ceilf(fminf(maxY, static_cast<float>(culler.GetHeight())))) - 1;
+		expected = expected && pixelMinX <= pixelMaxX && pixelMinY <= pixelMaxY;
+
+		for (int y = pixelMinY; expected && y <= pixelMaxY; y++)
+		{
+			for (int x = pixelMinX; expected && x <= pixelMaxX; x++)
+			{
+				expected = depth[y * culler.GetWidth() + x] < nearest;
+			}
+		}
+
+		CHECK_EQUAL(expected, culler.IsOccluded(center, extents));
+		occluded += expected ? 1 : 0;
+	}
+
+	CHECK(occluded > 0);
+}
+#pragma endregion
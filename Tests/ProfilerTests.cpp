@@ -0,0 +1,141 @@
+// Include{s}
+#include "TestFramework.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#pragma region Helper Functions
+// Finds the statistics of every scope with a name, the profiler is a singleton so each test uses its own names
+static std::vector<ProfileScopeStats> FindStats(const char* name)
+{
+	std::vector<ProfileScopeStats> found;
+	for (const ProfileScopeStats& stats : Profiler::GetInstance()->GetScopeStats())
+	{
+		if (strcmp(stats.Name, name) == 0)
+		{
+			found.push_back(stats);
+		}
+	}
+
+	return found;
+}
+
+// Opens a scope called Shared, from wherever it is called
+static void SharedFunction()
+{
+	PROFILE_SCOPE("Shared");
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(ScopesAreKeptApartByTheirParents)
+{
+	Profiler* profiler = Profiler::GetInstance();
+	profiler->BeginFrame();
+
+	for (int call = 0; call < 3; call++)
+	{
+		PROFILE_SCOPE("FirstCaller");
+		SharedFunction();
+		SharedFunction();
+	}
+	{
+		PROFILE_SCOPE("SecondCaller");
+		SharedFunction();
+	}
+	profiler->BeginFrame();
+
+	// Same name and depth, but under different parents
+	std::vector<ProfileScopeStats> shared = FindStats("Shared");
+	CHECK_EQUAL(size_t(2), shared.size());
+	if (shared.size() == 2)
+	{
+		CHECK_EQUAL(1u, shared[0].Depth);
+		CHECK_EQUAL(1u, shared[1].Depth);
+
+		const float calls[2] = { shared[0].CallsPerFrame, shared[1].CallsPerFrame };
+		CHECK((calls[0] == 6.0f && calls[1] == 1.0f) || (calls[0] == 1.0f && calls[1] == 6.0f));
+	}
+
+	CHECK_EQUAL(size_t(1), FindStats("FirstCaller").size());
+	CHECK_EQUAL(0u, Profiler::GetThreadDepth());
+}
+
+TEST_CASE(CopiesOfANameInOtherStringsMatch)
+{
+	Profiler* profiler = Profiler::GetInstance();
+	profiler->BeginFrame();
+
+	// Two arrays holding the same text, as __FUNCTION__ can be in two translation units
+	static const char firstCopy[] = "CopiedName";
+	static const char secondCopy[] = "CopiedName";
+	{
+		PROFILE_SCOPE(firstCopy);
+	}
+	{
+		PROFILE_SCOPE(secondCopy);
+	}
+	profiler->BeginFrame();
+
+	std::vector<ProfileScopeStats> copied = FindStats("CopiedName");
+	CHECK_EQUAL(size_t(1), copied.size());
+	CHECK(!copied.empty() && copied[0].CallsPerFrame == 2.0f);
+}
+
+TEST_CASE(WriteChromeTraceDoesNotCloseTheFrame)
+{
+	Profiler* profiler = Profiler::GetInstance();
+	profiler->BeginFrame();
+
+	{
+		PROFILE_SCOPE("BeforeTrace");
+	}
+	const std::string path = "ProfilerTests_trace.json";
+	CHECK(profiler->WriteChromeTrace(path));
+
+	// The trace has the event, but the frame it belongs to is still open
+	std::ifstream file(path);
+	std::stringstream contents;
+	contents << file.rdbuf();
+	file.close();
+	std::remove(path.c_str());
+	CHECK(contents.str().find("\"name\":\"BeforeTrace\"") != std::string::npos);
+	CHECK(contents.str().find("\"traceEvents\"") != std::string::npos);
+	CHECK(FindStats("BeforeTrace").empty());
+
+	// The rest of the frame is added to the same sample when it closes
+	{
+		PROFILE_SCOPE("BeforeTrace");
+	}
+	profiler->BeginFrame();
+
+	std::vector<ProfileScopeStats> stats = FindStats("BeforeTrace");
+	CHECK_EQUAL(size_t(1), stats.size());
+	CHECK(!stats.empty() && stats[0].CallsPerFrame == 2.0f);
+}
+
+TEST_CASE(OtherThreadsAreDrained)
+{
+	Profiler* profiler = Profiler::GetInstance();
+	profiler->BeginFrame();
+
+	// The thread has exited and handed its buffer back before the frame closes
+	std::thread worker([]()
+	{
+		PROFILE_THREAD("Worker");
+		PROFILE_SCOPE("WorkerScope");
+		SharedFunction();
+	});
+	worker.join();
+	profiler->BeginFrame();
+
+	std::vector<ProfileScopeStats> stats = FindStats("WorkerScope");
+	CHECK_EQUAL(size_t(1), stats.size());
+	CHECK(!stats.empty() && stats[0].Depth == 0 && stats[0].MinMs >= 0.0f);
+
+	// Shared under the worker's scope is a third path
+	CHECK_EQUAL(size_t(3), FindStats("Shared").size());
+}
+#pragma endregion
@@ -0,0 +1,177 @@
+// Include{s}
+#include "TestFramework.h"
+#include "SceneBVH.h"
+#include <cfloat>
+#include <random>
+
+using namespace DirectX;
+
+// Times building, refitting and querying the hierarchy over 1k, 100k and 1M random boxes, with the frustum query
+// compared against culling every box with FrustumCuller::Cull. Then times one QueryFrustums walk for 1 to 16
+// overlapping views, as the monitor wall draws them, against a QueryFrustum call per view
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const uint32_t counts[] = { 1000, 100000, 1000000 };
+	const uint32_t countCount = smoke ? 1 : 3;
+	const int queries = smoke ? 4 : 64;
+	const uint32_t viewCounts[] = { 1, 2, 4, 8, 16 };
+	const int viewRepeats = smoke ? 1 : 16;
+	char viewRows[3][5][96];
+
+	printf("%10s %10s %10s %12s %12s %12s\n", "Objects", "Build ms", "Refit ms", "Query ms", "Cull ms", "Ray us");
+
+	for (uint32_t c = 0; c < countCount; c++)
+	{
+		const uint32_t count = counts[c];
+
+		// Boxes spread so the density stays about the same as the count grows
+		const float worldSize = 10.0f * cbrtf(static_cast<float>(count));
+		std::mt19937 random(42);
+		std::uniform_real_distribution<float> position(-worldSize, worldSize);
+		std::uniform_real_distribution<float> size(0.5f, 4.0f);
+
+		std::vector<XMFLOAT3> centers(count);
+		std::vector<XMFLOAT3> extents(count);
+		FrustumCuller culler;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			centers[i] = XMFLOAT3(position(random), position(random), position(random));
+			extents[i] = XMFLOAT3(size(random), size(random), size(random));
+		}
+
+		SceneBVH bvh;
+		BenchmarkTimer buildTimer;
+		bvh.Build(centers, extents);
+		double buildMs = buildTimer.GetElapsedMilliseconds();
+
+		// Nudge every box and refit, as a frame of moving objects would
+		for (uint32_t i = 0; i < count; i++)
+		{
+			centers[i].x += 0.25f;
+			bvh.UpdatePrimitive(i, centers[i], extents[i]);
+			culler.AddBounds(centers[i], extents[i]);
+		}
+		BenchmarkTimer refitTimer;
+		bvh.Refit();
+		double refitMs = refitTimer.GetElapsedMilliseconds();
+
+		// Cameras inside the scene looking in random directions, a quarter of the world deep
+		std::vector<FrustumCuller> frustums(queries);
+		for (FrustumCuller& frustum : frustums)
+		{
+			XMVECTOR eye = XMVectorSet(position(random) * 0.5f, position(random) * 0.5f, position(random) * 0.5f, 1.0f);
+			XMVECTOR target = XMVectorSet(position(random), position(random), position(random), 1.0f);
+			XMMATRIX view = XMMatrixLookAtLH(eye, target, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+			XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, worldSize * 0.5f);
+			frustum.ExtractPlanes(XMMatrixMultiply(view, projection));
+		}
+
+		std::vector<uint32_t> results;
+		size_t bvhVisible = 0;
+		BenchmarkTimer queryTimer;
+		for (int q = 0; q < queries; q++)
+		{
+			bvh.QueryFrustum(frustums[q], results);
+			bvhVisible += results.size();
+		}
+		double queryMs = queryTimer.GetElapsedMilliseconds() / queries;
+
+		BenchmarkTimer cullTimer;
+		for (int q = 0; q < queries; q++)
+		{
+			culler.SetPlanes(frustums[q].GetPlanes());
+			culler.Cull(results);
+		}
+		double cullMs = cullTimer.GetElapsedMilliseconds() / queries;
+
+		uint32_t hit = 0;
+		float distance = 0.0f;
+		const int rays = queries * 16;
+		BenchmarkTimer rayTimer;
+		for (int r = 0; r < rays; r++)
+		{
+			XMFLOAT3 origin(position(random), position(random), position(random));
+			XMFLOAT3 direction(-origin.x, -origin.y, -origin.z);
+			bvh.RayCast(origin, direction, FLT_MAX, hit, distance);
+		}
+		double rayUs = rayTimer.GetElapsedMilliseconds() * 1000.0 / rays;
+
+		printf("%10u %10.3f %10.3f %12.4f %12.4f %12.3f\n", count, buildMs, refitMs, queryMs, cullMs, rayUs);
+
+		if (bvhVisible == 0)
+		{
+			printf("No query saw anything, the benchmark scene is broken\n");
+			return 1;
+		}
+
+		// A monitor wall of cameras on a ring round the middle of the scene, all looking in at it, so the views
+		// overlap the way the scene cameras do
+		std::vector<FrustumCuller> views(16);
+		for (uint32_t view = 0; view < 16; view++)
+		{
+			const float angle = XM_2PI * static_cast<float>(view) / 16.0f;
+			XMVECTOR eye = XMVectorSet(cosf(angle) * worldSize * 0.25f, worldSize * 0.05f,
+				sinf(angle) * worldSize * 0.25f, 1.0f);
+			XMMATRIX viewMatrix = XMMatrixLookAtLH(eye, XMVectorZero(), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+			XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, worldSize * 0.5f);
+			views[view].ExtractPlanes(XMMatrixMultiply(viewMatrix, projection));
+		}
+
+		// One walk for every view against a walk per view, both have to find the same primitives
+		std::vector<uint64_t> visibility;
+		for (uint32_t v = 0; v < 5; v++)
+		{
+			const uint32_t viewCount = viewCounts[v];
+
+			size_t multiVisible = 0;
+			BenchmarkTimer multiTimer;
+			for (int repeat = 0; repeat < viewRepeats; repeat++)
+			{
+				bvh.QueryFrustums(views.data(), viewCount, visibility);
+			}
+			double multiMs = multiTimer.GetElapsedMilliseconds() / viewRepeats;
+			for (uint64_t mask : visibility)
+			{
+				for (; mask != 0; mask &= mask - 1)
+				{
+					multiVisible++;
+				}
+			}
+
+			size_t separateVisible = 0;
+			BenchmarkTimer separateTimer;
+			for (int repeat = 0; repeat < viewRepeats; repeat++)
+			{
+				separateVisible = 0;
+				for (uint32_t view = 0; view < viewCount; view++)
+				{
+					bvh.QueryFrustum(views[view], results);
+					separateVisible += results.size();
+				}
+			}
+			double separateMs = separateTimer.GetElapsedMilliseconds() / viewRepeats;
+
+			if (multiVisible != separateVisible)
+			{
+				printf("QueryFrustums found %zu primitives over %u views, QueryFrustum found %zu\n", multiVisible,
+					viewCount, separateVisible);
+				return 1;
+			}
+
+			snprintf(viewRows[c][v], sizeof(viewRows[c][v]), "%10u %10u %12.4f %12.4f %9.2fx", count, viewCount,
+				multiMs, separateMs, separateMs / multiMs);
+		}
+	}
+
+	printf("\n%10s %10s %12s %12s %10s\n", "Objects", "Views", "Multi ms", "Separate ms", "Speedup");
+	for (uint32_t c = 0; c < countCount; c++)
+	{
+		for (uint32_t v = 0; v < 5; v++)
+		{
+			printf("%s\n", viewRows[c][v]);
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,395 @@
+// Include{s}
+#include "TestFramework.h"
+#include "SceneBVH.h"
+#include <algorithm>
+#include <cfloat>
+#include <random>
+
+using namespace DirectX;
+
+#pragma region Helper Functions
+// Struct to hold a random scene, boxes of mixed sizes in clumps so the tree has uneven splits to make
+struct RandomScene
+{
+	std::vector<XMFLOAT3> Centers;
+	std::vector<XMFLOAT3> Extents;
+};
+
+// Builds a scene of count boxes spread over a 400 unit cube
+static RandomScene CreateScene(uint32_t count, unsigned seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> clump(-200.0f, 200.0f);
+	std::normal_distribution<float> spread(0.0f, 20.0f);
+	std::uniform_real_distribution<float> size(0.1f, 6.0f);
+
+	RandomScene scene;
+	XMFLOAT3 clumpCenter(0.0f, 0.0f, 0.0f);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (i % 64 == 0)
+		{
+			clumpCenter.x = clump(random);
+			clumpCenter.y = clump(random);
+			clumpCenter.z = clump(random);
+		}
+
+		XMFLOAT3 center;
+		center.x = clumpCenter.x + spread(random);
+		center.y = clumpCenter.y + spread(random);
+		center.z = clumpCenter.z + spread(random);
+
+		XMFLOAT3 extents;
+		extents.x = size(random);
+		extents.y = size(random);
+		extents.z = size(random);
+
+		scene.Centers.push_back(center);
+		scene.Extents.push_back(extents);
+	}
+
+	return scene;
+}
+
+// Builds a frustum for a camera at a position looking at a target
+static FrustumCuller CreateFrustum(const XMFLOAT3& position, const XMFLOAT3& target, float farPlane)
+{
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(position.x, position.y, position.z, 1.0f),
+		XMVectorSet(target.x, target.y, target.z, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, farPlane);
+
+	FrustumCuller frustum;
+	frustum.ExtractPlanes(XMMatrixMultiply(view, projection));
+
+	return frustum;
+}
+
+// Tests every box against the frustum, the answer the tree has to give
+static std::vector<uint32_t> BruteForceFrustum(const RandomScene& scene, const FrustumCuller& frustum)
+{
+	std::vector<uint32_t> visible;
+	for (uint32_t i = 0; i < scene.Centers.size(); i++)
+	{
+		if (frustum.IsVisible(scene.Centers[i], scene.Extents[i]))
+		{
+			visible.push_back(i);
+		}
+	}
+
+	return visible;
+}
+
+// Sorts query results so they can be compared with the brute force order
+static std::vector<uint32_t> Sorted(std::vector<uint32_t> results)
+{
+	std::sort(results.begin(), results.end());
+	return results;
+}
+
+// Checks every node encloses what is below it, and every primitive is in exactly one leaf
+static bool IsTreeValid(const SceneBVH& bvh, const RandomScene& scene)
+{
+	const std::vector<BVHNode>& nodes = bvh.GetNodes();
+	std::vector<uint32_t> seen(scene.Centers.size(), 0);
+
+	auto encloses = [](const BVHNode& node, const XMFLOAT3& boundsMin, const XMFLOAT3& boundsMax)
+	{
+		return node.BoundsMin.x <= boundsMin.x && node.BoundsMin.y <= boundsMin.y && node.BoundsMin.z <= boundsMin.z &&
+			node.BoundsMax.x >= boundsMax.x && node.BoundsMax.y >= boundsMax.y && node.BoundsMax.z >= boundsMax.z;
+	};
+
+	// Walk down from the root checking each child is inside its parent
+	std::vector<uint32_t> stack(1, 0);
+	std::vector<uint32_t> results;
+	while (!stack.empty())
+	{
+		const BVHNode& node = nodes[stack.back()];
+		stack.pop_back();
+
+		if (node.Count > 0)
+		{
+			continue;
+		}
+
+		for (uint32_t child = node.LeftFirst; child < node.LeftFirst + 2; child++)
+		{
+			if (!encloses(node, nodes[child].BoundsMin, nodes[child].BoundsMax))
+			{
+				return false;
+			}
+			stack.push_back(child);
+		}
+	}
+
+	// A box query over everything finds each primitive once, and each must be inside the root
+	bvh.QueryBox(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX), results);
+	for (uint32_t primitive : results)
+	{
+		seen[primitive]++;
+
+		const XMFLOAT3& c = scene.Centers[primitive];
+		const XMFLOAT3& e = scene.Extents[primitive];
+		if (!encloses(nodes[0], XMFLOAT3(c.x - e.x, c.y - e.y, c.z - e.z), XMFLOAT3(c.x + e.x, c.y + e.y, c.z + e.z)))
+		{
+			return false;
+		}
+	}
+
+	return std::all_of(seen.begin(), seen.end(), [](uint32_t count) { return count == 1; });
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(QueryFrustumMatchesBruteForce)
+{
+	const uint32_t counts[] = { 1, 2, 3, 17, 1000, 20000 };
+	std::vector<uint32_t> results;
+
+	for (uint32_t count : counts)
+	{
+		RandomScene scene = CreateScene(count, count * 31 + 1);
+
+		SceneBVH bvh;
+		bvh.Build(scene.Centers, scene.Extents);
+		CHECK_EQUAL(count, bvh.GetPrimitiveCount());
+		CHECK(IsTreeValid(bvh, scene));
+
+		// Cameras inside, outside and at the edge of the scene, looking every which way
+		std::mt19937 random(count);
+		std::uniform_real_distribution<float> position(-300.0f, 300.0f);
+		for (int camera = 0; camera < 12; camera++)
+		{
+			XMFLOAT3 eye(position(random), position(random), position(random));
+			XMFLOAT3 target(position(random), position(random), position(random));
+			FrustumCuller frustum = CreateFrustum(eye, target, camera % 2 ? 150.0f : 1000.0f);
+
+			bvh.QueryFrustum(frustum, results);
+			CHECK(BruteForceFrustum(scene, frustum) == Sorted(results));
+		}
+	}
+}
+
+TEST_CASE(EmptyTreeFindsNothing)
+{
+	SceneBVH bvh;
+	bvh.Build({}, {});
+
+	std::vector<uint32_t> results(3, 7);
+	bvh.QueryFrustum(CreateFrustum(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), 100.0f), results);
+	CHECK(results.empty());
+
+	uint32_t hit = 0;
+	float distance = 0.0f;
+	CHECK(!bvh.RayCast(XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 1.0f), 100.0f, hit, distance));
+	CHECK_EQUAL(0u, bvh.GetPrimitiveCount());
+}
+
+TEST_CASE(QueryFrustumsMatchesSingleQueries)
+{
+	// Few enough boxes to walk on the calling thread, and enough to split the walk across the thread pool
+	const uint32_t counts[] = { 17, 1000, 20000 };
+	const uint32_t frustumCounts[] = { 1, 3, 17, 64 };
+	std::vector<uint32_t> results;
+	std::vector<uint64_t> visibility;
+
+	for (uint32_t count : counts)
+	{
+		RandomScene scene = CreateScene(count, count * 7 + 3);
+
+		SceneBVH bvh;
+		bvh.Build(scene.Centers, scene.Extents);
+
+		std::mt19937 random(count);
+		std::uniform_real_distribution<float> position(-300.0f, 300.0f);
+		std::vector<FrustumCuller> frustums;
+		for (int camera = 0; camera < 64; camera++)
+		{
+			XMFLOAT3 eye(position(random), position(random), position(random));
+			XMFLOAT3 target(position(random), position(random), position(random));
+			frustums.push_back(CreateFrustum(eye, target, camera % 3 ? 200.0f : 1000.0f));
+		}
+
+		for (uint32_t frustumCount : frustumCounts)
+		{
+			bvh.QueryFrustums(frustums.data(), frustumCount, visibility);
+			CHECK_EQUAL(size_t(count), visibility.size());
+
+			// Bit f of each mask has to list exactly what a query of frustum f on its own finds
+			for (uint32_t f = 0; f < frustumCount; f++)
+			{
+				std::vector<uint32_t> fromMasks;
+				for (uint32_t primitive = 0; primitive < count; primitive++)
+				{
+					if (visibility[primitive] & (1ull << f))
+					{
+						fromMasks.push_back(primitive);
+					}
+				}
+
+				bvh.QueryFrustum(frustums[f], results);
+				CHECK(Sorted(results) == fromMasks);
+			}
+
+			// No bits past the frustums that were asked for
+			const uint64_t unused = frustumCount == 64 ? 0 : ~((1ull << frustumCount) - 1);
+			for (uint64_t mask : visibility)
+			{
+				CHECK_EQUAL(0ull, mask & unused);
+			}
+		}
+	}
+
+	// An empty tree has no masks to give
+	SceneBVH empty;
+	empty.Build({}, {});
+	empty.QueryFrustums(nullptr, 0, visibility);
+	CHECK(visibility.empty());
+}
+
+TEST_CASE(RefitAfterMovesMatchesBruteForce)
+{
+	RandomScene scene = CreateScene(5000, 5);
+
+	SceneBVH bvh;
+	bvh.Build(scene.Centers, scene.Extents);
+
+	// Move a third of the boxes a long way, far enough that the old bounds would miss them
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> offset(-150.0f, 150.0f);
+	for (uint32_t i = 0; i < scene.Centers.size(); i += 3)
+	{
+		scene.Centers[i].x += offset(random);
+		scene.Centers[i].y += offset(random);
+		scene.Centers[i].z += offset(random);
+
+		bvh.UpdatePrimitive(i, scene.Centers[i], scene.Extents[i]);
+	}
+	bvh.Refit();
+
+	CHECK(IsTreeValid(bvh, scene));
+
+	std::vector<uint32_t> results;
+	std::uniform_real_distribution<float> position(-300.0f, 300.0f);
+	for (int camera = 0; camera < 12; camera++)
+	{
+		XMFLOAT3 eye(position(random), position(random), position(random));
+		XMFLOAT3 target(position(random), position(random), position(random));
+		FrustumCuller frustum = CreateFrustum(eye, target, 400.0f);
+
+		bvh.QueryFrustum(frustum, results);
+		CHECK(BruteForceFrustum(scene, frustum) == Sorted(results));
+	}
+}
+
+TEST_CASE(RayCastFindsClosestBox)
+{
+	RandomScene scene = CreateScene(3000, 21);
+
+	SceneBVH bvh;
+	bvh.Build(scene.Centers, scene.Extents);
+
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> position(-250.0f, 250.0f);
+	int hits = 0;
+
+	for (int ray = 0; ray < 200; ray++)
+	{
+		XMFLOAT3 origin(position(random), position(random), position(random));
+		XMFLOAT3 target(position(random) * 0.5f, position(random) * 0.5f, position(random) * 0.5f);
+		XMFLOAT3 direction(target.x - origin.x, target.y - origin.y, target.z - origin.z);
+
+		// Ray against every box with the same slab test
+		float closest = 1000.0f;
+		bool expectedHit = false;
+		for (uint32_t i = 0; i < scene.Centers.size(); i++)
+		{
+			float tMin = 0.0f;
+			float tMax = 1000.0f;
+			const float* o = &origin.x;
+			const float* d = &direction.x;
+			const float* c = &scene.Centers[i].x;
+			const float* e = &scene.Extents[i].x;
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				float inverse = d[axis] != 0.0f ? 1.0f / d[axis] : FLT_MAX;
+				float t1 = (c[axis] - e[axis] - o[axis]) * inverse;
+				float t2 = (c[axis] + e[axis] - o[axis]) * inverse;
+				tMin = (std::max)(tMin, (std::min)(t1, t2));
+				tMax = (std::min)(tMax, (std::max)(t1, t2));
+			}
+
+			if (tMin <= tMax && tMin < closest)
+			{
+				closest = tMin;
+				expectedHit = true;
+			}
+		}
+
+		uint32_t hit = 0;
+		float distance = 0.0f;
+		bool found = bvh.RayCast(origin, direction, 1000.0f, hit, distance);
+
+		CHECK_EQUAL(expectedHit, found);
+		if (found && expectedHit)
+		{
+			CHECK_NEAR(closest, distance, 1e-3);
+			hits++;
+		}
+	}
+
+	CHECK(hits > 0);
+}
+
+TEST_CASE(SphereAndBoxQueriesMatchBruteForce)
+{
+	RandomScene scene = CreateScene(4000, 8);
+
+	SceneBVH bvh;
+	bvh.Build(scene.Centers, scene.Extents);
+
+	std::mt19937 random(17);
+	std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+	std::uniform_real_distribution<float> size(1.0f, 60.0f);
+	std::vector<uint32_t> results;
+
+	for (int query = 0; query < 50; query++)
+	{
+		XMFLOAT3 center(position(random), position(random), position(random));
+		float radius = size(random);
+
+		std::vector<uint32_t> expectedSphere;
+		std::vector<uint32_t> expectedBox;
+		for (uint32_t i = 0; i < scene.Centers.size(); i++)
+		{
+			const float* c = &scene.Centers[i].x;
+			const float* e = &scene.Extents[i].x;
+			const float* q = &center.x;
+
+			float distanceSquared = 0.0f;
+			bool boxOverlap = true;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				float closest = (std::max)(c[axis] - e[axis], (std::min)(q[axis], c[axis] + e[axis]));
+				distanceSquared += (q[axis] - closest) * (q[axis] - closest);
+				boxOverlap = boxOverlap && fabsf(q[axis] - c[axis]) <= radius + e[axis];
+			}
+
+			if (distanceSquared <= radius * radius)
+			{
+				expectedSphere.push_back(i);
+			}
+			if (boxOverlap)
+			{
+				expectedBox.push_back(i);
+			}
+		}
+
+		bvh.QuerySphere(center, radius, results);
+		CHECK(expectedSphere == Sorted(results));
+
+		bvh.QueryBox(center, XMFLOAT3(radius, radius, radius), results);
+		CHECK(expectedBox == Sorted(results));
+	}
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Include{s}
+#include "TestFramework.h"
+#include "TerrainHeightField.h"
+#include <random>
+
+// Times GetHeights and GetNormals over 1k, 100k and 1M random points of a 513 sample heightmap, the size the app
+// loads, against a GetHeight or GetNormal call per point
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const uint32_t counts[] = { 1000, 100000, 1000000 };
+	const uint32_t countCount = smoke ? 1 : 3;
+	const int repeats = smoke ? 1 : 8;
+
+	const uint32_t samples = 513;
+	std::vector<float> heights(samples * samples);
+	for (uint32_t z = 0; z < samples; z++)
+	{
+		for (uint32_t x = 0; x < samples; x++)
+		{
+			heights[z * samples + x] = 20.0f * sinf(x * 0.02f) * cosf(z * 0.03f) + 0.01f * ((x * 7 + z * 13) % 50);
+		}
+	}
+
+	TerrainHeightField field;
+	field.Build(heights.data(), samples, samples, 1.0f, -256.0f, -256.0f);
+	field.BuildMips(4);
+
+	printf("%10s %12s %12s %10s %12s %12s %10s\n", "Points", "Batch ms", "Single ms", "Speedup", "Batch N ms",
+		"Single N ms", "Speedup");
+
+	for (uint32_t c = 0; c < countCount; c++)
+	{
+		const uint32_t count = counts[c];
+
+		// A little past the edges too, so the clamping is part of the cost
+		std::mt19937 random(3);
+		std::uniform_real_distribution<float> position(-270.0f, 270.0f);
+		std::vector<float> x(count);
+		std::vector<float> z(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			x[i] = position(random);
+			z[i] = position(random);
+		}
+
+		std::vector<float> batchHeights(count);
+		std::vector<float> singleHeights(count);
+		std::vector<float> batchNormals(count * 3);
+		std::vector<float> singleNormals(count * 3);
+
+		BenchmarkTimer batchTimer;
+		for (int repeat = 0; repeat < repeats; repeat++)
+		{
+			field.GetHeights(x.data(), z.data(), count, batchHeights.data());
+		}
+		double batchMs = batchTimer.GetElapsedMilliseconds() / repeats;
+
+		BenchmarkTimer singleTimer;
+		for (int repeat = 0; repeat < repeats; repeat++)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				singleHeights[i] = field.GetHeight(x[i], z[i]);
+			}
+		}
+		double singleMs = singleTimer.GetElapsedMilliseconds() / repeats;
+
+		BenchmarkTimer batchNormalTimer;
+		for (int repeat = 0; repeat < repeats; repeat++)
+		{
+			field.GetNormals(x.data(), z.data(), count, batchNormals.data());
+		}
+		double batchNormalMs = batchNormalTimer.GetElapsedMilliseconds() / repeats;
+
+		BenchmarkTimer singleNormalTimer;
+		for (int repeat = 0; repeat < repeats; repeat++)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				field.GetNormal(x[i], z[i], &singleNormals[i * 3]);
+			}
+		}
+		double singleNormalMs = singleNormalTimer.GetElapsedMilliseconds() / repeats;
+
+		printf("%10u %12.4f %12.4f %9.2fx %12.4f %12.4f %9.2fx\n", count, batchMs, singleMs, singleMs / batchMs,
+			batchNormalMs, singleNormalMs, singleNormalMs / batchNormalMs);
+
+		// Both ways have to give the same answers
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (fabsf(batchHeights[i] - singleHeights[i]) > 1e-4f ||
+				fabsf(batchNormals[i * 3 + 1] - singleNormals[i * 3 + 1]) > 1e-5f)
+			{
+				printf("The batch and single queries disagree at point %u\n", i);
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
\ No newline at end of file
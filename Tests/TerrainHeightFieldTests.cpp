@@ -0,0 +1,323 @@
+// Include{s}
+#include "TestFramework.h"
+#include "TerrainHeightField.h"
+#include <limits>
+#include <random>
+
+#pragma region Helper Functions
+// Size of the synthetic grid, 257 samples a side one unit apart and centred on the origin
+const uint32_t GridSamples = 257;
+const float GridOrigin = -128.0f;
+
+// Struct to hold a smooth analytic surface, a tilted plane with a long sine wave over it
+struct AnalyticSurface
+{
+	float SlopeX;
+	float SlopeZ;
+	float Amplitude;
+	float Frequency;
+
+	// Gets the height at a position
+	float GetHeight(float x, float z) const
+	{
+		return SlopeX * x + SlopeZ * z + Amplitude * sinf(Frequency * x) * cosf(Frequency * z);
+	}
+
+	// Gets the slopes along x and z at a position
+	void GetSlopes(float x, float z, float& slopeX, float& slopeZ) const
+	{
+		slopeX = SlopeX + Amplitude * Frequency * cosf(Frequency * x) * cosf(Frequency * z);
+		slopeZ = SlopeZ - Amplitude * Frequency * sinf(Frequency * x) * sinf(Frequency * z);
+	}
+};
+
+// Fills a grid with a surface's heights at every sample
+// Returns std::vector<float> - The samples, row major
+static std::vector<float> SampleSurface(const AnalyticSurface& surface)
+{
+	std::vector<float> heights(GridSamples * GridSamples);
+	for (uint32_t z = 0; z < GridSamples; z++)
+	{
+		for (uint32_t x = 0; x < GridSamples; x++)
+		{
+			heights[z * GridSamples + x] = surface.GetHeight(GridOrigin + x, GridOrigin + z);
+		}
+	}
+
+	return heights;
+}
+
+// Gets positions spread over the grid and past its edges, plus the ones with no sensible cell at all
+static void MakeQueryPositions(uint32_t count, std::vector<float>& x, std::vector<float>& z)
+{
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> position(GridOrigin - 20.0f, -GridOrigin + 20.0f);
+
+	x.resize(count);
+	z.resize(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		x[i] = position(random);
+		z[i] = position(random);
+	}
+
+	// Corners, far off the grid and not a number, in lanes of both the SIMD part and the part left over
+	const float special[] = { GridOrigin, -GridOrigin, 1e30f, -1e30f, std::numeric_limits<float>::infinity(),
+		std::numeric_limits<float>::quiet_NaN() };
+	for (uint32_t i = 0; i < 6; i++)
+	{
+		x[i * 3] = special[i];
+		z[count - 1 - i] = special[5 - i];
+	}
+}
+
+// Turns a surface's slopes into the unit normal the field should report
+static void NormalFromSlopes(float slopeX, float slopeZ, float normal[3])
+{
+	const float length = sqrtf(slopeX * slopeX + 1.0f + slopeZ * slopeZ);
+	normal[0] = -slopeX / length;
+	normal[1] = 1.0f / length;
+	normal[2] = -slopeZ / length;
+}
+
+// Samples a heightmap the way HeightmapSampler.hlsl does. GetHeightmapCoords puts the position on the centre of its
+// sample's texel, then the bilinear sampler blends the four texels round it, wrapping at the edges like the app's
+// sampler state
+// Returns float - The height the vertex shader would read
+static float SampleLikeTheShader(const std::vector<float>& heights, uint32_t width, uint32_t height, float spacing,
+	float originX, float originZ, float x, float z)
+{
+	const float u = ((x - originX) / spacing + 0.5f) * (1.0f / width);
+	const float v = ((z - originZ) / spacing + 0.5f) * (1.0f / height);
+
+	// Texel centres are half a texel in from the texel's corner
+	const float texelX = u * width - 0.5f;
+	const float texelZ = v * height - 0.5f;
+	const int left = static_cast<int>(floorf(texelX));
+	const int top = static_cast<int>(floorf(texelZ));
+	const float fractionX = texelX - floorf(texelX);
+	const float fractionZ = texelZ - floorf(texelZ);
+
+	auto texel = [&](int column, int row)
+	{
+		column = (column % static_cast<int>(width) + width) % width;
+		row = (row % static_cast<int>(height) + height) % height;
+		return heights[row * width + column];
+	};
+
+	const float upper = texel(left, top) + (texel(left + 1, top) - texel(left, top)) * fractionX;
+	const float lower = texel(left, top + 1) + (texel(left + 1, top + 1) - texel(left, top + 1)) * fractionX;
+	return upper + (lower - upper) * fractionZ;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(BatchHeightsMatchSingleQueries)
+{
+	const AnalyticSurface surface = { 0.1f, -0.05f, 12.0f, 0.03f };
+	const std::vector<float> heights = SampleSurface(surface);
+
+	TerrainHeightField field;
+	field.Build(heights.data(), GridSamples, GridSamples, 1.0f, GridOrigin, GridOrigin);
+	field.BuildMips(4);
+
+	// Not a multiple of four, so the last few go through the scalar path
+	std::vector<float> x;
+	std::vector<float> z;
+	MakeQueryPositions(203, x, z);
+
+	std::vector<float> batch(x.size());
+	for (uint32_t level = 0; level < field.GetLevelCount(); level++)
+	{
+		field.GetHeights(x.data(), z.data(), static_cast<uint32_t>(x.size()), batch.data(), level);
+
+		for (size_t i = 0; i < x.size(); i++)
+		{
+			CHECK_NEAR(field.GetHeight(x[i], z[i], level), batch[i], 1e-4);
+		}
+	}
+}
+
+TEST_CASE(BatchNormalsMatchSingleQueries)
+{
+	const AnalyticSurface surface = { -0.2f, 0.3f, 8.0f, 0.05f };
+	const std::vector<float> heights = SampleSurface(surface);
+
+	TerrainHeightField field;
+	field.Build(heights.data(), GridSamples, GridSamples, 1.0f, GridOrigin, GridOrigin);
+	field.BuildMips(4);
+
+	std::vector<float> x;
+	std::vector<float> z;
+	MakeQueryPositions(203, x, z);
+
+	std::vector<float> batch(x.size() * 3);
+	for (uint32_t level = 0; level < field.GetLevelCount(); level++)
+	{
+		field.GetNormals(x.data(), z.data(), static_cast<uint32_t>(x.size()), batch.data(), level);
+
+		for (size_t i = 0; i < x.size(); i++)
+		{
+			float normal[3];
+			field.GetNormal(x[i], z[i], normal, level);
+			CHECK_NEAR(normal[0], batch[i * 3 + 0], 1e-5);
+			CHECK_NEAR(normal[1], batch[i * 3 + 1], 1e-5);
+			CHECK_NEAR(normal[2], batch[i * 3 + 2], 1e-5);
+		}
+	}
+}
+
+TEST_CASE(HeightsMatchTheShadersTexelCentreLookup)
+{
+	// Uneven sides, spacing and origin, and rough heights, so half a texel off anywhere shows up
+	const uint32_t width = 97;
+	const uint32_t height = 65;
+	const float spacing = 2.5f;
+	const float originX = -40.0f;
+	const float originZ = 10.0f;
+
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> sample(0.0f, 10.0f);
+	std::vector<float> heights(width * height);
+	for (float& value : heights)
+	{
+		value = sample(random);
+	}
+
+	TerrainHeightField field;
+	field.Build(heights.data(), width, height, spacing, originX, originZ);
+
+	// Everywhere on the grid, up to its far edges. Past them the sampler wraps and the field clamps
+	const float sizeX = spacing * (width - 1);
+	const float sizeZ = spacing * (height - 1);
+	std::uniform_real_distribution<float> positionX(originX, originX + sizeX);
+	std::uniform_real_distribution<float> positionZ(originZ, originZ + sizeZ);
+	std::vector<float> x(500);
+	std::vector<float> z(500);
+	for (size_t i = 0; i < x.size(); i++)
+	{
+		x[i] = positionX(random);
+		z[i] = positionZ(random);
+	}
+
+	// Right on samples, halfway between them and on the corners
+	x[0] = originX;
+	z[0] = originZ;
+	x[1] = originX + sizeX;
+	z[1] = originZ + sizeZ;
+	x[2] = originX + spacing * 10.0f;
+	z[2] = originZ + spacing * 20.0f;
+	x[3] = originX + spacing * 10.5f;
+	z[3] = originZ + spacing * 20.5f;
+
+	std::vector<float> batch(x.size());
+	field.GetHeights(x.data(), z.data(), static_cast<uint32_t>(x.size()), batch.data());
+
+	for (size_t i = 0; i < x.size(); i++)
+	{
+		const float expected = SampleLikeTheShader(heights, width, height, spacing, originX, originZ, x[i], z[i]);
+		CHECK_NEAR(expected, field.GetHeight(x[i], z[i]), 1e-3);
+		CHECK_NEAR(expected, batch[i], 1e-3);
+	}
+	CHECK_NEAR(heights[20 * width + 10], field.GetHeight(x[2], z[2]), 1e-4);
+}
+
+TEST_CASE(PositionsThatAreNotANumberTakeTheLowestEdge)
+{
+	const AnalyticSurface surface = { 0.1f, 0.2f, 0.0f, 0.0f };
+	const std::vector<float> heights = SampleSurface(surface);
+
+	TerrainHeightField field;
+	field.Build(heights.data(), GridSamples, GridSamples, 1.0f, GridOrigin, GridOrigin);
+
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	CHECK_EQUAL(field.GetHeight(GridOrigin, 50.0f), field.GetHeight(nan, 50.0f));
+	CHECK_EQUAL(field.GetHeight(50.0f, GridOrigin), field.GetHeight(50.0f, nan));
+	CHECK_EQUAL(heights[0], field.GetHeight(nan, nan));
+
+	// The batch agrees whichever lane the NaN is in
+	const float x[4] = { nan, 50.0f, nan, 1.0f };
+	const float z[4] = { 50.0f, nan, nan, 1.0f };
+	float batch[4];
+	field.GetHeights(x, z, 4, batch);
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		CHECK_EQUAL(field.GetHeight(x[i], z[i]), batch[i]);
+	}
+
+	float normal[3];
+	field.GetNormal(nan, nan, normal);
+	CHECK(normal[1] > 0.0f && normal[1] <= 1.0f);
+}
+
+TEST_CASE(PlaneNormalsAreExactOnEveryLevel)
+{
+	// Both the bilinear blend and the tent filter keep a plane a plane, so every level has its exact slope
+	const AnalyticSurface surface = { 0.25f, -0.5f, 0.0f, 0.0f };
+	const std::vector<float> heights = SampleSurface(surface);
+
+	TerrainHeightField field;
+	field.Build(heights.data(), GridSamples, GridSamples, 1.0f, GridOrigin, GridOrigin);
+	field.BuildMips(MaxHeightFieldLevels);
+	CHECK_EQUAL(MaxHeightFieldLevels, field.GetLevelCount());
+
+	float expected[3];
+	NormalFromSlopes(surface.SlopeX, surface.SlopeZ, expected);
+
+	// The filter clamps at the edges, so only the middle of each level is compared
+	for (uint32_t level = 0; level < field.GetLevelCount(); level++)
+	{
+		const float inset = 2.0f * float(1u << level);
+		for (float z = GridOrigin + inset; z < -GridOrigin - inset; z += 13.7f)
+		{
+			for (float x = GridOrigin + inset; x < -GridOrigin - inset; x += 11.3f)
+			{
+				float normal[3];
+				field.GetNormal(x, z, normal, level);
+				CHECK_NEAR(expected[0], normal[0], 1e-5);
+				CHECK_NEAR(expected[1], normal[1], 1e-5);
+				CHECK_NEAR(expected[2], normal[2], 1e-5);
+				CHECK_NEAR(surface.GetHeight(x, z), field.GetHeight(x, z, level), 1e-3);
+			}
+		}
+	}
+}
+
+TEST_CASE(MipNormalsFollowAnalyticSlopes)
+{
+	// A wave 256 samples long, coarse levels smooth it a little but keep its shape
+	const AnalyticSurface surface = { 0.05f, 0.1f, 20.0f, 2.0f * 3.14159265f / 256.0f };
+	const std::vector<float> heights = SampleSurface(surface);
+
+	TerrainHeightField field;
+	field.Build(heights.data(), GridSamples, GridSamples, 1.0f, GridOrigin, GridOrigin);
+	field.BuildMips(4);
+
+	for (uint32_t level = 0; level < field.GetLevelCount(); level++)
+	{
+		// The blended slope is flat across a cell while the wave's turns, by up to amplitude * frequency^2 * size / 2
+		// over a cell, so coarser levels are allowed more
+		const float cellSize = float(1u << level);
+		const float tolerance = 0.6f * surface.Amplitude * surface.Frequency * surface.Frequency * cellSize;
+		const float inset = 4.0f * float(1u << level);
+		for (float z = GridOrigin + inset; z < -GridOrigin - inset; z += 9.1f)
+		{
+			for (float x = GridOrigin + inset; x < -GridOrigin - inset; x += 7.3f)
+			{
+				float slopeX = 0.0f;
+				float slopeZ = 0.0f;
+				surface.GetSlopes(x, z, slopeX, slopeZ);
+
+				float expected[3];
+				float normal[3];
+				NormalFromSlopes(slopeX, slopeZ, expected);
+				field.GetNormal(x, z, normal, level);
+
+				CHECK_NEAR(expected[0], normal[0], tolerance);
+				CHECK_NEAR(expected[1], normal[1], tolerance);
+				CHECK_NEAR(expected[2], normal[2], tolerance);
+			}
+		}
+	}
+}
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,341 @@
+// Include{s}
+#include "TestFramework.h"
+#include "TerrainQuadtree.h"
+#include <algorithm>
+
+#pragma region Helper Functions
+// Size of the synthetic grid, 2^8 + 1 samples a side so 16 cell patches fill 16 nodes exactly
+const uint32_t GridSamples = 257;
+const uint32_t GridPatch = 16;
+
+// Struct to hold the square of ground one selected node draws
+struct DrawnArea
+{
+	float X;
+	float Z;
+	float Size;
+	uint32_t Level;
+};
+
+// Builds a quadtree over a grid centred on the origin, a ridge down the middle with a little noise on top. The ridge
+// is straight between samples every level lands on, so the noise is all the level error there is. The heights are
+// whole multiples of 1/16 so every bound and range check comes out the same with any compiler
+// Returns std::vector<float> - The heights it was built from
+static std::vector<float> BuildSyntheticTerrain(TerrainQuadtree& quadtree)
+{
+	std::vector<float> heights(GridSamples * GridSamples);
+	for (uint32_t z = 0; z < GridSamples; z++)
+	{
+		for (uint32_t x = 0; x < GridSamples; x++)
+		{
+			heights[z * GridSamples + x] = ((x * 7 + z * 13) % 4) * 0.0625f + (std::min)(x, 256 - x) * 0.125f;
+		}
+	}
+
+	const float half = 0.5f * (GridSamples - 1);
+	quadtree.Build(heights.data(), GridSamples, GridSamples, 1.0f, -half, -half, GridPatch);
+
+	return heights;
+}
+
+// Turns a selection into the squares it draws, a quadrant covers a quarter of its node at the node's level
+static std::vector<DrawnArea> GetDrawnAreas(const std::vector<TerrainSelectedNode>& selection)
+{
+	std::vector<DrawnArea> areas;
+	for (const TerrainSelectedNode& node : selection)
+	{
+		if (node.Part == TerrainNodePart_Whole)
+		{
+			areas.push_back({ node.X, node.Z, node.Size, node.Level });
+			continue;
+		}
+
+		const float half = 0.5f * node.Size;
+		areas.push_back({ node.X + (node.Part & 1) * half, node.Z + (node.Part >> 1) * half, half, node.Level });
+	}
+
+	return areas;
+}
+
+// Checks two squares share part of an edge, touching at a corner does not count
+static bool AreNeighbours(const DrawnArea& first, const DrawnArea& second)
+{
+	const float overlapX = (std::min)(first.X + first.Size, second.X + second.Size) - (std::max)(first.X, second.X);
+	const float overlapZ = (std::min)(first.Z + first.Size, second.Z + second.Size) - (std::max)(first.Z, second.Z);
+
+	return (overlapX == 0.0f && overlapZ > 0.0f) || (overlapZ == 0.0f && overlapX > 0.0f);
+}
+
+// Gets the largest level step between any two drawn squares that share an edge
+static uint32_t GetLargestNeighbourStep(const std::vector<DrawnArea>& areas)
+{
+	uint32_t largestStep = 0;
+	for (size_t first = 0; first < areas.size(); first++)
+	{
+		for (size_t second = first + 1; second < areas.size(); second++)
+		{
+			if (AreNeighbours(areas[first], areas[second]))
+			{
+				const uint32_t step = areas[first].Level > areas[second].Level ?
+					areas[first].Level - areas[second].Level : areas[second].Level - areas[first].Level;
+				largestStep = (std::max)(largestStep, step);
+			}
+		}
+	}
+
+	return largestStep;
+}
+
+// Adds up the ground a selection draws
+static float GetDrawnArea(const std::vector<DrawnArea>& areas)
+{
+	float total = 0.0f;
+	for (const DrawnArea& area : areas)
+	{
+		total += area.Size * area.Size;
+	}
+
+	return total;
+}
+// Makes the six planes of a 90 degree frustum looking along a yaw from a camera, (normal, distance) with the inside
+// positive, reaching far units ahead
+static void MakeFrustumPlanes(const float camera[3], float yaw, float farDistance, float planes[6][4])
+{
+	const float forward[3] = { cosf(yaw), 0.0f, sinf(yaw) };
+	const float right[3] = { -forward[2], 0.0f, forward[0] };
+	const float normals[6][3] =
+	{
+		{ forward[0] + right[0], 0.0f, forward[2] + right[2] },
+		{ forward[0] - right[0], 0.0f, forward[2] - right[2] },
+		{ forward[0], 1.0f, forward[2] },
+		{ forward[0], -1.0f, forward[2] },
+		{ forward[0], 0.0f, forward[2] },
+		{ -forward[0], 0.0f, -forward[2] },
+	};
+
+	for (int plane = 0; plane < 6; plane++)
+	{
+		const float length = sqrtf(normals[plane][0] * normals[plane][0] + normals[plane][1] * normals[plane][1] +
+			normals[plane][2] * normals[plane][2]);
+		for (int axis = 0; axis < 3; axis++)
+		{
+			planes[plane][axis] = normals[plane][axis] / length;
+		}
+		planes[plane][3] = -(planes[plane][0] * camera[0] + planes[plane][1] * camera[1] +
+			planes[plane][2] * camera[2]);
+	}
+
+	// The far plane faces back towards the camera
+	planes[5][3] += farDistance;
+}
+
+// Culls every finest chunk on its own, from the bounds of the samples under it, with no pyramid to skip any
+// Returns std::vector<bool> - Whether each chunk, row by row, is inside all six planes
+static std::vector<bool> CullChunksOneByOne(const std::vector<float>& heights, const float planes[6][4])
+{
+	const uint32_t chunksPerSide = (GridSamples - 1) / GridPatch;
+	const float origin = -0.5f * (GridSamples - 1);
+	std::vector<bool> visible(chunksPerSide * chunksPerSide, true);
+
+	for (uint32_t chunkZ = 0; chunkZ < chunksPerSide; chunkZ++)
+	{
+		for (uint32_t chunkX = 0; chunkX < chunksPerSide; chunkX++)
+		{
+			float minHeight = heights[chunkZ * GridPatch * GridSamples + chunkX * GridPatch];
+			float maxHeight = minHeight;
+			for (uint32_t z = chunkZ * GridPatch; z <= (chunkZ + 1) * GridPatch; z++)
+			{
+				for (uint32_t x = chunkX * GridPatch; x <= (chunkX + 1) * GridPatch; x++)
+				{
+					minHeight = (std::min)(minHeight, heights[z * GridSamples + x]);
+					maxHeight = (std::max)(maxHeight, heights[z * GridSamples + x]);
+				}
+			}
+
+			const float center[3] = { origin + (chunkX + 0.5f) * GridPatch, 0.5f * (minHeight + maxHeight),
+				origin + (chunkZ + 0.5f) * GridPatch };
+			const float extents[3] = { 0.5f * GridPatch, 0.5f * (maxHeight - minHeight), 0.5f * GridPatch };
+
+			for (int plane = 0; plane < 6; plane++)
+			{
+				const float* p = planes[plane];
+				const float distance = p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3];
+				const float radius = fabsf(p[0]) * extents[0] + fabsf(p[1]) * extents[1] + fabsf(p[2]) * extents[2];
+
+				if (distance + radius < 0.0f)
+				{
+					visible[chunkZ * chunksPerSide + chunkX] = false;
+				}
+			}
+		}
+	}
+
+	return visible;
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(BuildMakesALevelPerHalving)
+{
+	TerrainQuadtree quadtree;
+	BuildSyntheticTerrain(quadtree);
+
+	// 16, 8, 4, 2 and 1 nodes a side
+	CHECK_EQUAL(5u, quadtree.GetLodLevels());
+	CHECK_EQUAL(256u, quadtree.GetChunkCount());
+	CHECK_EQUAL(256u + 64u + 16u + 4u + 1u, quadtree.GetTotalNodeCount());
+	CHECK_EQUAL(0.0f, quadtree.GetMinHeight());
+	CHECK_EQUAL(16.0f + 0.1875f, quadtree.GetMaxHeight());
+	CHECK_EQUAL(0.0f, quadtree.GetLevelError(0));
+
+	// Each level reaches twice as far as the one below until the view is set
+	for (uint32_t level = 1; level < quadtree.GetLodLevels(); level++)
+	{
+		CHECK_EQUAL(2.0f * quadtree.GetLodRange(level - 1), quadtree.GetLodRange(level));
+	}
+}
+
+TEST_CASE(SelectionCountsAtFixedCameras)
+{
+	TerrainQuadtree quadtree;
+	BuildSyntheticTerrain(quadtree);
+	quadtree.ComputeLodRanges(0.5f * 720.0f * 1.73f, 2.0f);
+
+	// Struct to hold a camera and what selecting from it has to come to
+	struct ExpectedSelection
+	{
+		float Camera[3];
+		uint32_t Nodes;
+		uint64_t Triangles;
+		uint32_t NodesPerLevel[5];
+	};
+	const ExpectedSelection expected[] =
+	{
+		// Low over the ridge, low at a corner, off to one side, high above and far outside the grid
+		{ { 0.0f, 10.0f, 0.0f }, 88, 32768, { 32, 36, 20, 0, 0 } },
+		{ { -128.0f, 5.0f, -128.0f }, 31, 11264, { 8, 9, 9, 5, 0 } },
+		{ { 60.0f, 40.0f, -30.0f }, 61, 23168, { 14, 30, 16, 1, 0 } },
+		{ { 0.0f, 1000.0f, 0.0f }, 1, 512, { 0, 0, 0, 0, 1 } },
+		{ { 2000.0f, 50.0f, 2000.0f }, 1, 512, { 0, 0, 0, 0, 1 } },
+	};
+
+	std::vector<TerrainSelectedNode> selection;
+	for (const ExpectedSelection& camera : expected)
+	{
+		quadtree.Select(camera.Camera, nullptr, selection);
+		const TerrainSelectionStats stats = quadtree.Summarise(selection);
+
+		CHECK_EQUAL(camera.Nodes, stats.Nodes);
+		CHECK_EQUAL(camera.Triangles, stats.Triangles);
+		for (uint32_t level = 0; level < 5; level++)
+		{
+			CHECK_EQUAL(camera.NodesPerLevel[level], stats.NodesPerLevel[level]);
+		}
+
+		// Without planes the whole grid is drawn once, with no gaps and no overlaps
+		const std::vector<DrawnArea> areas = GetDrawnAreas(selection);
+		CHECK_EQUAL(256u, stats.VisibleChunks);
+		CHECK_EQUAL(256.0f * 256.0f, GetDrawnArea(areas));
+	}
+}
+
+TEST_CASE(NeighbouringLevelsDifferByOne)
+{
+	TerrainQuadtree quadtree;
+	BuildSyntheticTerrain(quadtree);
+	quadtree.ComputeLodRanges(0.5f * 720.0f * 1.73f, 2.0f);
+
+	// A walk across the grid and up above it, every seam has to be between the same level or the next one
+	std::vector<TerrainSelectedNode> selection;
+	for (int step = 0; step <= 16; step++)
+	{
+		const float camera[3] = { -160.0f + step * 20.0f, 2.0f + step * step * 2.0f, 100.0f - step * 12.0f };
+		quadtree.Select(camera, nullptr, selection);
+
+		const std::vector<DrawnArea> areas = GetDrawnAreas(selection);
+		CHECK(GetLargestNeighbourStep(areas) <= 1);
+		CHECK_EQUAL(256.0f * 256.0f, GetDrawnArea(areas));
+	}
+}
+TEST_CASE(PyramidCullingMatchesCullingEveryChunk)
+{
+	TerrainQuadtree quadtree;
+	const std::vector<float> heights = BuildSyntheticTerrain(quadtree);
+
+	// No error is small enough for a coarser level, so every drawn node is one chunk
+	quadtree.ComputeLodRanges(0.5f * 720.0f * 1.73f, 1e-6f);
+
+	std::vector<TerrainSelectedNode> selection;
+	uint32_t visibleTotal = 0;
+	for (int view = 0; view < 8; view++)
+	{
+		const float camera[3] = { -140.0f + view * 40.0f, 8.0f + view * 4.0f, -60.0f + view * 15.0f };
+		float planes[6][4];
+		MakeFrustumPlanes(camera, view * 0.785f, 150.0f, planes);
+
+		quadtree.Select(camera, planes, selection);
+		const std::vector<bool> expected = CullChunksOneByOne(heights, planes);
+
+		// The pyramid drops whole subtrees at once and stops testing planes a node is inside, neither may change
+		// which chunks are kept
+		const uint32_t chunksPerSide = (GridSamples - 1) / GridPatch;
+		std::vector<bool> selected(expected.size(), false);
+		for (const TerrainSelectedNode& node : selection)
+		{
+			CHECK_EQUAL(0u, node.Level);
+			CHECK(node.Part == TerrainNodePart_Whole);
+
+			const uint32_t chunkX = static_cast<uint32_t>((node.X - quadtree.GetOriginX()) / GridPatch);
+			const uint32_t chunkZ = static_cast<uint32_t>((node.Z - quadtree.GetOriginZ()) / GridPatch);
+			selected[chunkZ * chunksPerSide + chunkX] = true;
+		}
+		CHECK(selected == expected);
+
+		const uint32_t visible = static_cast<uint32_t>(std::count(expected.begin(), expected.end(), true));
+		CHECK_EQUAL(visible, quadtree.Summarise(selection).VisibleChunks);
+		visibleTotal += visible;
+	}
+
+	// The views see some of the grid, not all or none of it
+	CHECK(visibleTotal > 0 && visibleTotal < 8 * 256);
+}
+
+TEST_CASE(CulledLevelsStillCoverEveryVisibleChunk)
+{
+	TerrainQuadtree quadtree;
+	const std::vector<float> heights = BuildSyntheticTerrain(quadtree);
+	quadtree.ComputeLodRanges(0.5f * 720.0f * 1.73f, 2.0f);
+
+	// Coarser nodes can reach past the frustum, but no chunk inside it may be left undrawn
+	std::vector<TerrainSelectedNode> selection;
+	for (int view = 0; view < 8; view++)
+	{
+		const float camera[3] = { 100.0f - view * 30.0f, 20.0f, 90.0f - view * 25.0f };
+		float planes[6][4];
+		MakeFrustumPlanes(camera, 3.0f + view * 0.785f, 400.0f, planes);
+
+		quadtree.Select(camera, planes, selection);
+		const std::vector<bool> expected = CullChunksOneByOne(heights, planes);
+		const std::vector<DrawnArea> areas = GetDrawnAreas(selection);
+
+		const uint32_t chunksPerSide = (GridSamples - 1) / GridPatch;
+		for (uint32_t chunk = 0; chunk < expected.size(); chunk++)
+		{
+			if (!expected[chunk])
+			{
+				continue;
+			}
+
+			const float x = quadtree.GetOriginX() + (chunk % chunksPerSide + 0.5f) * GridPatch;
+			const float z = quadtree.GetOriginZ() + (chunk / chunksPerSide + 0.5f) * GridPatch;
+			bool covered = false;
+			for (const DrawnArea& area : areas)
+			{
+				covered |= x > area.X && x < area.X + area.Size && z > area.Z && z < area.Z + area.Size;
+			}
+			CHECK(covered);
+		}
+		CHECK(GetLargestNeighbourStep(areas) <= 1);
+	}
+}
+#pragma endregion
\ No newline at end of file
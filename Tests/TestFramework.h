@@ -0,0 +1,129 @@
+#pragma once
+
+// Include{s}
+// Only the standard library, every test and benchmark target links TestMain.cpp and nothing else from here
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Struct to hold a registered test
+struct TestCase
+{
+	const char* Name;
+	void (*Function)();
+};
+
+// Collects the tests of a target as they are defined and runs them, a failed check marks the running test as failed
+// but lets it carry on so one run reports every broken expectation
+class TestRegistry
+{
+public:
+#pragma region Singleton
+	// Gets the registry every TEST_CASE adds itself to
+	// Returns TestRegistry* - The registry
+	static TestRegistry* GetInstance()
+	{
+		static TestRegistry instance;
+		return &instance;
+	}
+#pragma endregion
+
+#pragma region Test Methods
+	// Adds a test, called before main by TEST_CASE
+	// Returns bool - Always true, so registration can initialise a static
+	bool Register(const char* name, void (*function)())
+	{
+		m_tests.push_back({ name, function });
+		return true;
+	}
+
+	// Runs every test whose name contains the filter, or all of them with no filter
+	// Returns int - The number of tests that failed
+	int Run(const char* filter)
+	{
+		int failedTests = 0;
+		int ranTests = 0;
+
+		for (const TestCase& test : m_tests)
+		{
+			if (filter != nullptr && strstr(test.Name, filter) == nullptr)
+			{
+				continue;
+			}
+
+			m_failedChecks = 0;
+			test.Function();
+			ranTests++;
+
+			if (m_failedChecks > 0)
+			{
+				failedTests++;
+			}
+			printf("[%s] %s\n", m_failedChecks > 0 ? "FAILED" : "PASSED", test.Name);
+		}
+
+		printf("%d of %d tests passed\n", ranTests - failedTests, ranTests);
+		return failedTests;
+	}
+
+	// Reports a failed check against the running test
+	void Fail(const char* file, int line, const char* message)
+	{
+		printf("%s(%d): %s\n", file, line, message);
+		m_failedChecks++;
+	}
+#pragma endregion
+
+private:
+#pragma region Member Variables
+	std::vector<TestCase> m_tests;
+	int m_failedChecks = 0;
+#pragma endregion
+};
+
+// Times a block of work for the benchmark targets
+class BenchmarkTimer
+{
+public:
+	// Constructor starts the timer
+	BenchmarkTimer() : m_start(std::chrono::steady_clock::now()) {}
+
+	// Gets the time since the timer started
+	// Returns double - The elapsed time in milliseconds
+	double GetElapsedMilliseconds() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point m_start;
+};
+
+#pragma region Test Macros
+#define TEST_CONCAT_INNER(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_INNER(a, b)
+
+// Defines and registers a test function
+#define TEST_CASE(name) \
+	static void TEST_CONCAT(TestFunction_, name)(); \
+	static const bool TEST_CONCAT(TestRegistered_, name) = \
+		TestRegistry::GetInstance()->Register(#name, &TEST_CONCAT(TestFunction_, name)); \
+	static void TEST_CONCAT(TestFunction_, name)()
+
+// Checks a condition is true
+#define CHECK(condition) \
+	do { if (!(condition)) TestRegistry::GetInstance()->Fail(__FILE__, __LINE__, "CHECK(" #condition ")"); } while (0)
+
+// Checks two values are equal
+#define CHECK_EQUAL(expected, actual) \
+	do { if (!((expected) == (actual))) TestRegistry::GetInstance()->Fail(__FILE__, __LINE__, \
+		"CHECK_EQUAL(" #expected ", " #actual ")"); } while (0)
+
+// Checks two floating point values are within tolerance of each other
+#define CHECK_NEAR(expected, actual, tolerance) \
+	do { if (!(std::fabs(static_cast<double>(expected) - static_cast<double>(actual)) <= (tolerance))) \
+		TestRegistry::GetInstance()->Fail(__FILE__, __LINE__, \
+			"CHECK_NEAR(" #expected ", " #actual ", " #tolerance ")"); } while (0)
+#pragma endregion
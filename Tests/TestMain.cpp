@@ -0,0 +1,8 @@
+// Include{s}
+#include "TestFramework.h"
+
+// Runs the tests linked into the target, an optional argument only runs the tests whose names contain it
+int main(int argc, char** argv)
+{
+	return TestRegistry::GetInstance()->Run(argc > 1 ? argv[1] : nullptr) == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+// Include{s}
+#include "TestFramework.h"
+#include "TiledHeightmap.h"
+#include <fstream>
+
+#pragma region Helper Functions
+// Gets the sample a synthetic heightmap has at a position, every one different from its neighbours
+static uint16_t GetSourceSample(uint32_t x, uint32_t z)
+{
+	return static_cast<uint16_t>((x * 131 + z * 977 + x * z * 7) & 0xFFFF);
+}
+
+// Writes a synthetic row major .raw heightmap, 16-bit samples little endian or the top 8 bits of each
+// Returns bool - True if the file was written
+static bool WriteRaw(const std::string& path, uint32_t width, uint32_t height, uint32_t bitsPerSample)
+{
+	std::ofstream file(path, std::ios::binary);
+	for (uint32_t z = 0; z < height; z++)
+	{
+		for (uint32_t x = 0; x < width; x++)
+		{
+			const uint16_t sample = GetSourceSample(x, z);
+			if (bitsPerSample == 8)
+			{
+				file.put(static_cast<char>(sample >> 8));
+			}
+			else
+			{
+				file.put(static_cast<char>(sample & 0xFF));
+				file.put(static_cast<char>(sample >> 8));
+			}
+		}
+	}
+
+	return static_cast<bool>(file);
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(SamplesMatchTheRawFile)
+{
+	// Neither side is a whole number of tiles, so the last tiles repeat the edge
+	const uint32_t width = 37;
+	const uint32_t height = 23;
+	const std::string rawPath = "TiledHeightmapTests.raw";
+	const std::string tiledPath = "TiledHeightmapTests.tiled";
+
+	CHECK(WriteRaw(rawPath, width, height, 16));
+	CHECK(TiledHeightmap::ConvertRaw(rawPath, width, height, 16, 8, tiledPath));
+
+	TiledHeightmap heightmap;
+	CHECK(heightmap.Open(tiledPath));
+	CHECK_EQUAL(width, heightmap.GetWidth());
+	CHECK_EQUAL(height, heightmap.GetHeight());
+	CHECK_EQUAL(5u, heightmap.GetTilesX());
+	CHECK_EQUAL(3u, heightmap.GetTilesZ());
+
+	bool allMatch = heightmap.IsOpen();
+	for (uint32_t z = 0; z < height && allMatch; z++)
+	{
+		for (uint32_t x = 0; x < width; x++)
+		{
+			allMatch &= heightmap.GetSample(x, z) == GetSourceSample(x, z) / 65535.0f;
+		}
+	}
+	CHECK(allMatch);
+
+	// Positions off the heightmap read the nearest edge
+	if (heightmap.IsOpen())
+	{
+		CHECK_EQUAL(GetSourceSample(0, height - 1) / 65535.0f, heightmap.GetSample(-5, 100));
+		CHECK_EQUAL(GetSourceSample(width - 1, 0) / 65535.0f, heightmap.GetSample(width, -1));
+
+		// The shared edge of a tile is the first row and column of the next one
+		const uint16_t* first = heightmap.GetTile(0, 0);
+		const uint16_t* next = heightmap.GetTile(1, 0);
+		CHECK_EQUAL(first[8], next[0]);
+		CHECK_EQUAL(GetSourceSample(8, 0), first[8]);
+	}
+
+	heightmap.Close();
+	std::remove(rawPath.c_str());
+	std::remove(tiledPath.c_str());
+}
+
+TEST_CASE(EightBitSamplesSpanTheWholeRange)
+{
+	const std::string rawPath = "TiledHeightmapTests8.raw";
+	const std::string tiledPath = "TiledHeightmapTests8.tiled";
+
+	CHECK(WriteRaw(rawPath, 17, 17, 8));
+	CHECK(TiledHeightmap::ConvertRaw(rawPath, 17, 17, 8, 16, tiledPath));
+
+	TiledHeightmap heightmap;
+	CHECK(heightmap.Open(tiledPath));
+
+	bool allMatch = heightmap.IsOpen();
+	for (uint32_t z = 0; z < 17 && allMatch; z++)
+	{
+		for (uint32_t x = 0; x < 17; x++)
+		{
+			allMatch &= heightmap.GetSample(x, z) == (GetSourceSample(x, z) >> 8) * 257 / 65535.0f;
+		}
+	}
+	CHECK(allMatch);
+
+	heightmap.Close();
+	std::remove(rawPath.c_str());
+	std::remove(tiledPath.c_str());
+}
+
+TEST_CASE(ShortAndForeignFilesAreRejected)
+{
+	const std::string rawPath = "TiledHeightmapTestsShort.raw";
+	const std::string tiledPath = "TiledHeightmapTestsShort.tiled";
+
+	// Half the rows the conversion is told to expect
+	CHECK(WriteRaw(rawPath, 16, 8, 16));
+	CHECK(!TiledHeightmap::ConvertRaw(rawPath, 16, 16, 16, 8, tiledPath));
+	CHECK(!TiledHeightmap::ConvertRaw(rawPath, 16, 8, 12, 8, tiledPath));
+
+	// A file that is not a tiled heightmap, and one with no file at all
+	TiledHeightmap heightmap;
+	CHECK(!heightmap.Open(rawPath));
+	CHECK(!heightmap.IsOpen());
+	CHECK(!heightmap.Open("TiledHeightmapTestsMissing.tiled"));
+
+	std::remove(rawPath.c_str());
+	std::remove(tiledPath.c_str());
+}
+#pragma endregion
\ No newline at end of file
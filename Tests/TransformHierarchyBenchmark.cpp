@@ -0,0 +1,133 @@
+// Include{s}
+#include "TestFramework.h"
+#include "TransformStore.h"
+
+using namespace DirectX;
+
+// Struct to hold one synthetic hierarchy, parent[i] is an index into the hierarchy or InvalidTransform for a root
+struct SyntheticHierarchy
+{
+	const char* Name;
+	std::vector<uint32_t> Parents;
+};
+
+// Chains of depth nodes, so every subtree is as deep as it gets
+static SyntheticHierarchy CreateDeep(uint32_t count, uint32_t depth)
+{
+	SyntheticHierarchy hierarchy = { "Deep", std::vector<uint32_t>(count) };
+	for (uint32_t i = 0; i < count; i++)
+	{
+		hierarchy.Parents[i] = i % depth == 0 ? InvalidTransform : i - 1;
+	}
+
+	return hierarchy;
+}
+
+// Roots with fanOut children each, every child a leaf
+static SyntheticHierarchy CreateWide(uint32_t count, uint32_t fanOut)
+{
+	SyntheticHierarchy hierarchy = { "Wide", std::vector<uint32_t>(count) };
+	for (uint32_t i = 0; i < count; i++)
+	{
+		hierarchy.Parents[i] = i % (fanOut + 1) == 0 ? InvalidTransform : i - i % (fanOut + 1);
+	}
+
+	return hierarchy;
+}
+
+// Times re-sorting 10k and 100k node hierarchies after they are linked up, then a frame where one root in eight
+// moves (its whole subtree follows), a frame where one leaf in eight moves, and a frame where every root moves
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const uint32_t counts[] = { 10000, 100000 };
+	const uint32_t countCount = smoke ? 1 : 2;
+	const int frames = smoke ? 2 : 50;
+
+	TransformStore* store = TransformStore::GetInstance();
+	const XMFLOAT3 zero(0.0f, 0.0f, 0.0f);
+	const XMFLOAT3 one(1.0f, 1.0f, 1.0f);
+
+	printf("%6s %10s %10s %12s %12s %12s\n", "Shape", "Nodes", "Sort ms", "Roots/8 ms", "Leaves/8 ms", "Roots ms");
+
+	for (uint32_t c = 0; c < countCount; c++)
+	{
+		const SyntheticHierarchy hierarchies[] = { CreateDeep(counts[c], 64), CreateWide(counts[c], 64) };
+
+		for (const SyntheticHierarchy& hierarchy : hierarchies)
+		{
+			const uint32_t count = static_cast<uint32_t>(hierarchy.Parents.size());
+
+			// Children are allocated before their parents, so the first update has to sort everything
+			std::vector<uint32_t> handles(count);
+			for (uint32_t i = count; i-- > 0;)
+			{
+				handles[i] = store->Allocate(XMFLOAT3(1.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, 0.01f, 0.0f), one);
+			}
+
+			std::vector<uint32_t> roots;
+			std::vector<uint32_t> leaves;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (hierarchy.Parents[i] == InvalidTransform)
+				{
+					roots.push_back(handles[i]);
+				}
+				else
+				{
+					store->SetParent(handles[i], handles[hierarchy.Parents[i]]);
+				}
+
+				// Both shapes list a node's children straight after it, so a leaf is a node the next one is not under
+				if (i + 1 == count || hierarchy.Parents[i + 1] != i)
+				{
+					leaves.push_back(handles[i]);
+				}
+			}
+
+			BenchmarkTimer sortTimer;
+			store->UpdateDirtyTransforms();
+			double sortMs = sortTimer.GetElapsedMilliseconds();
+
+			// Times frames that move every step'th handle of a list
+			float offset = 0.0f;
+			auto timeFrames = [&](const std::vector<uint32_t>& moved, size_t step)
+			{
+				BenchmarkTimer timer;
+				for (int frame = 0; frame < frames; frame++)
+				{
+					offset += 0.01f;
+					for (size_t i = 0; i < moved.size(); i += step)
+					{
+						store->SetPosition(moved[i], XMFLOAT3(offset, 0.0f, 0.0f));
+					}
+					store->UpdateDirtyTransforms();
+				}
+
+				return timer.GetElapsedMilliseconds() / frames;
+			};
+
+			double rootsEighthMs = timeFrames(roots, 8);
+			double leavesEighthMs = timeFrames(leaves, 8);
+			double rootsMs = timeFrames(roots, 1);
+
+			printf("%6s %10u %10.3f %12.4f %12.4f %12.4f\n", hierarchy.Name, count, sortMs, rootsEighthMs,
+				leavesEighthMs, rootsMs);
+
+			// The end of a deep chain has every link's offset added up
+			if (hierarchy.Name[0] == 'D' && fabsf(store->GetWorldMatrix(handles[63])._41) < 10.0f)
+			{
+				printf("The chain did not follow its root\n");
+				return 1;
+			}
+
+			for (uint32_t handle : handles)
+			{
+				store->Free(handle);
+			}
+			store->UpdateDirtyTransforms();
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+// Include{s}
+#include "TestFramework.h"
+#include "TransformStore.h"
+
+using namespace DirectX;
+
+// Times a frame of UpdateDirtyTransforms over 1k, 10k and 100k root transforms when nothing moved, when a tenth
+// moved and when everything moved, against composing every world matrix from scratch the way Draw used to
+int main(int argc, char** argv)
+{
+	const bool smoke = argc > 1 && strcmp(argv[1], "--smoke") == 0;
+	const uint32_t counts[] = { 1000, 10000, 100000 };
+	const uint32_t countCount = smoke ? 1 : 3;
+	const int frames = smoke ? 2 : 50;
+
+	TransformStore* store = TransformStore::GetInstance();
+
+	printf("%10s %12s %12s %12s %14s\n", "Objects", "Static ms", "10% ms", "All ms", "Rebuild ms");
+
+	for (uint32_t c = 0; c < countCount; c++)
+	{
+		const uint32_t count = counts[c];
+
+		std::vector<uint32_t> handles(count);
+		std::vector<XMFLOAT3> positions(count);
+		const XMFLOAT3 rotation(0.1f, 0.2f, 0.3f);
+		const XMFLOAT3 scale(1.0f, 2.0f, 1.0f);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			positions[i] = XMFLOAT3(static_cast<float>(i), 0.0f, 0.0f);
+			handles[i] = store->Allocate(positions[i], rotation, scale);
+		}
+		store->UpdateDirtyTransforms();
+
+		// Times frames where every step'th transform moves, step 0 moves nothing
+		auto timeFrames = [&](uint32_t step)
+		{
+			BenchmarkTimer timer;
+			for (int frame = 0; frame < frames; frame++)
+			{
+				for (uint32_t i = 0; step > 0 && i < count; i += step)
+				{
+					positions[i].y += 0.01f;
+					store->SetPosition(handles[i], positions[i]);
+				}
+				store->UpdateDirtyTransforms();
+			}
+
+			return timer.GetElapsedMilliseconds() / frames;
+		};
+
+		double staticMs = timeFrames(0);
+		double tenthMs = timeFrames(10);
+		double allMs = timeFrames(1);
+
+		// Scale, three rotations and a translation for every object, every frame
+		std::vector<XMFLOAT4X4> worlds(count);
+		BenchmarkTimer rebuildTimer;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				XMMATRIX world = XMMatrixScaling(scale.x, scale.y, scale.z) * XMMatrixRotationX(rotation.x) *
+					XMMatrixRotationY(rotation.y) * XMMatrixRotationZ(rotation.z) *
+					XMMatrixTranslation(positions[i].x, positions[i].y, positions[i].z);
+				XMStoreFloat4x4(&worlds[i], XMMatrixTranspose(world));
+			}
+		}
+		double rebuildMs = rebuildTimer.GetElapsedMilliseconds() / frames;
+
+		printf("%10u %12.4f %12.4f %12.4f %14.4f\n", count, staticMs, tenthMs, allMs, rebuildMs);
+
+		// The cached matrix has to agree with the one built from scratch
+		if (fabsf(store->GetWorldMatrixTransposed(handles[count - 1])._24 - worlds[count - 1]._24) > 1e-3f)
+		{
+			printf("The store and the rebuilt matrices disagree\n");
+			return 1;
+		}
+
+		for (uint32_t handle : handles)
+		{
+			store->Free(handle);
+		}
+		store->UpdateDirtyTransforms();
+	}
+
+	return 0;
+}
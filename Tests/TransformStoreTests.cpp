@@ -0,0 +1,396 @@
+// Include{s}
+#include "TestFramework.h"
+#include "TransformStore.h"
+#include <algorithm>
+#include <random>
+
+using namespace DirectX;
+
+#pragma region Helper Functions
+// Builds the world matrix the way GameObject::Draw did before the store cached it
+static XMMATRIX ReferenceWorld(const XMFLOAT3& position, const XMFLOAT3& rotation, const XMFLOAT3& scale)
+{
+	return XMMatrixScaling(scale.x, scale.y, scale.z) * XMMatrixRotationX(rotation.x) *
+		XMMatrixRotationY(rotation.y) * XMMatrixRotationZ(rotation.z) *
+		XMMatrixTranslation(position.x, position.y, position.z);
+}
+
+// Checks a cached matrix holds the expected one, to within float rounding relative to the size of each element
+static bool NearMatrix(FXMMATRIX expected, const XMFLOAT4X4& actual)
+{
+	XMFLOAT4X4 stored;
+	XMStoreFloat4x4(&stored, expected);
+
+	for (int row = 0; row < 4; row++)
+	{
+		for (int column = 0; column < 4; column++)
+		{
+			float tolerance = 1e-4f * (std::max)(1.0f, fabsf(stored.m[row][column]));
+			if (fabsf(stored.m[row][column] - actual.m[row][column]) > tolerance)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+// Builds the world matrix of a node from the local transforms of it and its ancestors, parent[i] indexes the arrays
+static XMMATRIX ReferenceHierarchyWorld(uint32_t node, const std::vector<uint32_t>& parents,
+	const std::vector<XMFLOAT3>& positions, const std::vector<XMFLOAT3>& rotations,
+	const std::vector<XMFLOAT3>& scales)
+{
+	XMMATRIX world = ReferenceWorld(positions[node], rotations[node], scales[node]);
+	for (uint32_t ancestor = parents[node]; ancestor != InvalidTransform; ancestor = parents[ancestor])
+	{
+		world = world * ReferenceWorld(positions[ancestor], rotations[ancestor], scales[ancestor]);
+	}
+
+	return world;
+}
+
+// Returns every handle to the store, the store is a singleton so each test leaves it empty
+static void FreeAll(const std::vector<uint32_t>& handles)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	for (uint32_t handle : handles)
+	{
+		store->Free(handle);
+	}
+	store->UpdateDirtyTransforms();
+}
+#pragma endregion
+
+#pragma region Tests
+TEST_CASE(AllocateBuildsTheWorldMatrixStraightAway)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	const XMFLOAT3 position(1.0f, -2.0f, 3.0f);
+	const XMFLOAT3 rotation(0.3f, 1.1f, -0.7f);
+	const XMFLOAT3 scale(2.0f, 0.5f, 1.5f);
+
+	uint32_t handle = store->Allocate(position, rotation, scale);
+	CHECK_EQUAL(0u, store->GetDirtyCount());
+	CHECK(NearMatrix(ReferenceWorld(position, rotation, scale), store->GetWorldMatrix(handle)));
+	CHECK(NearMatrix(XMMatrixTranspose(ReferenceWorld(position, rotation, scale)),
+		store->GetWorldMatrixTransposed(handle)));
+	CHECK_EQUAL(InvalidTransform, store->GetParent(handle));
+
+	FreeAll({ handle });
+}
+
+TEST_CASE(OnlyDirtyTransformsAreRebuilt)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	std::vector<uint32_t> handles;
+	for (int i = 0; i < 100; i++)
+	{
+		handles.push_back(store->Allocate(XMFLOAT3(float(i), 0.0f, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f),
+			XMFLOAT3(1.0f, 1.0f, 1.0f)));
+	}
+
+	// A static scene costs nothing
+	CHECK_EQUAL(0u, store->UpdateDirtyTransforms());
+
+	// Setting the same transform twice in a frame only queues it once
+	store->SetPosition(handles[10], XMFLOAT3(5.0f, 6.0f, 7.0f));
+	store->SetRotation(handles[10], XMFLOAT3(0.0f, XM_PIDIV2, 0.0f));
+	store->SetScale(handles[42], XMFLOAT3(3.0f, 3.0f, 3.0f));
+	CHECK_EQUAL(2u, store->GetDirtyCount());
+
+	// Until the update the old matrix is still cached
+	CHECK_NEAR(10.0, store->GetWorldMatrix(handles[10])._41, 1e-6);
+
+	CHECK_EQUAL(2u, store->UpdateDirtyTransforms());
+	CHECK_EQUAL(0u, store->GetDirtyCount());
+	CHECK(NearMatrix(ReferenceWorld(XMFLOAT3(5.0f, 6.0f, 7.0f), XMFLOAT3(0.0f, XM_PIDIV2, 0.0f),
+		XMFLOAT3(1.0f, 1.0f, 1.0f)), store->GetWorldMatrix(handles[10])));
+	CHECK(NearMatrix(XMMatrixScaling(3.0f, 3.0f, 3.0f) * XMMatrixTranslation(42.0f, 0.0f, 0.0f),
+		store->GetWorldMatrix(handles[42])));
+
+	// Everything else kept its matrix
+	CHECK(NearMatrix(XMMatrixTranslation(41.0f, 0.0f, 0.0f), store->GetWorldMatrix(handles[41])));
+	CHECK_EQUAL(0u, store->UpdateDirtyTransforms());
+
+	FreeAll(handles);
+}
+
+TEST_CASE(RandomEditsMatchTheReference)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> angle(-XM_PI, XM_PI);
+	std::uniform_real_distribution<float> size(0.1f, 4.0f);
+
+	// Enough transforms that the update takes the parallel path
+	const uint32_t count = 5000;
+	std::vector<uint32_t> handles;
+	std::vector<XMFLOAT3> positions(count);
+	std::vector<XMFLOAT3> rotations(count, XMFLOAT3(0.0f, 0.0f, 0.0f));
+	std::vector<XMFLOAT3> scales(count, XMFLOAT3(1.0f, 1.0f, 1.0f));
+	for (uint32_t i = 0; i < count; i++)
+	{
+		positions[i] = XMFLOAT3(float(i), 0.0f, 0.0f);
+		handles.push_back(store->Allocate(positions[i], rotations[i], scales[i]));
+	}
+
+	for (int frame = 0; frame < 4; frame++)
+	{
+		std::vector<uint8_t> edited(count, 0);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (random() % 3 != 0)
+			{
+				continue;
+			}
+
+			positions[i].x = position(random);
+			positions[i].y = position(random);
+			rotations[i].z = angle(random);
+			scales[i].y = size(random);
+			store->SetPosition(handles[i], positions[i]);
+			store->SetRotation(handles[i], rotations[i]);
+			store->SetScale(handles[i], scales[i]);
+			edited[i] = 1;
+		}
+
+		uint32_t editedCount = 0;
+		for (uint8_t flag : edited)
+		{
+			editedCount += flag;
+		}
+		CHECK_EQUAL(editedCount, store->UpdateDirtyTransforms());
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			CHECK(NearMatrix(ReferenceWorld(positions[i], rotations[i], scales[i]), store->GetWorldMatrix(handles[i])));
+		}
+	}
+
+	FreeAll(handles);
+}
+
+TEST_CASE(SetWorldMatrixStaysUntilTheLocalTransformChanges)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	uint32_t handle = store->Allocate(XMFLOAT3(1.0f, 2.0f, 3.0f), XMFLOAT3(0.0f, 0.0f, 0.0f),
+		XMFLOAT3(1.0f, 1.0f, 1.0f));
+
+	XMMATRIX overridden = XMMatrixRotationY(1.0f) * XMMatrixTranslation(-9.0f, 8.0f, 7.0f);
+	store->SetWorldMatrix(handle, overridden);
+	CHECK_EQUAL(0u, store->UpdateDirtyTransforms());
+	CHECK(NearMatrix(overridden, store->GetWorldMatrix(handle)));
+	CHECK(NearMatrix(XMMatrixTranspose(overridden), store->GetWorldMatrixTransposed(handle)));
+
+	// The next local change rebuilds from position, rotation and scale again
+	store->SetPosition(handle, XMFLOAT3(4.0f, 5.0f, 6.0f));
+	CHECK_EQUAL(1u, store->UpdateDirtyTransforms());
+	CHECK(NearMatrix(XMMatrixTranslation(4.0f, 5.0f, 6.0f), store->GetWorldMatrix(handle)));
+
+	// A local change still waiting for the update is replaced by an override set after it
+	store->SetScale(handle, XMFLOAT3(2.0f, 2.0f, 2.0f));
+	CHECK_EQUAL(1u, store->GetDirtyCount());
+	store->SetWorldMatrix(handle, overridden);
+	CHECK_EQUAL(0u, store->GetDirtyCount());
+	CHECK_EQUAL(0u, store->UpdateDirtyTransforms());
+	CHECK(NearMatrix(overridden, store->GetWorldMatrix(handle)));
+
+	FreeAll({ handle });
+}
+
+TEST_CASE(FreedHandlesAreReusedAndNeverRebuilt)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	const XMFLOAT3 zero(0.0f, 0.0f, 0.0f);
+	const XMFLOAT3 one(1.0f, 1.0f, 1.0f);
+
+	uint32_t first = store->Allocate(zero, zero, one);
+	uint32_t second = store->Allocate(XMFLOAT3(2.0f, 0.0f, 0.0f), zero, one);
+
+	// A transform freed while dirty drops out of the pending update
+	store->SetPosition(first, XMFLOAT3(1.0f, 1.0f, 1.0f));
+	store->Free(first);
+	CHECK_EQUAL(0u, store->GetDirtyCount());
+	CHECK_EQUAL(0u, store->UpdateDirtyTransforms());
+
+	uint32_t third = store->Allocate(XMFLOAT3(3.0f, 0.0f, 0.0f), zero, one);
+	CHECK_EQUAL(first, third);
+	CHECK(NearMatrix(XMMatrixTranslation(3.0f, 0.0f, 0.0f), store->GetWorldMatrix(third)));
+	CHECK(NearMatrix(XMMatrixTranslation(2.0f, 0.0f, 0.0f), store->GetWorldMatrix(second)));
+
+	FreeAll({ second, third });
+}
+
+TEST_CASE(ChildrenFollowTheirParent)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	const XMFLOAT3 zero(0.0f, 0.0f, 0.0f);
+	const XMFLOAT3 one(1.0f, 1.0f, 1.0f);
+
+	uint32_t vehicle = store->Allocate(XMFLOAT3(10.0f, 0.0f, 0.0f), XMFLOAT3(0.0f, XM_PIDIV2, 0.0f), one);
+	uint32_t crate = store->Allocate(XMFLOAT3(1.0f, 0.0f, 0.0f), zero, XMFLOAT3(0.5f, 0.5f, 0.5f));
+	uint32_t other = store->Allocate(XMFLOAT3(-5.0f, 0.0f, 0.0f), zero, one);
+
+	CHECK(store->SetParent(crate, vehicle));
+	CHECK_EQUAL(vehicle, store->GetParent(crate));
+	CHECK_EQUAL(1u, store->UpdateDirtyTransforms());
+
+	// The crate's local offset is turned with the vehicle, +X becomes -Z
+	XMMATRIX vehicleWorld = XMMatrixRotationY(XM_PIDIV2) * XMMatrixTranslation(10.0f, 0.0f, 0.0f);
+	CHECK(NearMatrix(XMMatrixScaling(0.5f, 0.5f, 0.5f) * XMMatrixTranslation(1.0f, 0.0f, 0.0f) * vehicleWorld,
+		store->GetWorldMatrix(crate)));
+	CHECK_NEAR(10.0, store->GetWorldMatrix(crate)._41, 1e-5);
+	CHECK_NEAR(-1.0, store->GetWorldMatrix(crate)._43, 1e-5);
+
+	// Moving the parent rebuilds its whole subtree and nothing else
+	store->SetPosition(vehicle, XMFLOAT3(20.0f, 0.0f, 0.0f));
+	CHECK_EQUAL(2u, store->UpdateDirtyTransforms());
+	CHECK_NEAR(20.0, store->GetWorldMatrix(crate)._41, 1e-5);
+	CHECK(NearMatrix(XMMatrixTranslation(-5.0f, 0.0f, 0.0f), store->GetWorldMatrix(other)));
+
+	// A dirty child inside a dirty subtree is only rebuilt once
+	store->SetPosition(crate, XMFLOAT3(2.0f, 0.0f, 0.0f));
+	store->SetPosition(vehicle, XMFLOAT3(30.0f, 0.0f, 0.0f));
+	CHECK_EQUAL(2u, store->UpdateDirtyTransforms());
+	CHECK_NEAR(-2.0, store->GetWorldMatrix(crate)._43, 1e-5);
+
+	// Overriding the parent's world matrix moves the children with it
+	store->SetWorldMatrix(vehicle, XMMatrixTranslation(0.0f, 100.0f, 0.0f));
+	CHECK_EQUAL(1u, store->UpdateDirtyTransforms());
+	CHECK(NearMatrix(XMMatrixScaling(0.5f, 0.5f, 0.5f) * XMMatrixTranslation(2.0f, 100.0f, 0.0f),
+		store->GetWorldMatrix(crate)));
+
+	FreeAll({ crate, vehicle, other });
+}
+
+TEST_CASE(SetParentRejectsCycles)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	const XMFLOAT3 zero(0.0f, 0.0f, 0.0f);
+	const XMFLOAT3 one(1.0f, 1.0f, 1.0f);
+
+	uint32_t a = store->Allocate(zero, zero, one);
+	uint32_t b = store->Allocate(zero, zero, one);
+	uint32_t c = store->Allocate(zero, zero, one);
+	CHECK(store->SetParent(b, a));
+	CHECK(store->SetParent(c, b));
+
+	CHECK(!store->SetParent(a, a));
+	CHECK(!store->SetParent(a, c));
+	CHECK(!store->SetParent(a, b));
+	CHECK_EQUAL(InvalidTransform, store->GetParent(a));
+
+	// Detaching is always allowed, and the same parent twice changes nothing
+	CHECK(store->SetParent(c, InvalidTransform));
+	CHECK(store->SetParent(a, c));
+	CHECK(store->SetParent(a, c));
+	CHECK_EQUAL(c, store->GetParent(a));
+	store->UpdateDirtyTransforms();
+	CHECK_EQUAL(InvalidTransform, store->GetParent(c));
+
+	FreeAll({ a, b, c });
+}
+
+TEST_CASE(FreeTurnsChildrenIntoRoots)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	const XMFLOAT3 zero(0.0f, 0.0f, 0.0f);
+	const XMFLOAT3 one(1.0f, 1.0f, 1.0f);
+
+	uint32_t parent = store->Allocate(XMFLOAT3(100.0f, 0.0f, 0.0f), zero, one);
+	uint32_t child = store->Allocate(XMFLOAT3(1.0f, 2.0f, 3.0f), zero, one);
+	uint32_t grandchild = store->Allocate(XMFLOAT3(0.0f, 0.0f, 1.0f), zero, one);
+	store->SetParent(child, parent);
+	store->SetParent(grandchild, child);
+	store->UpdateDirtyTransforms();
+	CHECK_NEAR(101.0, store->GetWorldMatrix(grandchild)._41, 1e-5);
+
+	// The child keeps its local transform, which now places it in the world, and takes the grandchild with it
+	store->Free(parent);
+	CHECK_EQUAL(2u, store->UpdateDirtyTransforms());
+	CHECK_EQUAL(InvalidTransform, store->GetParent(child));
+	CHECK_EQUAL(child, store->GetParent(grandchild));
+	CHECK(NearMatrix(XMMatrixTranslation(1.0f, 2.0f, 3.0f), store->GetWorldMatrix(child)));
+	CHECK(NearMatrix(XMMatrixTranslation(1.0f, 2.0f, 4.0f), store->GetWorldMatrix(grandchild)));
+
+	FreeAll({ grandchild, child });
+}
+
+TEST_CASE(RandomHierarchyMatchesTheReference)
+{
+	TransformStore* store = TransformStore::GetInstance();
+	std::mt19937 random(21);
+	std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> angle(-XM_PI, XM_PI);
+	std::uniform_real_distribution<float> size(0.5f, 1.5f);
+
+	// Parents are picked at random, often allocated after their children so the store has to re-sort
+	const uint32_t count = 4000;
+	std::vector<uint32_t> handles(count);
+	std::vector<uint32_t> parents(count, InvalidTransform);
+	std::vector<XMFLOAT3> positions(count);
+	std::vector<XMFLOAT3> rotations(count);
+	std::vector<XMFLOAT3> scales(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		positions[i] = XMFLOAT3(position(random), position(random), position(random));
+		rotations[i] = XMFLOAT3(angle(random), angle(random), angle(random));
+		scales[i] = XMFLOAT3(size(random), size(random), size(random));
+		handles[i] = store->Allocate(positions[i], rotations[i], scales[i]);
+	}
+
+	// Node i + 1 of a shuffled order takes a parent from the nodes before it, so there are no cycles
+	std::vector<uint32_t> order(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		order[i] = i;
+	}
+	std::shuffle(order.begin(), order.end(), random);
+	for (uint32_t i = 1; i < count; i++)
+	{
+		if (random() % 8 == 0)
+		{
+			continue;
+		}
+
+		// Mostly recent nodes, so some chains get deep
+		uint32_t parent = order[i - 1 - random() % (std::min)(i, 4u)];
+		parents[order[i]] = parent;
+		CHECK(store->SetParent(handles[order[i]], handles[parent]));
+	}
+
+	for (int frame = 0; frame < 4; frame++)
+	{
+		store->UpdateDirtyTransforms();
+		CHECK_EQUAL(0u, store->GetDirtyCount());
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			CHECK_EQUAL(parents[i] == InvalidTransform ? InvalidTransform : handles[parents[i]],
+				store->GetParent(handles[i]));
+
+			XMMATRIX expected = ReferenceHierarchyWorld(i, parents, positions, rotations, scales);
+			CHECK(NearMatrix(expected, store->GetWorldMatrix(handles[i])));
+		}
+
+		// Move a few nodes and reparent a few more before the next frame
+		for (int edit = 0; edit < 50; edit++)
+		{
+			uint32_t node = random() % count;
+			positions[node].x = position(random);
+			store->SetPosition(handles[node], positions[node]);
+
+			uint32_t moved = random() % count;
+			uint32_t newParent = random() % count;
+			if (store->SetParent(handles[moved], handles[newParent]))
+			{
+				parents[moved] = newParent;
+			}
+		}
+	}
+
+	FreeAll(handles);
+}
+#pragma endregion